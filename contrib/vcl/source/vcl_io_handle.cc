@@ -371,6 +371,11 @@ Api::IoCallUint64Result VclIoHandle::recvmsg(Buffer::RawSlice* slices, const uin
   return vclCallResultToIoCallResult(result);
 }
 
+Api::IoCallUint64Result
+VclIoHandle::sendmmsg(absl::Span<const absl::Span<const Buffer::RawSlice>>, int) {
+  PANIC("not implemented");
+}
+
 Api::IoCallUint64Result VclIoHandle::recvmmsg(RawSliceArrays&, uint32_t, RecvMsgOutput&) {
   PANIC("not implemented");
 }
@@ -289,6 +289,13 @@ public:
    */
   virtual uint32_t bufferLimit() const PURE;
 
+  /**
+   * Charge the memory of the slices allocated by the read and write buffers of the connection to
+   * an account. Must be called before any data is buffered.
+   * @param account supplies the account to charge.
+   */
+  virtual void bindBufferMemoryAccount(Buffer::BufferMemoryAccountSharedPtr account) PURE;
+
   /**
    * @return boolean telling if the connection is currently above the high watermark.
    */
@@ -367,6 +374,16 @@ public:
    * return value is cwnd(in packets) times the connection's MSS.
    */
   virtual absl::optional<uint64_t> congestionWindowInBytes() const PURE;
+
+  /**
+   * Detach the socket of the connection so that it can be handed off to another process, and
+   * close the connection without notifying the peer. This is only possible when the connection is
+   * open, has no buffered data, and neither its transport socket nor its read filters hold state
+   * that would be lost with the connection.
+   * @return IoHandlePtr a duplicate of the socket of the connection, or nullptr if the connection
+   *         can't be migrated, in which case it is left untouched.
+   */
+  virtual IoHandlePtr migrateSocket() PURE;
 };
 
 using ConnectionPtr = std::unique_ptr<Connection>;
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/network/address.h"
 #include "envoy/network/connection.h"
@@ -104,6 +105,20 @@ public:
    */
   virtual const std::string& statPrefix() const PURE;
 
+  /**
+   * Close the idle connections of the tcp listeners without notifying their peers, so that their
+   * sockets can be handed off to another process.
+   * @return std::vector<IoHandlePtr> the sockets of the closed connections.
+   */
+  virtual std::vector<IoHandlePtr> migrateIdleConnections() PURE;
+
+  /**
+   * Accept the socket of a connection migrated from another process on the tcp listener of its
+   * local address. The socket is closed if there is no such listener.
+   * @param socket supplies the socket of the migrated connection.
+   */
+  virtual void acceptMigratedConnection(ConnectionSocketPtr&& socket) PURE;
+
   /**
    * Used by ConnectionHandler to manage listeners.
    */
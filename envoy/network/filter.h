@@ -214,6 +214,13 @@ public:
    * non-terminal filters should not implement startUpstreamSecureTransport.
    */
   virtual bool startUpstreamSecureTransport() { return false; }
+
+  /**
+   * Method is called by the filter manager to check whether the connection is idle from the point
+   * of view of the filter, so that its socket can be handed off to another process, where the
+   * filter chain is created anew. Filters holding state about the connection must not migrate.
+   */
+  virtual bool canMigrate() { return false; }
 };
 
 using ReadFilterSharedPtr = std::shared_ptr<ReadFilter>;
@@ -12,6 +12,7 @@
 
 #include "absl/container/fixed_array.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Buffer {
@@ -120,6 +121,18 @@ public:
                                           int flags, const Address::Ip* self_ip,
                                           const Address::Instance& peer_address) PURE;
 
+  /**
+   * If the platform supports it (see supportsMmsg()), send multiple messages on a connected socket
+   * with a single system call.
+   * @param messages supplies the slices of each message to send, in order.
+   * @param flags flags to pass to the underlying sendmmsg function (see man 2 sendmmsg).
+   * @return a Api::IoCallUint64Result with err_ = nullptr and rc_ = the number of messages sent,
+   * which can be fewer than the number of messages passed in, or err_ = some IoError if the first
+   * message could not be sent.
+   */
+  virtual Api::IoCallUint64Result
+  sendmmsg(absl::Span<const absl::Span<const Buffer::RawSlice>> messages, int flags) PURE;
+
   struct RecvMsgPerPacketInfo {
     // The destination address from transport header.
     Address::InstanceConstSharedPtr local_address_;
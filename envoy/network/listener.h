@@ -31,6 +31,9 @@ class UdpListenerWorkerRouter;
 class ListenSocketFactory;
 using ListenSocketFactoryPtr = std::unique_ptr<ListenSocketFactory>;
 
+// By default a TCP listener accepts all the connections pending accept on a socket event.
+constexpr uint32_t DefaultMaxConnectionsToAcceptPerSocketEvent = UINT32_MAX;
+
 /**
  * ListenSocketFactory is a member of ListenConfig to provide listen socket.
  * Listeners created from the same ListenConfig instance have listening sockets
@@ -250,6 +253,12 @@ public:
    * limit.
    */
   virtual bool ignoreGlobalConnLimit() const PURE;
+
+  /**
+   * @return the maximum number of connections a TCP listener accepts per socket event. The
+   * connections pending over this number are accepted in the following event loop iterations.
+   */
+  virtual uint32_t maxConnectionsToAcceptPerSocketEvent() const PURE;
 };
 
 /**
@@ -273,6 +282,13 @@ public:
    * Called when a new connection is rejected.
    */
   virtual void onReject(RejectCause cause) PURE;
+
+  /**
+   * Called after accepting the connections pending on a socket event.
+   * @param connections_accepted supplies the number of connections accepted, including the
+   * rejected ones.
+   */
+  virtual void recordConnectionsAcceptedOnSocketEvent(uint32_t connections_accepted) PURE;
 };
 
 /**
@@ -132,6 +132,12 @@ public:
    */
   virtual bool canFlushClose() PURE;
 
+  /**
+   * @return bool whether the underlying socket can be handed off to another process without
+   *         losing any state held by the transport socket.
+   */
+  virtual bool canMigrate() const { return false; }
+
   /**
    * Connect the underlying transport.
    * @param socket provides the socket to connect.
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "envoy/common/pure.h"
 #include "envoy/event/dispatcher.h"
@@ -31,6 +32,15 @@ public:
     bool enable_reuse_port_default_;
   };
 
+  struct MigrateConnectionsResponse {
+    // The sockets of idle connections of the parent, empty if it has none to hand off right now.
+    std::vector<int> fds_;
+    // Whether the parent has more sockets to hand off right away.
+    bool more_;
+    // The number of connections left in the parent.
+    uint64_t parent_connections_;
+  };
+
   virtual ~HotRestart() = default;
 
   /**
@@ -68,6 +78,14 @@ public:
    */
   virtual void sendParentTerminateRequest() PURE;
 
+  /**
+   * Take over a batch of idle connections of the parent process. The sockets of the connections
+   * will be duplicated across process boundaries, and the connections closed in the parent without
+   * notifying the peers.
+   * @return response if the parent is alive and supports handing off its connections.
+   */
+  virtual absl::optional<MigrateConnectionsResponse> migrateParentConnections() PURE;
+
   /**
    * Retrieve stats from our parent process and merges them into stats_store, taking into account
    * the stats values we've already seen transferred.
@@ -253,6 +253,28 @@ public:
    * @return TRUE if the worker has started or FALSE if not.
    */
   virtual bool isWorkerStarted() PURE;
+
+  /**
+   * Callback called with the sockets of the idle connections closed by the workers.
+   * @param sockets supplies the sockets of the closed connections.
+   */
+  using MigrateIdleConnectionsCallback =
+      std::function<void(std::vector<Network::IoHandlePtr>&& sockets)>;
+
+  /**
+   * Close the idle connections of all workers without notifying their peers, so that their sockets
+   * can be handed off to a new process on hot restart.
+   * @param callback supplies the callback called on the main thread once all the workers are done,
+   *        with the sockets of the connections closed by them.
+   */
+  virtual void migrateIdleConnections(MigrateIdleConnectionsCallback callback) PURE;
+
+  /**
+   * Accept a connection migrated from the parent process on hot restart on one of the workers. The
+   * connection is closed if there is no listener for its local address.
+   * @param fd supplies the socket of the migrated connection, which is owned by the callee.
+   */
+  virtual void acceptMigratedConnection(os_fd_t fd) PURE;
 };
 
 // overload operator| to allow ListenerManager::listeners(ListenerState) to be called using a
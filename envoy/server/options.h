@@ -220,6 +220,12 @@ public:
    */
   virtual bool hotRestartDisabled() const PURE;
 
+  /**
+   * @return bool indicating whether the idle connections of the parent process are migrated to
+   *         this process on hot restart.
+   */
+  virtual bool hotRestartMigrateIdleConnections() const PURE;
+
   /**
    * @return bool indicating whether system signal listeners are enabled.
    */
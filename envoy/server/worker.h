@@ -1,8 +1,10 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
 #include "envoy/event/dispatcher.h"
+#include "envoy/network/listen_socket.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/server/guarddog.h"
 #include "envoy/server/overload/overload_manager.h"
@@ -90,6 +92,28 @@ public:
    */
   virtual void stopListener(Network::ListenerConfig& listener,
                             std::function<void()> completion) PURE;
+
+  /**
+   * Completion called when the idle connections of the worker have been closed.
+   * @param sockets supplies the sockets of the closed connections.
+   */
+  using MigrateIdleConnectionsCompletion =
+      std::function<void(std::vector<Network::IoHandlePtr>&& sockets)>;
+
+  /**
+   * Close the idle connections of the worker without notifying their peers, so that their sockets
+   * can be handed off to another process. This is used for hot restart.
+   * @param completion supplies the completion to be called with the sockets of the closed
+   * connections. This completion is called on the worker thread. No locking is performed by the
+   * worker.
+   */
+  virtual void migrateIdleConnections(MigrateIdleConnectionsCompletion completion) PURE;
+
+  /**
+   * Accept the socket of a connection migrated from another process on the worker.
+   * @param socket supplies the socket of the migrated connection.
+   */
+  virtual void acceptMigratedConnection(Network::ConnectionSocketPtr&& socket) PURE;
 };
 
 using WorkerPtr = std::unique_ptr<Worker>;
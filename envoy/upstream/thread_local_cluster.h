@@ -64,6 +64,13 @@ public:
 
   Upstream::HostDescriptionConstSharedPtr host() const { return pool_->host(); }
 
+  /**
+   * @return the connection pool. A pool only hands out connections to its own host, priority and
+   *         set of transport socket options. It is destroyed once idle, so its address may later
+   *         be reused by another pool.
+   */
+  Tcp::ConnectionPool::Instance& pool() { return *pool_; }
+
 private:
   friend class TcpPoolDataPeer;
   OnNewConnectionFn on_new_connection_;
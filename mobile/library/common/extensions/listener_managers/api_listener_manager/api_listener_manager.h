@@ -34,6 +34,8 @@ public:
   void beginListenerUpdate() override {}
   void endListenerUpdate(FailureStates&&) override {}
   bool isWorkerStarted() override { return true; }
+  void migrateIdleConnections(MigrateIdleConnectionsCallback) override {}
+  void acceptMigratedConnection(os_fd_t) override {}
   Http::Context& httpContext() { return server_.httpContext(); }
   ApiListenerOptRef apiListener() override {
     return api_listener_ ? ApiListenerOptRef(std::ref(*api_listener_)) : absl::nullopt;
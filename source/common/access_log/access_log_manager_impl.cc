@@ -1,5 +1,6 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <atomic>
 #include <string>
 
 #include "envoy/common/exception.h"
@@ -87,8 +88,9 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    moveWriteShards(about_to_write_buffer_);
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -125,6 +127,14 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
   buffer.drain(buffer.length());
 }
 
+void AccessLogFileImpl::moveWriteShards(Buffer::Instance& destination) {
+  for (WriteShard& shard : write_shards_) {
+    Thread::LockGuard lock(shard.lock_);
+    buffered_bytes_ -= shard.buffer_.length();
+    destination.move(shard.buffer_);
+  }
+}
+
 void AccessLogFileImpl::flushThreadFunc() {
 
   while (true) {
@@ -133,9 +143,9 @@ void AccessLogFileImpl::flushThreadFunc() {
     {
       Thread::LockGuard write_lock(write_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      // flush_event_ can be woken up either by large enough write buffers or by timer.
+      // In case it was timer, the write buffers can be empty.
+      while (buffered_bytes_ == 0 && !flush_thread_exit_ && !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -145,10 +155,10 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
     }
 
+    moveWriteShards(about_to_write_buffer_);
+
     // if we failed to reopen before, do it next loop.
     if (reopen_file_) {
       if (file_->isOpen()) {
@@ -176,33 +186,55 @@ void AccessLogFileImpl::flush() {
 
     // flush_lock_ must be held while checking this or else it is
     // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
+    // write_shards_ to about_to_write_buffer_, has unlocked flush_lock_,
     // but has not yet completed doWrite(). This would allow flush() to
     // return before the pending data has actually been written to disk.
     flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
 
-    if (flush_buffer_.length() == 0) {
+    if (buffered_bytes_ == 0) {
       return;
     }
 
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
+    moveWriteShards(about_to_write_buffer_);
   }
 
   doWrite(about_to_write_buffer_);
 }
 
+uint32_t AccessLogFileImpl::writeShardIndex() {
+  // Threads are given shards in turn the first time they write, which spreads the workers evenly
+  // over the shards.
+  static std::atomic<uint32_t> next_shard{0};
+  thread_local const uint32_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+  return shard % WRITE_SHARDS;
+}
+
 void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
+  stats_.write_buffered_.inc();
+  stats_.write_total_buffered_.add(data.length());
 
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+  // Threads keep writing to the same shard, which preserves the order of their lines.
+  WriteShard& shard = write_shards_[writeShardIndex()];
+  uint64_t previously_buffered;
+  {
+    Thread::LockGuard lock(shard.lock_);
+    shard.buffer_.add(data.data(), data.size());
+    previously_buffered = buffered_bytes_.fetch_add(data.size());
   }
 
-  stats_.write_buffered_.inc();
-  stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
+  if (!flush_thread_created_) {
+    Thread::LockGuard lock(write_lock_);
+    if (flush_thread_ == nullptr) {
+      createFlushStructures();
+      flush_thread_created_ = true;
+    }
+  }
+
+  // Only the write crossing the threshold wakes up the flush thread. It does so under write_lock_,
+  // so that the wake up can't be missed by a flush thread about to wait.
+  if (previously_buffered <= MIN_FLUSH_SIZE &&
+      previously_buffered + data.size() > MIN_FLUSH_SIZE) {
+    Thread::LockGuard lock(write_lock_);
     flush_event_.notifyOne();
   }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -61,6 +62,11 @@ private:
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * Writes are spread over a few independently locked buffers, chosen by the writing thread, so that
+ * workers logging to the same file concurrently rarely contend with each other. Every write is
+ * appended to a single buffer in full, so lines are never interleaved, and the lines written by
+ * one thread stay in order.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
@@ -81,8 +87,20 @@ public:
   void reopen() override;
   void flush() override;
 
+  /**
+   * @return the index of the buffer the calling thread writes to, which is the same for all files.
+   */
+  static uint32_t writeShardIndex();
+
 private:
+  // A buffer filled by writes and drained by flushes, with its own lock.
+  struct alignas(64) WriteShard {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
   void doWrite(Buffer::Instance& buffer);
+  void moveWriteShards(Buffer::Instance& destination);
   void flushThreadFunc();
   Api::IoCallBoolResult open();
   void createFlushStructures();
@@ -93,12 +111,16 @@ private:
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
 
+  // Number of buffers writes are spread over.
+  static constexpr uint32_t WRITE_SHARDS = 8;
+
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
   //    1) write_lock_
   //    2) flush_lock_
-  //    3) file_lock_
+  //    3) WriteShard::lock_
+  //    4) file_lock_
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -109,25 +131,26 @@ private:
                                           // and all other data used during flushing and file
                                           // re-opening.
   Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
+      write_lock_; // The lock guarding flush_event_ and the creation of the flush thread. Writers
+                   // only take it to start the flush thread, or to wake it up once enough data
+                   // has been buffered. It is always local to the process.
   Thread::ThreadPtr flush_thread_;
+  std::atomic<bool> flush_thread_created_{};
   Thread::CondVar flush_event_;
   std::atomic<bool> flush_thread_exit_{};
   std::atomic<bool> reopen_file_{};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+  std::array<WriteShard, WRITE_SHARDS>
+      write_shards_; // These buffers are used by multiple threads. They get filled and then
+                     // flushed either when max size is reached or when a timer fires.
+  std::atomic<uint64_t> buffered_bytes_{}; // Total length of the write_shards_ buffers.
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
   Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only by the flush thread. Data
-                                            // is moved from flush_buffer_ under lock, and then
-                                            // the lock is released so that flush_buffer_ can
-                                            // continue to fill. This buffer is then used for the
-                                            // final write to disk.
+                                            // is moved from each of write_shards_ under its
+                                            // lock, and then the lock is released so that the
+                                            // shard can continue to fill. This buffer is then
+                                            // used for the final write to disk.
   Event::TimerPtr flush_timer_;
   Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
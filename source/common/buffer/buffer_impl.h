@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_allocator.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -35,7 +36,7 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = std::unique_ptr<uint8_t[], SliceStorageDeleter>;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -55,7 +56,9 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)),
+        storage_(SliceAllocator::allocate(capacity_),
+                 SliceStorageDeleter{static_cast<size_t>(capacity_)}),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -369,7 +372,9 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {StoragePtr{SliceAllocator::allocate(slice_size),
+                       SliceStorageDeleter{static_cast<size_t>(slice_size)}},
+            static_cast<size_t>(slice_size)};
   }
 
 protected:
@@ -763,32 +768,18 @@ private:
 
   struct OwnedImplReservationSlicesOwnerMultiple : public OwnedImplReservationSlicesOwner {
   public:
-    static constexpr uint32_t free_list_max_ = Buffer::Reservation::MAX_SLICES_;
-
-    OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
+      // Release the uncommitted storage in reverse order, so that the storage of the first slices,
+      // which are the most likely to be committed by the next read, is reused first.
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
-        if (r->mem_ != nullptr) {
-          ASSERT(r->len_ == Slice::default_slice_size_);
-          if (free_list_ref_.size() < free_list_max_) {
-            free_list_ref_.push_back(std::move(r->mem_));
-          }
-        }
+        ASSERT(r->mem_ == nullptr || r->len_ == Slice::default_slice_size_);
+        r->mem_.reset();
       }
     }
 
     Slice::SizedStorage newStorage() {
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
-
-      Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
-      if (!free_list_ref_.empty()) {
-        storage.mem_ = std::move(free_list_ref_.back());
-        free_list_ref_.pop_back();
-      } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
-      }
-
-      return storage;
+      return Slice::newStorage(Slice::default_slice_size_);
     }
 
     absl::Span<Slice::SizedStorage> ownedStorages() override {
@@ -796,16 +787,6 @@ private:
     }
 
     absl::InlinedVector<Slice::SizedStorage, Buffer::Reservation::MAX_SLICES_> owned_storages_;
-
-  private:
-    // Thread local resolving introduces additional overhead. Initialize this reference once when
-    // constructing the owner to reduce thread local resolving to improve performance.
-    absl::InlinedVector<Slice::StoragePtr, free_list_max_>& free_list_ref_;
-
-    // Simple thread local cache to reduce unnecessary memory allocation and release. This cache
-    // is currently only used for multiple slices reservation because of the additional overhead
-    // that thread local resolving would introduce.
-    static thread_local absl::InlinedVector<Slice::StoragePtr, free_list_max_> free_list_;
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
@@ -0,0 +1,213 @@
+#include "source/common/buffer/slice_allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "source/common/common/macros.h"
+
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+struct SizeClass {
+  size_t size_;
+  // Bound on the number of blocks cached by the free list of a thread. Half of them are moved at
+  // once between the free list of a thread and the shared free list.
+  size_t thread_max_;
+  // Bound on the number of blocks cached by the shared free list.
+  size_t shared_max_;
+};
+
+// Up to 640KiB are cached per thread, and 5MiB in the shared free list.
+constexpr std::array<SizeClass, 3> SizeClasses{{
+    {4096, 32, 256},
+    {16384, 16, 128},
+    {65536, 4, 32},
+}};
+
+int sizeClassIndex(size_t size) {
+  for (size_t i = 0; i < SizeClasses.size(); ++i) {
+    if (SizeClasses[i].size_ == size) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+using FreeList = std::vector<uint8_t*>;
+
+class SharedFreeLists {
+public:
+  // Takes count blocks, of which the ones exceeding the bound of the free list are released to the
+  // heap.
+  void put(size_t index, uint8_t* const* blocks, size_t count) {
+    size_t accepted;
+    {
+      absl::MutexLock lock(&mutex_);
+      FreeList& free_list = free_lists_[index];
+      accepted = std::min(count, SizeClasses[index].shared_max_ - free_list.size());
+      free_list.insert(free_list.end(), blocks, blocks + accepted);
+      sizes_[index].store(free_list.size(), std::memory_order_relaxed);
+    }
+    for (size_t i = accepted; i < count; ++i) {
+      delete[] blocks[i];
+    }
+  }
+
+  // Moves up to count blocks to the given free list.
+  void take(size_t index, FreeList& to, size_t count) {
+    // Avoid locking the shared free list while it is empty.
+    if (sizes_[index].load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    absl::MutexLock lock(&mutex_);
+    FreeList& free_list = free_lists_[index];
+    const size_t taken = std::min(count, free_list.size());
+    to.insert(to.end(), free_list.end() - taken, free_list.end());
+    free_list.resize(free_list.size() - taken);
+    sizes_[index].store(free_list.size(), std::memory_order_relaxed);
+  }
+
+  void trim() {
+    trim_epoch_.fetch_add(1, std::memory_order_relaxed);
+    std::array<FreeList, SizeClasses.size()> free_lists;
+    {
+      absl::MutexLock lock(&mutex_);
+      for (size_t i = 0; i < SizeClasses.size(); ++i) {
+        free_lists[i].swap(free_lists_[i]);
+        sizes_[i].store(0, std::memory_order_relaxed);
+      }
+    }
+    for (const FreeList& free_list : free_lists) {
+      for (uint8_t* block : free_list) {
+        delete[] block;
+      }
+    }
+  }
+
+  size_t size(size_t index) const { return sizes_[index].load(std::memory_order_relaxed); }
+  uint64_t trimEpoch() const { return trim_epoch_.load(std::memory_order_relaxed); }
+
+private:
+  absl::Mutex mutex_;
+  std::array<FreeList, SizeClasses.size()> free_lists_ ABSL_GUARDED_BY(mutex_);
+  std::array<std::atomic<size_t>, SizeClasses.size()> sizes_{};
+  std::atomic<uint64_t> trim_epoch_{};
+};
+
+// Never destroyed, as slices may be released during static destruction.
+SharedFreeLists& sharedFreeLists() { MUTABLE_CONSTRUCT_ON_FIRST_USE(SharedFreeLists); }
+
+struct ThreadFreeLists {
+  ThreadFreeLists() : trim_epoch_(sharedFreeLists().trimEpoch()) {
+    for (size_t i = 0; i < SizeClasses.size(); ++i) {
+      free_lists_[i].reserve(SizeClasses[i].thread_max_ + 1);
+    }
+  }
+
+  ~ThreadFreeLists();
+
+  uint8_t* allocate(size_t index) {
+    maybeTrim();
+    FreeList& free_list = free_lists_[index];
+    if (free_list.empty()) {
+      sharedFreeLists().take(index, free_list, SizeClasses[index].thread_max_ / 2);
+      if (free_list.empty()) {
+        return nullptr;
+      }
+    }
+    uint8_t* block = free_list.back();
+    free_list.pop_back();
+    return block;
+  }
+
+  void release(size_t index, uint8_t* block) {
+    maybeTrim();
+    FreeList& free_list = free_lists_[index];
+    free_list.push_back(block);
+    if (free_list.size() > SizeClasses[index].thread_max_) {
+      // Hand the least recently released half over to the other threads.
+      const size_t count = SizeClasses[index].thread_max_ / 2;
+      sharedFreeLists().put(index, free_list.data(), count);
+      free_list.erase(free_list.begin(), free_list.begin() + count);
+    }
+  }
+
+  void maybeTrim() {
+    const uint64_t trim_epoch = sharedFreeLists().trimEpoch();
+    if (trim_epoch == trim_epoch_) {
+      return;
+    }
+    trim_epoch_ = trim_epoch;
+    for (FreeList& free_list : free_lists_) {
+      for (uint8_t* block : free_list) {
+        delete[] block;
+      }
+      free_list.clear();
+    }
+  }
+
+  std::array<FreeList, SizeClasses.size()> free_lists_;
+  uint64_t trim_epoch_;
+};
+
+thread_local ThreadFreeLists thread_free_lists;
+// Set once the free lists of the thread are destroyed on thread exit, after which the slices still
+// released by the thread go to the shared free list.
+thread_local bool thread_free_lists_destroyed = false;
+
+ThreadFreeLists::~ThreadFreeLists() {
+  thread_free_lists_destroyed = true;
+  for (size_t i = 0; i < SizeClasses.size(); ++i) {
+    sharedFreeLists().put(i, free_lists_[i].data(), free_lists_[i].size());
+  }
+}
+
+} // namespace
+
+uint8_t* SliceAllocator::allocate(size_t size) {
+  const int index = sizeClassIndex(size);
+  if (index >= 0 && !thread_free_lists_destroyed) {
+    if (uint8_t* block = thread_free_lists.allocate(index); block != nullptr) {
+      return block;
+    }
+  }
+  return new uint8_t[size];
+}
+
+void SliceAllocator::release(uint8_t* mem, size_t size) {
+  if (mem == nullptr) {
+    return;
+  }
+  const int index = sizeClassIndex(size);
+  if (index < 0) {
+    delete[] mem;
+  } else if (thread_free_lists_destroyed) {
+    sharedFreeLists().put(index, &mem, 1);
+  } else {
+    thread_free_lists.release(index, mem);
+  }
+}
+
+void SliceAllocator::trim() { sharedFreeLists().trim(); }
+
+size_t SliceAllocator::threadCachedForTest(size_t size) {
+  const int index = sizeClassIndex(size);
+  if (index < 0 || thread_free_lists_destroyed) {
+    return 0;
+  }
+  thread_free_lists.maybeTrim();
+  return thread_free_lists.free_lists_[index].size();
+}
+
+size_t SliceAllocator::sharedCachedForTest(size_t size) {
+  const int index = sizeClassIndex(size);
+  return index < 0 ? 0 : sharedFreeLists().size(index);
+}
+
+} // namespace Buffer
+} // namespace Envoy
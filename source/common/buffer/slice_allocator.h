@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Allocator of the backing storage of buffer slices.
+ *
+ * Storage of the common slice sizes (4KiB, 16KiB and 64KiB) is cached in per-thread free lists, so
+ * that the read and write cycles of connections reuse the storage they just released rather than
+ * going through the heap. A thread whose free list overflows moves a batch of its storage to a
+ * shared free list, and a thread whose free list runs empty takes a batch from it, so that storage
+ * released on another thread than the one which allocated it flows back to the threads which need
+ * it. Storage of other sizes is allocated from and released to the heap.
+ */
+class SliceAllocator {
+public:
+  /**
+   * @param size supplies the size of the storage, a multiple of 4KiB.
+   * @return the storage.
+   */
+  static uint8_t* allocate(size_t size);
+
+  /**
+   * @param mem supplies storage returned by allocate(), or nullptr.
+   * @param size supplies the size the storage was allocated with.
+   */
+  static void release(uint8_t* mem, size_t size);
+
+  /**
+   * Release the storage cached by the allocator to the heap. The shared free list is released
+   * right away, and the free list of every thread on its next use. Called under memory pressure.
+   */
+  static void trim();
+
+  /**
+   * @return the number of blocks of the given size cached by the free list of the calling thread.
+   */
+  static size_t threadCachedForTest(size_t size);
+
+  /**
+   * @return the number of blocks of the given size cached by the shared free list.
+   */
+  static size_t sharedCachedForTest(size_t size);
+};
+
+/**
+ * Deleter of slice storage allocated by the SliceAllocator.
+ */
+struct SliceStorageDeleter {
+  void operator()(uint8_t* mem) const { SliceAllocator::release(mem, size_); }
+
+  size_t size_{};
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -28,6 +29,8 @@
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stream_info/utility.h"
 
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_replace.h"
 #include "absl/strings/str_split.h"
@@ -58,6 +61,224 @@ const std::regex& getSystemTimeFormatNewlinePattern() {
 }
 const std::regex& getNewlinePattern() { CONSTRUCT_ON_FIRST_USE(std::regex, "\n"); }
 
+// Decodes the UTF-8 sequence at the start of a non-empty string. Overlong sequences, surrogates
+// and sequences beyond U+10FFFF are invalid, as they are for the JSON library used by
+// Json::sanitize().
+// @return the code point and the length of the sequence, or a length of 0 if it is invalid.
+std::pair<uint32_t, size_t> decodeUtf8(absl::string_view str) {
+  const uint8_t c = static_cast<uint8_t>(str[0]);
+  if (c < 0x80) {
+    return {c, 1};
+  }
+  uint32_t code_point;
+  size_t length;
+  uint32_t min_code_point;
+  if ((c & 0xe0) == 0xc0) {
+    code_point = c & 0x1f;
+    length = 2;
+    min_code_point = 0x80;
+  } else if ((c & 0xf0) == 0xe0) {
+    code_point = c & 0x0f;
+    length = 3;
+    min_code_point = 0x800;
+  } else if ((c & 0xf8) == 0xf0) {
+    code_point = c & 0x07;
+    length = 4;
+    min_code_point = 0x10000;
+  } else {
+    return {0, 0};
+  }
+  if (str.size() < length) {
+    return {0, 0};
+  }
+  for (size_t i = 1; i < length; ++i) {
+    const uint8_t next = static_cast<uint8_t>(str[i]);
+    if ((next & 0xc0) != 0x80) {
+      return {0, 0};
+    }
+    code_point = (code_point << 6) | (next & 0x3f);
+  }
+  if (code_point < min_code_point || (code_point >= 0xd800 && code_point <= 0xdfff) ||
+      code_point > 0x10ffff) {
+    return {0, 0};
+  }
+  return {code_point, length};
+}
+
+// The code points escaped by the protobuf JSON serializer, besides the ones with a short escape:
+// control characters, '<' and '>' for HTML, and invisible or formatting characters.
+bool needsUnicodeEscape(uint32_t code_point) {
+  return code_point < 0x20 || code_point == '<' || code_point == '>' ||
+         (code_point >= 0x7f && code_point <= 0x9f) || code_point == 0xad ||
+         (code_point >= 0x600 && code_point <= 0x603) || code_point == 0x6dd ||
+         code_point == 0x70f || code_point == 0x17b4 || code_point == 0x17b5 ||
+         (code_point >= 0x200b && code_point <= 0x200f) ||
+         (code_point >= 0x2028 && code_point <= 0x202e) ||
+         (code_point >= 0x2060 && code_point <= 0x2064) ||
+         (code_point >= 0x206a && code_point <= 0x206f) || code_point == 0xfeff ||
+         (code_point >= 0xfff9 && code_point <= 0xfffb) ||
+         (code_point >= 0x1d173 && code_point <= 0x1d17a) || code_point == 0xe0001 ||
+         (code_point >= 0xe0020 && code_point <= 0xe007f);
+}
+
+void appendUnicodeEscape(uint32_t code_point, std::string& output) {
+  if (code_point < 0x10000) {
+    absl::StrAppendFormat(&output, "\\u%04x", code_point);
+    return;
+  }
+  // Code points beyond the basic multilingual plane are escaped as a UTF-16 surrogate pair.
+  code_point -= 0x10000;
+  absl::StrAppendFormat(&output, "\\u%04x\\u%04x", 0xd800 + (code_point >> 10),
+                        0xdc00 + (code_point & 0x3ff));
+}
+
+// Escapes a string which isn't valid UTF-8 the way Json::sanitize() does: every control
+// character, double quote, backslash and byte from 0x7f up is written as an octal escape.
+void appendOctalEscapedJsonString(absl::string_view str, std::string& output) {
+  output.push_back('"');
+  for (const char c : str) {
+    const uint8_t byte = static_cast<uint8_t>(c);
+    if (byte < 0x20 || byte >= 0x7f || c == '"' || c == '\\') {
+      absl::StrAppendFormat(&output, "\\%03o", byte);
+    } else {
+      output.push_back(c);
+    }
+  }
+  output.push_back('"');
+}
+
+// The JSON writers below produce the same output as the protobuf JSON serializer does for a
+// ProtobufWkt::Struct, except that object members are always sorted by key, and that strings which
+// aren't valid UTF-8 are escaped as Json::sanitize() does rather than losing their invalid bytes.
+// They don't throw, unlike Json::sanitize(), so that they can be used on workers.
+void appendJsonString(absl::string_view str, std::string& output) {
+  const size_t output_start = output.size();
+  output.push_back('"');
+  size_t unescaped_start = 0;
+  size_t i = 0;
+  while (i < str.size()) {
+    const char c = str[i];
+    absl::string_view escape;
+    switch (c) {
+    case '"':
+      escape = "\\\"";
+      break;
+    case '\\':
+      escape = "\\\\";
+      break;
+    case '\b':
+      escape = "\\b";
+      break;
+    case '\f':
+      escape = "\\f";
+      break;
+    case '\n':
+      escape = "\\n";
+      break;
+    case '\r':
+      escape = "\\r";
+      break;
+    case '\t':
+      escape = "\\t";
+      break;
+    default:
+      if (c >= 0x20 && c < 0x7f && c != '<' && c != '>') {
+        ++i;
+        continue;
+      }
+      break;
+    }
+
+    if (!escape.empty()) {
+      output.append(str.data() + unescaped_start, i - unescaped_start);
+      output.append(escape.data(), escape.size());
+      unescaped_start = ++i;
+      continue;
+    }
+
+    const auto [code_point, length] = decodeUtf8(str.substr(i));
+    if (length == 0) {
+      output.resize(output_start);
+      appendOctalEscapedJsonString(str, output);
+      return;
+    }
+    if (needsUnicodeEscape(code_point)) {
+      output.append(str.data() + unescaped_start, i - unescaped_start);
+      appendUnicodeEscape(code_point, output);
+      unescaped_start = i + length;
+    }
+    i += length;
+  }
+  output.append(str.data() + unescaped_start, str.size() - unescaped_start);
+  output.push_back('"');
+}
+
+void appendJsonNumber(double number, std::string& output) {
+  if (std::isnan(number)) {
+    output.append("\"NaN\"");
+    return;
+  }
+  if (std::isinf(number)) {
+    output.append(number > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+    return;
+  }
+  // Use the shortest of 15 or 17 significant digits which reads back as the same number.
+  char buffer[32];
+  int length = absl::SNPrintF(buffer, sizeof(buffer), "%.15g", number);
+  double parsed;
+  if (!absl::SimpleAtod(absl::string_view(buffer, length), &parsed) || parsed != number) {
+    length = absl::SNPrintF(buffer, sizeof(buffer), "%.17g", number);
+  }
+  output.append(buffer, length);
+}
+
+void appendJsonValue(const ProtobufWkt::Value& value, std::string& output) {
+  switch (value.kind_case()) {
+  case ProtobufWkt::Value::kNumberValue:
+    appendJsonNumber(value.number_value(), output);
+    break;
+  case ProtobufWkt::Value::kStringValue:
+    appendJsonString(value.string_value(), output);
+    break;
+  case ProtobufWkt::Value::kBoolValue:
+    output.append(value.bool_value() ? "true" : "false");
+    break;
+  case ProtobufWkt::Value::kStructValue: {
+    std::vector<const Protobuf::Map<std::string, ProtobufWkt::Value>::value_type*> fields;
+    fields.reserve(value.struct_value().fields().size());
+    for (const auto& field : value.struct_value().fields()) {
+      fields.push_back(&field);
+    }
+    std::sort(fields.begin(), fields.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+    output.push_back('{');
+    for (const auto* field : fields) {
+      if (output.back() != '{') {
+        output.push_back(',');
+      }
+      appendJsonString(field->first, output);
+      output.push_back(':');
+      appendJsonValue(field->second, output);
+    }
+    output.push_back('}');
+    break;
+  }
+  case ProtobufWkt::Value::kListValue:
+    output.push_back('[');
+    for (const ProtobufWkt::Value& element : value.list_value().values()) {
+      if (output.back() != '[') {
+        output.push_back(',');
+      }
+      appendJsonValue(element, output);
+    }
+    output.push_back(']');
+    break;
+  default:
+    output.append("null");
+    break;
+  }
+}
+
 } // namespace
 
 const std::string SubstitutionFormatUtils::DEFAULT_FORMAT =
@@ -137,7 +358,8 @@ std::string FormatterImpl::format(const Http::RequestHeaderMap& request_headers,
   for (const FormatterProviderPtr& provider : providers_) {
     const auto bit = provider->format(request_headers, response_headers, response_trailers,
                                       stream_info, local_reply_body, access_log_type);
-    log_line += bit.value_or(empty_value_string_);
+    // Don't use value_or(), which would copy the formatted value.
+    log_line += bit.has_value() ? *bit : empty_value_string_;
   }
 
   return log_line;
@@ -149,18 +371,12 @@ std::string JsonFormatterImpl::format(const Http::RequestHeaderMap& request_head
                                       const StreamInfo::StreamInfo& stream_info,
                                       absl::string_view local_reply_body,
                                       AccessLog::AccessLogType access_log_type) const {
-  const ProtobufWkt::Struct output_struct =
-      struct_formatter_.format(request_headers, response_headers, response_trailers, stream_info,
-                               local_reply_body, access_log_type);
-
-#ifdef ENVOY_ENABLE_YAML
-  const std::string log_line =
-      MessageUtil::getJsonStringFromMessageOrError(output_struct, false, true);
-#else
-  IS_ENVOY_BUG("Json support compiled out");
-  const std::string log_line = "";
-#endif
-  return absl::StrCat(log_line, "\n");
+  std::string log_line;
+  log_line.reserve(512);
+  struct_formatter_.formatJson(request_headers, response_headers, response_trailers, stream_info,
+                               local_reply_body, access_log_type, log_line);
+  log_line.push_back('\n');
+  return log_line;
 }
 
 StructFormatter::StructFormatter(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
@@ -275,7 +491,7 @@ ProtobufWkt::Value StructFormatter::providersCallback(
   for (const auto& provider : providers) {
     const auto bit = provider->format(request_headers, response_headers, response_trailers,
                                       stream_info, local_reply_body, access_log_type);
-    str += bit.value_or(empty_value_);
+    str += bit.has_value() ? *bit : empty_value_;
   }
   return ValueUtil::stringValue(str);
 }
@@ -333,6 +549,121 @@ ProtobufWkt::Struct StructFormatter::format(const Http::RequestHeaderMap& reques
   return structFormatMapCallback(struct_output_format_, visitor).struct_value();
 }
 
+bool StructFormatter::providersJson(const std::vector<FormatterProviderPtr>& providers,
+                                    const FormatContext& context, std::string& output) const {
+  ASSERT(!providers.empty());
+  if (providers.size() == 1) {
+    const auto& provider = providers.front();
+    if (preserve_types_) {
+      const ProtobufWkt::Value value = provider->formatValue(
+          context.request_headers_, context.response_headers_, context.response_trailers_,
+          context.stream_info_, context.local_reply_body_, context.access_log_type_);
+      appendJsonValue(value, output);
+      return value.kind_case() == ProtobufWkt::Value::kNullValue;
+    }
+
+    const auto str = provider->format(context.request_headers_, context.response_headers_,
+                                      context.response_trailers_, context.stream_info_,
+                                      context.local_reply_body_, context.access_log_type_);
+    if (!str.has_value() && omit_empty_values_) {
+      output.append("null");
+      return true;
+    }
+    appendJsonString(str.has_value() ? *str : DefaultUnspecifiedValueString, output);
+    return false;
+  }
+  // Multiple providers forces string output.
+  std::string str;
+  for (const auto& provider : providers) {
+    const auto bit = provider->format(context.request_headers_, context.response_headers_,
+                                      context.response_trailers_, context.stream_info_,
+                                      context.local_reply_body_, context.access_log_type_);
+    str += bit.has_value() ? *bit : empty_value_;
+  }
+  appendJsonString(str, output);
+  return false;
+}
+
+bool StructFormatter::structFormatMapJson(const StructFormatter::StructFormatMapWrapper& format_map,
+                                          const FormatContext& context,
+                                          std::string& output) const {
+  const size_t start = output.size();
+  bool empty = true;
+  output.push_back('{');
+  for (const auto& pair : *format_map.value_) {
+    // Null values are omitted by truncating the output back to where the member started.
+    const size_t member_start = output.size();
+    if (!empty) {
+      output.push_back(',');
+    }
+    appendJsonString(pair.first, output);
+    output.push_back(':');
+    if (structFormatValueJson(pair.second, context, output) && omit_empty_values_) {
+      output.resize(member_start);
+      continue;
+    }
+    empty = false;
+  }
+  if (omit_empty_values_ && empty) {
+    output.resize(start);
+    output.append("null");
+    return true;
+  }
+  output.push_back('}');
+  return false;
+}
+
+bool StructFormatter::structFormatListJson(
+    const StructFormatter::StructFormatListWrapper& format_list, const FormatContext& context,
+    std::string& output) const {
+  bool empty = true;
+  output.push_back('[');
+  for (const auto& val : *format_list.value_) {
+    const size_t element_start = output.size();
+    if (!empty) {
+      output.push_back(',');
+    }
+    if (structFormatValueJson(val, context, output) && omit_empty_values_) {
+      output.resize(element_start);
+      continue;
+    }
+    empty = false;
+  }
+  output.push_back(']');
+  return false;
+}
+
+bool StructFormatter::structFormatValueJson(const StructFormatValue& value,
+                                            const FormatContext& context,
+                                            std::string& output) const {
+  if (const auto* providers = absl::get_if<const std::vector<FormatterProviderPtr>>(&value);
+      providers != nullptr) {
+    return providersJson(*providers, context, output);
+  }
+  if (const auto* format_map = absl::get_if<const StructFormatMapWrapper>(&value);
+      format_map != nullptr) {
+    return structFormatMapJson(*format_map, context, output);
+  }
+  return structFormatListJson(absl::get<const StructFormatListWrapper>(value), context, output);
+}
+
+void StructFormatter::formatJson(const Http::RequestHeaderMap& request_headers,
+                                 const Http::ResponseHeaderMap& response_headers,
+                                 const Http::ResponseTrailerMap& response_trailers,
+                                 const StreamInfo::StreamInfo& stream_info,
+                                 absl::string_view local_reply_body,
+                                 AccessLog::AccessLogType access_log_type,
+                                 std::string& output) const {
+  const FormatContext context{request_headers, response_headers, response_trailers,
+                              stream_info,     local_reply_body, access_log_type};
+  const size_t start = output.size();
+  if (structFormatMapJson(struct_output_format_, context, output)) {
+    // Like format(), output an empty object when every value was omitted.
+    output.resize(start);
+    output.append("{}");
+  }
+}
+
 void SubstitutionFormatParser::parseSubcommandHeaders(const std::string& subcommand,
                                                       std::string& main_header,
                                                       std::string& alternative_header) {
@@ -178,6 +178,16 @@ public:
                              absl::string_view local_reply_body,
                              AccessLog::AccessLogType access_log_type) const;
 
+  /**
+   * Appends the JSON serialization of the Struct that format() would return to output. The JSON
+   * is written directly, without building the Struct and serializing it through protobuf.
+   */
+  void formatJson(const Http::RequestHeaderMap& request_headers,
+                  const Http::ResponseHeaderMap& response_headers,
+                  const Http::ResponseTrailerMap& response_trailers,
+                  const StreamInfo::StreamInfo& stream_info, absl::string_view local_reply_body,
+                  AccessLog::AccessLogType access_log_type, std::string& output) const;
+
 private:
   struct StructFormatMapWrapper;
   struct StructFormatListWrapper;
@@ -234,6 +244,26 @@ private:
   structFormatListCallback(const StructFormatter::StructFormatListWrapper& format_list,
                            const StructFormatMapVisitor& visitor) const;
 
+  // Methods for writing JSON directly. The arguments of formatJson() are passed along as a
+  // FormatContext. Each method appends the JSON serialization of the value to output, and
+  // returns true if the value was null.
+  struct FormatContext {
+    const Http::RequestHeaderMap& request_headers_;
+    const Http::ResponseHeaderMap& response_headers_;
+    const Http::ResponseTrailerMap& response_trailers_;
+    const StreamInfo::StreamInfo& stream_info_;
+    const absl::string_view local_reply_body_;
+    const AccessLog::AccessLogType access_log_type_;
+  };
+  bool providersJson(const std::vector<FormatterProviderPtr>& providers,
+                     const FormatContext& context, std::string& output) const;
+  bool structFormatMapJson(const StructFormatter::StructFormatMapWrapper& format_map,
+                           const FormatContext& context, std::string& output) const;
+  bool structFormatListJson(const StructFormatter::StructFormatListWrapper& format_list,
+                            const FormatContext& context, std::string& output) const;
+  bool structFormatValueJson(const StructFormatValue& value, const FormatContext& context,
+                             std::string& output) const;
+
   const bool omit_empty_values_;
   const bool preserve_types_;
   const std::string empty_value_;
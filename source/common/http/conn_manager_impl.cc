@@ -485,6 +485,13 @@ Network::FilterStatus ConnectionManagerImpl::onNewConnection() {
   return Network::FilterStatus::StopIteration;
 }
 
+bool ConnectionManagerImpl::canMigrate() {
+  // HTTP/1 connections carry no state between requests, unlike HTTP/2 and HTTP/3 connections whose
+  // header compression and stream state is shared with the peer.
+  return streams_.empty() && drain_state_ == DrainState::NotDraining &&
+         (codec_ == nullptr || (codec_->protocol() < Protocol::Http2 && !codec_->wantsToWrite()));
+}
+
 void ConnectionManagerImpl::resetAllStreams(absl::optional<StreamInfo::ResponseFlag> response_flag,
                                             absl::string_view details) {
   while (!streams_.empty()) {
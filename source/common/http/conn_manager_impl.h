@@ -92,6 +92,7 @@ public:
   Network::FilterStatus onData(Buffer::Instance& data, bool end_stream) override;
   Network::FilterStatus onNewConnection() override;
   void initializeReadFilterCallbacks(Network::ReadFilterCallbacks& callbacks) override;
+  bool canMigrate() override;
 
   // Http::ConnectionCallbacks
   void onGoAway(GoAwayErrorCode error_code) override;
@@ -0,0 +1,73 @@
+#include "source/common/memory/arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include "source/common/common/assert.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+constexpr size_t PageSize = 4096;
+
+std::atomic<uint64_t> total_reserved{0};
+std::atomic<uint64_t> total_allocated{0};
+
+size_t roundUp(size_t size, size_t alignment) { return (size + alignment - 1) & ~(alignment - 1); }
+
+} // namespace
+
+Arena::~Arena() {
+  for (const Chunk& chunk : chunks_) {
+    ::operator delete(chunk.mem_, std::align_val_t(chunk.alignment_));
+  }
+  total_reserved -= reserved_;
+  total_allocated -= allocated_;
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+  ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  uintptr_t mem = roundUp(reinterpret_cast<uintptr_t>(next_), alignment);
+  if (next_ == nullptr || mem + size > reinterpret_cast<uintptr_t>(end_)) {
+    // Chunks are page aligned, so only larger alignments need slack.
+    newChunk(alignment <= PageSize ? size : size + alignment);
+    mem = roundUp(reinterpret_cast<uintptr_t>(next_), alignment);
+  }
+  next_ = reinterpret_cast<uint8_t*>(mem + size);
+  allocated_ += size;
+  total_allocated += size;
+  return reinterpret_cast<void*>(mem);
+}
+
+void Arena::newChunk(size_t min_size) {
+  // Grow the chunks geometrically, so that small arenas don't reserve huge pages.
+  size_t size = chunks_.empty() ? MinChunkSize : std::min(chunks_.back().size_ * 2, HugePageSize);
+  const size_t alignment = size == HugePageSize ? HugePageSize : PageSize;
+  size = std::max(size, roundUp(min_size, alignment));
+
+  uint8_t* mem = static_cast<uint8_t*>(::operator new(size, std::align_val_t(alignment)));
+#ifdef __linux__
+  if (alignment == HugePageSize) {
+    // Best effort, as transparent huge pages may be disabled on the host.
+    madvise(mem, size, MADV_HUGEPAGE);
+  }
+#endif
+  chunks_.push_back({mem, size, alignment});
+  next_ = mem;
+  end_ = mem + size;
+  reserved_ += size;
+  total_reserved += size;
+}
+
+uint64_t Arena::totalReserved() { return total_reserved.load(); }
+
+uint64_t Arena::totalAllocated() { return total_allocated.load(); }
+
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Memory {
+
+/**
+ * Bump allocator for long-lived objects which are built together and released together, such as
+ * the route entries of a route configuration. Packing them into a few large chunks rather than
+ * scattering them across the heap keeps the working set of lookups walking them small. Only the
+ * objects themselves come from the arena: memory they allocate internally still comes from the
+ * heap. Chunks grow geometrically up to the huge page size, from which point they are aligned to
+ * it and, on Linux, advised to be backed by transparent huge pages.
+ *
+ * Memory is only released when the arena is destroyed. The arena is not thread safe: objects must
+ * be allocated from a single thread at a time, typically the main thread building a configuration.
+ */
+class Arena : NonCopyable {
+public:
+  static constexpr size_t MinChunkSize = 64 * 1024;
+  static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+  ~Arena();
+
+  /**
+   * @param size supplies the number of bytes to allocate.
+   * @param alignment supplies the alignment of the allocation, a power of two.
+   * @return memory which remains valid until the arena is destroyed.
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * @return the number of bytes reserved by the chunks of this arena.
+   */
+  uint64_t reserved() const { return reserved_; }
+
+  /**
+   * @return the number of bytes allocated from this arena.
+   */
+  uint64_t allocated() const { return allocated_; }
+
+  /**
+   * @return the number of bytes reserved by the chunks of all live arenas.
+   */
+  static uint64_t totalReserved();
+
+  /**
+   * @return the number of bytes allocated from all live arenas.
+   */
+  static uint64_t totalAllocated();
+
+private:
+  struct Chunk {
+    uint8_t* mem_;
+    size_t size_;
+    size_t alignment_;
+  };
+
+  void newChunk(size_t min_size);
+
+  std::vector<Chunk> chunks_;
+  uint8_t* next_{};
+  uint8_t* end_{};
+  uint64_t reserved_{};
+  uint64_t allocated_{};
+};
+
+using ArenaSharedPtr = std::shared_ptr<Arena>;
+
+/**
+ * Standard allocator allocating from an Arena. Copies of the allocator share the ownership of the
+ * arena, so that containers and std::allocate_shared() control blocks using it keep the arena alive
+ * for as long as they hold memory from it.
+ */
+template <class T> class ArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(ArenaSharedPtr arena) : arena_(std::move(arena)) {}
+  template <class U> ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  T* allocate(size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+  void deallocate(T*, size_t) {}
+
+  const ArenaSharedPtr& arena() const { return arena_; }
+
+  template <class U> bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <class U> bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  ArenaSharedPtr arena_;
+};
+
+/**
+ * Create a shared object in an arena, or on the heap if there is no arena.
+ * @param arena supplies the arena to allocate the object from, or nullptr.
+ * @param args supplies the arguments of the constructor of the object.
+ * @return the object, which keeps the arena alive until it is destroyed.
+ */
+template <class T, class... Args>
+std::shared_ptr<T> makeSharedInArena(const ArenaSharedPtr& arena, Args&&... args) {
+  if (arena == nullptr) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+}
+
+} // namespace Memory
+} // namespace Envoy
@@ -519,6 +519,11 @@ void ConnectionImpl::setBufferLimits(uint32_t limit) {
   }
 }
 
+void ConnectionImpl::bindBufferMemoryAccount(Buffer::BufferMemoryAccountSharedPtr account) {
+  read_buffer_->bindAccount(account);
+  write_buffer_->bindAccount(std::move(account));
+}
+
 void ConnectionImpl::onReadBufferLowWatermark() {
   ENVOY_CONN_LOG(debug, "onBelowReadBufferLowWatermark", *this);
   if (state() == State::Open) {
@@ -798,6 +803,20 @@ absl::optional<uint64_t> ConnectionImpl::congestionWindowInBytes() const {
   return socket_->congestionWindowInBytes();
 }
 
+IoHandlePtr ConnectionImpl::migrateSocket() {
+  if (state() != State::Open || connecting_ || read_end_stream_ || read_buffer_->length() > 0 ||
+      write_buffer_->length() > 0 || !transport_socket_->canMigrate() ||
+      !filter_manager_.canMigrate()) {
+    return nullptr;
+  }
+  ENVOY_CONN_LOG(debug, "migrating socket", *this);
+  IoHandlePtr io_handle = ioHandle().duplicate();
+  // Closing the socket doesn't shut it down, so the peer doesn't notice that the connection was
+  // closed here as long as the duplicate is open.
+  close(ConnectionCloseType::NoFlush, "migrated");
+  return io_handle;
+}
+
 void ConnectionImpl::flushWriteBuffer() {
   if (state() == State::Open && write_buffer_->length() > 0) {
     onWriteReady();
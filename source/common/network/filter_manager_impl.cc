@@ -115,6 +115,20 @@ bool FilterManagerImpl::startUpstreamSecureTransport() {
   return false;
 }
 
+bool FilterManagerImpl::canMigrate() {
+  // Write filters see the connection through its writes only, so they can't tell whether it is
+  // idle.
+  if (upstream_filters_.empty() || !downstream_filters_.empty()) {
+    return false;
+  }
+  for (auto& filter : upstream_filters_) {
+    if (filter->filter_ != nullptr && !filter->filter_->canMigrate()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 FilterStatus FilterManagerImpl::onWrite() { return onWrite(nullptr, connection_); }
 
 FilterStatus FilterManagerImpl::onWrite(ActiveWriteFilter* filter,
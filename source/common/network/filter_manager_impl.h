@@ -112,6 +112,7 @@ public:
   void onRead();
   FilterStatus onWrite();
   bool startUpstreamSecureTransport();
+  bool canMigrate();
 
 private:
   struct ActiveReadFilter : public ReadFilterCallbacks, LinkedObject<ActiveReadFilter> {
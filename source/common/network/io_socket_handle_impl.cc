@@ -3,6 +3,7 @@
 #include "envoy/buffer/buffer.h"
 
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/event/file_event_impl.h"
 #include "source/common/network/address_impl.h"
@@ -113,6 +114,15 @@ Api::IoCallUint64Result IoSocketHandleImpl::read(Buffer::Instance& buffer,
   if (max_length == 0) {
     return Api::ioCallUint64ResultNoError();
   }
+  if (max_length < Buffer::Slice::default_slice_size_) {
+    // Read small amounts of data into a slice of their size rather than into a default sized one,
+    // which would be kept around for as long as the data is buffered.
+    Buffer::ReservationSingleSlice reservation = buffer.reserveSingleSlice(max_length);
+    Buffer::RawSlice slice = reservation.slice();
+    Api::IoCallUint64Result result = readv(max_length, &slice, 1);
+    reservation.commit(result.ok() ? result.return_value_ : 0);
+    return result;
+  }
   Buffer::Reservation reservation = buffer.reserveForRead();
   Api::IoCallUint64Result result = readv(std::min(reservation.length(), max_length),
                                          reservation.slices(), reservation.numSlices());
@@ -238,6 +248,36 @@ Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slic
   }
 }
 
+Api::IoCallUint64Result
+IoSocketHandleImpl::sendmmsg(absl::Span<const absl::Span<const Buffer::RawSlice>> messages,
+                             int flags) {
+  uint64_t num_slices = 0;
+  for (const auto& message : messages) {
+    num_slices += message.size();
+  }
+  absl::FixedArray<iovec> iov(num_slices);
+  absl::FixedArray<mmsghdr> mmsg_hdr(messages.size());
+  uint64_t num_slices_to_write = 0;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    memset(&mmsg_hdr[i], 0, sizeof(mmsghdr));
+    msghdr& message = mmsg_hdr[i].msg_hdr;
+    // The socket is connected, so neither a destination address nor a source address is passed.
+    message.msg_iov = iov.begin() + num_slices_to_write;
+    for (const Buffer::RawSlice& slice : messages[i]) {
+      if (slice.mem_ != nullptr && slice.len_ != 0) {
+        iov[num_slices_to_write].iov_base = slice.mem_;
+        iov[num_slices_to_write].iov_len = slice.len_;
+        num_slices_to_write++;
+        message.msg_iovlen++;
+      }
+    }
+  }
+
+  const Api::SysCallIntResult result =
+      Api::OsSysCallsSingleton::get().sendmmsg(fd_, mmsg_hdr.begin(), messages.size(), flags);
+  return sysCallResultToIoCallResult(result);
+}
+
 Address::InstanceConstSharedPtr
 maybeGetDstAddressFromHeader(const cmsghdr& cmsg, uint32_t self_port, os_fd_t fd, bool v6only) {
   if (cmsg.cmsg_type == IPV6_PKTINFO) {
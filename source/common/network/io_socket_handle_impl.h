@@ -48,6 +48,9 @@ public:
                                   const Address::Ip* self_ip,
                                   const Address::Instance& peer_address) override;
 
+  Api::IoCallUint64Result sendmmsg(absl::Span<const absl::Span<const Buffer::RawSlice>> messages,
+                                   int flags) override;
+
   Api::IoCallUint64Result recvmsg(Buffer::RawSlice* slices, const uint64_t num_slice,
                                   uint32_t self_port, RecvMsgOutput& output) override;
 
@@ -94,10 +94,13 @@ public:
   void setConnectionStats(const ConnectionStats& stats) override;
   void setDelayedCloseTimeout(std::chrono::milliseconds timeout) override;
   void setBufferLimits(uint32_t limit) override;
+  // Only used on downstream connections.
+  void bindBufferMemoryAccount(Buffer::BufferMemoryAccountSharedPtr) override {}
   bool startSecureTransport() override;
   absl::optional<std::chrono::milliseconds> lastRoundTripTime() const override;
   void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
   absl::optional<uint64_t> congestionWindowInBytes() const override;
+  IoHandlePtr migrateSocket() override { return nullptr; }
 
   // Simple getters which always delegate to the first connection in connections_.
   bool isHalfCloseEnabled() const override;
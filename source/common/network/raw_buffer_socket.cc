@@ -1,13 +1,35 @@
 #include "source/common/network/raw_buffer_socket.h"
 
+#include <algorithm>
+
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Network {
 
+namespace {
+
+// Bounds of the amount of data read at once. Reads shrink down to a page while the peer sends
+// little data, so that the data buffered by mostly idle connections is held in small slices, and
+// grow up to the size of a read reservation while the peer sends more data than fits in a read.
+constexpr uint64_t MinReadSize = 4096;
+constexpr uint64_t InitialReadSize = Buffer::Slice::default_slice_size_;
+constexpr uint64_t MaxReadSize = Buffer::Reservation::MAX_SLICES_ * InitialReadSize;
+
+} // namespace
+
+RawBufferSocket::RawBufferSocket() {
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.raw_buffer_socket_adapt_read_size")) {
+    read_size_ = InitialReadSize;
+  }
+}
+
 void RawBufferSocket::setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) {
   ASSERT(!callbacks_);
   callbacks_ = &callbacks;
@@ -18,7 +40,7 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
   uint64_t bytes_read = 0;
   bool end_stream = false;
   do {
-    Api::IoCallUint64Result result = callbacks_->ioHandle().read(buffer, absl::nullopt);
+    Api::IoCallUint64Result result = callbacks_->ioHandle().read(buffer, read_size_);
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "read returns: {}", callbacks_->connection(), result.return_value_);
@@ -28,6 +50,7 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
         break;
       }
       bytes_read += result.return_value_;
+      updateReadSize(result.return_value_);
       if (callbacks_->shouldDrainReadBuffer()) {
         callbacks_->setTransportSocketIsReadable();
         break;
@@ -46,6 +69,17 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
   return {action, bytes_read, end_stream};
 }
 
+void RawBufferSocket::updateReadSize(uint64_t bytes_read) {
+  if (!read_size_.has_value()) {
+    return;
+  }
+  if (bytes_read >= *read_size_) {
+    read_size_ = std::min(*read_size_ * 2, MaxReadSize);
+  } else if (bytes_read <= *read_size_ / 4) {
+    read_size_ = std::max(*read_size_ / 2, MinReadSize);
+  }
+}
+
 IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   PostIoAction action;
   uint64_t bytes_written = 0;
@@ -7,16 +7,21 @@
 #include "source/common/common/logger.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Network {
 
 class RawBufferSocket : public TransportSocket, protected Logger::Loggable<Logger::Id::connection> {
 public:
+  RawBufferSocket();
+
   // Network::TransportSocket
   void setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) override;
   std::string protocol() const override;
   absl::string_view failureReason() const override;
   bool canFlushClose() override { return true; }
+  bool canMigrate() const override { return !shutdown_; }
   void closeSocket(Network::ConnectionEvent) override {}
   void onConnected() override;
   IoResult doRead(Buffer::Instance& buffer) override;
@@ -29,8 +34,13 @@ protected:
   TransportSocketCallbacks* transportSocketCallbacks() const { return callbacks_; };
 
 private:
+  // Adapts the amount of data read at once to the amount the peer sends.
+  void updateReadSize(uint64_t bytes_read);
+
   bool shutdown_{};
   TransportSocketCallbacks* callbacks_{};
+  // The amount of data read at once, or nullopt to read as much as a read reservation holds.
+  absl::optional<uint64_t> read_size_;
 };
 
 class RawBufferSocketFactory : public DownstreamTransportSocketFactory,
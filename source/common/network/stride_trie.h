@@ -0,0 +1,388 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/network/address.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_set.h"
+#include "absl/hash/hash.h"
+#include "absl/numeric/bits.h"
+#include "absl/numeric/int128.h"
+
+namespace Envoy {
+namespace Network {
+namespace StrideTrie {
+
+/**
+ * Multibit stride trie for associating data with CIDR ranges. It has the same interface and
+ * returns the same data as LcTrie::LcTrie, but targets large sets of CIDR ranges, such as full
+ * BGP tables used for geo or ASN tagging: lookups take a fixed, small number of steps, and the
+ * number of CIDR ranges isn't limited by the encoding of the nodes.
+ *
+ * Each IP version is held in a poptrie, as described in the paper 'Poptrie: A Compressed Trie
+ * with Population Count for Fast and Scalable Software IP Routing Table Lookup' by 'H. Asai' and
+ * 'Y. Ohara'. Refer to Poptrie for implementation details.
+ */
+template <class T> class StrideTrie {
+public:
+  /**
+   * @param data supplies a vector of data and CIDR ranges.
+   * @param exclusive if true then only data for the most specific subnet will be returned
+   *                  (i.e. data isn't inherited from wider ranges).
+   */
+  StrideTrie(const std::vector<std::pair<T, std::vector<Address::CidrRange>>>& data,
+             bool exclusive = false) {
+    std::vector<Prefix<Ipv4>> ipv4_prefixes;
+    std::vector<Prefix<Ipv6>> ipv6_prefixes;
+    for (const auto& pair_data : data) {
+      for (const auto& cidr_range : pair_data.second) {
+        if (cidr_range.ip()->version() == Address::IpVersion::v4) {
+          ipv4_prefixes.push_back({ntohl(cidr_range.ip()->ipv4()->address()),
+                                   static_cast<uint32_t>(cidr_range.length()),
+                                   {pair_data.first}});
+        } else {
+          ipv6_prefixes.push_back({Utility::Ip6ntohl(cidr_range.ip()->ipv6()->address()),
+                                   static_cast<uint32_t>(cidr_range.length()),
+                                   {pair_data.first}});
+        }
+      }
+    }
+    ipv4_trie_ = std::make_unique<Poptrie<Ipv4>>(std::move(ipv4_prefixes), exclusive);
+    ipv6_trie_ = std::make_unique<Poptrie<Ipv6>>(std::move(ipv6_prefixes), exclusive);
+  }
+
+  /**
+   * Retrieve data associated with the CIDR range that contains `ip_address`. Both IPv4 and IPv6
+   * addresses are supported.
+   * @param  ip_address supplies the IP address.
+   * @return a vector of data from the CIDR ranges and IP addresses that contains 'ip_address'. An
+   * empty vector is returned if no prefix contains 'ip_address' or there is no data for the IP
+   * version of the ip_address.
+   */
+  std::vector<T> getData(const Network::Address::InstanceConstSharedPtr& ip_address) const {
+    if (ip_address->ip()->version() == Address::IpVersion::v4) {
+      return ipv4_trie_->getData(ntohl(ip_address->ip()->ipv4()->address()));
+    } else {
+      return ipv6_trie_->getData(Utility::Ip6ntohl(ip_address->ip()->ipv6()->address()));
+    }
+  }
+
+private:
+  // IP addresses are stored in host byte order.
+  using Ipv4 = uint32_t;
+  using Ipv6 = absl::uint128;
+
+  using DataSet = absl::node_hash_set<T>;
+
+  /**
+   * A CIDR range and its data.
+   */
+  template <class IpType> struct Prefix {
+    IpType ip_;
+    uint32_t length_;
+    DataSet data_;
+  };
+
+  /**
+   * Poptrie holding the CIDR ranges of an IP version.
+   *
+   * The first bits of an address index a root array, whose size grows with the number of CIDR
+   * ranges. The following bits are looked up 6 at a time in nodes of 64 children. A child is
+   * either a leaf holding the id of the data of the addresses it covers, or an internal node. The
+   * internal node children of a node are stored contiguously, as are its leaves, where
+   * consecutive leaves with the same data are only stored once. A child is found through the
+   * population count of a bitmap of the internal node children of the node, or of a bitmap of the
+   * leaves that differ from the previous one.
+   *
+   * A node takes 24 bytes, so that a lookup touches an entry of the root array and a few cache
+   * lines, at most 3 nodes for an IPv4 address.
+   *
+   * Nested CIDR ranges are expanded into the children they cover, from the widest to the
+   * narrowest, so that each leaf holds the data of the most specific CIDR range containing it, or
+   * the data of all of them if not exclusive.
+   */
+  template <class IpType, uint32_t address_size = CHAR_BIT * sizeof(IpType)> class Poptrie {
+  public:
+    /**
+     * Construct a poptrie for IpType.
+     * @param prefixes supplies the CIDR ranges and their data.
+     * @param exclusive supplies whether a leaf holds the data of the most specific CIDR range
+     *                  containing it only.
+     */
+    Poptrie(std::vector<Prefix<IpType>>&& prefixes, bool exclusive);
+
+    /**
+     * Retrieve the data associated with the CIDR range that contains `ip_address`.
+     * @param  ip_address supplies the IP address in host byte order.
+     * @return a vector of data from the CIDR ranges that contain the IP address.
+     */
+    const std::vector<T>& getData(const IpType& ip_address) const {
+      if (root_.empty()) {
+        return data_[NoData];
+      }
+
+      uint32_t child = root_[bits(0, root_bits_, ip_address)];
+      uint32_t position = root_bits_;
+      while ((child & LeafBit) == 0) {
+        const Node& node = nodes_[child];
+        const uint32_t index = bits(position, NodeBits, ip_address);
+        // Mask of the children up to and including index.
+        const uint64_t mask = (uint64_t(2) << index) - 1;
+        if ((node.internal_ & (uint64_t(1) << index)) == 0) {
+          return data_[leaves_[node.leaves_base_ + absl::popcount(node.leaves_ & mask) - 1]];
+        }
+        child = node.internal_base_ + absl::popcount(node.internal_ & mask) - 1;
+        position += NodeBits;
+      }
+      return data_[child & ~LeafBit];
+    }
+
+  private:
+    /**
+     * A node of 64 children.
+     */
+    struct Node {
+      // Bitmap of the children that are internal nodes.
+      uint64_t internal_;
+      // Bitmap of the leaf children whose data differs from the previous leaf child.
+      uint64_t leaves_;
+      // Index of the first leaf in leaves_.
+      uint32_t leaves_base_;
+      // Index of the first internal node child in nodes_.
+      uint32_t internal_base_;
+    };
+
+    // Number of address bits looked up per node.
+    static constexpr uint32_t NodeBits = 6;
+    // Bounds of the number of address bits indexing the root array.
+    static constexpr uint32_t MinRootBits = 8;
+    static constexpr uint32_t MaxRootBits = 16;
+    // Set on root entries that are leaves rather than node indices.
+    static constexpr uint32_t LeafBit = 1u << 31;
+    // Id of the empty data.
+    static constexpr uint32_t NoData = 0;
+
+    /**
+     * Extract n bits from input starting at position p, padded with zeros past the end of the
+     * address.
+     */
+    static uint32_t bits(uint32_t p, uint32_t n, IpType input) {
+      ASSERT(p < address_size && n > 0 && n <= 32);
+      return static_cast<uint32_t>(input << p >> (address_size - n));
+    }
+
+    /**
+     * Compute the data id of each of the 2^n children starting at position, from the CIDR
+     * ranges in prefixes_[first, last) that end within the children and the data id the children
+     * inherit from wider CIDR ranges. Also find the CIDR ranges of each child longer than the
+     * child, as ranges of prefixes_.
+     */
+    void expandChildren(uint32_t position, uint32_t n, size_t first, size_t last,
+                        uint32_t inherited, std::vector<uint32_t>& children,
+                        std::vector<std::pair<size_t, size_t>>& longer) {
+      children.assign(size_t(1) << n, inherited);
+      longer.assign(size_t(1) << n, {0, 0});
+
+      std::vector<size_t> ending;
+      for (size_t i = first; i < last; ++i) {
+        const Prefix<IpType>& prefix = prefixes_[i];
+        if (prefix.length_ > position + n) {
+          auto& range = longer[bits(position, n, prefix.ip_)];
+          if (range.first == range.second) {
+            range.first = i;
+          }
+          range.second = i + 1;
+        } else if (position == 0 || prefix.length_ > position) {
+          // Wider CIDR ranges were already expanded into the inherited data.
+          ending.push_back(i);
+        }
+      }
+
+      // Expand the CIDR ranges from the widest to the narrowest, so that narrower ranges override
+      // or add to the data of wider ranges.
+      std::stable_sort(ending.begin(), ending.end(), [this](size_t a, size_t b) {
+        return prefixes_[a].length_ < prefixes_[b].length_;
+      });
+      for (size_t i : ending) {
+        const Prefix<IpType>& prefix = prefixes_[i];
+        const uint32_t begin = bits(position, n, prefix.ip_);
+        const uint32_t end = begin + (1u << (position + n - prefix.length_));
+        uint32_t previous = NoData;
+        uint32_t merged = dataFor(i, previous);
+        for (uint32_t child = begin; child < end; ++child) {
+          if (children[child] != previous) {
+            previous = children[child];
+            merged = dataFor(i, previous);
+          }
+          children[child] = merged;
+        }
+      }
+    }
+
+    /**
+     * @return the data id of the addresses of the CIDR range prefixes_[i] which would otherwise
+     *         have the data id inherited.
+     */
+    uint32_t dataFor(size_t i, uint32_t inherited) {
+      if (exclusive_ || inherited == NoData) {
+        if (prefix_data_[i] == NoData) {
+          prefix_data_[i] = addData(prefixes_[i].data_);
+        }
+        return prefix_data_[i];
+      }
+      auto [it, inserted] = merged_data_.try_emplace({inherited, i}, NoData);
+      if (inserted) {
+        DataSet merged = sets_[inherited];
+        merged.insert(prefixes_[i].data_.begin(), prefixes_[i].data_.end());
+        it->second = addData(std::move(merged));
+      }
+      return it->second;
+    }
+
+    /**
+     * @return the data id of data, shared with any identical data added before so that leaves with
+     *         the same data compare equal and the data is only stored once.
+     */
+    uint32_t addData(DataSet data) {
+      // The hash must not depend on the iteration order of the set.
+      size_t hash = 0;
+      for (const T& value : data) {
+        hash += absl::Hash<T>()(value);
+      }
+      std::vector<uint32_t>& ids = data_ids_[hash];
+      for (const uint32_t id : ids) {
+        if (sets_[id] == data) {
+          return id;
+        }
+      }
+      RELEASE_ASSERT(sets_.size() < LeafBit, "too many distinct data sets for the stride trie");
+      sets_.push_back(std::move(data));
+      ids.push_back(sets_.size() - 1);
+      return sets_.size() - 1;
+    }
+
+    /**
+     * Build the node at nodes_[index] starting at position, from the CIDR ranges in
+     * prefixes_[first, last) and the data id inherited from wider CIDR ranges.
+     */
+    void buildNode(uint32_t index, uint32_t position, size_t first, size_t last,
+                   uint32_t inherited) {
+      std::vector<uint32_t> children;
+      std::vector<std::pair<size_t, size_t>> longer;
+      expandChildren(position, NodeBits, first, last, inherited, children, longer);
+
+      Node node{0, 0, static_cast<uint32_t>(leaves_.size()), static_cast<uint32_t>(nodes_.size())};
+      for (uint32_t child = 0; child < children.size(); ++child) {
+        if (longer[child].first != longer[child].second) {
+          node.internal_ |= uint64_t(1) << child;
+        } else if (leaves_.size() == node.leaves_base_ || leaves_.back() != children[child]) {
+          node.leaves_ |= uint64_t(1) << child;
+          leaves_.push_back(children[child]);
+        }
+      }
+      // The internal node children are stored contiguously, before building their own children.
+      nodes_.resize(nodes_.size() + absl::popcount(node.internal_));
+      nodes_[index] = node;
+
+      uint32_t next = node.internal_base_;
+      for (uint32_t child = 0; child < children.size(); ++child) {
+        if (longer[child].first != longer[child].second) {
+          buildNode(next++, position + NodeBits, longer[child].first, longer[child].second,
+                    children[child]);
+        }
+      }
+    }
+
+    std::vector<Prefix<IpType>> prefixes_;
+    // Data id of each CIDR range on its own, once used.
+    std::vector<uint32_t> prefix_data_;
+    // Data of each data id, while building.
+    std::vector<DataSet> sets_;
+    // Data ids by the hash of their data, while building.
+    absl::flat_hash_map<size_t, std::vector<uint32_t>> data_ids_;
+    // Data id of the data of a CIDR range merged into an inherited data id, while building.
+    absl::flat_hash_map<std::pair<uint32_t, size_t>, uint32_t> merged_data_;
+    const bool exclusive_;
+
+    uint32_t root_bits_{0};
+    // Leaf data ids with LeafBit set, or node indices.
+    std::vector<uint32_t> root_;
+    std::vector<Node> nodes_;
+    // Data ids of the leaves of the nodes.
+    std::vector<uint32_t> leaves_;
+    // Data of each data id.
+    std::vector<std::vector<T>> data_;
+  };
+
+  std::unique_ptr<Poptrie<Ipv4>> ipv4_trie_;
+  std::unique_ptr<Poptrie<Ipv6>> ipv6_trie_;
+};
+
+template <class T>
+template <class IpType, uint32_t address_size>
+StrideTrie<T>::Poptrie<IpType, address_size>::Poptrie(std::vector<Prefix<IpType>>&& prefixes,
+                                                      bool exclusive)
+    : prefixes_(std::move(prefixes)), exclusive_(exclusive) {
+  addData({});
+  if (!prefixes_.empty()) {
+    // Sort the CIDR ranges by address then length, so that the CIDR ranges within a child are
+    // contiguous, and merge the data of duplicate CIDR ranges.
+    std::sort(prefixes_.begin(), prefixes_.end(),
+              [](const Prefix<IpType>& a, const Prefix<IpType>& b) {
+                return a.ip_ < b.ip_ || (a.ip_ == b.ip_ && a.length_ < b.length_);
+              });
+    size_t unique = 0;
+    for (size_t i = 1; i < prefixes_.size(); ++i) {
+      if (prefixes_[i].ip_ == prefixes_[unique].ip_ &&
+          prefixes_[i].length_ == prefixes_[unique].length_) {
+        prefixes_[unique].data_.insert(prefixes_[i].data_.begin(), prefixes_[i].data_.end());
+      } else {
+        prefixes_[++unique] = std::move(prefixes_[i]);
+      }
+    }
+    prefixes_.resize(unique + 1);
+    prefix_data_.assign(prefixes_.size(), NoData);
+
+    root_bits_ = std::clamp<uint32_t>(absl::bit_width(prefixes_.size()), MinRootBits, MaxRootBits);
+    std::vector<uint32_t> children;
+    std::vector<std::pair<size_t, size_t>> longer;
+    expandChildren(0, root_bits_, 0, prefixes_.size(), NoData, children, longer);
+    root_.resize(children.size());
+    for (uint32_t child = 0; child < children.size(); ++child) {
+      if (longer[child].first != longer[child].second) {
+        root_[child] = nodes_.size();
+        nodes_.emplace_back();
+        buildNode(root_[child], root_bits_, longer[child].first, longer[child].second,
+                  children[child]);
+      } else {
+        root_[child] = children[child] | LeafBit;
+      }
+    }
+  }
+
+  // Only keep what lookups need.
+  data_.reserve(sets_.size());
+  for (const DataSet& data : sets_) {
+    data_.emplace_back(data.begin(), data.end());
+  }
+  sets_ = {};
+  data_ids_ = {};
+  merged_data_ = {};
+  prefixes_ = {};
+  prefix_data_ = {};
+}
+
+} // namespace StrideTrie
+} // namespace Network
+} // namespace Envoy
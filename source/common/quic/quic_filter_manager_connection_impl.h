@@ -122,6 +122,8 @@ public:
     // As quic connection is not HTTP1.1, this method shouldn't be called by HCM.
     PANIC("not implemented");
   }
+  // QUIC streams buffer data in their own buffers.
+  void bindBufferMemoryAccount(Buffer::BufferMemoryAccountSharedPtr) override {}
   bool aboveHighWatermark() const override;
 
   const Network::ConnectionSocket::OptionsSharedPtr& socketOptions() const override;
@@ -133,6 +135,8 @@ public:
   void configureInitialCongestionWindow(uint64_t bandwidth_bits_per_sec,
                                         std::chrono::microseconds rtt) override;
   absl::optional<uint64_t> congestionWindowInBytes() const override;
+  // QUIC connections are bound to the UDP socket of the listener.
+  Network::IoHandlePtr migrateSocket() override { return nullptr; }
 
   // Network::FilterManagerConnection
   void rawWrite(Buffer::Instance& data, bool end_stream) override;
@@ -80,35 +80,36 @@ RouteEntryImplBaseConstSharedPtr createAndValidateRoute(
     ProtobufMessage::ValidationVisitor& validator,
     const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters) {
 
+  const Memory::ArenaSharedPtr& arena = vhost->globalRouteConfig().arena();
   RouteEntryImplBaseConstSharedPtr route;
   switch (route_config.match().path_specifier_case()) {
   case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPrefix: {
-    route = std::make_shared<PrefixRouteEntryImpl>(vhost, route_config, optional_http_filters,
-                                                   factory_context, validator);
+    route = Memory::makeSharedInArena<PrefixRouteEntryImpl>(
+        arena, vhost, route_config, optional_http_filters, factory_context, validator);
     break;
   }
   case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPath: {
-    route = std::make_shared<PathRouteEntryImpl>(vhost, route_config, optional_http_filters,
-                                                 factory_context, validator);
+    route = Memory::makeSharedInArena<PathRouteEntryImpl>(
+        arena, vhost, route_config, optional_http_filters, factory_context, validator);
     break;
   }
   case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex: {
-    route = std::make_shared<RegexRouteEntryImpl>(vhost, route_config, optional_http_filters,
-                                                  factory_context, validator);
+    route = Memory::makeSharedInArena<RegexRouteEntryImpl>(
+        arena, vhost, route_config, optional_http_filters, factory_context, validator);
     break;
   }
   case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kConnectMatcher: {
-    route = std::make_shared<ConnectRouteEntryImpl>(vhost, route_config, optional_http_filters,
-                                                    factory_context, validator);
+    route = Memory::makeSharedInArena<ConnectRouteEntryImpl>(
+        arena, vhost, route_config, optional_http_filters, factory_context, validator);
     break;
   case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPathSeparatedPrefix: {
-    route = std::make_shared<PathSeparatedPrefixRouteEntryImpl>(
-        vhost, route_config, optional_http_filters, factory_context, validator);
+    route = Memory::makeSharedInArena<PathSeparatedPrefixRouteEntryImpl>(
+        arena, vhost, route_config, optional_http_filters, factory_context, validator);
     break;
   }
   case envoy::config::route::v3::RouteMatch::PathSpecifierCase::kPathMatchPolicy: {
-    route = std::make_shared<UriTemplateMatcherRouteEntryImpl>(
-        vhost, route_config, optional_http_filters, factory_context, validator);
+    route = Memory::makeSharedInArena<UriTemplateMatcherRouteEntryImpl>(
+        arena, vhost, route_config, optional_http_filters, factory_context, validator);
     break;
   }
   case envoy::config::route::v3::RouteMatch::PathSpecifierCase::PATH_SPECIFIER_NOT_SET:
@@ -1753,8 +1754,9 @@ VirtualHostImpl::VirtualHostImpl(
     ProtobufMessage::ValidationVisitor& validator,
     const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters) {
 
-  shared_virtual_host_ = std::make_shared<CommonVirtualHostImpl>(
-      virtual_host, optional_http_filters, global_route_config, factory_context, scope, validator);
+  shared_virtual_host_ = Memory::makeSharedInArena<CommonVirtualHostImpl>(
+      global_route_config->arena(), virtual_host, optional_http_filters, global_route_config,
+      factory_context, scope, validator);
 
   switch (virtual_host.require_tls()) {
     PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
@@ -1918,9 +1920,9 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
     validation_clusters = factory_context.clusterManager().clusters();
   }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, optional_http_filters, global_route_config, factory_context,
-        *vhost_scope_, validator, validation_clusters);
+    VirtualHostSharedPtr virtual_host = Memory::makeSharedInArena<VirtualHostImpl>(
+        global_route_config->arena(), virtual_host_config, optional_http_filters,
+        global_route_config, factory_context, *vhost_scope_, validator, validation_clusters);
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2044,6 +2046,10 @@ CommonConfigImpl::CommonConfigImpl(const envoy::config::route::v3::RouteConfigur
       uses_vhds_(config.has_vhds()),
       most_specific_header_mutations_wins_(config.most_specific_header_mutations_wins()),
       ignore_path_parameters_in_path_matching_(config.ignore_path_parameters_in_path_matching()) {
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.route_config_hugepage_arena")) {
+    arena_ = std::make_shared<Memory::Arena>();
+  }
+
   if (!config.request_mirror_policies().empty()) {
     shadow_policies_.reserve(config.request_mirror_policies().size());
     for (const auto& mirror_policy_config : config.request_mirror_policies()) {
@@ -28,6 +28,7 @@
 #include "source/common/http/hash_policy.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/matcher/matcher.h"
+#include "source/common/memory/arena.h"
 #include "source/common/router/config_utility.h"
 #include "source/common/router/header_formatter.h"
 #include "source/common/router/header_parser.h"
@@ -1555,8 +1556,11 @@ public:
   bool ignorePathParametersInPathMatching() const {
     return ignore_path_parameters_in_path_matching_;
   }
+  // Arena the virtual hosts and routes of the configuration are allocated from, if any.
+  const Memory::ArenaSharedPtr& arena() const { return arena_; }
 
 private:
+  Memory::ArenaSharedPtr arena_;
   std::list<Http::LowerCaseString> internal_only_headers_;
   HeaderParserPtr request_headers_parser_;
   HeaderParserPtr response_headers_parser_;
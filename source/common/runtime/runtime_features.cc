@@ -55,6 +55,7 @@ RUNTIME_GUARD(envoy_reloadable_features_oauth_use_url_encoding);
 RUNTIME_GUARD(envoy_reloadable_features_original_dst_rely_on_idle_timeout);
 RUNTIME_GUARD(envoy_reloadable_features_prohibit_route_refresh_after_response_headers_sent);
 RUNTIME_GUARD(envoy_reloadable_features_quic_defer_logging_to_ack_listener);
+RUNTIME_GUARD(envoy_reloadable_features_raw_buffer_socket_adapt_read_size);
 RUNTIME_GUARD(envoy_reloadable_features_reject_require_client_certificate_with_quic);
 RUNTIME_GUARD(envoy_reloadable_features_sanitize_original_path);
 RUNTIME_GUARD(envoy_reloadable_features_service_sanitize_non_utf8_strings);
@@ -103,6 +104,12 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_always_use_v6);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_no_delay_close_for_upgrades);
 // TODO(pradeepcrao) reset this to true after 2 releases (1.27)
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_enable_include_histograms);
+// Opt-in, as the arena reserves at least 64KiB per route configuration.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_route_config_hugepage_arena);
+// Opt-in, as every slice allocated or released by a connection updates a gauge shared by workers.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_listener_buffer_memory_accounting);
+// Opt-in until the IP tagging stride trie has been proven on production tables.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_ip_tagging_stride_trie);
 
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
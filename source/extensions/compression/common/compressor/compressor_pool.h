@@ -0,0 +1,138 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/server/overload/overload_manager.h"
+#include "envoy/thread_local/thread_local.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+
+// Default number of idle compressors kept by a pool on each worker.
+constexpr uint32_t DefaultMaxIdleCompressors = 16;
+
+/**
+ * Per-worker pool of idle compressors. Creating a compressor allocates the library's whole
+ * stream state (e.g. ~256 KB for zlib at the highest memory level), which dominates the cost of
+ * compressing small responses. Instead, compressors handed out by the pool go back to the pool of
+ * the worker they were used on when the stream is done with them, and are reset and reused for
+ * the next stream.
+ *
+ * T must be a compressor providing reset(), which discards any stream in progress and returns it
+ * to the state of a freshly created compressor with the same parameters.
+ *
+ * Every worker keeps at most max_idle compressors. While the shrink heap overload action is
+ * saturated returned compressors are freed instead, and the idle ones are released.
+ */
+template <class T> class CompressorPool {
+public:
+  using CompressorBuilder = std::function<std::unique_ptr<T>()>;
+
+  CompressorPool(ThreadLocal::SlotAllocator& tls, Server::OverloadManager& overload_manager,
+                 uint32_t max_idle, CompressorBuilder builder)
+      : tls_slot_(ThreadLocal::TypedSlot<ThreadLocalPool>::makeUnique(tls)),
+        builder_(std::move(builder)) {
+    tls_slot_->set([&overload_manager, max_idle](Event::Dispatcher&) {
+      return std::make_shared<ThreadLocalPool>(overload_manager, max_idle);
+    });
+  }
+
+  /**
+   * @return a compressor ready to start a new stream, reused from this worker's pool if any is
+   * idle. It must be destroyed on the thread which acquired it.
+   */
+  Envoy::Compression::Compressor::CompressorPtr acquire() {
+    const std::shared_ptr<IdleCompressors>& idle = (*tls_slot_)->idle_;
+    std::unique_ptr<T> compressor = idle->pop();
+    if (compressor == nullptr) {
+      compressor = builder_();
+    }
+    return std::make_unique<PooledCompressor>(std::move(compressor), idle);
+  }
+
+  /**
+   * @return the number of idle compressors pooled on the calling thread.
+   */
+  size_t idleCount() const { return (*tls_slot_)->idle_->compressors_.size(); }
+
+private:
+  struct IdleCompressors {
+    IdleCompressors(Server::OverloadManager& overload_manager, uint32_t max_idle)
+        : overload_manager_(overload_manager), max_idle_(max_idle) {}
+
+    std::unique_ptr<T> pop() {
+      if (compressors_.empty()) {
+        return nullptr;
+      }
+      std::unique_ptr<T> compressor = std::move(compressors_.back());
+      compressors_.pop_back();
+      return compressor;
+    }
+
+    void push(std::unique_ptr<T>&& compressor) {
+      if (overload_manager_.getThreadLocalOverloadState()
+              .getState(Server::OverloadActionNames::get().ShrinkHeap)
+              .isSaturated()) {
+        compressors_.clear();
+        return;
+      }
+      if (compressors_.size() < max_idle_) {
+        compressor->reset();
+        compressors_.push_back(std::move(compressor));
+      }
+    }
+
+    Server::OverloadManager& overload_manager_;
+    const uint32_t max_idle_;
+    std::vector<std::unique_ptr<T>> compressors_;
+  };
+
+  // Only the thread local object owns a worker's idle compressors. Compressors in use keep a weak
+  // reference, so that the ones outliving the pool (e.g. after a configuration update) are freed
+  // rather than returned.
+  struct ThreadLocalPool : public ThreadLocal::ThreadLocalObject {
+    ThreadLocalPool(Server::OverloadManager& overload_manager, uint32_t max_idle)
+        : idle_(std::make_shared<IdleCompressors>(overload_manager, max_idle)) {}
+
+    const std::shared_ptr<IdleCompressors> idle_;
+  };
+
+  class PooledCompressor : public Envoy::Compression::Compressor::Compressor {
+  public:
+    PooledCompressor(std::unique_ptr<T>&& compressor, std::weak_ptr<IdleCompressors> idle)
+        : compressor_(std::move(compressor)), idle_(std::move(idle)) {}
+
+    ~PooledCompressor() override {
+      if (auto idle = idle_.lock(); idle != nullptr) {
+        idle->push(std::move(compressor_));
+      }
+    }
+
+    // Compression::Compressor::Compressor
+    void compress(Buffer::Instance& buffer,
+                  Envoy::Compression::Compressor::State state) override {
+      compressor_->compress(buffer, state);
+    }
+
+  private:
+    std::unique_ptr<T> compressor_;
+    const std::weak_ptr<IdleCompressors> idle_;
+  };
+
+  ThreadLocal::TypedSlotPtr<ThreadLocalPool> tls_slot_;
+  const CompressorBuilder builder_;
+};
+
+template <class T> using CompressorPoolPtr = std::unique_ptr<CompressorPool<T>>;
+
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -15,6 +15,15 @@ GzipCompressorFactory::GzipCompressorFactory(
                    GzipHeaderValue),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)) {}
 
+GzipCompressorFactory::GzipCompressorFactory(
+    const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip,
+    ThreadLocal::SlotAllocator& tls, Server::OverloadManager& overload_manager)
+    : GzipCompressorFactory(gzip) {
+  pool_ = std::make_unique<Compression::Common::Compressor::CompressorPool<ZlibCompressorImpl>>(
+      tls, overload_manager, Compression::Common::Compressor::DefaultMaxIdleCompressors,
+      [this]() { return createZlibCompressor(); });
+}
+
 ZlibCompressorImpl::CompressionLevel GzipCompressorFactory::compressionLevelEnum(
     envoy::extensions::compression::gzip::compressor::v3::Gzip::CompressionLevel
         compression_level) {
@@ -59,17 +68,25 @@ ZlibCompressorImpl::CompressionStrategy GzipCompressorFactory::compressionStrate
   }
 }
 
-Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompressor() {
+std::unique_ptr<ZlibCompressorImpl> GzipCompressorFactory::createZlibCompressor() {
   auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
   compressor->init(compression_level_, compression_strategy_, window_bits_, memory_level_);
   return compressor;
 }
 
+Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompressor() {
+  if (pool_ != nullptr) {
+    return pool_->acquire();
+  }
+  return createZlibCompressor();
+}
+
 Envoy::Compression::Compressor::CompressorFactoryPtr
 GzipCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::compressor::v3::Gzip& proto_config,
-    Server::Configuration::FactoryContext&) {
-  return std::make_unique<GzipCompressorFactory>(proto_config);
+    Server::Configuration::FactoryContext& context) {
+  return std::make_unique<GzipCompressorFactory>(proto_config, context.threadLocal(),
+                                                 context.overloadManager());
 }
 
 /**
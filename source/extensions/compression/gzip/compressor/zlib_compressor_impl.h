@@ -82,6 +82,12 @@ public:
   void init(CompressionLevel level, CompressionStrategy strategy, int64_t window_bits,
             uint64_t memory_level);
 
+  /**
+   * Discards any stream in progress, keeping the parameters and the memory set up by init(), so
+   * that the compressor can be reused for a new stream.
+   */
+  void reset();
+
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
 
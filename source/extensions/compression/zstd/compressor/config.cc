@@ -8,7 +8,8 @@ namespace Compressor {
 
 ZstdCompressorFactory::ZstdCompressorFactory(
     const envoy::extensions::compression::zstd::compressor::v3::Zstd& zstd,
-    Event::Dispatcher& dispatcher, Api::Api& api, ThreadLocal::SlotAllocator& tls)
+    Event::Dispatcher& dispatcher, Api::Api& api, ThreadLocal::SlotAllocator& tls,
+    Server::OverloadManager& overload_manager)
     : compression_level_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, compression_level, ZSTD_CLEVEL_DEFAULT)),
       enable_checksum_(zstd.enable_checksum()), strategy_(zstd.strategy()),
@@ -21,20 +22,34 @@ ZstdCompressorFactory::ZstdCompressorFactory(
         [this](const void* dict_buffer, size_t dict_size) -> ZSTD_CDict* {
           return ZSTD_createCDict(dict_buffer, dict_size, compression_level_);
         });
+  } else {
+    // Contexts referencing a dictionary are not pooled: the dictionary may be replaced when its
+    // file is updated, which idle contexts would not notice.
+    pool_ = std::make_unique<Compression::Common::Compressor::CompressorPool<ZstdCompressorImpl>>(
+        tls, overload_manager, Compression::Common::Compressor::DefaultMaxIdleCompressors,
+        [this]() { return createZstdCompressor(); });
   }
 }
 
-Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompressor() {
+std::unique_ptr<ZstdCompressorImpl> ZstdCompressorFactory::createZstdCompressor() {
   return std::make_unique<ZstdCompressorImpl>(compression_level_, enable_checksum_, strategy_,
                                               cdict_manager_, chunk_size_);
 }
 
+Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompressor() {
+  if (pool_ != nullptr) {
+    return pool_->acquire();
+  }
+  return createZstdCompressor();
+}
+
 Envoy::Compression::Compressor::CompressorFactoryPtr
 ZstdCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::zstd::compressor::v3::Zstd& proto_config,
     Server::Configuration::FactoryContext& context) {
   return std::make_unique<ZstdCompressorFactory>(proto_config, context.mainThreadDispatcher(),
-                                                 context.api(), context.threadLocal());
+                                                 context.api(), context.threadLocal(),
+                                                 context.overloadManager());
 }
 
 /**
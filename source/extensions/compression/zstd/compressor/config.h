@@ -5,6 +5,7 @@
 #include "envoy/extensions/compression/zstd/compressor/v3/zstd.pb.validate.h"
 
 #include "source/common/http/headers.h"
+#include "source/extensions/compression/common/compressor/compressor_pool.h"
 #include "source/extensions/compression/common/compressor/factory_base.h"
 #include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
 
@@ -27,7 +28,7 @@ class ZstdCompressorFactory : public Envoy::Compression::Compressor::CompressorF
 public:
   ZstdCompressorFactory(const envoy::extensions::compression::zstd::compressor::v3::Zstd& zstd,
                         Event::Dispatcher& dispatcher, Api::Api& api,
-                        ThreadLocal::SlotAllocator& tls);
+                        ThreadLocal::SlotAllocator& tls, Server::OverloadManager& overload_manager);
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
@@ -37,11 +38,14 @@ public:
   }
 
 private:
+  std::unique_ptr<ZstdCompressorImpl> createZstdCompressor();
+
   const uint32_t compression_level_;
   const bool enable_checksum_;
   const uint32_t strategy_;
   const uint32_t chunk_size_;
   ZstdCDictManagerPtr cdict_manager_{nullptr};
+  Compression::Common::Compressor::CompressorPoolPtr<ZstdCompressorImpl> pool_;
 };
 
 class ZstdCompressorLibraryFactory
@@ -29,6 +29,13 @@ ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_c
   RELEASE_ASSERT(!ZSTD_isError(result), "");
 }
 
+void ZstdCompressorImpl::reset() {
+  const size_t result = ZSTD_CCtx_reset(cctx_.get(), ZSTD_reset_session_only);
+  RELEASE_ASSERT(!ZSTD_isError(result), "");
+  input_ = {nullptr, 0, 0};
+  output_.pos = 0;
+}
+
 void ZstdCompressorImpl::compress(Buffer::Instance& buffer,
                                   Envoy::Compression::Compressor::State state) {
   Buffer::OwnedImpl accumulation_buffer;
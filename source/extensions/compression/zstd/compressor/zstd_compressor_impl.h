@@ -25,6 +25,12 @@ public:
   ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum, uint32_t strategy,
                      const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size);
 
+  /**
+   * Discards any frame in progress, keeping the compression parameters and the context's memory,
+   * so that the compressor can be reused for a new stream.
+   */
+  void reset();
+
   // Compression::Compressor::Compressor
   void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override;
 
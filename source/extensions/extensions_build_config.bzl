@@ -384,6 +384,12 @@ EXTENSIONS = {
 
     "envoy.rbac.matchers.upstream_ip_port":     "//source/extensions/filters/common/rbac/matchers:upstream_ip_port_lib",
 
+    #
+    # Connection balancers
+    #
+
+    "envoy.network.connection_balance.load_aware":     "//source/extensions/network/connection_balance/load_aware:config",
+
     #
     # DNS Resolver
     #
@@ -6,6 +6,7 @@
 
 #include "envoy/http/header_map.h"
 
+#include "source/common/common/utility.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/header_utility.h"
 #include "source/extensions/filters/http/cache/cache_custom_headers.h"
@@ -14,6 +15,7 @@
 #include "absl/container/btree_set.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 
 namespace Envoy {
@@ -300,6 +302,38 @@ namespace {
 constexpr absl::string_view headerSeparator = "\n";
 // Used to separate multiple values of a same header.
 constexpr absl::string_view inValueSeparator = "\r";
+
+// Returns a canonical form of the request's Accept-Encoding header: the sorted, de-duplicated set
+// of lower-cased content codings, each followed by its q-value unless it is the default of 1.
+// "gzip, br", "br,gzip" and "GZIP;q=1.0, br" all map to "br,gzip". Any of these requests accepts
+// the representation selected for the others with the same preference, so they can share one
+// cached variant instead of each storing (and compressing) a copy of the same response.
+std::string normalizeAcceptEncoding(const Http::RequestHeaderMap& request_headers) {
+  absl::btree_set<std::string> codings;
+  for (const absl::string_view token : CacheHeadersUtils::parseCommaDelimitedHeader(
+           request_headers.get(Http::CustomHeaders::get().AcceptEncoding))) {
+    const std::string coding =
+        absl::AsciiStrToLower(StringUtil::trim(StringUtil::cropRight(token, ";")));
+    if (coding.empty()) {
+      continue;
+    }
+    float q_value = 1;
+    const absl::string_view params = StringUtil::cropLeft(token, ";");
+    if (params != token) {
+      const absl::string_view value = StringUtil::cropLeft(params, "=");
+      if (value == params ||
+          !absl::EqualsIgnoreCase("q", StringUtil::trim(StringUtil::cropRight(params, "="))) ||
+          !absl::SimpleAtof(StringUtil::trim(value), &q_value)) {
+        // Keep parameters we don't understand, so they still differentiate variants.
+        codings.insert(
+            absl::StrCat(coding, ";", absl::AsciiStrToLower(StringUtil::trim(params))));
+        continue;
+      }
+    }
+    codings.insert(q_value == 1 ? coding : absl::StrCat(coding, ";q=", q_value));
+  }
+  return absl::StrJoin(codings, ",");
+}
 }; // namespace
 
 absl::optional<std::string>
@@ -332,6 +366,11 @@ VaryHeaderUtils::createVaryIdentifier(const VaryAllowList& allow_list,
     // UserAgent::initializeFromHeaders tries to do that normalization and could
     // be used as an inspiration for some bucketing configuration. The config
     // should enable and control the bucketing wanted.
+    if (absl::EqualsIgnoreCase(value, Http::CustomHeaders::get().AcceptEncoding.get())) {
+      absl::StrAppend(&vary_identifier, value, inValueSeparator,
+                      normalizeAcceptEncoding(request_headers), headerSeparator);
+      continue;
+    }
     const auto all_values = Http::HeaderUtility::getAllOfHeaderAsString(
         request_headers, Http::LowerCaseString(std::string(value)), inValueSeparator);
     absl::StrAppend(&vary_identifier, value, inValueSeparator,
@@ -148,7 +148,8 @@ absl::btree_set<absl::string_view> getVaryValues(const Envoy::Http::ResponseHead
 // Creates a single string combining the values of the varied headers from
 // entry_headers. Returns an absl::nullopt if no valid vary key can be created
 // and the response should not be cached (eg. when disallowed vary headers are
-// present in the response).
+// present in the response). Accept-Encoding values are canonicalized, so that
+// requests accepting the same content codings share a variant.
 absl::optional<std::string>
 createVaryIdentifier(const VaryAllowList& allow_list,
                      const absl::btree_set<absl::string_view>& vary_header_values,
@@ -5,6 +5,7 @@
 
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/str_join.h"
 
@@ -52,7 +53,11 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
     tag_data.emplace_back(ip_tag.ip_tag_name(), cidr_set);
     stat_name_set_->rememberBuiltin(absl::StrCat(ip_tag.ip_tag_name(), ".hit"));
   }
-  trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.ip_tagging_stride_trie")) {
+    stride_trie_ = std::make_unique<Network::StrideTrie::StrideTrie<std::string>>(tag_data);
+  } else {
+    lc_trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+  }
 }
 
 void IpTaggingFilterConfig::incCounter(Stats::StatName name) {
@@ -78,7 +83,7 @@ Http::FilterHeadersStatus IpTaggingFilter::decodeHeaders(Http::RequestHeaderMap&
   }
 
   std::vector<std::string> tags =
-      config_->trie().getData(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
+      config_->getTags(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
 
   if (!tags.empty()) {
     const std::string tags_join = absl::StrJoin(tags, ",");
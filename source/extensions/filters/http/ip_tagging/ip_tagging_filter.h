@@ -14,6 +14,7 @@
 
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/lc_trie.h"
+#include "source/common/network/stride_trie.h"
 #include "source/common/stats/symbol_table.h"
 
 namespace Envoy {
@@ -37,7 +38,10 @@ public:
 
   Runtime::Loader& runtime() { return runtime_; }
   FilterRequestType requestType() const { return request_type_; }
-  const Network::LcTrie::LcTrie<std::string>& trie() const { return *trie_; }
+  // @return the tags of the CIDR ranges containing address.
+  std::vector<std::string> getTags(const Network::Address::InstanceConstSharedPtr& address) const {
+    return stride_trie_ != nullptr ? stride_trie_->getData(address) : lc_trie_->getData(address);
+  }
 
   void incHit(absl::string_view tag) {
     incCounter(stat_name_set_->getBuiltin(absl::StrCat(tag, ".hit"), unknown_tag_));
@@ -70,7 +74,10 @@ private:
   const Stats::StatName no_hit_;
   const Stats::StatName total_;
   const Stats::StatName unknown_tag_;
-  std::unique_ptr<Network::LcTrie::LcTrie<std::string>> trie_;
+  // Only one of the tries is built, the stride trie if the runtime guard
+  // envoy.reloadable_features.ip_tagging_stride_trie is enabled.
+  std::unique_ptr<Network::LcTrie::LcTrie<std::string>> lc_trie_;
+  std::unique_ptr<Network::StrideTrie::StrideTrie<std::string>> stride_trie_;
 };
 
 using IpTaggingFilterConfigSharedPtr = std::shared_ptr<IpTaggingFilterConfig>;
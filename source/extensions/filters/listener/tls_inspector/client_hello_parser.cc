@@ -0,0 +1,226 @@
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include <algorithm>
+#include <array>
+
+#include "openssl/bytestring.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+namespace {
+
+// Bound on the number of extensions of a parsed ClientHello, far above what clients send.
+constexpr size_t MaxExtensions = 64;
+
+// Size of the record header and of the handshake message header preceding the ClientHello.
+constexpr size_t ClientHelloHeaderSize = SSL3_RT_HEADER_LENGTH + SSL3_HM_HEADER_LENGTH;
+
+bool getNonEmptyU8List(CBS extension, CBS& list) {
+  return CBS_get_u8_length_prefixed(&extension, &list) && CBS_len(&extension) == 0 &&
+         CBS_len(&list) > 0;
+}
+
+bool isNonEmptyU16List(CBS extension) {
+  CBS list;
+  return CBS_get_u16_length_prefixed(&extension, &list) && CBS_len(&extension) == 0 &&
+         CBS_len(&list) > 0 && CBS_len(&list) % 2 == 0;
+}
+
+// The TLS library rejects a server_name extension unless it holds a single, valid host name.
+bool parseServerName(CBS extension, absl::string_view& server_name) {
+  CBS server_name_list;
+  CBS host_name;
+  uint8_t name_type;
+  if (!CBS_get_u16_length_prefixed(&extension, &server_name_list) ||
+      !CBS_get_u8(&server_name_list, &name_type) ||
+      !CBS_get_u16_length_prefixed(&server_name_list, &host_name) ||
+      CBS_len(&server_name_list) != 0 || CBS_len(&extension) != 0 ||
+      name_type != TLSEXT_NAMETYPE_host_name || CBS_len(&host_name) == 0 ||
+      CBS_len(&host_name) > TLSEXT_MAXLEN_host_name || CBS_contains_zero_byte(&host_name)) {
+    return false;
+  }
+  server_name =
+      absl::string_view(reinterpret_cast<const char*>(CBS_data(&host_name)), CBS_len(&host_name));
+  return true;
+}
+
+// Whether the supported_versions extension offers a version the TLS inspector accepts.
+bool hasSupportedVersion(CBS extension) {
+  CBS versions;
+  if (!CBS_get_u8_length_prefixed(&extension, &versions) || CBS_len(&extension) != 0 ||
+      CBS_len(&versions) == 0 || CBS_len(&versions) % 2 != 0) {
+    return false;
+  }
+  bool found = false;
+  while (CBS_len(&versions) > 0) {
+    uint16_t version;
+    CBS_get_u16(&versions, &version);
+    found |= version >= TLS1_VERSION && version <= TLS1_3_VERSION;
+  }
+  return found;
+}
+
+bool parseExtensions(CBS extensions, uint16_t legacy_version, absl::string_view& server_name) {
+  std::array<uint16_t, MaxExtensions> types;
+  size_t num_types = 0;
+  bool has_supported_versions = false;
+  while (CBS_len(&extensions) > 0) {
+    uint16_t type;
+    CBS extension;
+    if (!CBS_get_u16(&extensions, &type) ||
+        !CBS_get_u16_length_prefixed(&extensions, &extension)) {
+      return false;
+    }
+    // The TLS library rejects duplicate extensions.
+    if (num_types == types.size() ||
+        std::find(types.begin(), types.begin() + num_types, type) != types.begin() + num_types) {
+      return false;
+    }
+    types[num_types++] = type;
+
+    bool valid = true;
+    CBS list;
+    switch (type) {
+    case TLSEXT_TYPE_server_name:
+      valid = parseServerName(extension, server_name);
+      break;
+    case TLSEXT_TYPE_supported_versions:
+      // Clients offering versions through the extension send a TLS 1.2 legacy version.
+      valid = legacy_version == TLS1_2_VERSION && hasSupportedVersion(extension);
+      has_supported_versions = true;
+      break;
+    case TLSEXT_TYPE_extended_master_secret:
+    case TLSEXT_TYPE_certificate_timestamp:
+    case TLSEXT_TYPE_next_proto_neg:
+    case TLSEXT_TYPE_channel_id:
+    case TLSEXT_TYPE_early_data:
+      valid = CBS_len(&extension) == 0;
+      break;
+    case TLSEXT_TYPE_renegotiate: {
+      CBS renegotiated_connection;
+      valid = CBS_get_u8_length_prefixed(&extension, &renegotiated_connection) &&
+              CBS_len(&extension) == 0 && CBS_len(&renegotiated_connection) == 0;
+      break;
+    }
+    case TLSEXT_TYPE_supported_groups:
+    case TLSEXT_TYPE_signature_algorithms:
+    case TLSEXT_TYPE_delegated_credential:
+      valid = isNonEmptyU16List(extension);
+      break;
+    case TLSEXT_TYPE_cert_compression:
+      valid = getNonEmptyU8List(extension, list) && CBS_len(&list) % 2 == 0;
+      break;
+    case TLSEXT_TYPE_psk_key_exchange_modes:
+      valid = getNonEmptyU8List(extension, list);
+      break;
+    case TLSEXT_TYPE_ec_point_formats:
+      valid = getNonEmptyU8List(extension, list) &&
+              std::find(CBS_data(&list), CBS_data(&list) + CBS_len(&list),
+                        TLSEXT_ECPOINTFORMAT_uncompressed) != CBS_data(&list) + CBS_len(&list);
+      break;
+    case TLSEXT_TYPE_status_request:
+    case TLSEXT_TYPE_encrypted_client_hello:
+      valid = CBS_len(&extension) > 0;
+      break;
+    case TLSEXT_TYPE_srtp:
+    case TLSEXT_TYPE_quic_transport_parameters:
+    case TLSEXT_TYPE_quic_transport_parameters_legacy:
+      // Not expected on TCP connections, leave them to the TLS library.
+      valid = false;
+      break;
+    default:
+      // The other extensions are either ignored by the TLS library, or only parsed after the
+      // server name has been reported.
+      break;
+    }
+    if (!valid) {
+      return false;
+    }
+  }
+  return has_supported_versions || legacy_version >= TLS1_VERSION;
+}
+
+} // namespace
+
+ClientHelloParser::Result ClientHelloParser::parse(const uint8_t* data, size_t len,
+                                                   SSL_CLIENT_HELLO& client_hello,
+                                                   absl::string_view& server_name) {
+  // Wait for the record and handshake message headers as long as the bytes received so far match
+  // them.
+  if ((len > 0 && data[0] != SSL3_RT_HANDSHAKE) || (len > 1 && data[1] != SSL3_VERSION_MAJOR) ||
+      (len > SSL3_RT_HEADER_LENGTH && data[SSL3_RT_HEADER_LENGTH] != SSL3_MT_CLIENT_HELLO)) {
+    return Result::Unsupported;
+  }
+  if (len < ClientHelloHeaderSize) {
+    return Result::NeedMoreData;
+  }
+
+  // The ClientHello must fill a single record.
+  CBS input;
+  CBS_init(&input, data, len);
+  uint16_t record_length;
+  uint32_t message_length;
+  CBS_skip(&input, 3);
+  CBS_get_u16(&input, &record_length);
+  CBS_skip(&input, 1);
+  CBS_get_u24(&input, &message_length);
+  if (record_length > SSL3_RT_MAX_PLAIN_LENGTH ||
+      record_length != SSL3_HM_HEADER_LENGTH + message_length) {
+    return Result::Unsupported;
+  }
+  CBS body;
+  if (!CBS_get_bytes(&input, &body, message_length)) {
+    return Result::NeedMoreData;
+  }
+
+  client_hello = {};
+  client_hello.client_hello = CBS_data(&body);
+  client_hello.client_hello_len = CBS_len(&body);
+  CBS random;
+  CBS session_id;
+  CBS cipher_suites;
+  CBS compression_methods;
+  if (!CBS_get_u16(&body, &client_hello.version) ||
+      !CBS_get_bytes(&body, &random, SSL3_RANDOM_SIZE) ||
+      !CBS_get_u8_length_prefixed(&body, &session_id) ||
+      CBS_len(&session_id) > SSL_MAX_SSL_SESSION_ID_LENGTH ||
+      !CBS_get_u16_length_prefixed(&body, &cipher_suites) || CBS_len(&cipher_suites) < 2 ||
+      CBS_len(&cipher_suites) % 2 != 0 ||
+      !CBS_get_u8_length_prefixed(&body, &compression_methods) ||
+      CBS_len(&compression_methods) == 0) {
+    return Result::Unsupported;
+  }
+
+  // Extensions are optional.
+  CBS extensions;
+  CBS_init(&extensions, nullptr, 0);
+  if (CBS_len(&body) > 0 &&
+      (!CBS_get_u16_length_prefixed(&body, &extensions) || CBS_len(&body) != 0)) {
+    return Result::Unsupported;
+  }
+
+  client_hello.random = CBS_data(&random);
+  client_hello.random_len = CBS_len(&random);
+  client_hello.session_id = CBS_data(&session_id);
+  client_hello.session_id_len = CBS_len(&session_id);
+  client_hello.cipher_suites = CBS_data(&cipher_suites);
+  client_hello.cipher_suites_len = CBS_len(&cipher_suites);
+  client_hello.compression_methods = CBS_data(&compression_methods);
+  client_hello.compression_methods_len = CBS_len(&compression_methods);
+  client_hello.extensions = CBS_data(&extensions);
+  client_hello.extensions_len = CBS_len(&extensions);
+
+  server_name = absl::string_view();
+  if (!parseExtensions(extensions, client_hello.version, server_name)) {
+    return Result::Unsupported;
+  }
+  return Result::Parsed;
+}
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+/**
+ * Parser of the TLS ClientHello sent at the start of a connection, working directly on the
+ * received bytes rather than through a handshake of the TLS library.
+ *
+ * Only the common shape of a ClientHello is handled: a single handshake record holding the
+ * ClientHello and nothing else, whose framing, server name, versions and the extensions the TLS
+ * library checks before reporting the server name are well formed. Anything else is reported as
+ * unsupported, so that it can be left to the TLS library to accept or reject exactly as before.
+ */
+class ClientHelloParser {
+public:
+  enum class Result {
+    // The ClientHello was parsed.
+    Parsed,
+    // The bytes received so far are the start of a ClientHello the parser handles.
+    NeedMoreData,
+    // The bytes received so far are not the start of a ClientHello the parser handles.
+    Unsupported
+  };
+
+  /**
+   * @param data supplies the bytes received on the connection so far.
+   * @param len supplies the number of bytes received on the connection so far.
+   * @param client_hello receives the fields of the ClientHello once parsed. The fields point into
+   *        data, and the ssl field is always nullptr.
+   * @param server_name receives the server name once parsed, or an empty name if the ClientHello
+   *        has none. The name points into data.
+   * @return the parse result.
+   */
+  static Result parse(const uint8_t* data, size_t len, SSL_CLIENT_HELLO& client_hello,
+                      absl::string_view& server_name);
+};
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -16,6 +16,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/hex.h"
 #include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
 
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -53,14 +54,7 @@ Config::Config(
   SSL_CTX_set_select_certificate_cb(
       ssl_ctx_.get(), [](const SSL_CLIENT_HELLO* client_hello) -> ssl_select_cert_result_t {
         Filter* filter = static_cast<Filter*>(SSL_get_app_data(client_hello->ssl));
-        filter->createJA3Hash(client_hello);
-
-        const uint8_t* data;
-        size_t len;
-        if (SSL_early_callback_ctx_extension_get(
-                client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &data, &len)) {
-          filter->onALPN(data, len);
-        }
+        filter->onClientHello(client_hello);
         return ssl_select_cert_success;
       });
   SSL_CTX_set_tlsext_servername_callback(
@@ -77,10 +71,7 @@ Config::Config(
 
 bssl::UniquePtr<SSL> Config::newSsl() { return bssl::UniquePtr<SSL>{SSL_new(ssl_ctx_.get())}; }
 
-Filter::Filter(const ConfigSharedPtr& config) : config_(config), ssl_(config_->newSsl()) {
-  SSL_set_app_data(ssl_.get(), this);
-  SSL_set_accept_state(ssl_.get());
-}
+Filter::Filter(const ConfigSharedPtr& config) : config_(config) {}
 
 Network::FilterStatus Filter::onAccept(Network::ListenerFilterCallbacks& cb) {
   ENVOY_LOG(trace, "tls inspector: new connection accepted");
@@ -89,6 +80,17 @@ Network::FilterStatus Filter::onAccept(Network::ListenerFilterCallbacks& cb) {
   return Network::FilterStatus::StopIteration;
 }
 
+void Filter::onClientHello(const SSL_CLIENT_HELLO* ssl_client_hello) {
+  createJA3Hash(ssl_client_hello);
+
+  const uint8_t* data;
+  size_t len;
+  if (SSL_early_callback_ctx_extension_get(
+          ssl_client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &data, &len)) {
+    onALPN(data, len);
+  }
+}
+
 void Filter::onALPN(const unsigned char* data, unsigned int len) {
   CBS wire, list;
   CBS_init(&wire, reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(len));
@@ -126,12 +128,11 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   ENVOY_LOG(trace, "tls inspector: recv: {}", raw_slice.len_);
 
   // Because we're doing a MSG_PEEK, data we've seen before gets returned every time, so
-  // skip over what we've already processed.
+  // only parse when there is new data.
   if (static_cast<uint64_t>(raw_slice.len_) > read_) {
-    const uint8_t* data = static_cast<const uint8_t*>(raw_slice.mem_) + read_;
-    const size_t len = raw_slice.len_ - read_;
+    ParseState parse_state =
+        parseClientHello(static_cast<const uint8_t*>(raw_slice.mem_), raw_slice.len_);
     read_ = raw_slice.len_;
-    ParseState parse_state = parseClientHello(data, len);
     switch (parse_state) {
     case ParseState::Error:
       cb_->socket().ioHandle().close();
@@ -148,7 +149,36 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   return Network::FilterStatus::StopIteration;
 }
 
-ParseState Filter::parseClientHello(const void* data, size_t len) {
+ParseState Filter::parseClientHello(const uint8_t* data, size_t len) {
+  if (ssl_ != nullptr) {
+    // Only feed the TLS library the data it hasn't seen yet.
+    return parseClientHelloWithSsl(data + read_, len - read_, len);
+  }
+
+  // Parse the ClientHello directly from the data when possible, as it is much cheaper than
+  // creating an SSL object and running the handshake up to the server name callback.
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  switch (ClientHelloParser::parse(data, len, client_hello, server_name)) {
+  case ClientHelloParser::Result::Parsed:
+    onClientHello(&client_hello);
+    onServername(server_name);
+    return done();
+  case ClientHelloParser::Result::NeedMoreData:
+    return needMoreData(len);
+  case ClientHelloParser::Result::Unsupported:
+    break;
+  }
+
+  // Leave anything else, including data that isn't TLS, to the TLS library.
+  ENVOY_LOG(trace, "tls inspector: parsing ClientHello with the TLS library");
+  ssl_ = config_->newSsl();
+  SSL_set_app_data(ssl_.get(), this);
+  SSL_set_accept_state(ssl_.get());
+  return parseClientHelloWithSsl(data, len, len);
+}
+
+ParseState Filter::parseClientHelloWithSsl(const uint8_t* data, size_t len, size_t total_len) {
   // Ownership is passed to ssl_ in SSL_set_bio()
   bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(data, len));
 
@@ -165,31 +195,39 @@ ParseState Filter::parseClientHello(const void* data, size_t len) {
   ASSERT(ret <= 0);
   switch (SSL_get_error(ssl_.get(), ret)) {
   case SSL_ERROR_WANT_READ:
-    if (read_ == config_->maxClientHelloSize()) {
-      // We've hit the specified size limit. This is an unreasonably large ClientHello;
-      // indicate failure.
-      config_->stats().client_hello_too_large_.inc();
-      return ParseState::Error;
-    }
-    return ParseState::Continue;
+    return needMoreData(total_len);
   case SSL_ERROR_SSL:
-    if (clienthello_success_) {
-      config_->stats().tls_found_.inc();
-      if (alpn_found_) {
-        config_->stats().alpn_found_.inc();
-      } else {
-        config_->stats().alpn_not_found_.inc();
-      }
-      cb_->socket().setDetectedTransportProtocol("tls");
-    } else {
-      config_->stats().tls_not_found_.inc();
-    }
-    return ParseState::Done;
+    return done();
   default:
     return ParseState::Error;
   }
 }
 
+ParseState Filter::needMoreData(size_t total_len) {
+  if (total_len == config_->maxClientHelloSize()) {
+    // We've hit the specified size limit. This is an unreasonably large ClientHello;
+    // indicate failure.
+    config_->stats().client_hello_too_large_.inc();
+    return ParseState::Error;
+  }
+  return ParseState::Continue;
+}
+
+ParseState Filter::done() {
+  if (clienthello_success_) {
+    config_->stats().tls_found_.inc();
+    if (alpn_found_) {
+      config_->stats().alpn_found_.inc();
+    } else {
+      config_->stats().alpn_not_found_.inc();
+    }
+    cb_->socket().setDetectedTransportProtocol("tls");
+  } else {
+    config_->stats().tls_not_found_.inc();
+  }
+  return ParseState::Done;
+}
+
 // Google GREASE values (https://datatracker.ietf.org/doc/html/rfc8701)
 static constexpr std::array<uint16_t, 16> GREASE = {
     0x0a0a, 0x1a1a, 0x2a2a, 0x3a3a, 0x4a4a, 0x5a5a, 0x6a6a, 0x7a7a,
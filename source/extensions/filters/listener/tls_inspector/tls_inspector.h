@@ -83,8 +83,11 @@ public:
   size_t maxReadBytes() const override { return config_->maxClientHelloSize(); }
 
 private:
-  ParseState parseClientHello(const void* data, size_t len);
-  ParseState onRead();
+  ParseState parseClientHello(const uint8_t* data, size_t len);
+  ParseState parseClientHelloWithSsl(const uint8_t* data, size_t len, size_t total_len);
+  ParseState needMoreData(size_t total_len);
+  ParseState done();
+  void onClientHello(const SSL_CLIENT_HELLO* ssl_client_hello);
   void onALPN(const unsigned char* data, unsigned int len);
   void onServername(absl::string_view name);
   void createJA3Hash(const SSL_CLIENT_HELLO* ssl_client_hello);
@@ -92,6 +95,7 @@ private:
   ConfigSharedPtr config_;
   Network::ListenerFilterCallbacks* cb_{};
 
+  // Only created for the ClientHellos left to the TLS library by the ClientHelloParser.
   bssl::UniquePtr<SSL> ssl_;
   uint64_t read_{0};
   bool alpn_found_{false};
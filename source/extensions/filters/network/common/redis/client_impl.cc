@@ -25,7 +25,7 @@ ConfigImpl::ConfigImpl(
       buffer_flush_timeout_(PROTOBUF_GET_MS_OR_DEFAULT(
           config, buffer_flush_timeout,
           3)), // Default timeout is 3ms. If max_buffer_size_before_flush is zero, this is not used
-               // as the buffer is flushed on each request immediately.
+               // as the buffer is flushed at the end of the event loop iteration.
       max_upstream_unknown_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_upstream_unknown_connections, 100)),
       enable_command_stats_(config.enable_command_stats()) {
@@ -83,6 +83,8 @@ ClientImpl::ClientImpl(Upstream::HostConstSharedPtr host, Event::Dispatcher& dis
       config_(config),
       connect_or_op_timer_(dispatcher.createTimer([this]() { onConnectOrOpTimeout(); })),
       flush_timer_(dispatcher.createTimer([this]() { flushBufferAndResetTimer(); })),
+      flush_cb_(dispatcher.createSchedulableCallback(
+          [this]() { connection_->write(encoder_buffer_, false); })),
       time_source_(dispatcher.timeSource()), redis_command_stats_(redis_command_stats),
       scope_(scope), is_transaction_client_(is_transaction_client) {
   Upstream::ClusterTrafficStats& traffic_stats = *host->cluster().trafficStats();
@@ -127,8 +129,16 @@ PoolRequest* ClientImpl::makeRequest(const RespValue& request, ClientCallbacks&
   pending_requests_.emplace_back(*this, callbacks, command);
   encoder_->encode(request, encoder_buffer_);
 
-  // If buffer is full, flush. If the buffer was empty before the request, start the timer.
-  if (encoder_buffer_.length() >= config_.maxBufferSizeBeforeFlush()) {
+  // Without a buffer size, the requests made during this event loop iteration are flushed together
+  // at its end. This sends all the requests fanned out to this upstream from one downstream read,
+  // e.g. the keys of an MGET, with a single write rather than with a write each.
+  // Otherwise, if buffer is full, flush. If the buffer was empty before the request, start the
+  // timer.
+  if (config_.maxBufferSizeBeforeFlush() == 0) {
+    if (empty_buffer) {
+      flush_cb_->scheduleCallbackCurrentIteration();
+    }
+  } else if (encoder_buffer_.length() >= config_.maxBufferSizeBeforeFlush()) {
     flushBufferAndResetTimer();
   } else if (empty_buffer) {
     flush_timer_->enableTimer(std::chrono::milliseconds(config_.bufferFlushTimeoutInMs()));
@@ -199,6 +209,7 @@ void ClientImpl::onEvent(Network::ConnectionEvent event) {
       pending_requests_.pop_front();
     }
 
+    flush_cb_->cancel();
     connect_or_op_timer_->disableTimer();
   } else if (event == Network::ConnectionEvent::Connected) {
     connected_ = true;
@@ -2,6 +2,7 @@
 
 #include <chrono>
 
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
 #include "envoy/stats/timespan.h"
 #include "envoy/thread_local/thread_local.h"
@@ -146,6 +147,9 @@ private:
   Event::TimerPtr connect_or_op_timer_;
   bool connected_{};
   Event::TimerPtr flush_timer_;
+  // Flushes the requests made during an event loop iteration with a single write when requests are
+  // not buffered by size.
+  Event::SchedulableCallbackPtr flush_cb_;
   Envoy::TimeSource& time_source_;
   const RedisCommandStatsSharedPtr redis_command_stats_;
   Stats::Scope& scope_;
@@ -208,6 +208,14 @@ public:
    * @param out supplies the buffer to encode to.
    */
   virtual void encode(const RespValue& value, Buffer::Instance& out) PURE;
+
+  /**
+   * Encode a RESP value which is not needed anymore to a buffer. Large bulk strings are moved into
+   * the buffer rather than copied.
+   * @param value supplies the value to encode, which is consumed.
+   * @param out supplies the buffer to encode to.
+   */
+  virtual void encodeAndRelease(RespValuePtr&& value, Buffer::Instance& out) PURE;
 };
 
 using EncoderPtr = std::unique_ptr<Encoder>;
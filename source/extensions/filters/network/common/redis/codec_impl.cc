@@ -7,6 +7,7 @@
 
 #include "envoy/common/platform.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/utility.h"
@@ -330,7 +331,9 @@ RespValue::CompositeArray::CompositeArrayConstIterator::empty() {
 }
 
 void DecoderImpl::decode(Buffer::Instance& data) {
+  following_slices_length_ = data.length();
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    following_slices_length_ -= slice.len_;
     parseSlice(slice);
   }
 
@@ -458,7 +461,11 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       } else {
         ASSERT(current_value.value_->type() == RespType::BulkString);
         if (!pending_integer_.negative_) {
-          // TODO(mattklein123): reserve and define max length since we don't stream currently.
+          // Allocate the string once if the whole body has been received, rather than growing it
+          // slice by slice. Only the received bytes are reserved, so that a declared length alone
+          // cannot make us allocate.
+          current_value.value_->asString().reserve(
+              std::min(pending_integer_.integer_, remaining + following_slices_length_));
           state_ = State::BulkStringBody;
         } else {
           // Null bulk string. Switch type to null and move to value complete.
@@ -581,15 +588,47 @@ void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
   }
 }
 
-void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+void EncoderImpl::encodeAndRelease(RespValuePtr&& value, Buffer::Instance& out) {
+  encodeMovingBulkStrings(*value, out);
+  value.reset();
+}
+
+void EncoderImpl::encodeMovingBulkStrings(RespValue& value, Buffer::Instance& out) {
+  if (value.type() == RespType::Array) {
+    encodeLength('*', value.asArray().size(), out);
+    for (RespValue& element : value.asArray()) {
+      encodeMovingBulkStrings(element, out);
+    }
+  } else if (value.type() == RespType::BulkString &&
+             value.asString().size() >= MinMovedBulkStringLength) {
+    // The fragment takes the string over, and frees it once the buffer is done with its bytes.
+    auto* string = new std::string(std::move(value.asString()));
+    auto* fragment = new Buffer::BufferFragmentImpl(
+        string->data(), string->size(),
+        [string](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+          delete string;
+          delete this_fragment;
+        });
+    encodeLength('$', string->size(), out);
+    out.addBufferFragment(*fragment);
+    out.add("\r\n", 2);
+  } else {
+    encode(value, out);
+  }
+}
+
+void EncoderImpl::encodeLength(char type, uint64_t length, Buffer::Instance& out) {
   char buffer[32];
   char* current = buffer;
-  *current++ = '*';
-  current += StringUtil::itoa(current, 21, array.size());
+  *current++ = type;
+  current += StringUtil::itoa(current, 21, length);
   *current++ = '\r';
   *current++ = '\n';
   out.add(buffer, current - buffer);
+}
 
+void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+  encodeLength('*', array.size(), out);
   for (const RespValue& value : array) {
     encode(value, out);
   }
@@ -597,26 +636,14 @@ void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Insta
 
 void EncoderImpl::encodeCompositeArray(const RespValue::CompositeArray& composite_array,
                                        Buffer::Instance& out) {
-  char buffer[32];
-  char* current = buffer;
-  *current++ = '*';
-  current += StringUtil::itoa(current, 21, composite_array.size());
-  *current++ = '\r';
-  *current++ = '\n';
-  out.add(buffer, current - buffer);
+  encodeLength('*', composite_array.size(), out);
   for (const RespValue& value : composite_array) {
     encode(value, out);
   }
 }
 
 void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance& out) {
-  char buffer[32];
-  char* current = buffer;
-  *current++ = '$';
-  current += StringUtil::itoa(current, 21, string.size());
-  *current++ = '\r';
-  *current++ = '\n';
-  out.add(buffer, current - buffer);
+  encodeLength('$', string.size(), out);
   out.add(string);
   out.add("\r\n", 2);
 }
@@ -58,6 +58,8 @@ private:
   void parseSlice(const Buffer::RawSlice& slice);
 
   DecoderCallbacks& callbacks_;
+  // Length of the slices of the data being decoded which follow the one being parsed.
+  uint64_t following_slices_length_{};
   State state_{State::ValueRootStart};
   PendingInteger pending_integer_;
   RespValuePtr pending_value_root_;
@@ -80,10 +82,17 @@ public:
  */
 class EncoderImpl : public Encoder {
 public:
+  // Bulk strings at least this long are moved into the output buffer by encodeAndRelease(). Below
+  // that, copying is cheaper than wrapping the string into a buffer fragment.
+  static constexpr uint64_t MinMovedBulkStringLength = 16384;
+
   // RedisProxy::Encoder
   void encode(const RespValue& value, Buffer::Instance& out) override;
+  void encodeAndRelease(RespValuePtr&& value, Buffer::Instance& out) override;
 
 private:
+  void encodeLength(char type, uint64_t length, Buffer::Instance& out);
+  void encodeMovingBulkStrings(RespValue& value, Buffer::Instance& out);
   void encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out);
   void encodeCompositeArray(const RespValue::CompositeArray& array, Buffer::Instance& out);
   void encodeBulkString(const std::string& string, Buffer::Instance& out);
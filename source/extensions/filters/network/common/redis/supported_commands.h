@@ -86,12 +86,20 @@ struct SupportedCommands {
   static const absl::flat_hash_set<std::string>& writeCommands() {
     CONSTRUCT_ON_FIRST_USE(
         absl::flat_hash_set<std::string>, "append", "bitfield", "decr", "decrby", "del", "expire",
-        "expireat", "eval", "evalsha", "geoadd", "hdel", "hincrby", "hincrbyfloat", "hmset", "hset",
-        "hsetnx", "incr", "incrby", "incrbyfloat", "linsert", "lpop", "lpush", "lpushx", "lrem",
-        "lset", "ltrim", "mset", "persist", "pexpire", "pexpireat", "pfadd", "psetex", "restore",
-        "rpop", "rpush", "rpushx", "sadd", "set", "setbit", "setex", "setnx", "setrange", "spop",
-        "srem", "zadd", "zincrby", "touch", "zpopmin", "zpopmax", "zrem", "zremrangebylex",
-        "zremrangebyrank", "zremrangebyscore", "unlink");
+        "expireat", "eval", "evalsha", "geoadd", "getset", "hdel", "hincrby", "hincrbyfloat",
+        "hmset", "hset", "hsetnx", "incr", "incrby", "incrbyfloat", "linsert", "lpop", "lpush",
+        "lpushx", "lrem", "lset", "ltrim", "mset", "persist", "pexpire", "pexpireat", "pfadd",
+        "psetex", "restore", "rpop", "rpush", "rpushx", "sadd", "set", "setbit", "setex", "setnx",
+        "setrange", "spop", "srem", "zadd", "zincrby", "touch", "zpopmin", "zpopmax", "zrem",
+        "zremrangebylex", "zremrangebyrank", "zremrangebyscore", "unlink");
+  }
+
+  /**
+   * @return read commands taking a single key, whose response only depends on the value of the key
+   */
+  static const absl::flat_hash_set<std::string>& cacheableCommands() {
+    CONSTRUCT_ON_FIRST_USE(absl::flat_hash_set<std::string>, "get", "hgetall", "hkeys", "hlen",
+                           "hvals", "llen", "scard", "smembers", "strlen", "type", "zcard");
   }
 
   static bool isReadCommand(const std::string& command) {
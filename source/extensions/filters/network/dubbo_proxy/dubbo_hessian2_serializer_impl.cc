@@ -14,6 +14,56 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace DubboProxy {
 
+namespace {
+
+RpcInvocationImpl::AttachmentPtr makeAttachment(Hessian2::ObjectPtr&& result, size_t offset) {
+  if (result != nullptr && result->type() == Hessian2::Object::Type::UntypedMap) {
+    return std::make_unique<RpcInvocationImpl::Attachment>(
+        RpcInvocationImpl::Attachment::MapPtr{
+            dynamic_cast<RpcInvocationImpl::Attachment::Map*>(result.release())},
+        offset);
+  }
+  return std::make_unique<RpcInvocationImpl::Attachment>(
+      std::make_unique<RpcInvocationImpl::Attachment::Map>(), offset);
+}
+
+// Decodes the attachment of a message whose parameters start at the given offset, skipping over
+// the parameters rather than decoding them. Returns nullptr if the parameters cannot be skipped, or
+// if the attachment cannot be decoded on its own, e.g. because it refers to the parameters.
+RpcInvocationImpl::AttachmentPtr decodeAttachmentSkippingParameters(Buffer::Instance& message,
+                                                                    size_t offset) {
+  Hessian2::Decoder types_decoder(std::make_unique<BufferReader>(message, offset));
+  auto types = types_decoder.decode<std::string>();
+  if (types == nullptr) {
+    return nullptr;
+  }
+
+  HessianSkipper skipper(message, types_decoder.offset());
+  const uint32_t number = HessianUtils::getParametersNumber(*types);
+  for (uint32_t i = 0; i < number; i++) {
+    if (!skipper.skipValue()) {
+      return nullptr;
+    }
+  }
+
+  // The attachment is decoded on its own, so it must not refer to anything before it.
+  const size_t attachment_offset = skipper.offset();
+  const uint64_t references = skipper.references();
+  if (attachment_offset < message.length() &&
+      (!skipper.skipValue() || skipper.references() != references)) {
+    return nullptr;
+  }
+
+  Hessian2::Decoder decoder(std::make_unique<BufferReader>(message, attachment_offset));
+  auto result = decoder.decode<Hessian2::Object>();
+  if (result == nullptr && attachment_offset < message.length()) {
+    return nullptr;
+  }
+  return makeAttachment(std::move(result), attachment_offset);
+}
+
+} // namespace
+
 std::pair<RpcInvocationSharedPtr, bool>
 DubboHessian2SerializerImpl::deserializeRpcInvocation(Buffer::Instance& buffer,
                                                       ContextSharedPtr context) {
@@ -61,19 +111,17 @@ DubboHessian2SerializerImpl::deserializeRpcInvocation(Buffer::Instance& buffer,
     return params;
   });
 
-  invo->setAttachmentLazyCallback([delayed_decoder]() -> RpcInvocationImpl::AttachmentPtr {
-    size_t offset = delayed_decoder->offset();
-
-    auto result = delayed_decoder->decode<Hessian2::Object>();
-    if (result != nullptr && result->type() == Hessian2::Object::Type::UntypedMap) {
-      return std::make_unique<RpcInvocationImpl::Attachment>(
-          RpcInvocationImpl::Attachment::MapPtr{
-              dynamic_cast<RpcInvocationImpl::Attachment::Map*>(result.release())},
-          offset);
-    } else {
-      return std::make_unique<RpcInvocationImpl::Attachment>(
-          std::make_unique<RpcInvocationImpl::Attachment::Map>(), offset);
+  // Routing usually only needs the attachment: skip over the parameters to reach it, unless they
+  // have been decoded already. The callback is owned by the invocation, which it may refer to.
+  invo->setAttachmentLazyCallback([delayed_decoder, invocation = invo.get(),
+                                   &message = context->originMessage(),
+                                   parsed_size]() -> RpcInvocationImpl::AttachmentPtr {
+    if (!invocation->hasParameters()) {
+      return decodeAttachmentSkippingParameters(message, parsed_size);
     }
+
+    size_t offset = delayed_decoder->offset();
+    return makeAttachment(delayed_decoder->decode<Hessian2::Object>(), offset);
   });
 
   return std::pair<RpcInvocationSharedPtr, bool>(invo, true);
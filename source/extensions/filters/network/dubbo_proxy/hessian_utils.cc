@@ -55,6 +55,336 @@ uint32_t HessianUtils::getParametersNumber(const std::string& parameters_type) {
   return count;
 }
 
+namespace {
+
+// Deeper values are left to the decoder.
+constexpr uint32_t MaxSkipDepth = 64;
+
+} // namespace
+
+HessianSkipper::HessianSkipper(const Envoy::Buffer::Instance& buffer, uint64_t offset)
+    : slices_(buffer.getRawSlices()), remaining_(buffer.length()) {
+  if (!skipBytes(offset)) {
+    remaining_ = 0;
+  }
+}
+
+// Check http://hessian.caucho.com/doc/hessian-serialization.html for the grammar of the values.
+bool HessianSkipper::skipValue(uint32_t depth) {
+  if (depth > MaxSkipDepth) {
+    return false;
+  }
+
+  uint8_t byte;
+  uint64_t length;
+  int32_t value;
+  // Chunks and class definitions are followed by the rest of the value, which is skipped by the
+  // next iteration rather than recursively, as a message may chain millions of them.
+  for (;;) {
+    uint8_t code;
+    if (!readByte(code)) {
+      return false;
+    }
+    if (code <= 0x1f) {
+      // Compact string.
+      return skipChars(code);
+    }
+    if (code <= 0x2f) {
+      // Compact binary.
+      return skipBytes(code - 0x20);
+    }
+    if (code <= 0x33) {
+      // Compact string.
+      return readByte(byte) && skipChars((static_cast<uint64_t>(code - 0x30) << 8) + byte);
+    }
+    if (code <= 0x37) {
+      // Compact binary.
+      return readByte(byte) && skipBytes((static_cast<uint64_t>(code - 0x34) << 8) + byte);
+    }
+    if (code <= 0x3f) {
+      // Three octet long.
+      return skipBytes(2);
+    }
+    if (code >= 0x60 && code <= 0x6f) {
+      // Compact object instance.
+      const uint64_t definition = code - 0x60;
+      references_++;
+      return definition < class_field_counts_.size() &&
+             skipValues(class_field_counts_[definition], depth);
+    }
+    if (code >= 0x70 && code <= 0x77) {
+      // Compact fixed length typed list.
+      return skipType(depth) && skipValues(code - 0x70, depth);
+    }
+    if (code >= 0x78 && code <= 0x7f) {
+      // Compact fixed length untyped list.
+      return skipValues(code - 0x78, depth);
+    }
+    if (code >= 0x80 && code <= 0xbf) {
+      // One octet int.
+      return true;
+    }
+    if (code >= 0xc0 && code <= 0xcf) {
+      // Two octet int.
+      return skipBytes(1);
+    }
+    if (code >= 0xd0 && code <= 0xd7) {
+      // Three octet int.
+      return skipBytes(2);
+    }
+    if (code >= 0xd8 && code <= 0xef) {
+      // One octet long.
+      return true;
+    }
+    if (code >= 0xf0) {
+      // Two octet long.
+      return skipBytes(1);
+    }
+
+    switch (code) {
+    case 'N':
+    case 'T':
+    case 'F':
+    case 0x5b:
+    case 0x5c:
+      // Null, booleans and the zero and one doubles.
+      return true;
+    case 0x5d:
+      // Byte double.
+      return skipBytes(1);
+    case 0x5e:
+      // Short double.
+      return skipBytes(2);
+    case 'I':
+    case 'K':
+    case 'Y':
+    case 0x5f:
+      // Int, date in minutes, 32-bit long and float double.
+      return skipBytes(4);
+    case 'D':
+    case 'J':
+    case 'L':
+      // Double, date and long.
+      return skipBytes(8);
+    case 'R':
+      // Non-final string chunk, followed by the next chunk.
+      if (!readUInt16(length) || !skipChars(length)) {
+        return false;
+      }
+      continue;
+    case 'S':
+      // Final string chunk.
+      return readUInt16(length) && skipChars(length);
+    case 'A':
+      // Non-final binary chunk, followed by the next chunk.
+      if (!readUInt16(length) || !skipBytes(length)) {
+        return false;
+      }
+      continue;
+    case 'B':
+      // Final binary chunk.
+      return readUInt16(length) && skipBytes(length);
+    case 'C':
+      // Class definition: name, number of fields and field names, followed by a value.
+      if (!skipValue(depth + 1) || !readInt(value) || value < 0 || !skipValues(value, depth)) {
+        return false;
+      }
+      class_field_counts_.push_back(value);
+      continue;
+    case 'O':
+      // Object instance.
+      references_++;
+      return readInt(value) && value >= 0 &&
+             static_cast<uint64_t>(value) < class_field_counts_.size() &&
+             skipValues(class_field_counts_[value], depth);
+    case 'Q':
+      // Reference to a previous value.
+      references_++;
+      return readInt(value);
+    case 'U':
+      // Variable length typed list.
+      return skipType(depth) && skipValuesUntilEnd(depth);
+    case 'V':
+      // Fixed length typed list.
+      return skipType(depth) && readInt(value) && value >= 0 && skipValues(value, depth);
+    case 'W':
+      // Variable length untyped list.
+      return skipValuesUntilEnd(depth);
+    case 'X':
+      // Fixed length untyped list.
+      return readInt(value) && value >= 0 && skipValues(value, depth);
+    case 'M':
+      // Typed map.
+      return skipType(depth) && skipValuesUntilEnd(depth);
+    case 'H':
+      // Untyped map.
+      return skipValuesUntilEnd(depth);
+    default:
+      return false;
+    }
+  }
+}
+
+bool HessianSkipper::skipValues(uint64_t count, uint32_t depth) {
+  // Each value takes one octet at least.
+  if (count > remaining_) {
+    return false;
+  }
+  for (uint64_t i = 0; i < count; i++) {
+    if (!skipValue(depth + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HessianSkipper::skipValuesUntilEnd(uint32_t depth) {
+  uint8_t byte;
+  while (peekByte(byte)) {
+    if (byte == 'Z') {
+      return skipBytes(1);
+    }
+    if (!skipValue(depth + 1)) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool HessianSkipper::skipType(uint32_t depth) {
+  // A type is either a string, or a reference to a previous type.
+  uint8_t byte;
+  if (!peekByte(byte)) {
+    return false;
+  }
+  if (byte <= 0x1f || (byte >= 0x30 && byte <= 0x33) || byte == 'R' || byte == 'S') {
+    return skipValue(depth + 1);
+  }
+  references_++;
+  int32_t value;
+  return readInt(value);
+}
+
+bool HessianSkipper::skipChars(uint64_t count) {
+  // Strings are encoded in UTF-8, and their length counted in characters.
+  while (count > 0) {
+    uint8_t byte;
+    if (!readByte(byte)) {
+      return false;
+    }
+    if (byte < 0x80) {
+      count--;
+    } else if (byte < 0xc0) {
+      return false;
+    } else if (byte < 0xe0) {
+      count--;
+      if (!skipBytes(1)) {
+        return false;
+      }
+    } else if (byte < 0xf0) {
+      count--;
+      if (!skipBytes(2)) {
+        return false;
+      }
+    } else {
+      // Java encodes supplementary characters as surrogate pairs, while other encoders may count
+      // them as one character: leave them to the decoder.
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HessianSkipper::skipBytes(uint64_t length) {
+  if (length > remaining_) {
+    return false;
+  }
+  remaining_ -= length;
+  offset_ += length;
+  while (length > 0) {
+    const uint64_t available = slices_[slice_index_].len_ - slice_offset_;
+    if (length < available) {
+      slice_offset_ += length;
+      break;
+    }
+    length -= available;
+    slice_index_++;
+    slice_offset_ = 0;
+  }
+  return true;
+}
+
+bool HessianSkipper::readInt(int32_t& value) {
+  uint8_t code;
+  if (!readByte(code)) {
+    return false;
+  }
+
+  uint8_t bytes[4];
+  if (code >= 0x80 && code <= 0xbf) {
+    value = code - 0x90;
+    return true;
+  }
+  if (code >= 0xc0 && code <= 0xcf) {
+    if (!readByte(bytes[0])) {
+      return false;
+    }
+    value = (code - 0xc8) * 0x100 + bytes[0];
+    return true;
+  }
+  if (code >= 0xd0 && code <= 0xd7) {
+    if (!readByte(bytes[0]) || !readByte(bytes[1])) {
+      return false;
+    }
+    value = (code - 0xd4) * 0x10000 + bytes[0] * 0x100 + bytes[1];
+    return true;
+  }
+  if (code == 'I') {
+    for (uint8_t& byte : bytes) {
+      if (!readByte(byte)) {
+        return false;
+      }
+    }
+    value = static_cast<int32_t>((static_cast<uint32_t>(bytes[0]) << 24) |
+                                 (static_cast<uint32_t>(bytes[1]) << 16) |
+                                 (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3]);
+    return true;
+  }
+  return false;
+}
+
+bool HessianSkipper::readUInt16(uint64_t& value) {
+  uint8_t high;
+  uint8_t low;
+  if (!readByte(high) || !readByte(low)) {
+    return false;
+  }
+  value = (static_cast<uint64_t>(high) << 8) + low;
+  return true;
+}
+
+bool HessianSkipper::readByte(uint8_t& byte) {
+  if (!peekByte(byte)) {
+    return false;
+  }
+  remaining_--;
+  offset_++;
+  slice_offset_++;
+  return true;
+}
+
+bool HessianSkipper::peekByte(uint8_t& byte) {
+  if (remaining_ == 0) {
+    return false;
+  }
+  while (slice_offset_ == slices_[slice_index_].len_) {
+    slice_index_++;
+    slice_offset_ = 0;
+  }
+  byte = static_cast<const uint8_t*>(slices_[slice_index_].mem_)[slice_offset_];
+  return true;
+}
+
 void BufferWriter::rawWrite(const void* data, uint64_t size) { buffer_.add(data, size); }
 
 void BufferWriter::rawWrite(absl::string_view data) { buffer_.add(data); }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 
@@ -21,6 +22,60 @@ public:
   static uint32_t getParametersNumber(const std::string& parameters_type);
 };
 
+/**
+ * Walks over Hessian2 encoded values in a buffer without decoding them, to find where they end
+ * without copying or allocating them. Class definitions are tracked across the values skipped by
+ * the same instance, as they are by a decoder.
+ */
+class HessianSkipper {
+public:
+  /**
+   * @param buffer supplies the buffer holding the values, which must outlive the skipper and not
+   *        be modified while it is in use.
+   * @param offset supplies the offset of the first value in the buffer.
+   */
+  HessianSkipper(const Envoy::Buffer::Instance& buffer, uint64_t offset);
+
+  /**
+   * Skips the next value.
+   * @return false if the value is malformed, incomplete or nested too deeply, in which case the
+   *         skipper must not be used anymore.
+   */
+  bool skipValue() { return skipValue(0); }
+
+  /**
+   * @return the offset in the buffer of the next value.
+   */
+  uint64_t offset() const { return offset_; }
+
+  /**
+   * @return the number of references to previous values, class definitions or types skipped so
+   *         far, which a decoder can only resolve if it decoded everything they refer to.
+   */
+  uint64_t references() const { return references_; }
+
+private:
+  bool skipValue(uint32_t depth);
+  bool skipValues(uint64_t count, uint32_t depth);
+  bool skipValuesUntilEnd(uint32_t depth);
+  bool skipType(uint32_t depth);
+  bool skipChars(uint64_t count);
+  bool skipBytes(uint64_t length);
+  bool readInt(int32_t& value);
+  bool readUInt16(uint64_t& value);
+  bool readByte(uint8_t& byte);
+  bool peekByte(uint8_t& byte);
+
+  const Envoy::Buffer::RawSliceVector slices_;
+  uint64_t slice_index_{};
+  uint64_t slice_offset_{};
+  uint64_t offset_{};
+  uint64_t remaining_;
+  uint64_t references_{};
+  // The number of fields of the classes defined so far, by reference.
+  std::vector<uint64_t> class_field_counts_;
+};
+
 class BufferWriter : public Hessian2::Writer {
 public:
   BufferWriter(Envoy::Buffer::Instance& buffer) : buffer_(buffer) {}
@@ -66,8 +66,14 @@ void RpcInvocationImpl::assignAttachmentIfNeed() const {
     return;
   }
 
-  assignParametersIfNeed();
+  // The callback may skip over the parameters to decode the attachment. It returns nullptr if it
+  // cannot, in which case the parameters are decoded first.
   attachment_ = attachment_lazy_callback_();
+  if (attachment_ == nullptr) {
+    assignParametersIfNeed();
+    attachment_ = attachment_lazy_callback_();
+  }
+  ASSERT(attachment_ != nullptr);
 
   if (auto g = attachment_->lookup("group"); g != nullptr) {
     const_cast<RpcInvocationImpl*>(this)->group_ = *g;
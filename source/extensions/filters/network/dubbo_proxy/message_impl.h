@@ -95,6 +95,7 @@ public:
   };
   using AttachmentPtr = std::unique_ptr<Attachment>;
 
+  // May return nullptr if the attachment can only be decoded once the parameters have been.
   using AttachmentLazyCallback = std::function<AttachmentPtr()>;
   using ParametersLazyCallback = std::function<ParametersPtr()>;
 
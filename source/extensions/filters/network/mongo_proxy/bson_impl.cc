@@ -1,9 +1,11 @@
 #include "source/extensions/filters/network/mongo_proxy/bson_impl.h"
 
 #include <cstdint>
+#include <cstring>
 #include <sstream>
 #include <string>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/byte_order.h"
 #include "source/common/common/fmt.h"
@@ -401,108 +403,99 @@ void DocumentImpl::fromBuffer(Buffer::Instance& data) {
     const uint8_t element_type = BufferHelper::removeByte(data);
     const std::string key = BufferHelper::removeCString(data);
     ENVOY_LOG(trace, "BSON element type: {:#x} key: {}", element_type, key);
-    switch (static_cast<Field::Type>(element_type)) {
-    case Field::Type::Double: {
-      double value = BufferHelper::removeDouble(data);
-      ENVOY_LOG(trace, "BSON double: {}", value);
-      addDouble(key, value);
-      break;
-    }
+    fields_.push_back(fieldFromBuffer(element_type, key, data));
+  }
+}
 
-    case Field::Type::String: {
-      std::string value = BufferHelper::removeString(data);
-      ENVOY_LOG(trace, "BSON string: {}", value);
-      addString(key, std::move(value));
-      break;
-    }
+FieldPtr DocumentImpl::fieldFromBuffer(uint8_t element_type, const std::string& key,
+                                       Buffer::Instance& data) {
+  switch (static_cast<Field::Type>(element_type)) {
+  case Field::Type::Double: {
+    double value = BufferHelper::removeDouble(data);
+    ENVOY_LOG(trace, "BSON double: {}", value);
+    return std::make_unique<FieldImpl>(key, value);
+  }
 
-    case Field::Type::Symbol: {
-      std::string value = BufferHelper::removeString(data);
-      ENVOY_LOG(trace, "BSON symbol: {}", value);
-      addSymbol(key, std::move(value));
-      break;
-    }
+  case Field::Type::String: {
+    std::string value = BufferHelper::removeString(data);
+    ENVOY_LOG(trace, "BSON string: {}", value);
+    return std::make_unique<FieldImpl>(Field::Type::String, key, std::move(value));
+  }
 
-    case Field::Type::Document: {
-      ENVOY_LOG(trace, "BSON document");
-      addDocument(key, DocumentImpl::create(data));
-      break;
-    }
+  case Field::Type::Symbol: {
+    std::string value = BufferHelper::removeString(data);
+    ENVOY_LOG(trace, "BSON symbol: {}", value);
+    return std::make_unique<FieldImpl>(Field::Type::Symbol, key, std::move(value));
+  }
 
-    case Field::Type::Array: {
-      ENVOY_LOG(trace, "BSON array");
-      addArray(key, DocumentImpl::create(data));
-      break;
-    }
+  case Field::Type::Document: {
+    ENVOY_LOG(trace, "BSON document");
+    return std::make_unique<FieldImpl>(Field::Type::Document, key, DocumentImpl::create(data));
+  }
 
-    case Field::Type::Binary: {
-      std::string value = BufferHelper::removeBinary(data);
-      ENVOY_LOG(trace, "BSON binary: {}", value);
-      addBinary(key, std::move(value));
-      break;
-    }
+  case Field::Type::Array: {
+    ENVOY_LOG(trace, "BSON array");
+    return std::make_unique<FieldImpl>(Field::Type::Array, key, DocumentImpl::create(data));
+  }
 
-    case Field::Type::ObjectId: {
-      Field::ObjectId value;
-      BufferHelper::removeBytes(data, &value[0], value.size());
-      addObjectId(key, std::move(value));
-      break;
-    }
+  case Field::Type::Binary: {
+    std::string value = BufferHelper::removeBinary(data);
+    ENVOY_LOG(trace, "BSON binary: {}", value);
+    return std::make_unique<FieldImpl>(Field::Type::Binary, key, std::move(value));
+  }
 
-    case Field::Type::Boolean: {
-      const bool value = BufferHelper::removeByte(data) != 0;
-      ENVOY_LOG(trace, "BSON boolean: {}", value);
-      addBoolean(key, value);
-      break;
-    }
+  case Field::Type::ObjectId: {
+    Field::ObjectId value;
+    BufferHelper::removeBytes(data, &value[0], value.size());
+    return std::make_unique<FieldImpl>(key, std::move(value));
+  }
 
-    case Field::Type::Datetime: {
-      const int64_t value = BufferHelper::removeInt64(data);
-      ENVOY_LOG(trace, "BSON datetime: {}", value);
-      addDatetime(key, value);
-      break;
-    }
+  case Field::Type::Boolean: {
+    const bool value = BufferHelper::removeByte(data) != 0;
+    ENVOY_LOG(trace, "BSON boolean: {}", value);
+    return std::make_unique<FieldImpl>(key, value);
+  }
 
-    case Field::Type::NullValue: {
-      ENVOY_LOG(trace, "BSON null value");
-      addNull(key);
-      break;
-    }
+  case Field::Type::Datetime: {
+    const int64_t value = BufferHelper::removeInt64(data);
+    ENVOY_LOG(trace, "BSON datetime: {}", value);
+    return std::make_unique<FieldImpl>(Field::Type::Datetime, key, value);
+  }
 
-    case Field::Type::Regex: {
-      Field::Regex value;
-      value.pattern_ = BufferHelper::removeCString(data);
-      value.options_ = BufferHelper::removeCString(data);
-      ENVOY_LOG(trace, "BSON regex pattern: {} options: {}", value.pattern_, value.options_);
-      addRegex(key, std::move(value));
-      break;
-    }
+  case Field::Type::NullValue: {
+    ENVOY_LOG(trace, "BSON null value");
+    return std::make_unique<FieldImpl>(key);
+  }
 
-    case Field::Type::Int32: {
-      const int32_t value = BufferHelper::removeInt32(data);
-      ENVOY_LOG(trace, "BSON int32: {}", value);
-      addInt32(key, value);
-      break;
-    }
+  case Field::Type::Regex: {
+    Field::Regex value;
+    value.pattern_ = BufferHelper::removeCString(data);
+    value.options_ = BufferHelper::removeCString(data);
+    ENVOY_LOG(trace, "BSON regex pattern: {} options: {}", value.pattern_, value.options_);
+    return std::make_unique<FieldImpl>(key, std::move(value));
+  }
 
-    case Field::Type::Timestamp: {
-      const int64_t value = BufferHelper::removeInt64(data);
-      ENVOY_LOG(trace, "BSON timestamp: {}", value);
-      addTimestamp(key, value);
-      break;
-    }
+  case Field::Type::Int32: {
+    const int32_t value = BufferHelper::removeInt32(data);
+    ENVOY_LOG(trace, "BSON int32: {}", value);
+    return std::make_unique<FieldImpl>(key, value);
+  }
 
-    case Field::Type::Int64: {
-      const int64_t value = BufferHelper::removeInt64(data);
-      ENVOY_LOG(trace, "BSON int64: {}", value);
-      addInt64(key, value);
-      break;
-    }
+  case Field::Type::Timestamp: {
+    const int64_t value = BufferHelper::removeInt64(data);
+    ENVOY_LOG(trace, "BSON timestamp: {}", value);
+    return std::make_unique<FieldImpl>(Field::Type::Timestamp, key, value);
+  }
 
-    default:
-      throw EnvoyException(
-          fmt::format("invalid BSON element type: {:#x} key: {}", element_type, key));
-    }
+  case Field::Type::Int64: {
+    const int64_t value = BufferHelper::removeInt64(data);
+    ENVOY_LOG(trace, "BSON int64: {}", value);
+    return std::make_unique<FieldImpl>(Field::Type::Int64, key, value);
+  }
+
+  default:
+    throw EnvoyException(
+        fmt::format("invalid BSON element type: {:#x} key: {}", element_type, key));
   }
 }
 
@@ -580,6 +573,195 @@ const Field* DocumentImpl::find(const std::string& name, Field::Type type) const
   return nullptr;
 }
 
+namespace {
+
+/**
+ * Walks the elements of a linearized BSON document without decoding their values.
+ */
+class ElementIterator {
+public:
+  ElementIterator(const uint8_t* data, int32_t length) : data_(data), length_(length) {}
+
+  /**
+   * Moves to the next element.
+   * @return bool false at the end of the document.
+   */
+  bool next() {
+    offset_ = next_offset_;
+    // Although mongo_proxy traffic is trusted, do a minimal check.
+    if (offset_ >= length_) {
+      throw EnvoyException("invalid document");
+    }
+    if (offset_ == length_ - 1) {
+      if (data_[offset_] != 0) {
+        throw EnvoyException("invalid document");
+      }
+
+      return false;
+    }
+
+    type_ = data_[offset_];
+    const uint64_t key_offset = offset_ + 1;
+    const uint64_t key_end = cStringEnd(key_offset);
+    key_ = absl::string_view(reinterpret_cast<const char*>(data_ + key_offset),
+                             key_end - key_offset);
+    value_offset_ = key_end + 1;
+    next_offset_ = value_offset_ + elementValueSize();
+    // The value has to be followed by either another element or the terminating null byte.
+    if (next_offset_ >= length_) {
+      throw EnvoyException("invalid document");
+    }
+
+    return true;
+  }
+
+  uint8_t type() const { return type_; }
+  absl::string_view key() const { return key_; }
+  uint64_t offset() const { return offset_; }
+  uint64_t valueOffset() const { return value_offset_; }
+  uint64_t valueSize() const { return next_offset_ - value_offset_; }
+
+private:
+  uint64_t cStringEnd(uint64_t offset) const {
+    const void* end = offset < length_ ? memchr(data_ + offset, 0, length_ - offset) : nullptr;
+    if (end == nullptr) {
+      throw EnvoyException("invalid document");
+    }
+
+    return static_cast<const uint8_t*>(end) - data_;
+  }
+
+  uint64_t int32At(uint64_t offset) const {
+    if (offset + sizeof(int32_t) > length_) {
+      throw EnvoyException("invalid buffer size");
+    }
+
+    int32_t value;
+    memcpy(&value, data_ + offset, sizeof(value));
+    value = le32toh(value);
+    if (value < 0) {
+      throw EnvoyException("invalid buffer size");
+    }
+
+    return value;
+  }
+
+  uint64_t elementValueSize() const {
+    switch (static_cast<Field::Type>(type_)) {
+    case Field::Type::Double:
+    case Field::Type::Datetime:
+    case Field::Type::Timestamp:
+    case Field::Type::Int64:
+      return sizeof(int64_t);
+    case Field::Type::Int32:
+      return sizeof(int32_t);
+    case Field::Type::Boolean:
+      return 1;
+    case Field::Type::NullValue:
+      return 0;
+    case Field::Type::ObjectId:
+      return sizeof(Field::ObjectId);
+    case Field::Type::String:
+    case Field::Type::Symbol:
+      return sizeof(int32_t) + int32At(value_offset_);
+    case Field::Type::Binary:
+      // The length does not include the subtype.
+      return sizeof(int32_t) + 1 + int32At(value_offset_);
+    case Field::Type::Document:
+    case Field::Type::Array:
+      return int32At(value_offset_);
+    case Field::Type::Regex:
+      return cStringEnd(cStringEnd(value_offset_) + 1) + 1 - value_offset_;
+    default:
+      throw EnvoyException(fmt::format("invalid BSON element type: {:#x} key: {}", type_, key_));
+    }
+  }
+
+  const uint8_t* const data_;
+  const uint64_t length_;
+  uint64_t offset_{};
+  uint64_t next_offset_{sizeof(int32_t)};
+  uint64_t value_offset_{};
+  uint8_t type_{};
+  absl::string_view key_;
+};
+
+} // namespace
+
+DocumentSharedPtr DocumentView::create(Buffer::Instance& data) {
+  const int32_t length = BufferHelper::peekInt32(data);
+  if (length <= 0 || static_cast<uint64_t>(length) > data.length()) {
+    throw EnvoyException("invalid BSON message length");
+  }
+
+  auto storage = std::make_shared<Buffer::OwnedImpl>();
+  storage->move(data, length);
+  uint64_t offset = 0;
+  return create(storage, offset);
+}
+
+DocumentSharedPtr DocumentView::create(const std::shared_ptr<Buffer::Instance>& storage,
+                                       uint64_t& offset) {
+  const int32_t length = storage->peekLEInt<int32_t>(offset);
+  // The smallest document is its length and the terminating null byte.
+  if (length < static_cast<int32_t>(sizeof(int32_t) + 1) ||
+      static_cast<uint64_t>(length) > storage->length() - offset) {
+    throw EnvoyException("invalid BSON message length");
+  }
+
+  ENVOY_LOG(trace, "BSON document view offset: {} length: {}", offset, length);
+  DocumentSharedPtr view{new DocumentView(storage, offset, length)};
+  offset += length;
+  return view;
+}
+
+const uint8_t* DocumentView::data() const {
+  // Documents are only linearized when they are actually looked into. Linearizing the storage
+  // once makes it contiguous for every view sharing it.
+  return static_cast<const uint8_t*>(storage_->linearize(storage_->length())) + offset_;
+}
+
+const Document& DocumentView::document() const {
+  if (document_ == nullptr) {
+    Buffer::OwnedImpl copy(data(), length_);
+    document_ = DocumentImpl::create(copy);
+  }
+
+  return *document_;
+}
+
+const Field* DocumentView::findField(const std::string& name,
+                                     absl::optional<Field::Type> type) const {
+  if (document_ != nullptr) {
+    return type.has_value() ? document_->find(name, type.value()) : document_->find(name);
+  }
+
+  ElementIterator element(data(), length_);
+  while (element.next()) {
+    if (element.key() != name ||
+        (type.has_value() && element.type() != static_cast<uint8_t>(type.value()))) {
+      continue;
+    }
+
+    FieldPtr& field = found_fields_[element.offset()];
+    if (field == nullptr) {
+      const std::string key(element.key());
+      const Field::Type element_type = static_cast<Field::Type>(element.type());
+      if (element_type == Field::Type::Document || element_type == Field::Type::Array) {
+        uint64_t offset = offset_ + element.valueOffset();
+        field = std::make_unique<FieldImpl>(element_type, key, create(storage_, offset));
+      } else {
+        Buffer::OwnedImpl value(data() + element.valueOffset(), element.valueSize());
+        field = DocumentImpl::fieldFromBuffer(element.type(), key, value);
+      }
+    }
+
+    return field.get();
+  }
+
+  return nullptr;
+}
+
 } // namespace Bson
 } // namespace MongoProxy
 } // namespace NetworkFilters
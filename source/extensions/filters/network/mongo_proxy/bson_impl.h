@@ -11,6 +11,9 @@
 #include "source/common/common/utility.h"
 #include "source/extensions/filters/network/mongo_proxy/bson.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -188,6 +191,16 @@ public:
     return new_doc;
   }
 
+  /**
+   * Decodes the value of an element from the front of data.
+   * @param element_type supplies the BSON type of the element.
+   * @param key supplies the key of the element.
+   * @param data supplies the buffer to remove the value from.
+   * @return FieldPtr the decoded field.
+   */
+  static FieldPtr fieldFromBuffer(uint8_t element_type, const std::string& key,
+                                  Buffer::Instance& data);
+
   // Mongo::Document
   DocumentSharedPtr addDouble(const std::string& key, double value) override {
     fields_.emplace_back(new FieldImpl(key, value));
@@ -275,6 +288,79 @@ private:
   std::list<FieldPtr> fields_;
 };
 
+/**
+ * A read-only document over the raw bytes of a decoded BSON document. Nothing is parsed when the
+ * view is created: byteSize() and encode() use the bytes as they are, find() only decodes the top
+ * level fields it matches, and embedded documents found that way are views over the same bytes.
+ * values(), toString() and operator== decode the whole document on first use.
+ */
+class DocumentView : public Document, Logger::Loggable<Logger::Id::mongo> {
+public:
+  /**
+   * Creates a view over the document at the front of data, moving its bytes out of data.
+   */
+  static DocumentSharedPtr create(Buffer::Instance& data);
+
+  /**
+   * Creates a view over the document at offset in storage, which the views of the other
+   * documents of a message may share.
+   * @param storage supplies the bytes of the documents.
+   * @param offset supplies the offset of the document, and is advanced past its end.
+   */
+  static DocumentSharedPtr create(const std::shared_ptr<Buffer::Instance>& storage,
+                                  uint64_t& offset);
+
+  // Mongo::Document
+  DocumentSharedPtr addDouble(const std::string&, double) override { throwReadOnly(); }
+  DocumentSharedPtr addString(const std::string&, std::string&&) override { throwReadOnly(); }
+  DocumentSharedPtr addSymbol(const std::string&, std::string&&) override { throwReadOnly(); }
+  DocumentSharedPtr addDocument(const std::string&, DocumentSharedPtr) override {
+    throwReadOnly();
+  }
+  DocumentSharedPtr addArray(const std::string&, DocumentSharedPtr) override { throwReadOnly(); }
+  DocumentSharedPtr addBinary(const std::string&, std::string&&) override { throwReadOnly(); }
+  DocumentSharedPtr addObjectId(const std::string&, Field::ObjectId&&) override {
+    throwReadOnly();
+  }
+  DocumentSharedPtr addBoolean(const std::string&, bool) override { throwReadOnly(); }
+  DocumentSharedPtr addDatetime(const std::string&, int64_t) override { throwReadOnly(); }
+  DocumentSharedPtr addNull(const std::string&) override { throwReadOnly(); }
+  DocumentSharedPtr addRegex(const std::string&, Field::Regex&&) override { throwReadOnly(); }
+  DocumentSharedPtr addInt32(const std::string&, int32_t) override { throwReadOnly(); }
+  DocumentSharedPtr addTimestamp(const std::string&, int64_t) override { throwReadOnly(); }
+  DocumentSharedPtr addInt64(const std::string&, int64_t) override { throwReadOnly(); }
+
+  bool operator==(const Document& rhs) const override { return document() == rhs; }
+  int32_t byteSize() const override { return length_; }
+  void encode(Buffer::Instance& output) const override { output.add(data(), length_); }
+  const Field* find(const std::string& name) const override { return findField(name, {}); }
+  const Field* find(const std::string& name, Field::Type type) const override {
+    return findField(name, type);
+  }
+  std::string toString() const override { return document().toString(); }
+  const std::list<FieldPtr>& values() const override { return document().values(); }
+
+private:
+  DocumentView(std::shared_ptr<Buffer::Instance> storage, uint64_t offset, int32_t length)
+      : storage_(std::move(storage)), offset_(offset), length_(length) {}
+
+  [[noreturn]] static void throwReadOnly() {
+    ExceptionUtil::throwEnvoyException("BSON document view is read-only");
+  }
+
+  const uint8_t* data() const;
+  const Document& document() const;
+  const Field* findField(const std::string& name, absl::optional<Field::Type> type) const;
+
+  // The bytes of the document, shared with the views of the documents embedded in it.
+  const std::shared_ptr<Buffer::Instance> storage_;
+  const uint64_t offset_;
+  const int32_t length_;
+  // The fields decoded by find(), keyed by their offset in the document.
+  mutable absl::flat_hash_map<uint64_t, FieldPtr> found_fields_;
+  mutable DocumentSharedPtr document_;
+};
+
 } // namespace Bson
 } // namespace MongoProxy
 } // namespace NetworkFilters
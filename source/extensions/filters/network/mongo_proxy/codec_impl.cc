@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/exception.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/extensions/filters/network/mongo_proxy/bson_impl.h"
@@ -17,6 +18,26 @@ namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
 namespace MongoProxy {
+namespace {
+
+/**
+ * Moves the documents that end a message out of the decode buffer, for the document views of the
+ * message to share.
+ * @param data supplies the decode buffer.
+ * @param message_end supplies the number of bytes in data past the end of the message.
+ * @return the documents of the message.
+ */
+std::shared_ptr<Buffer::Instance> removeDocuments(Buffer::Instance& data, uint64_t message_end) {
+  if (data.length() < message_end) {
+    throw EnvoyException("invalid mongo message length");
+  }
+
+  auto documents = std::make_shared<Buffer::OwnedImpl>();
+  documents->move(data, data.length() - message_end);
+  return documents;
+}
+
+} // namespace
 
 std::string
 MessageImpl::documentListToString(const std::list<Bson::DocumentSharedPtr>& documents) const {
@@ -66,8 +87,10 @@ void InsertMessageImpl::fromBuffer(uint32_t message_length, Buffer::Instance& da
 
   flags_ = Bson::BufferHelper::removeInt32(data);
   full_collection_name_ = Bson::BufferHelper::removeCString(data);
-  while (data.length() - (original_buffer_length - message_length) > 0) {
-    documents_.emplace_back(Bson::DocumentImpl::create(data));
+  const auto documents = removeDocuments(data, original_buffer_length - message_length);
+  uint64_t offset = 0;
+  while (offset < documents->length()) {
+    documents_.emplace_back(Bson::DocumentView::create(documents, offset));
   }
 
   ENVOY_LOG(trace, "{}", toString(true));
@@ -141,10 +164,12 @@ void QueryMessageImpl::fromBuffer(uint32_t message_length, Buffer::Instance& dat
   full_collection_name_ = Bson::BufferHelper::removeCString(data);
   number_to_skip_ = Bson::BufferHelper::removeInt32(data);
   number_to_return_ = Bson::BufferHelper::removeInt32(data);
-  query_ = Bson::DocumentImpl::create(data);
+  const auto documents = removeDocuments(data, original_buffer_length - message_length);
+  uint64_t offset = 0;
+  query_ = Bson::DocumentView::create(documents, offset);
 
-  if (data.length() - (original_buffer_length - message_length) > 0) {
-    return_fields_selector_ = Bson::DocumentImpl::create(data);
+  if (offset < documents->length()) {
+    return_fields_selector_ = Bson::DocumentView::create(documents, offset);
   }
 
   ENVOY_LOG(trace, "{}", toString(true));
@@ -182,14 +207,19 @@ std::string QueryMessageImpl::toString(bool full) const {
       return_fields_selector_ ? return_fields_selector_->toString() : "{}");
 }
 
-void ReplyMessageImpl::fromBuffer(uint32_t, Buffer::Instance& data) {
+void ReplyMessageImpl::fromBuffer(uint32_t message_length, Buffer::Instance& data) {
   ENVOY_LOG(trace, "decoding reply message");
+  const uint64_t original_buffer_length = data.length();
+  ASSERT(message_length <= original_buffer_length);
+
   flags_ = Bson::BufferHelper::removeInt32(data);
   cursor_id_ = Bson::BufferHelper::removeInt64(data);
   starting_from_ = Bson::BufferHelper::removeInt32(data);
   number_returned_ = Bson::BufferHelper::removeInt32(data);
+  const auto documents = removeDocuments(data, original_buffer_length - message_length);
+  uint64_t offset = 0;
   for (int32_t i = 0; i < number_returned_; i++) {
-    documents_.emplace_back(Bson::DocumentImpl::create(data));
+    documents_.emplace_back(Bson::DocumentView::create(documents, offset));
   }
 
   ENVOY_LOG(trace, "{}", toString(true));
@@ -231,14 +261,16 @@ void CommandMessageImpl::fromBuffer(uint32_t message_length, Buffer::Instance& d
 
   database_ = Bson::BufferHelper::removeCString(data);
   command_name_ = Bson::BufferHelper::removeCString(data);
-  metadata_ = Bson::DocumentImpl::create(data);
-  command_args_ = Bson::DocumentImpl::create(data);
-
-  // There may be additional docs.
   // message_length is mongo message length. original_data_length contains
   // mongo message and possibly first few bytes of next message.
-  while (data.length() - (original_data_length - message_length) > 0) {
-    input_docs_.emplace_back(Bson::DocumentImpl::create(data));
+  const auto documents = removeDocuments(data, original_data_length - message_length);
+  uint64_t offset = 0;
+  metadata_ = Bson::DocumentView::create(documents, offset);
+  command_args_ = Bson::DocumentView::create(documents, offset);
+
+  // There may be additional docs.
+  while (offset < documents->length()) {
+    input_docs_.emplace_back(Bson::DocumentView::create(documents, offset));
   }
 
   ENVOY_LOG(trace, "{}", toString(true));
@@ -291,14 +323,16 @@ void CommandReplyMessageImpl::fromBuffer(uint32_t message_length, Buffer::Instan
   const uint64_t original_data_length = data.length();
   ASSERT(data.length() >= message_length); // See comment below about relationship.
 
-  metadata_ = Bson::DocumentImpl::create(data);
-  command_reply_ = Bson::DocumentImpl::create(data);
-
-  // There may be additional docs.
   // message_length is mongo message length. original_data_length contains
   // mongo message and possibly first few bytes of next message.
-  while (data.length() - (original_data_length - message_length) > 0) {
-    output_docs_.emplace_back(Bson::DocumentImpl::create(data));
+  const auto documents = removeDocuments(data, original_data_length - message_length);
+  uint64_t offset = 0;
+  metadata_ = Bson::DocumentView::create(documents, offset);
+  command_reply_ = Bson::DocumentView::create(documents, offset);
+
+  // There may be additional docs.
+  while (offset < documents->length()) {
+    output_docs_.emplace_back(Bson::DocumentView::create(documents, offset));
   }
 
   ENVOY_LOG(trace, "{}", toString(true));
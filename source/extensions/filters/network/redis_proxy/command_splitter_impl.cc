@@ -150,6 +150,13 @@ void DelayFaultRequest::onDelayResponse() {
 
 void DelayFaultRequest::cancel() { delay_timer_->disableTimer(); }
 
+void HotKeyCacheFillRequest::onResponse(Common::Redis::RespValuePtr&& response) {
+  if (response->type() != Common::Redis::RespType::Error) {
+    cache_.fill(command_, key_, fill_id_, *response);
+  }
+  callbacks_.onResponse(std::move(response));
+}
+
 SplitRequestPtr SimpleRequest::create(Router& router,
                                       Common::Redis::RespValuePtr&& incoming_request,
                                       SplitCallbacks& callbacks, CommandStats& command_stats,
@@ -538,13 +545,15 @@ SplitRequestPtr TransactionRequest::create(Router& router,
 
 InstanceImpl::InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                            TimeSource& time_source, bool latency_in_micros,
-                           Common::Redis::FaultManagerPtr&& fault_manager)
+                           Common::Redis::FaultManagerPtr&& fault_manager,
+                           HotKeyCacheSharedPtr hot_key_cache)
     : router_(std::move(router)), simple_command_handler_(*router_),
       eval_command_handler_(*router_), mget_handler_(*router_), mset_handler_(*router_),
       split_keys_sum_result_handler_(*router_),
       transaction_handler_(*router_), stats_{ALL_COMMAND_SPLITTER_STATS(
                                           POOL_COUNTER_PREFIX(scope, stat_prefix + "splitter."))},
-      time_source_(time_source), fault_manager_(std::move(fault_manager)) {
+      time_source_(time_source), fault_manager_(std::move(fault_manager)),
+      hot_key_cache_(std::move(hot_key_cache)) {
   for (const std::string& command : Common::Redis::SupportedCommands::simpleCommands()) {
     addHandler(scope, stat_prefix, command, latency_in_micros, simple_command_handler_);
   }
@@ -644,6 +653,29 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   // Fault Injection Check
   const Common::Redis::Fault* fault_ptr = fault_manager_->getFaultForCommand(command_name);
 
+  // Answer cached read commands from the hot key cache, and have the responses of the ones which
+  // miss cached on their way back.
+  std::unique_ptr<HotKeyCacheFillRequest> cache_fill_ptr;
+  if (hot_key_cache_ != nullptr) {
+    hot_key_cache_->invalidate(command_name, *request);
+    const absl::optional<uint32_t> cached_command = hot_key_cache_->commandIndex(command_name);
+    if (cached_command.has_value() && request->asArray().size() == 2 && fault_ptr == nullptr &&
+        !callbacks.transaction().active_) {
+      const std::string& key = request->asArray()[1].asString();
+      uint64_t fill_id;
+      Common::Redis::RespValuePtr response =
+          hot_key_cache_->lookup(cached_command.value(), key, fill_id);
+      if (response != nullptr) {
+        handler->command_stats_.total_.inc();
+        handler->command_stats_.success_.inc();
+        callbacks.onResponse(std::move(response));
+        return nullptr;
+      }
+      cache_fill_ptr = std::make_unique<HotKeyCacheFillRequest>(
+          callbacks, *hot_key_cache_, cached_command.value(), key, fill_id);
+    }
+  }
+
   // Check if delay, which determines which callbacks to use. If a delay fault is enabled,
   // the delay fault itself wraps the request (or other fault) and the delay fault itself
   // implements the callbacks functions, and in turn calls the real callbacks after injecting
@@ -667,6 +699,15 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   if (fault_ptr != nullptr && fault_ptr->faultType() == Common::Redis::FaultType::Error) {
     request_ptr = ErrorFaultRequest::create(has_delay_fault ? *delay_fault_ptr : callbacks,
                                             handler->command_stats_, time_source_, has_delay_fault);
+  } else if (cache_fill_ptr != nullptr) {
+    // The request is not subject to faults.
+    request_ptr = handler->handler_.get().startRequest(
+        std::move(request), *cache_fill_ptr, handler->command_stats_, time_source_, false);
+    if (request_ptr == nullptr) {
+      return nullptr;
+    }
+    cache_fill_ptr->wrapped_request_ptr_ = std::move(request_ptr);
+    return cache_fill_ptr;
   } else {
     request_ptr = handler->handler_.get().startRequest(
         std::move(request), has_delay_fault ? *delay_fault_ptr : callbacks, handler->command_stats_,
@@ -16,6 +16,7 @@
 #include "source/extensions/filters/network/common/redis/utility.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
+#include "source/extensions/filters/network/redis_proxy/hot_key_cache.h"
 #include "source/extensions/filters/network/redis_proxy/router.h"
 
 namespace Envoy {
@@ -168,6 +169,39 @@ private:
   Common::Redis::RespValuePtr response_;
 };
 
+/**
+ * HotKeyCacheFillRequest wraps a request which missed the hot key cache, and caches its response
+ * on the way to the downstream.
+ */
+class HotKeyCacheFillRequest : public SplitRequest, public SplitCallbacks {
+public:
+  HotKeyCacheFillRequest(SplitCallbacks& callbacks, HotKeyCache& cache, uint32_t command,
+                         const std::string& key, uint64_t fill_id)
+      : callbacks_(callbacks), cache_(cache), command_(command), key_(key), fill_id_(fill_id) {}
+
+  // SplitCallbacks
+  bool connectionAllowed() override { return callbacks_.connectionAllowed(); }
+  void onQuit() override { callbacks_.onQuit(); }
+  void onAuth(const std::string& password) override { callbacks_.onAuth(password); }
+  void onAuth(const std::string& username, const std::string& password) override {
+    callbacks_.onAuth(username, password);
+  }
+  void onResponse(Common::Redis::RespValuePtr&& response) override;
+  Common::Redis::Client::Transaction& transaction() override { return callbacks_.transaction(); }
+
+  // RedisProxy::CommandSplitter::SplitRequest
+  void cancel() override { wrapped_request_ptr_->cancel(); }
+
+  SplitRequestPtr wrapped_request_ptr_;
+
+private:
+  SplitCallbacks& callbacks_;
+  HotKeyCache& cache_;
+  const uint32_t command_;
+  const std::string key_;
+  const uint64_t fill_id_;
+};
+
 /**
  * SimpleRequest hashes the first argument as the key.
  */
@@ -354,7 +388,7 @@ class InstanceImpl : public Instance, Logger::Loggable<Logger::Id::redis> {
 public:
   InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                TimeSource& time_source, bool latency_in_micros,
-               Common::Redis::FaultManagerPtr&& fault_manager);
+               Common::Redis::FaultManagerPtr&& fault_manager, HotKeyCacheSharedPtr hot_key_cache);
 
   // RedisProxy::CommandSplitter::Instance
   SplitRequestPtr makeRequest(Common::Redis::RespValuePtr&& request, SplitCallbacks& callbacks,
@@ -389,6 +423,7 @@ private:
   InstanceStats stats_;
   TimeSource& time_source_;
   Common::Redis::FaultManagerPtr fault_manager_;
+  const HotKeyCacheSharedPtr hot_key_cache_;
 };
 
 } // namespace CommandSplitter
@@ -8,6 +8,7 @@
 #include "source/extensions/filters/network/common/redis/client_impl.h"
 #include "source/extensions/filters/network/common/redis/fault_impl.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
+#include "source/extensions/filters/network/redis_proxy/hot_key_cache.h"
 #include "source/extensions/filters/network/redis_proxy/proxy_filter.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
 
@@ -83,10 +84,17 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
   auto fault_manager = std::make_unique<Common::Redis::FaultManagerImpl>(
       context.api().randomGenerator(), context.runtime(), proto_config.faults());
 
+  HotKeyCacheSharedPtr hot_key_cache;
+  if (proto_config.has_hot_key_cache()) {
+    hot_key_cache = std::make_shared<HotKeyCache>(proto_config.hot_key_cache(),
+                                                  context.threadLocal(), context.timeSource(),
+                                                  context.scope(), filter_config->stat_prefix_);
+  }
+
   std::shared_ptr<CommandSplitter::Instance> splitter =
       std::make_shared<CommandSplitter::InstanceImpl>(
           std::move(router), context.scope(), filter_config->stat_prefix_, context.timeSource(),
-          proto_config.latency_in_micros(), std::move(fault_manager));
+          proto_config.latency_in_micros(), std::move(fault_manager), std::move(hot_key_cache));
   return [splitter, filter_config](Network::FilterManager& filter_manager) -> void {
     Common::Redis::DecoderFactoryImpl factory;
     filter_manager.addReadFilter(std::make_shared<ProxyFilter>(
@@ -0,0 +1,150 @@
+#include "source/extensions/filters/network/redis_proxy/hot_key_cache.h"
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/fmt.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/network/common/redis/supported_commands.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+namespace {
+
+std::vector<std::string> cachedCommands(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::HotKeyCache& config) {
+  if (config.commands().empty()) {
+    return {"get"};
+  }
+  std::vector<std::string> commands;
+  for (const std::string& command : config.commands()) {
+    std::string lower_command = absl::AsciiStrToLower(command);
+    if (!Common::Redis::SupportedCommands::cacheableCommands().contains(lower_command)) {
+      throw EnvoyException(fmt::format("unsupported hot key cache command '{}'", command));
+    }
+    commands.push_back(std::move(lower_command));
+  }
+  return commands;
+}
+
+} // namespace
+
+HotKeyCache::HotKeyCache(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::HotKeyCache& config,
+    ThreadLocal::SlotAllocator& tls, TimeSource& time_source, Stats::Scope& scope,
+    const std::string& stat_prefix)
+    : commands_(cachedCommands(config)), ttl_(PROTOBUF_GET_MS_REQUIRED(config, ttl)),
+      max_keys_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_keys, 1024)), time_source_(time_source),
+      stats_{ALL_HOT_KEY_CACHE_STATS(POOL_COUNTER_PREFIX(scope, stat_prefix + "hot_key_cache."))},
+      tls_slot_(ThreadLocal::TypedSlot<ThreadLocalCache>::makeUnique(tls)) {
+  tls_slot_->set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalCache>(); });
+}
+
+absl::optional<uint32_t> HotKeyCache::commandIndex(const std::string& command) const {
+  for (uint32_t i = 0; i < commands_.size(); i++) {
+    if (commands_[i] == command) {
+      return i;
+    }
+  }
+  return absl::nullopt;
+}
+
+Common::Redis::RespValuePtr HotKeyCache::lookup(uint32_t command, const std::string& key,
+                                                uint64_t& fill_id) {
+  ThreadLocalCache& cache = **tls_slot_;
+  EntryList::iterator entry;
+  auto it = cache.index_.find(key);
+  if (it == cache.index_.end()) {
+    if (cache.entries_.size() >= max_keys_) {
+      cache.index_.erase(cache.entries_.back().key_);
+      cache.entries_.pop_back();
+      stats_.eviction_.inc();
+    }
+    cache.entries_.push_front(Entry{key, std::vector<CachedResponse>(commands_.size())});
+    entry = cache.entries_.begin();
+    cache.index_.emplace(entry->key_, entry);
+  } else {
+    entry = it->second;
+    cache.entries_.splice(cache.entries_.begin(), cache.entries_, entry);
+  }
+
+  CachedResponse& cached = entry->responses_[command];
+  if (cached.response_ != nullptr && cached.expiry_ > time_source_.monotonicTime()) {
+    stats_.hit_.inc();
+    return std::make_unique<Common::Redis::RespValue>(*cached.response_);
+  }
+
+  stats_.miss_.inc();
+  cached.response_.reset();
+  cached.fill_id_ = fill_id = cache.next_fill_id_++;
+  return nullptr;
+}
+
+void HotKeyCache::fill(uint32_t command, const std::string& key, uint64_t fill_id,
+                       const Common::Redis::RespValue& response) {
+  ThreadLocalCache& cache = **tls_slot_;
+  auto it = cache.index_.find(key);
+  if (it == cache.index_.end()) {
+    return;
+  }
+
+  CachedResponse& cached = it->second->responses_[command];
+  if (cached.fill_id_ != fill_id) {
+    return;
+  }
+  cached.fill_id_ = 0;
+  cached.response_ = std::make_unique<Common::Redis::RespValue>(response);
+  cached.expiry_ = time_source_.monotonicTime() + ttl_;
+}
+
+void HotKeyCache::invalidate(const std::string& command, const Common::Redis::RespValue& request) {
+  if (!Common::Redis::SupportedCommands::writeCommands().contains(command)) {
+    return;
+  }
+  ThreadLocalCache& cache = **tls_slot_;
+  if (cache.entries_.empty()) {
+    return;
+  }
+
+  const std::vector<Common::Redis::RespValue>& args = request.asArray();
+  if (command == Common::Redis::SupportedCommands::mset()) {
+    for (uint64_t i = 1; i < args.size(); i += 2) {
+      invalidateKey(cache, args[i].asString());
+    }
+  } else if (Common::Redis::SupportedCommands::evalCommands().contains(command)) {
+    // EVAL looks like: EVAL script numkeys key [key ...] arg [arg ...]
+    uint64_t num_keys;
+    if (args.size() > 3 && absl::SimpleAtoi(args[2].asString(), &num_keys)) {
+      for (uint64_t i = 3; i < args.size() && i - 3 < num_keys; i++) {
+        invalidateKey(cache, args[i].asString());
+      }
+    }
+  } else if (Common::Redis::SupportedCommands::hashMultipleSumResultCommands().contains(command)) {
+    for (uint64_t i = 1; i < args.size(); i++) {
+      invalidateKey(cache, args[i].asString());
+    }
+  } else if (args.size() > 1) {
+    invalidateKey(cache, args[1].asString());
+  }
+}
+
+void HotKeyCache::invalidateKey(ThreadLocalCache& cache, const std::string& key) {
+  auto it = cache.index_.find(key);
+  if (it == cache.index_.end()) {
+    return;
+  }
+  const EntryList::iterator entry = it->second;
+  cache.index_.erase(it);
+  cache.entries_.erase(entry);
+  stats_.invalidation_.inc();
+}
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/filters/network/common/redis/codec.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+/**
+ * All hot key cache stats. @see stats_macros.h
+ */
+#define ALL_HOT_KEY_CACHE_STATS(COUNTER)                                                           \
+  COUNTER(hit)                                                                                     \
+  COUNTER(miss)                                                                                    \
+  COUNTER(eviction)                                                                                \
+  COUNTER(invalidation)
+
+/**
+ * Struct definition for all hot key cache stats. @see stats_macros.h
+ */
+struct HotKeyCacheStats {
+  ALL_HOT_KEY_CACHE_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Per-worker cache of the responses to read commands taking a single key. Each worker keeps the
+ * most recently used keys, up to max_keys, and serves their cached responses until they expire.
+ *
+ * A response is only stored if it was requested after the last invalidation of its key on this
+ * worker: a miss leaves a pending fill for the key, which an invalidation or an eviction discards
+ * along with the rest of the key's entry. A response to a read overtaken by a write through this
+ * worker is therefore never cached.
+ *
+ * All methods other than the constructor must be called on a worker thread.
+ */
+class HotKeyCache {
+public:
+  HotKeyCache(
+      const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::HotKeyCache& config,
+      ThreadLocal::SlotAllocator& tls, TimeSource& time_source, Stats::Scope& scope,
+      const std::string& stat_prefix);
+
+  /**
+   * @return the index of the command among the cached ones, if its responses are cached.
+   */
+  absl::optional<uint32_t> commandIndex(const std::string& command) const;
+
+  /**
+   * Looks the response to a command up.
+   * @param command supplies the index of the command.
+   * @param key supplies the key of the command.
+   * @param fill_id receives, on a miss, the id to pass to fill() along with the response.
+   * @return a copy of the cached response, or nullptr on a miss.
+   */
+  Common::Redis::RespValuePtr lookup(uint32_t command, const std::string& key, uint64_t& fill_id);
+
+  /**
+   * Caches the response to a command which missed, unless the key has been invalidated or evicted
+   * since.
+   * @param command supplies the index of the command.
+   * @param key supplies the key of the command.
+   * @param fill_id supplies the id returned by lookup().
+   * @param response supplies the response to cache.
+   */
+  void fill(uint32_t command, const std::string& key, uint64_t fill_id,
+            const Common::Redis::RespValue& response);
+
+  /**
+   * Invalidates the keys a command may modify, if it is a write command.
+   * @param command supplies the lower case name of the command.
+   * @param request supplies the command.
+   */
+  void invalidate(const std::string& command, const Common::Redis::RespValue& request);
+
+private:
+  struct CachedResponse {
+    Common::Redis::RespValuePtr response_;
+    MonotonicTime expiry_;
+    // Id of the pending fill, or 0 if none.
+    uint64_t fill_id_{};
+  };
+
+  struct Entry {
+    std::string key_;
+    // Indexed by the index of the command.
+    std::vector<CachedResponse> responses_;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // The keys cached by a worker, the most recently used first.
+  struct ThreadLocalCache : public ThreadLocal::ThreadLocalObject {
+    EntryList entries_;
+    // Views of the keys of the entries.
+    absl::flat_hash_map<absl::string_view, EntryList::iterator> index_;
+    uint64_t next_fill_id_{1};
+  };
+
+  void invalidateKey(ThreadLocalCache& cache, const std::string& key);
+
+  const std::vector<std::string> commands_;
+  const std::chrono::milliseconds ttl_;
+  const uint32_t max_keys_;
+  TimeSource& time_source_;
+  HotKeyCacheStats stats_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalCache> tls_slot_;
+};
+
+using HotKeyCacheSharedPtr = std::shared_ptr<HotKeyCache>;
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -31,7 +31,11 @@ namespace ThriftProxy {
 ProtocolOptionsConfigImpl::ProtocolOptionsConfigImpl(
     const envoy::extensions::filters::network::thrift_proxy::v3::ThriftProtocolOptions& config)
     : transport_(ProtoUtils::getTransportType(config.transport())),
-      protocol_(ProtoUtils::getProtocolType(config.protocol())) {}
+      protocol_(ProtoUtils::getProtocolType(config.protocol())),
+      max_concurrent_requests_per_connection_(
+          config.has_max_concurrent_requests_per_connection()
+              ? absl::make_optional(config.max_concurrent_requests_per_connection().value())
+              : absl::nullopt) {}
 
 TransportType ProtocolOptionsConfigImpl::transport(TransportType downstream_transport) const {
   return (transport_ == TransportType::Auto) ? downstream_transport : transport_;
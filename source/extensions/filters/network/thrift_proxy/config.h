@@ -32,10 +32,14 @@ public:
   // ProtocolOptionsConfig
   TransportType transport(TransportType downstream_transport) const override;
   ProtocolType protocol(ProtocolType downstream_protocol) const override;
+  absl::optional<uint32_t> maxConcurrentRequestsPerConnection() const override {
+    return max_concurrent_requests_per_connection_;
+  }
 
 private:
   const TransportType transport_;
   const ProtocolType protocol_;
+  const absl::optional<uint32_t> max_concurrent_requests_per_connection_;
 };
 
 /**
@@ -208,7 +208,9 @@ DecoderEventHandler& ConnectionManager::newDecoderEventHandler() {
 }
 
 bool ConnectionManager::ResponseDecoder::passthroughEnabled() const {
-  return parent_.parent_.passthroughEnabled();
+  // The response belongs to this RPC, which is not necessarily the most recent one when requests
+  // are pipelined, so its own filter chain decides whether the body can be passed through.
+  return parent_.parent_.config_.payloadPassthrough() && parent_.passthroughSupported();
 }
 
 bool ConnectionManager::passthroughEnabled() const {
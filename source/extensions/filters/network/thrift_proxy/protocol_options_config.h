@@ -4,6 +4,8 @@
 
 #include "source/extensions/filters/network/thrift_proxy/thrift.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -18,6 +20,12 @@ public:
 
   virtual TransportType transport(TransportType downstream_transport) const PURE;
   virtual ProtocolType protocol(ProtocolType downstream_protocol) const PURE;
+
+  /**
+   * @return the maximum number of outstanding requests on a multiplexed upstream connection, or
+   *         nullopt if upstream connections are not multiplexed.
+   */
+  virtual absl::optional<uint32_t> maxConcurrentRequestsPerConnection() const PURE;
 };
 
 } // namespace ThriftProxy
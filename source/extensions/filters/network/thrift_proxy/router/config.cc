@@ -6,6 +6,7 @@
 
 #include "source/extensions/filters/network/thrift_proxy/router/router_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/router/shadow_writer_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/router/upstream_multiplexer.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -22,14 +23,15 @@ ThriftFilters::FilterFactoryCb RouterFilterConfig::createFilterFactoryFromProtoT
       std::make_shared<const RouterStats>(stat_prefix, context.scope(), context.localInfo());
   auto shadow_writer = std::make_shared<ShadowWriterImpl>(
       context.clusterManager(), *stats, context.mainThreadDispatcher(), context.threadLocal());
+  auto multiplexer = std::make_shared<UpstreamMultiplexer>(context.threadLocal());
   bool close_downstream_on_error =
       PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, close_downstream_on_upstream_error, true);
 
-  return [&context, stats, shadow_writer, close_downstream_on_error](
+  return [&context, stats, shadow_writer, multiplexer, close_downstream_on_error](
              ThriftFilters::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addDecoderFilter(std::make_shared<Router>(context.clusterManager(), *stats,
                                                         context.runtime(), *shadow_writer,
-                                                        close_downstream_on_error));
+                                                        *multiplexer, close_downstream_on_error));
   };
 }
 
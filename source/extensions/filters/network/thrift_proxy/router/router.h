@@ -457,6 +457,8 @@ protected:
     TransportType transport;
     ProtocolType protocol;
     absl::optional<Upstream::TcpPoolData> conn_pool_data;
+    // Maximum number of requests sharing an upstream connection, or 0 if they are not multiplexed.
+    uint32_t max_concurrent_requests;
   };
 
   struct PrepareUpstreamRequestResult {
@@ -530,8 +532,17 @@ protected:
         (transport == TransportType::Framed || transport == TransportType::Header) &&
         (final_transport == TransportType::Framed || final_transport == TransportType::Header) &&
         protocol == final_protocol && final_protocol != ProtocolType::Twitter;
+    // Responses are matched to requests by the sequence id of their message, read from the frame
+    // the transport prefixes with its size.
+    const auto max_concurrent_requests =
+        options != nullptr &&
+                (final_transport == TransportType::Framed ||
+                 final_transport == TransportType::Header) &&
+                final_protocol != ProtocolType::Twitter
+            ? options->maxConcurrentRequestsPerConnection().value_or(0)
+            : 0;
     UpstreamRequestInfo result = {passthrough_supported, final_transport, final_protocol,
-                                  conn_pool_data};
+                                  conn_pool_data, max_concurrent_requests};
     return {absl::nullopt, result};
   }
 
@@ -328,7 +328,9 @@ FilterStatus Router::messageBegin(MessageMetadataSharedPtr metadata) {
 
   upstream_request_ = std::make_unique<UpstreamRequest>(
       *this, *upstream_req_info.conn_pool_data, metadata, upstream_req_info.transport,
-      upstream_req_info.protocol, close_downstream_on_error_);
+      upstream_req_info.protocol, close_downstream_on_error_,
+      upstream_req_info.max_concurrent_requests > 0 ? &multiplexer_ : nullptr,
+      upstream_req_info.max_concurrent_requests);
   return upstream_request_->start();
 }
 
@@ -226,9 +226,11 @@ class Router : public Tcp::ConnectionPool::UpstreamCallbacks,
                public ThriftFilters::DecoderFilter {
 public:
   Router(Upstream::ClusterManager& cluster_manager, const RouterStats& stats,
-         Runtime::Loader& runtime, ShadowWriter& shadow_writer, bool close_downstream_on_error)
+         Runtime::Loader& runtime, ShadowWriter& shadow_writer, UpstreamMultiplexer& multiplexer,
+         bool close_downstream_on_error)
       : RequestOwner(cluster_manager, stats), passthrough_supported_(false), runtime_(runtime),
-        shadow_writer_(shadow_writer), close_downstream_on_error_(close_downstream_on_error) {}
+        shadow_writer_(shadow_writer), multiplexer_(multiplexer),
+        close_downstream_on_error_(close_downstream_on_error) {}
 
   ~Router() override = default;
 
@@ -329,6 +331,7 @@ private:
   uint64_t request_size_{};
   Runtime::Loader& runtime_;
   ShadowWriter& shadow_writer_;
+  UpstreamMultiplexer& multiplexer_;
   std::vector<std::reference_wrapper<ShadowRouterHandle>> shadow_routers_{};
 
   bool close_downstream_on_error_;
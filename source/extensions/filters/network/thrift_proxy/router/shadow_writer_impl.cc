@@ -55,9 +55,10 @@ bool ShadowRouterImpl::createUpstreamRequest() {
 
   auto& upstream_req_info = prepare_result.upstream_request_info.value();
 
-  upstream_request_ = std::make_unique<UpstreamRequest>(*this, *upstream_req_info.conn_pool_data,
-                                                        metadata_, upstream_req_info.transport,
-                                                        upstream_req_info.protocol, true);
+  // Shadow requests outlive their router and are not multiplexed.
+  upstream_request_ = std::make_unique<UpstreamRequest>(
+      *this, *upstream_req_info.conn_pool_data, metadata_, upstream_req_info.transport,
+      upstream_req_info.protocol, true, nullptr, 0);
   upstream_request_->start();
   return true;
 }
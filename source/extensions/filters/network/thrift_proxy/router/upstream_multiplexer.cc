@@ -0,0 +1,390 @@
+#include "source/extensions/filters/network/thrift_proxy/router/upstream_multiplexer.h"
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/assert.h"
+#include "source/extensions/filters/network/thrift_proxy/framed_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/header_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/metadata.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+namespace {
+
+int32_t maxFrameSize(TransportType transport) {
+  // Only the transports prefixing frames with their size are multiplexed.
+  if (transport == TransportType::Framed) {
+    return FramedTransportImpl::MaxFrameSize;
+  }
+  ASSERT(transport == TransportType::Header);
+  return HeaderTransportImpl::MaxFrameSize;
+}
+
+} // namespace
+
+/**
+ * The view of a request on its multiplexed connection.
+ */
+class MultiplexedConnection::StreamData : public Tcp::ConnectionPool::ConnectionData {
+public:
+  StreamData(MultiplexedConnectionSharedPtr parent, int32_t sequence_id)
+      : parent_(std::move(parent)), sequence_id_(sequence_id), state_(sequence_id) {}
+  ~StreamData() override { parent_->releaseStream(sequence_id_); }
+
+  // Tcp::ConnectionPool::ConnectionData
+  Network::ClientConnection& connection() override { return parent_->conn_data_->connection(); }
+  void setConnectionState(Tcp::ConnectionPool::ConnectionStatePtr&&) override {
+    IS_ENVOY_BUG("unexpected connection state change on a multiplexed connection");
+  }
+  void addUpstreamCallbacks(Tcp::ConnectionPool::UpstreamCallbacks& callbacks) override {
+    parent_->setStreamCallbacks(sequence_id_, callbacks);
+  }
+
+protected:
+  // Tcp::ConnectionPool::ConnectionData
+  Tcp::ConnectionPool::ConnectionState* connectionState() override { return &state_; }
+
+private:
+  const MultiplexedConnectionSharedPtr parent_;
+  const int32_t sequence_id_;
+  // Hands the request's sequence id out.
+  ThriftConnectionState state_;
+};
+
+MultiplexedConnection::MultiplexedConnection(MultiplexedConnPool& parent,
+                                             const MultiplexedConnectionKey& key)
+    : parent_(&parent), key_(key),
+      transport_(NamedTransportConfigFactory::getFactory(std::get<1>(key)).createTransport()),
+      protocol_(NamedProtocolConfigFactory::getFactory(std::get<2>(key)).createProtocol()),
+      max_frame_size_(maxFrameSize(std::get<1>(key))) {}
+
+MultiplexedConnection::~MultiplexedConnection() {
+  if (pool_handle_ != nullptr) {
+    pool_handle_->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+  }
+}
+
+void MultiplexedConnection::connect(Upstream::TcpPoolData& pool_data) {
+  pool_handle_ = pool_data.newConnection(*this);
+}
+
+Tcp::ConnectionPool::Cancellable*
+MultiplexedConnection::newStream(Tcp::ConnectionPool::Callbacks& callbacks,
+                                 bool expects_response) {
+  if (conn_data_ != nullptr) {
+    attachStream(callbacks, expects_response);
+    return nullptr;
+  }
+
+  pending_streams_.push_back(std::make_unique<PendingStream>(*this, callbacks, expects_response));
+  return pending_streams_.back().get();
+}
+
+void MultiplexedConnection::onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                                          absl::string_view transport_failure_reason,
+                                          Upstream::HostDescriptionConstSharedPtr host) {
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  pool_handle_ = nullptr;
+  removeFromParent();
+
+  std::list<PendingStreamPtr> pending_streams = std::move(pending_streams_);
+  for (const PendingStreamPtr& stream : pending_streams) {
+    stream->callbacks_.onPoolFailure(reason, transport_failure_reason, host);
+  }
+}
+
+void MultiplexedConnection::onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_data,
+                                        Upstream::HostDescriptionConstSharedPtr host) {
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  pool_handle_ = nullptr;
+  conn_data_ = std::move(conn_data);
+  host_ = host;
+  conn_data_->addUpstreamCallbacks(*this);
+
+  // Sequence ids carry on from the previous users of the connection.
+  conn_state_ = conn_data_->connectionStateTyped<ThriftConnectionState>();
+  if (conn_state_ == nullptr) {
+    conn_data_->setConnectionState(std::make_unique<ThriftConnectionState>());
+    conn_state_ = conn_data_->connectionStateTyped<ThriftConnectionState>();
+  }
+
+  std::list<PendingStreamPtr> pending_streams = std::move(pending_streams_);
+  dispatching_ = true;
+  for (const PendingStreamPtr& stream : pending_streams) {
+    if (conn_data_ == nullptr) {
+      // The connection was closed while starting a previous request.
+      stream->callbacks_.onPoolFailure(ConnectionPool::PoolFailureReason::LocalConnectionFailure,
+                                       "", host);
+      continue;
+    }
+    attachStream(stream->callbacks_, stream->expects_response_);
+  }
+  dispatching_ = false;
+  maybeRelease();
+}
+
+void MultiplexedConnection::attachStream(Tcp::ConnectionPool::Callbacks& callbacks,
+                                         bool expects_response) {
+  int32_t sequence_id = conn_state_->nextSequenceId();
+  while (streams_.contains(sequence_id)) {
+    sequence_id = conn_state_->nextSequenceId();
+  }
+
+  Stream& stream = streams_[sequence_id];
+  stream.expects_response_ = expects_response;
+  active_streams_++;
+  callbacks.onPoolReady(std::make_unique<StreamData>(shared_from_this(), sequence_id), host_);
+}
+
+void MultiplexedConnection::cancelPendingStream(PendingStream& stream) {
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  pending_streams_.remove_if(
+      [&stream](const PendingStreamPtr& pending) { return pending.get() == &stream; });
+
+  if (pending_streams_.empty() && pool_handle_ != nullptr) {
+    pool_handle_->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+    pool_handle_ = nullptr;
+    removeFromParent();
+  }
+}
+
+void MultiplexedConnection::setStreamCallbacks(int32_t sequence_id,
+                                               Tcp::ConnectionPool::UpstreamCallbacks& callbacks) {
+  auto it = streams_.find(sequence_id);
+  ASSERT(it != streams_.end());
+  it->second.callbacks_ = &callbacks;
+}
+
+void MultiplexedConnection::releaseStream(int32_t sequence_id) {
+  auto it = streams_.find(sequence_id);
+  if (it != streams_.end()) {
+    // The response has not been received.
+    if (it->second.expects_response_) {
+      it->second.callbacks_ = nullptr;
+      it->second.abandoned_ = true;
+    } else {
+      streams_.erase(it);
+    }
+    active_streams_--;
+  }
+
+  maybeRelease();
+}
+
+void MultiplexedConnection::onUpstreamData(Buffer::Instance& data, bool) {
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  response_buffer_.move(data);
+
+  dispatching_ = true;
+  // Both the framed and the header transports prefix frames with their size.
+  while (conn_data_ != nullptr && response_buffer_.length() >= sizeof(int32_t)) {
+    const int32_t frame_size = response_buffer_.peekBEInt<int32_t>();
+    if (frame_size <= 0 || frame_size > max_frame_size_) {
+      ENVOY_LOG(debug, "thrift: invalid multiplexed response frame size {}", frame_size);
+      close();
+      break;
+    }
+    const uint64_t frame_length = sizeof(int32_t) + static_cast<uint64_t>(frame_size);
+    if (response_buffer_.length() < frame_length) {
+      break;
+    }
+
+    Buffer::OwnedImpl frame;
+    frame.move(response_buffer_, frame_length);
+    const absl::optional<int32_t> sequence_id = sequenceId(frame);
+    if (!sequence_id.has_value()) {
+      ENVOY_LOG(debug, "thrift: invalid multiplexed response");
+      close();
+      break;
+    }
+
+    auto it = streams_.find(sequence_id.value());
+    if (it == streams_.end()) {
+      ENVOY_LOG(debug, "thrift: dropping multiplexed response with unknown sequence id {}",
+                sequence_id.value());
+      continue;
+    }
+    Tcp::ConnectionPool::UpstreamCallbacks* callbacks = it->second.callbacks_;
+    if (!it->second.abandoned_) {
+      active_streams_--;
+    }
+    streams_.erase(it);
+    if (callbacks != nullptr) {
+      callbacks->onUpstreamData(frame, false);
+    }
+  }
+  dispatching_ = false;
+  maybeRelease();
+}
+
+void MultiplexedConnection::onEvent(Network::ConnectionEvent event) {
+  if (event != Network::ConnectionEvent::RemoteClose &&
+      event != Network::ConnectionEvent::LocalClose) {
+    return;
+  }
+
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  removeFromParent();
+  response_buffer_.drain(response_buffer_.length());
+
+  absl::flat_hash_map<int32_t, Stream> streams = std::move(streams_);
+  streams_.clear();
+  active_streams_ = 0;
+  const bool dispatching = dispatching_;
+  dispatching_ = true;
+  for (const auto& stream : streams) {
+    if (stream.second.callbacks_ != nullptr) {
+      stream.second.callbacks_->onEvent(event);
+    }
+  }
+  dispatching_ = dispatching;
+  conn_data_.reset();
+}
+
+absl::optional<int32_t> MultiplexedConnection::sequenceId(const Buffer::Instance& frame) {
+  // The sequence id is in the message begin, after the transport header. Only copy as much of
+  // the frame as needed to decode them.
+  uint64_t length = std::min<uint64_t>(frame.length(), 256);
+  while (true) {
+    std::string prefix_data(length, '\0');
+    frame.copyOut(0, length, prefix_data.data());
+    Buffer::OwnedImpl prefix(prefix_data);
+    MessageMetadata metadata(false);
+    try {
+      if (transport_->decodeFrameStart(prefix, metadata) &&
+          protocol_->readMessageBegin(prefix, metadata)) {
+        return metadata.hasSequenceId() ? absl::make_optional(metadata.sequenceId())
+                                        : absl::nullopt;
+      }
+    } catch (const EnvoyException& ex) {
+      ENVOY_LOG(debug, "thrift: multiplexed response decoding error: {}", ex.what());
+      return absl::nullopt;
+    }
+
+    if (length == frame.length()) {
+      return absl::nullopt;
+    }
+    length = std::min<uint64_t>(frame.length(), length * 2);
+  }
+}
+
+void MultiplexedConnection::maybeRelease() {
+  if (dispatching_ || conn_data_ == nullptr || !pending_streams_.empty() || active_streams_ > 0) {
+    return;
+  }
+
+  const MultiplexedConnectionSharedPtr self = shared_from_this();
+  removeFromParent();
+  if (!streams_.empty() || response_buffer_.length() > 0) {
+    // Responses to abandoned requests would reach the next user of the connection.
+    close();
+    return;
+  }
+
+  conn_data_.reset();
+}
+
+void MultiplexedConnection::close() {
+  if (conn_data_ != nullptr) {
+    conn_data_->connection().close(Network::ConnectionCloseType::NoFlush);
+  }
+}
+
+void MultiplexedConnection::removeFromParent() {
+  if (parent_ != nullptr) {
+    MultiplexedConnPool* parent = parent_;
+    parent_ = nullptr;
+    parent->remove(*this);
+  }
+}
+
+MultiplexedConnPool::~MultiplexedConnPool() {
+  for (auto& connections : connections_) {
+    for (const MultiplexedConnectionSharedPtr& connection : connections.second) {
+      connection->detach();
+    }
+  }
+}
+
+Tcp::ConnectionPool::Cancellable*
+MultiplexedConnPool::newStream(Upstream::TcpPoolData& pool_data, TransportType transport,
+                               ProtocolType protocol, uint32_t max_streams, bool expects_response,
+                               Tcp::ConnectionPool::Callbacks& callbacks) {
+  const MultiplexedConnectionKey key{poolId(pool_data.pool()), transport, protocol};
+  std::list<MultiplexedConnectionSharedPtr>& connections = connections_[key];
+  for (const MultiplexedConnectionSharedPtr& connection : connections) {
+    if (connection->streams() < max_streams) {
+      return connection->newStream(callbacks, expects_response);
+    }
+  }
+
+  auto connection = std::make_shared<MultiplexedConnection>(*this, key);
+  connections.push_back(connection);
+  Tcp::ConnectionPool::Cancellable* handle = connection->newStream(callbacks, expects_response);
+  // The request has been called back if the pool called the connection back before returning.
+  connection->connect(pool_data);
+  return connection->connecting() ? handle : nullptr;
+}
+
+void MultiplexedConnPool::remove(MultiplexedConnection& connection) {
+  auto it = connections_.find(connection.key());
+  if (it == connections_.end()) {
+    return;
+  }
+  it->second.remove_if([&connection](const MultiplexedConnectionSharedPtr& existing) {
+    return existing.get() == &connection;
+  });
+  if (it->second.empty()) {
+    connections_.erase(it);
+  }
+}
+
+uint64_t MultiplexedConnPool::poolId(Tcp::ConnectionPool::Instance& pool) {
+  auto it = pool_ids_.find(&pool);
+  if (it != pool_ids_.end()) {
+    return it->second;
+  }
+
+  // The cluster manager destroys TCP connection pools once they are idle.
+  pool.addIdleCallback([this, &pool, still_alive = std::weak_ptr<bool>(still_alive_)]() {
+    if (!still_alive.expired()) {
+      onPoolIdle(pool);
+    }
+  });
+  return pool_ids_[&pool] = next_pool_id_++;
+}
+
+void MultiplexedConnPool::onPoolIdle(const Tcp::ConnectionPool::Instance& pool) {
+  auto id_it = pool_ids_.find(&pool);
+  if (id_it == pool_ids_.end()) {
+    return;
+  }
+  const uint64_t id = id_it->second;
+  pool_ids_.erase(id_it);
+
+  // An idle pool has no connection in use, so its connections have all been removed already.
+  for (auto it = connections_.begin(); it != connections_.end();) {
+    if (std::get<0>(it->first) != id) {
+      ++it;
+      continue;
+    }
+    for (const MultiplexedConnectionSharedPtr& connection : it->second) {
+      connection->detach();
+    }
+    connections_.erase(it++);
+  }
+}
+
+UpstreamMultiplexer::UpstreamMultiplexer(ThreadLocal::SlotAllocator& tls)
+    : tls_slot_(ThreadLocal::TypedSlot<MultiplexedConnPool>::makeUnique(tls)) {
+  tls_slot_->set([](Event::Dispatcher&) { return std::make_shared<MultiplexedConnPool>(); });
+}
+
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <tuple>
+
+#include "envoy/tcp/conn_pool.h"
+#include "envoy/thread_local/thread_local.h"
+#include "envoy/upstream/thread_local_cluster.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/logger.h"
+#include "source/extensions/filters/network/thrift_proxy/conn_state.h"
+#include "source/extensions/filters/network/thrift_proxy/protocol.h"
+#include "source/extensions/filters/network/thrift_proxy/thrift.h"
+#include "source/extensions/filters/network/thrift_proxy/transport.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+
+class MultiplexedConnPool;
+
+// Identifies the connections which can be shared: those of a TCP connection pool, carrying a
+// given transport and protocol. Pools are identified by an id assigned by the MultiplexedConnPool,
+// since the address of a destroyed pool may be reused by another one.
+using MultiplexedConnectionKey = std::tuple<uint64_t, TransportType, ProtocolType>;
+
+/**
+ * An upstream connection shared by concurrent requests. Each request gets a sequence id which is
+ * unique among the requests outstanding on the connection, and the responses are dispatched to
+ * the requests by sequence id.
+ *
+ * The requests see the connection through their own Tcp::ConnectionPool::ConnectionData, whose
+ * connection state hands out the request's sequence id, and to which they attach the callbacks
+ * receiving their response. Releasing the ConnectionData before the response has been received
+ * abandons the request: its response is discarded when it arrives.
+ *
+ * The connection is released back to the TCP connection pool once no request is left on it, or
+ * closed if responses to abandoned requests are still expected.
+ */
+class MultiplexedConnection : public Tcp::ConnectionPool::Callbacks,
+                              public Tcp::ConnectionPool::UpstreamCallbacks,
+                              public std::enable_shared_from_this<MultiplexedConnection>,
+                              Logger::Loggable<Logger::Id::thrift> {
+public:
+  MultiplexedConnection(MultiplexedConnPool& parent, const MultiplexedConnectionKey& key);
+  ~MultiplexedConnection() override;
+
+  /**
+   * Acquires the underlying connection for the requests added so far.
+   */
+  void connect(Upstream::TcpPoolData& pool_data);
+
+  /**
+   * Adds a request to the connection. The callbacks are invoked immediately if the connection is
+   * ready, otherwise once it is.
+   * @return a handle to cancel the request while the connection is pending, or nullptr if the
+   *         callbacks have been invoked.
+   */
+  Tcp::ConnectionPool::Cancellable* newStream(Tcp::ConnectionPool::Callbacks& callbacks,
+                                              bool expects_response);
+
+  /**
+   * @return the number of requests on the connection, including the abandoned ones which still
+   *         expect a response.
+   */
+  uint64_t streams() const { return pending_streams_.size() + streams_.size(); }
+
+  /**
+   * @return true while the underlying connection is being acquired.
+   */
+  bool connecting() const { return pool_handle_ != nullptr; }
+
+  const MultiplexedConnectionKey& key() const { return key_; }
+
+  /**
+   * Detaches the connection from its pool, which is being destroyed.
+   */
+  void detach() { parent_ = nullptr; }
+
+  // Tcp::ConnectionPool::Callbacks
+  void onPoolFailure(ConnectionPool::PoolFailureReason reason,
+                     absl::string_view transport_failure_reason,
+                     Upstream::HostDescriptionConstSharedPtr host) override;
+  void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn_data,
+                   Upstream::HostDescriptionConstSharedPtr host) override;
+
+  // Tcp::ConnectionPool::UpstreamCallbacks
+  void onUpstreamData(Buffer::Instance& data, bool end_stream) override;
+  void onEvent(Network::ConnectionEvent event) override;
+  void onAboveWriteBufferHighWatermark() override {}
+  void onBelowWriteBufferLowWatermark() override {}
+
+private:
+  class StreamData;
+
+  struct PendingStream : public Tcp::ConnectionPool::Cancellable {
+    PendingStream(MultiplexedConnection& parent, Tcp::ConnectionPool::Callbacks& callbacks,
+                  bool expects_response)
+        : parent_(parent), callbacks_(callbacks), expects_response_(expects_response) {}
+
+    // Tcp::ConnectionPool::Cancellable
+    void cancel(Tcp::ConnectionPool::CancelPolicy) override { parent_.cancelPendingStream(*this); }
+
+    MultiplexedConnection& parent_;
+    Tcp::ConnectionPool::Callbacks& callbacks_;
+    const bool expects_response_;
+  };
+  using PendingStreamPtr = std::unique_ptr<PendingStream>;
+
+  struct Stream {
+    Tcp::ConnectionPool::UpstreamCallbacks* callbacks_{};
+    bool expects_response_{};
+    // Set once the request has released the connection without receiving its response.
+    bool abandoned_{};
+  };
+
+  void attachStream(Tcp::ConnectionPool::Callbacks& callbacks, bool expects_response);
+  void cancelPendingStream(PendingStream& stream);
+  void setStreamCallbacks(int32_t sequence_id, Tcp::ConnectionPool::UpstreamCallbacks& callbacks);
+  void releaseStream(int32_t sequence_id);
+  absl::optional<int32_t> sequenceId(const Buffer::Instance& frame);
+  void maybeRelease();
+  void close();
+  void removeFromParent();
+
+  MultiplexedConnPool* parent_;
+  const MultiplexedConnectionKey key_;
+  TransportPtr transport_;
+  ProtocolPtr protocol_;
+  // Largest response frame the transport accepts.
+  const int32_t max_frame_size_;
+  Tcp::ConnectionPool::Cancellable* pool_handle_{};
+  Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+  Upstream::HostDescriptionConstSharedPtr host_;
+  ThriftConnectionState* conn_state_{};
+  std::list<PendingStreamPtr> pending_streams_;
+  absl::flat_hash_map<int32_t, Stream> streams_;
+  // Number of streams which are not abandoned.
+  uint64_t active_streams_{};
+  Buffer::OwnedImpl response_buffer_;
+  // Set while requests are being called back, which may release their streams.
+  bool dispatching_{};
+};
+
+using MultiplexedConnectionSharedPtr = std::shared_ptr<MultiplexedConnection>;
+
+/**
+ * The multiplexed upstream connections of a worker, by TCP connection pool, transport and protocol.
+ * Connections are taken from the pool of the request, so that they are never shared between pools
+ * created for different priorities, transport socket options or versions of the cluster.
+ */
+class MultiplexedConnPool : public ThreadLocal::ThreadLocalObject {
+public:
+  ~MultiplexedConnPool() override;
+
+  /**
+   * Adds a request to a multiplexed connection to the host of the given TCP connection pool,
+   * acquiring a new connection from that pool if the existing ones are full.
+   * @param pool_data supplies the TCP connection pool.
+   * @param transport supplies the upstream transport.
+   * @param protocol supplies the upstream protocol.
+   * @param max_streams supplies the maximum number of requests on a connection.
+   * @param expects_response supplies whether the request is a call rather than a oneway message.
+   * @param callbacks supplies the callbacks invoked once the request has a connection.
+   * @return a handle to cancel the request, or nullptr if the callbacks have been invoked.
+   */
+  Tcp::ConnectionPool::Cancellable* newStream(Upstream::TcpPoolData& pool_data,
+                                              TransportType transport, ProtocolType protocol,
+                                              uint32_t max_streams, bool expects_response,
+                                              Tcp::ConnectionPool::Callbacks& callbacks);
+
+  /**
+   * Stops assigning requests to a connection.
+   */
+  void remove(MultiplexedConnection& connection);
+
+private:
+  uint64_t poolId(Tcp::ConnectionPool::Instance& pool);
+  void onPoolIdle(const Tcp::ConnectionPool::Instance& pool);
+
+  absl::flat_hash_map<MultiplexedConnectionKey, std::list<MultiplexedConnectionSharedPtr>>
+      connections_;
+  // Ids of the TCP connection pools in use, forgotten once a pool is idle and about to be
+  // destroyed.
+  absl::flat_hash_map<const Tcp::ConnectionPool::Instance*, uint64_t> pool_ids_;
+  uint64_t next_pool_id_{};
+  // Guards the idle callbacks registered with the pools, which may outlive this object.
+  const std::shared_ptr<bool> still_alive_{std::make_shared<bool>(true)};
+};
+
+/**
+ * Provides the multiplexed connections of the current worker.
+ */
+class UpstreamMultiplexer {
+public:
+  UpstreamMultiplexer(ThreadLocal::SlotAllocator& tls);
+
+  /**
+   * @return MultiplexedConnPool& the multiplexed connections of the current worker.
+   */
+  MultiplexedConnPool& connPool() { return **tls_slot_; }
+
+private:
+  ThreadLocal::TypedSlotPtr<MultiplexedConnPool> tls_slot_;
+};
+
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -10,8 +10,10 @@ namespace Router {
 
 UpstreamRequest::UpstreamRequest(RequestOwner& parent, Upstream::TcpPoolData& pool_data,
                                  MessageMetadataSharedPtr& metadata, TransportType transport_type,
-                                 ProtocolType protocol_type, bool close_downstream_on_error)
+                                 ProtocolType protocol_type, bool close_downstream_on_error,
+                                 UpstreamMultiplexer* multiplexer, uint32_t max_concurrent_requests)
     : parent_(parent), stats_(parent.stats()), conn_pool_data_(pool_data), metadata_(metadata),
+      multiplexer_(multiplexer), max_concurrent_requests_(max_concurrent_requests),
       transport_(NamedTransportConfigFactory::getFactory(transport_type).createTransport()),
       protocol_(NamedProtocolConfigFactory::getFactory(protocol_type).createProtocol()),
       request_complete_(false), response_underflow_(false), charged_response_timing_(false),
@@ -24,7 +26,13 @@ UpstreamRequest::~UpstreamRequest() {
 }
 
 FilterStatus UpstreamRequest::start() {
-  Tcp::ConnectionPool::Cancellable* handle = conn_pool_data_.newConnection(*this);
+  Tcp::ConnectionPool::Cancellable* handle =
+      multiplexer_ != nullptr
+          ? multiplexer_->connPool().newStream(conn_pool_data_, transport_->type(),
+                                               protocol_->type(), max_concurrent_requests_,
+                                               metadata_->messageType() != MessageType::Oneway,
+                                               *this)
+          : conn_pool_data_.newConnection(*this);
   if (handle) {
     // Pause while we wait for a connection.
     conn_pool_handle_ = handle;
@@ -55,7 +63,9 @@ void UpstreamRequest::releaseConnection(const bool close) {
   // The event triggered by close will also release this connection so clear conn_data_ before
   // closing.
   auto conn_data = std::move(conn_data_);
-  if (close && conn_data != nullptr) {
+  // A multiplexed connection is shared with other requests: releasing it only drops this request,
+  // whose response is discarded if it arrives later.
+  if (close && conn_data != nullptr && multiplexer_ == nullptr) {
     conn_data->connection().close(Network::ConnectionCloseType::NoFlush);
   }
 }
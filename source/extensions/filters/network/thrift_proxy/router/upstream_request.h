@@ -8,6 +8,7 @@
 #include "source/extensions/filters/network/thrift_proxy/filters/filter.h"
 #include "source/extensions/filters/network/thrift_proxy/metadata.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router.h"
+#include "source/extensions/filters/network/thrift_proxy/router/upstream_multiplexer.h"
 #include "source/extensions/filters/network/thrift_proxy/thrift.h"
 
 namespace Envoy {
@@ -30,7 +31,8 @@ struct UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
                          Logger::Loggable<Logger::Id::thrift> {
   UpstreamRequest(RequestOwner& parent, Upstream::TcpPoolData& pool_data,
                   MessageMetadataSharedPtr& metadata, TransportType transport_type,
-                  ProtocolType protocol_type, bool close_downstream_on_error);
+                  ProtocolType protocol_type, bool close_downstream_on_error,
+                  UpstreamMultiplexer* multiplexer, uint32_t max_concurrent_requests);
   ~UpstreamRequest() override;
 
   FilterStatus start();
@@ -62,6 +64,9 @@ struct UpstreamRequest : public Tcp::ConnectionPool::Callbacks,
   const RouterStats& stats_;
   Upstream::TcpPoolData& conn_pool_data_;
   MessageMetadataSharedPtr metadata_;
+  // Set if the request shares its upstream connection with up to max_concurrent_requests_ ones.
+  UpstreamMultiplexer* multiplexer_;
+  const uint32_t max_concurrent_requests_;
 
   Tcp::ConnectionPool::Cancellable* conn_pool_handle_{};
   Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
@@ -1,5 +1,8 @@
 #include "source/extensions/filters/udp/udp_proxy/udp_proxy_filter.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "envoy/network/listener.h"
 
 #include "source/common/network/socket_option_factory.h"
@@ -13,7 +16,10 @@ UdpProxyFilter::UdpProxyFilter(Network::UdpReadFilterCallbacks& callbacks,
                                const UdpProxyFilterConfigSharedPtr& config)
     : UdpListenerReadFilter(callbacks), config_(config),
       cluster_update_callbacks_(
-          config->clusterManager().addThreadLocalClusterUpdateCallbacks(*this)) {
+          config->clusterManager().addThreadLocalClusterUpdateCallbacks(*this)),
+      flush_sessions_cb_(callbacks.udpListener().dispatcher().createSchedulableCallback(
+          [this] { flushSessions(); })),
+      idle_timer_(callbacks.udpListener().dispatcher().createTimer([this] { onIdleTimer(); })) {
   for (const auto& entry : config_->allClusterNames()) {
     Upstream::ThreadLocalCluster* cluster = config->clusterManager().getThreadLocalCluster(entry);
     if (cluster != nullptr) {
@@ -76,6 +82,50 @@ Network::FilterStatus UdpProxyFilter::onReceiveError(Api::IoError::IoErrorCode)
   return Network::FilterStatus::StopIteration;
 }
 
+std::list<UdpProxyFilter::ActiveSession*>::iterator
+UdpProxyFilter::addIdleSession(ActiveSession& session) {
+  if (!idle_timer_->enabled()) {
+    idle_timer_->enableTimer(config_->sessionTimeout());
+  }
+  return idle_sessions_.insert(idle_sessions_.end(), &session);
+}
+
+void UdpProxyFilter::onIdleTimer() {
+  const MonotonicTime now = read_callbacks_->udpListener().dispatcher().approximateMonotonicTime();
+  while (!idle_sessions_.empty()) {
+    ActiveSession* session = idle_sessions_.front();
+    const MonotonicTime::duration idle_time = now - session->lastActivity();
+    if (idle_time < config_->sessionTimeout()) {
+      // Sessions are ordered by last activity, so the others have not timed out either.
+      idle_timer_->enableTimer(
+          std::chrono::ceil<std::chrono::milliseconds>(config_->sessionTimeout() - idle_time));
+      return;
+    }
+    // This removes the session from the list.
+    session->onIdleTimeout();
+  }
+}
+
+void UdpProxyFilter::scheduleFlush(ActiveSession& session) {
+  if (sessions_pending_flush_.empty()) {
+    flush_sessions_cb_->scheduleCallbackCurrentIteration();
+  }
+  sessions_pending_flush_.push_back(&session);
+}
+
+void UdpProxyFilter::cancelFlush(const ActiveSession& session) {
+  auto it = std::find(sessions_pending_flush_.begin(), sessions_pending_flush_.end(), &session);
+  ASSERT(it != sessions_pending_flush_.end());
+  sessions_pending_flush_.erase(it);
+}
+
+void UdpProxyFilter::flushSessions() {
+  for (ActiveSession* session : sessions_pending_flush_) {
+    session->onScheduledFlush();
+  }
+  sessions_pending_flush_.clear();
+}
+
 UdpProxyFilter::ClusterInfo::ClusterInfo(UdpProxyFilter& filter,
                                          Upstream::ThreadLocalCluster& cluster,
                                          SessionStorageType&& sessions)
@@ -197,7 +247,7 @@ Network::FilterStatus UdpProxyFilter::StickySessionClusterInfo::onData(Network::
     }
   }
 
-  active_session->write(*data.buffer_);
+  active_session->write(std::move(data.buffer_));
 
   return Network::FilterStatus::StopIteration;
 }
@@ -233,7 +283,7 @@ UdpProxyFilter::PerPacketLoadBalancingClusterInfo::onData(Network::UdpRecvData&
               active_session->host().address()->asStringView());
   }
 
-  active_session->write(*data.buffer_);
+  active_session->write(std::move(data.buffer_));
 
   return Network::FilterStatus::StopIteration;
 }
@@ -243,8 +293,9 @@ UdpProxyFilter::ActiveSession::ActiveSession(ClusterInfo& cluster,
                                              const Upstream::HostConstSharedPtr& host)
     : cluster_(cluster), use_original_src_ip_(cluster_.filter_.config_->usingOriginalSrcIp()),
       addresses_(std::move(addresses)), host_(host),
-      idle_timer_(cluster.filter_.read_callbacks_->udpListener().dispatcher().createTimer(
-          [this] { onIdleTimer(); })),
+      last_activity_(
+          cluster.filter_.read_callbacks_->udpListener().dispatcher().approximateMonotonicTime()),
+      idle_sessions_entry_(cluster.filter_.addIdleSession(*this)),
       // NOTE: The socket call can only fail due to memory/fd exhaustion. No local ephemeral port
       //       is bound until the first packet is sent to the upstream host.
       socket_(cluster.filter_.createSocket(host)) {
@@ -289,6 +340,12 @@ UdpProxyFilter::ActiveSession::~ActiveSession() {
   ENVOY_LOG(debug, "deleting the session: downstream={} local={} upstream={}",
             addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host_->address()->asStringView());
+  if (flush_scheduled_) {
+    // Datagrams already accepted by the session are still sent.
+    cluster_.filter_.cancelFlush(*this);
+    flushDatagrams();
+  }
+  cluster_.filter_.idle_sessions_.erase(idle_sessions_entry_);
   cluster_.filter_.config_->stats().downstream_sess_active_.dec();
   cluster_.cluster_.info()
       ->resourceManager(Upstream::ResourcePriority::Default)
@@ -343,15 +400,22 @@ void UdpProxyFilter::fillProxyStreamInfo() {
   udp_proxy_stats_.value().setDynamicMetadata("udp.proxy.proxy", stats_obj);
 }
 
-void UdpProxyFilter::ActiveSession::onIdleTimer() {
+void UdpProxyFilter::ActiveSession::onIdleTimeout() {
   ENVOY_LOG(debug, "session idle timeout: downstream={} local={}", addresses_.peer_->asStringView(),
             addresses_.local_->asStringView());
   cluster_.filter_.config_->stats().idle_timeout_.inc();
   cluster_.removeSession(this);
 }
 
+void UdpProxyFilter::ActiveSession::onActivity() {
+  last_activity_ =
+      cluster_.filter_.read_callbacks_->udpListener().dispatcher().approximateMonotonicTime();
+  std::list<ActiveSession*>& idle_sessions = cluster_.filter_.idle_sessions_;
+  idle_sessions.splice(idle_sessions.end(), idle_sessions, idle_sessions_entry_);
+}
+
 void UdpProxyFilter::ActiveSession::onReadReady() {
-  idle_timer_->enableTimer(cluster_.filter_.config_->sessionTimeout());
+  onActivity();
 
   // TODO(mattklein123): We should not be passing *addresses_.local_ to this function as we are
   //                     not trying to populate the local address for received packets.
@@ -370,28 +434,29 @@ void UdpProxyFilter::ActiveSession::onReadReady() {
   cluster_.filter_.read_callbacks_->udpListener().flush();
 }
 
-void UdpProxyFilter::ActiveSession::write(const Buffer::Instance& buffer) {
+void UdpProxyFilter::ActiveSession::write(Buffer::InstancePtr&& buffer) {
   ENVOY_LOG(trace, "writing {} byte datagram upstream: downstream={} local={} upstream={}",
-            buffer.length(), addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
+            buffer->length(), addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host_->address()->asStringView());
-  const uint64_t buffer_length = buffer.length();
+  const uint64_t buffer_length = buffer->length();
   cluster_.filter_.config_->stats().downstream_sess_rx_bytes_.add(buffer_length);
   session_stats_.downstream_sess_rx_bytes_ += buffer_length;
   cluster_.filter_.config_->stats().downstream_sess_rx_datagrams_.inc();
   ++session_stats_.downstream_sess_rx_datagrams_;
 
-  idle_timer_->enableTimer(cluster_.filter_.config_->sessionTimeout());
+  onActivity();
 
   // NOTE: On the first write, a local ephemeral port is bound, and thus this write can fail due to
   //       port exhaustion. To avoid exhaustion, UDP sockets will be connected and associated with
   //       a 4-tuple including the local IP, and the UDP port may be reused for multiple
   //       connections unless use_original_src_ip_ is set. When use_original_src_ip_ is set, the
   //       socket should not be connected since the source IP will be changed.
-  // NOTE: We do not specify the local IP to use for the sendmsg call if use_original_src_ip_ is not
-  //       set. We allow the OS to select the right IP based on outbound routing rules if
-  //       use_original_src_ip_ is not set, else use downstream peer IP as local IP.
-  const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
-  if (!use_original_src_ip_ && !connected_) {
+  if (use_original_src_ip_) {
+    // Every datagram carries its own source address, so it cannot be batched.
+    writeDatagram(*buffer);
+    return;
+  }
+  if (!connected_) {
     Api::SysCallIntResult rc = socket_->ioHandle().connect(host_->address());
     if (SOCKET_FAILURE(rc.return_value_)) {
       ENVOY_LOG(debug, "cannot connect: ({}) {}", rc.errno_, errorDetails(rc.errno_));
@@ -401,13 +466,86 @@ void UdpProxyFilter::ActiveSession::write(const Buffer::Instance& buffer) {
 
     connected_ = true;
   }
+
+  pending_datagrams_.push_back(std::move(buffer));
+  if (pending_datagrams_.size() >= MaxPendingDatagrams) {
+    flushDatagrams();
+  } else if (!flush_scheduled_) {
+    flush_scheduled_ = true;
+    cluster_.filter_.scheduleFlush(*this);
+  }
+}
+
+void UdpProxyFilter::ActiveSession::onScheduledFlush() {
+  flush_scheduled_ = false;
+  flushDatagrams();
+}
+
+void UdpProxyFilter::ActiveSession::flushDatagrams() {
+  if (pending_datagrams_.empty()) {
+    return;
+  }
+  if (pending_datagrams_.size() == 1 || !socket_->ioHandle().supportsMmsg()) {
+    for (const Buffer::InstancePtr& datagram : pending_datagrams_) {
+      writeDatagram(*datagram);
+    }
+    pending_datagrams_.clear();
+    return;
+  }
+
+  std::vector<Buffer::RawSliceVector> slices;
+  std::vector<absl::Span<const Buffer::RawSlice>> messages;
+  slices.reserve(pending_datagrams_.size());
+  messages.reserve(pending_datagrams_.size());
+  for (const Buffer::InstancePtr& datagram : pending_datagrams_) {
+    slices.push_back(datagram->getRawSlices());
+    messages.emplace_back(slices.back());
+  }
+
+  size_t sent = 0;
+  while (sent < messages.size()) {
+    const Api::IoCallUint64Result rc =
+        socket_->ioHandle().sendmmsg(absl::MakeConstSpan(messages).subspan(sent), 0);
+    if (rc.ok() && rc.return_value_ > 0) {
+      for (size_t i = sent; i < sent + rc.return_value_; ++i) {
+        onDatagramWritten(pending_datagrams_[i]->length(), true);
+      }
+      sent += rc.return_value_;
+      continue;
+    }
+    if (!rc.ok() && rc.err_->getErrorCode() == Api::IoError::IoErrorCode::MessageTooBig) {
+      // Only the first remaining datagram is at fault. Drop it, like a failed sendmsg would, and
+      // carry on with the next ones.
+      onDatagramWritten(pending_datagrams_[sent]->length(), false);
+      ++sent;
+      continue;
+    }
+    // The socket can't take more right now (EAGAIN, ENOBUFS), or fails for every datagram alike.
+    // Drop the rest of the batch rather than retrying it one datagram at a time.
+    for (size_t i = sent; i < messages.size(); ++i) {
+      onDatagramWritten(pending_datagrams_[i]->length(), false);
+    }
+    break;
+  }
+  pending_datagrams_.clear();
+}
+
+void UdpProxyFilter::ActiveSession::writeDatagram(const Buffer::Instance& buffer) {
+  // NOTE: We do not specify the local IP to use for the sendmsg call if use_original_src_ip_ is not
+  //       set. We allow the OS to select the right IP based on outbound routing rules if
+  //       use_original_src_ip_ is not set, else use downstream peer IP as local IP.
+  const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
   Api::IoCallUint64Result rc =
       Network::Utility::writeToSocket(socket_->ioHandle(), buffer, local_ip, *host_->address());
-  if (!rc.ok()) {
+  onDatagramWritten(buffer.length(), rc.ok());
+}
+
+void UdpProxyFilter::ActiveSession::onDatagramWritten(uint64_t length, bool ok) {
+  if (!ok) {
     cluster_.cluster_stats_.sess_tx_errors_.inc();
   } else {
     cluster_.cluster_stats_.sess_tx_datagrams_.inc();
-    cluster_.cluster_.info()->trafficStats()->upstream_cx_tx_bytes_total_.add(buffer_length);
+    cluster_.cluster_.info()->trafficStats()->upstream_cx_tx_bytes_total_.add(length);
   }
 }
 
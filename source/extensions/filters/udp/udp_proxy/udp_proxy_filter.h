@@ -1,8 +1,11 @@
 #pragma once
 
+#include <list>
+
 #include "envoy/access_log/access_log.h"
 #include "envoy/config/accesslog/v3/accesslog.pb.h"
 #include "envoy/event/file_event.h"
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/network/filter.h"
@@ -199,12 +202,22 @@ private:
     ~ActiveSession() override;
     const Network::UdpRecvData::LocalPeerAddresses& addresses() const { return addresses_; }
     const Upstream::Host& host() const { return *host_; }
-    void write(const Buffer::Instance& buffer);
+    void write(Buffer::InstancePtr&& buffer);
+    void onScheduledFlush();
+    MonotonicTime lastActivity() const { return last_activity_; }
+    void onIdleTimeout();
 
   private:
-    void onIdleTimer();
+    // Maximum number of datagrams buffered by a session before they are sent upstream, even if
+    // the current event loop iteration is not done.
+    static constexpr size_t MaxPendingDatagrams = 64;
+
+    void onActivity();
     void onReadReady();
     void fillSessionStreamInfo();
+    void flushDatagrams();
+    void writeDatagram(const Buffer::Instance& buffer);
+    void onDatagramWritten(uint64_t length, bool ok);
 
     // Network::UdpPacketProcessor
     void processPacket(Network::Address::InstanceConstSharedPtr local_address,
@@ -237,18 +250,21 @@ private:
     const bool use_original_src_ip_;
     const Network::UdpRecvData::LocalPeerAddresses addresses_;
     const Upstream::HostConstSharedPtr host_;
-    // TODO(mattklein123): Consider replacing an idle timer for each session with a last used
-    // time stamp and a periodic scan of all sessions to look for timeouts. This solution is simple,
-    // though it might not perform well for high volume traffic. Note that this is how TCP proxy
-    // idle timeouts work so we should consider unifying the implementation if we move to a time
-    // stamp and scan approach.
-    const Event::TimerPtr idle_timer_;
+    // Rather than having an idle timer, each session records when it was last active and keeps its
+    // place in the filter's list of sessions ordered by last activity.
+    MonotonicTime last_activity_;
+    const std::list<ActiveSession*>::iterator idle_sessions_entry_;
     // The socket is used for writing packets to the selected upstream host as well as receiving
     // packets from the upstream host. Note that a a local ephemeral port is bound on the first
     // write to the upstream host.
     const Network::SocketPtr socket_;
     // The socket has been connected to avoid port exhaustion.
     bool connected_{};
+    // Datagrams written since the session was last flushed. Unless use_original_src_ip_ is set,
+    // datagrams are sent upstream at the end of the event loop iteration they were received in,
+    // so that the ones received together can be sent with a single sendmmsg call.
+    std::vector<Buffer::InstancePtr> pending_datagrams_;
+    bool flush_scheduled_{};
 
     UdpProxySessionStats session_stats_{};
     absl::optional<StreamInfo::StreamInfoImpl> udp_session_stats_;
@@ -390,6 +406,11 @@ private:
   }
 
   void fillProxyStreamInfo();
+  std::list<ActiveSession*>::iterator addIdleSession(ActiveSession& session);
+  void onIdleTimer();
+  void scheduleFlush(ActiveSession& session);
+  void cancelFlush(const ActiveSession& session);
+  void flushSessions();
 
   // Upstream::ClusterUpdateCallbacks
   void onClusterAddOrUpdate(Upstream::ThreadLocalCluster& cluster) final;
@@ -397,6 +418,15 @@ private:
 
   const UdpProxyFilterConfigSharedPtr config_;
   const Upstream::ClusterUpdateCallbacksHandlePtr cluster_update_callbacks_;
+  // Sessions with datagrams to send upstream at the end of the current event loop iteration.
+  // Declared before the cluster infos, as sessions remove themselves when they are destroyed.
+  const Event::SchedulableCallbackPtr flush_sessions_cb_;
+  std::vector<ActiveSession*> sessions_pending_flush_;
+  // All sessions, least recently active first. A single timer expires them, firing when the least
+  // recently active session would time out. Refreshing a session on every datagram is then only a
+  // time stamp and a list splice, instead of re-arming a timer per session.
+  const Event::TimerPtr idle_timer_;
+  std::list<ActiveSession*> idle_sessions_;
   // Map for looking up cluster info with its name.
   absl::flat_hash_map<std::string, ClusterInfoPtr> cluster_infos_;
 
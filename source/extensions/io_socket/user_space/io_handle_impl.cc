@@ -238,6 +238,11 @@ Api::IoCallUint64Result IoHandleImpl::recvmsg(Buffer::RawSlice*, const uint64_t,
   return Network::IoSocketError::ioResultSocketInvalidAddress();
 }
 
+Api::IoCallUint64Result
+IoHandleImpl::sendmmsg(absl::Span<const absl::Span<const Buffer::RawSlice>>, int) {
+  return Network::IoSocketError::ioResultSocketInvalidAddress();
+}
+
 Api::IoCallUint64Result IoHandleImpl::recvmmsg(RawSliceArrays&, uint32_t, RecvMsgOutput&) {
   return Network::IoSocketError::ioResultSocketInvalidAddress();
 }
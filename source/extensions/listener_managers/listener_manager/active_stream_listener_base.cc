@@ -1,12 +1,39 @@
 #include "source/extensions/listener_managers/listener_manager/active_stream_listener_base.h"
 
 #include "envoy/network/filter.h"
+#include "envoy/stats/stats.h"
 
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/timespan_impl.h"
 
 namespace Envoy {
 namespace Server {
 
+namespace {
+
+/**
+ * Account tracking the memory of the buffers of the connections of a listener in a gauge. Slices
+ * moved out of the connection buffers, for instance to the buffers of an upstream connection,
+ * stay charged to the account until they are released.
+ */
+class ListenerBufferMemoryAccount : public Buffer::BufferMemoryAccount {
+public:
+  // The gauge is kept alive by the account, as slices may outlive the listener.
+  explicit ListenerBufferMemoryAccount(Stats::Gauge& gauge) : gauge_(&gauge) {}
+
+  // Buffer::BufferMemoryAccount
+  void charge(uint64_t amount) override { gauge_->add(amount); }
+  void credit(uint64_t amount) override { gauge_->sub(amount); }
+  // The connections of a listener aren't reset through this account.
+  void clearDownstream() override {}
+  void resetDownstream() override {}
+
+private:
+  const Stats::GaugeSharedPtr gauge_;
+};
+
+} // namespace
+
 ActiveStreamListenerBase::ActiveStreamListenerBase(Network::ConnectionHandler& parent,
                                                    Event::Dispatcher& dispatcher,
                                                    Network::ListenerPtr&& listener,
@@ -14,7 +41,13 @@ ActiveStreamListenerBase::ActiveStreamListenerBase(Network::ConnectionHandler& p
     : ActiveListenerImplBase(parent, &config), parent_(parent),
       listener_filters_timeout_(config.listenerFiltersTimeout()),
       continue_on_listener_filters_timeout_(config.continueOnListenerFiltersTimeout()),
-      listener_(std::move(listener)), dispatcher_(dispatcher) {}
+      listener_(std::move(listener)),
+      buffer_memory_account_(
+          Runtime::runtimeFeatureEnabled(
+              "envoy.reloadable_features.listener_buffer_memory_accounting")
+              ? std::make_shared<ListenerBufferMemoryAccount>(stats_.downstream_cx_buffer_bytes_)
+              : nullptr),
+      dispatcher_(dispatcher) {}
 
 void ActiveStreamListenerBase::emitLogs(Network::ListenerConfig& config,
                                         StreamInfo::StreamInfo& stream_info) {
@@ -49,6 +82,9 @@ void ActiveStreamListenerBase::newConnection(Network::ConnectionSocketPtr&& sock
         timeout, stats_.downstream_cx_transport_socket_connect_timeout_);
   }
   server_conn_ptr->setBufferLimits(config_->perConnectionBufferLimitBytes());
+  if (buffer_memory_account_ != nullptr) {
+    server_conn_ptr->bindBufferMemoryAccount(buffer_memory_account_);
+  }
   RELEASE_ASSERT(server_conn_ptr->connectionInfoProvider().remoteAddress() != nullptr, "");
   const bool empty_filter_chain = !config_->filterChainFactory().createNetworkFilterChain(
       *server_conn_ptr, filter_chain->networkFilterFactories());
@@ -136,6 +172,29 @@ void OwnedActiveStreamListenerBase::removeConnection(ActiveTcpConnection& connec
   }
 }
 
+void OwnedActiveStreamListenerBase::migrateIdleConnections(
+    std::vector<Network::IoHandlePtr>& sockets) {
+  // Closed connections are removed from the containers being iterated, and deferred deleted.
+  std::vector<Network::Connection*> connections;
+  for (const auto& [filter_chain, active_connections] : connections_by_context_) {
+    for (const auto& active_connection : active_connections->connections_) {
+      const auto& info = active_connection->connection_->connectionInfoProvider();
+      // The other process accepts the socket by its own addresses and runs the listener filters
+      // again, which can't restore addresses taken from a preamble such as a PROXY protocol
+      // header.
+      if (*info.remoteAddress() == *info.directRemoteAddress() && !info.localAddressRestored()) {
+        connections.push_back(active_connection->connection_.get());
+      }
+    }
+  }
+  for (Network::Connection* connection : connections) {
+    Network::IoHandlePtr socket = connection->migrateSocket();
+    if (socket != nullptr) {
+      sockets.push_back(std::move(socket));
+    }
+  }
+}
+
 ActiveConnections& OwnedActiveStreamListenerBase::getOrCreateActiveConnections(
     const Network::FilterChain& filter_chain) {
   ActiveConnectionCollectionPtr& connections = connections_by_context_[&filter_chain];
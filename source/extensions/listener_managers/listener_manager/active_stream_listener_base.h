@@ -4,7 +4,9 @@
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <vector>
 
+#include "envoy/buffer/buffer.h"
 #include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/connection.h"
@@ -133,6 +135,9 @@ protected:
 
   std::list<std::unique_ptr<ActiveTcpSocket>> sockets_;
   Network::ListenerPtr listener_;
+  // Charged for the buffers of the connections of the listener, if buffer memory accounting is
+  // enabled.
+  const Buffer::BufferMemoryAccountSharedPtr buffer_memory_account_;
   // True if the follow up connection deletion is raised by the connection collection deletion is
   // performing. Otherwise, the collection should be deleted when the last connection in the
   // collection is removed. This state is maintained in base class because this state is independent
@@ -203,6 +208,13 @@ public:
    */
   void removeConnection(ActiveTcpConnection& connection);
 
+  /**
+   * Close the idle connections without notifying their peers, and return their sockets so that
+   * they can be handed off to another process.
+   * @param sockets receives the sockets of the closed connections.
+   */
+  void migrateIdleConnections(std::vector<Network::IoHandlePtr>& sockets);
+
 protected:
   /**
    * Return the active connections container attached to the given filter chain.
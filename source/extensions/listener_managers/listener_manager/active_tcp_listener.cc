@@ -20,7 +20,8 @@ ActiveTcpListener::ActiveTcpListener(Network::TcpConnectionHandler& parent,
     : OwnedActiveStreamListenerBase(
           parent, parent.dispatcher(),
           parent.dispatcher().createListener(std::move(socket), *this, runtime, config.bindToPort(),
-                                             config.ignoreGlobalConnLimit()),
+                                             config.ignoreGlobalConnLimit(),
+                                             config.maxConnectionsToAcceptPerSocketEvent()),
           config),
       tcp_conn_handler_(parent), connection_balancer_(connection_balancer),
       listen_address_(listen_address) {
@@ -100,6 +101,10 @@ void ActiveTcpListener::onReject(RejectCause cause) {
   }
 }
 
+void ActiveTcpListener::recordConnectionsAcceptedOnSocketEvent(uint32_t connections_accepted) {
+  stats_.connections_accepted_per_socket_event_.recordValue(connections_accepted);
+}
+
 void ActiveTcpListener::onAcceptWorker(Network::ConnectionSocketPtr&& socket,
                                        bool hand_off_restored_destination_connections,
                                        bool rebalanced) {
@@ -383,6 +383,36 @@ ConnectionHandlerImpl::getBalancedHandlerByAddress(const Network::Address::Insta
              : absl::nullopt;
 }
 
+std::vector<Network::IoHandlePtr> ConnectionHandlerImpl::migrateIdleConnections() {
+  std::vector<Network::IoHandlePtr> sockets;
+  for (auto& listener : listener_map_by_tag_) {
+    for (auto& details : listener.second->per_address_details_list_) {
+      // Migrated connections are accepted by the listener of their local address, which is only
+      // looked up for IP listeners.
+      if (auto tcp_listener = details->tcpListener();
+          tcp_listener.has_value() && details->address_->type() == Network::Address::Type::Ip) {
+        tcp_listener->get().migrateIdleConnections(sockets);
+      }
+    }
+  }
+  ENVOY_LOG(debug, "{}migrating {} idle connections", per_handler_stat_prefix_, sockets.size());
+  return sockets;
+}
+
+void ConnectionHandlerImpl::acceptMigratedConnection(Network::ConnectionSocketPtr&& socket) {
+  const auto& local_address = *socket->connectionInfoProvider().localAddress();
+  auto balanced_handler = local_address.type() == Network::Address::Type::Ip
+                              ? getBalancedHandlerByAddress(local_address)
+                              : absl::nullopt;
+  if (!balanced_handler.has_value()) {
+    ENVOY_LOG(debug, "{}no listener for migrated connection to {}", per_handler_stat_prefix_,
+              local_address.asStringView());
+    socket->close();
+    return;
+  }
+  balanced_handler->get().onAcceptWorker(std::move(socket), false, false);
+}
+
 REGISTER_FACTORY(ConnectionHandlerFactoryImpl, ConnectionHandlerFactory);
 
 } // namespace Server
@@ -56,6 +56,8 @@ public:
   void enableListeners() override;
   void setListenerRejectFraction(UnitFloat reject_fraction) override;
   const std::string& statPrefix() const override { return per_handler_stat_prefix_; }
+  std::vector<Network::IoHandlePtr> migrateIdleConnections() override;
+  void acceptMigratedConnection(Network::ConnectionSocketPtr&& socket) override;
 
   // Network::TcpConnectionHandler
   Event::Dispatcher& dispatcher() override { return dispatcher_; }
@@ -216,6 +216,7 @@ void FilterChainManagerImpl::addFilterChains(
       filter_chains;
   uint32_t new_filter_chain_size = 0;
   FilterChainsByName filter_chains_by_name;
+  FilterChainsByPort filter_chains_by_port;
 
   for (const auto& filter_chain : filter_chain_span) {
     const auto& filter_chain_match = filter_chain->filter_chain_match();
@@ -265,48 +266,15 @@ void FilterChainManagerImpl::addFilterChains(
         ENVOY_LOG(debug, "filter chain match in chain '{}' is ignored", filter_chain->name());
       }
     } else {
-      auto createAddressVector = [](const auto& prefix_ranges) -> std::vector<std::string> {
-        std::vector<std::string> ips;
-        ips.reserve(prefix_ranges.size());
-        for (const auto& ip : prefix_ranges) {
-          const auto& cidr_range = Network::Address::CidrRange::create(ip);
-          ips.push_back(cidr_range.asString());
-        }
-        return ips;
-      };
-
-      // Validate IP addresses.
-      std::vector<std::string> destination_ips =
-          createAddressVector(filter_chain_match.prefix_ranges());
-      std::vector<std::string> source_ips =
-          createAddressVector(filter_chain_match.source_prefix_ranges());
-      std::vector<std::string> direct_source_ips =
-          createAddressVector(filter_chain_match.direct_source_prefix_ranges());
-
-      std::vector<std::string> server_names;
-      // Reject partial wildcards, we don't match on them.
-      for (const auto& server_name : filter_chain_match.server_names()) {
-        if (absl::StrContains(server_name, '*') && !isWildcardServerName(server_name)) {
-          throw EnvoyException(
-              fmt::format("error adding listener '{}': partial wildcards are not supported in "
-                          "\"server_names\"",
-                          absl::StrJoin(addresses_, ",", Network::AddressStrFormatter())));
-        }
-        server_names.push_back(absl::AsciiStrToLower(server_name));
-      }
-
-      addFilterChainForDestinationPorts(
-          destination_ports_map_,
-          PROTOBUF_GET_WRAPPED_OR_DEFAULT(filter_chain_match, destination_port, 0), destination_ips,
-          server_names, filter_chain_match.transport_protocol(),
-          filter_chain_match.application_protocols(), direct_source_ips,
-          filter_chain_match.source_type(), source_ips, filter_chain_match.source_ports(),
-          filter_chain_impl);
+      // The index is built per destination port once all the filter chains are known.
+      const uint16_t destination_port =
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(filter_chain_match, destination_port, 0);
+      filter_chains_by_port[destination_port].emplace_back(filter_chain, filter_chain_impl);
     }
 
     fc_contexts_[*filter_chain] = filter_chain_impl;
   }
-  convertIPsToTries();
+  copyOrRebuildDestinationPorts(filter_chains_by_port);
   copyOrRebuildDefaultFilterChain(default_filter_chain, filter_chain_factory_builder,
                                   context_creator);
   // Construct matcher if it is present in the listener configuration.
@@ -355,80 +323,186 @@ void FilterChainManagerImpl::copyOrRebuildDefaultFilterChain(
   }
 }
 
-void FilterChainManagerImpl::addFilterChainForDestinationPorts(
-    DestinationPortsMap& destination_ports_map, uint16_t destination_port,
-    const std::vector<std::string>& destination_ips,
-    const absl::Span<const std::string> server_names, const std::string& transport_protocol,
-    const absl::Span<const std::string* const> application_protocols,
-    const std::vector<std::string>& direct_source_ips,
-    const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
-    const std::vector<std::string>& source_ips,
-    const absl::Span<const Protobuf::uint32> source_ports,
-    const Network::FilterChainSharedPtr& filter_chain) {
-  if (destination_ports_map.find(destination_port) == destination_ports_map.end()) {
-    destination_ports_map[destination_port] =
-        std::make_pair<DestinationIPsMap, DestinationIPsTriePtr>(DestinationIPsMap{}, nullptr);
+namespace {
+
+template <class T> std::vector<std::string> createAddressVector(const T& prefix_ranges) {
+  std::vector<std::string> ips;
+  ips.reserve(prefix_ranges.size());
+  for (const auto& ip : prefix_ranges) {
+    const auto& cidr_range = Network::Address::CidrRange::create(ip);
+    ips.push_back(cidr_range.asString());
   }
-  addFilterChainForDestinationIPs(destination_ports_map[destination_port].first, destination_ips,
-                                  server_names, transport_protocol, application_protocols,
-                                  direct_source_ips, source_type, source_ips, source_ports,
-                                  filter_chain);
+  return ips;
 }
 
-void FilterChainManagerImpl::addFilterChainForDestinationIPs(
-    DestinationIPsMap& destination_ips_map, const std::vector<std::string>& destination_ips,
-    const absl::Span<const std::string> server_names, const std::string& transport_protocol,
-    const absl::Span<const std::string* const> application_protocols,
-    const std::vector<std::string>& direct_source_ips,
-    const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
-    const std::vector<std::string>& source_ips,
-    const absl::Span<const Protobuf::uint32> source_ports,
-    const Network::FilterChainSharedPtr& filter_chain) {
-  if (destination_ips.empty()) {
-    addFilterChainForServerNames(destination_ips_map[EMPTY_STRING], server_names,
-                                 transport_protocol, application_protocols, direct_source_ips,
-                                 source_type, source_ips, source_ports, filter_chain);
-  } else {
-    for (const auto& destination_ip : destination_ips) {
-      addFilterChainForServerNames(destination_ips_map[destination_ip], server_names,
-                                   transport_protocol, application_protocols, direct_source_ips,
-                                   source_type, source_ips, source_ports, filter_chain);
+// The validated source addresses of a filter chain, indexed below its server names.
+struct SourceAddresses {
+  std::vector<std::string> source_ips_;
+  std::vector<std::string> direct_source_ips_;
+};
+
+// Template function for creating a CIDR list entry for either source or destination address.
+template <class T>
+std::pair<T, std::vector<Network::Address::CidrRange>> makeCidrListEntry(const std::string& cidr,
+                                                                         const T& data) {
+  std::vector<Network::Address::CidrRange> subnets;
+  if (cidr == EMPTY_STRING) {
+    if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET)) {
+      subnets.push_back(
+          Network::Address::CidrRange::create(Network::Utility::getIpv4CidrCatchAllAddress()));
+    }
+    if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET6)) {
+      subnets.push_back(
+          Network::Address::CidrRange::create(Network::Utility::getIpv6CidrCatchAllAddress()));
     }
+  } else {
+    subnets.push_back(Network::Address::CidrRange::create(cidr));
   }
+  return std::make_pair<T, std::vector<Network::Address::CidrRange>>(T(data), std::move(subnets));
 }
 
-void FilterChainManagerImpl::addFilterChainForServerNames(
-    ServerNamesMapSharedPtr& server_names_map_ptr, const absl::Span<const std::string> server_names,
-    const std::string& transport_protocol,
-    const absl::Span<const std::string* const> application_protocols,
-    const std::vector<std::string>& direct_source_ips,
-    const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
-    const std::vector<std::string>& source_ips,
-    const absl::Span<const Protobuf::uint32> source_ports,
-    const Network::FilterChainSharedPtr& filter_chain) {
-  if (server_names_map_ptr == nullptr) {
-    server_names_map_ptr = std::make_shared<ServerNamesMap>();
+}; // namespace
+
+void FilterChainManagerImpl::copyOrRebuildDestinationPorts(
+    const FilterChainsByPort& filter_chains_by_port) {
+  // Origin filter chain manager could be empty if the current is the ancestor.
+  const auto* origin = getOriginFilterChainManager();
+  uint32_t copied_destination_ports = 0;
+  for (const auto& [destination_port, filter_chains] : filter_chains_by_port) {
+    FilterChainSet filter_chain_set;
+    filter_chain_set.reserve(filter_chains.size());
+    for (const auto& filter_chain : filter_chains) {
+      filter_chain_set.insert(filter_chain.second.get());
+    }
+
+    // Copy the subtree of the original filter chain manager if it indexes exactly the same filter
+    // chains. This skips the validation, the map building and the trie conversion of all the
+    // filter chains on the port.
+    const DestinationPortEntry* origin_destination_port_entry = nullptr;
+    if (origin != nullptr) {
+      const auto origin_iter = origin->destination_ports_map_.find(destination_port);
+      if (origin_iter != origin->destination_ports_map_.end()) {
+        if (origin_iter->second->filter_chains_ == filter_chain_set) {
+          destination_ports_map_.emplace(destination_port, origin_iter->second);
+          ++copied_destination_ports;
+          continue;
+        }
+        origin_destination_port_entry = origin_iter->second.get();
+      }
+    }
+
+    auto destination_port_entry = std::make_shared<DestinationPortEntry>();
+    destination_port_entry->filter_chains_ = std::move(filter_chain_set);
+    copyOrRebuildServerNames(*destination_port_entry, origin_destination_port_entry,
+                             filter_chains);
+    destination_ports_map_.emplace(destination_port, std::move(destination_port_entry));
+  }
+  ENVOY_LOG(debug, "new destination ports map has {} ports, including {} copied",
+            destination_ports_map_.size(), copied_destination_ports);
+}
+
+void FilterChainManagerImpl::copyOrRebuildServerNames(
+    DestinationPortEntry& destination_port_entry,
+    const DestinationPortEntry* origin_destination_port_entry,
+    const FilterChainsByPort::mapped_type& filter_chains) {
+  std::vector<SourceAddresses> source_addresses;
+  source_addresses.reserve(filter_chains.size());
+  // Indices of the filter chains on the port, keyed by destination IP and then server name.
+  absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, std::vector<size_t>>>
+      filter_chain_indices;
+  for (size_t i = 0; i < filter_chains.size(); i++) {
+    const auto& filter_chain_match = filter_chains[i].first->filter_chain_match();
+    // Validate IP addresses.
+    std::vector<std::string> destination_ips =
+        createAddressVector(filter_chain_match.prefix_ranges());
+    std::vector<std::string> source_ips =
+        createAddressVector(filter_chain_match.source_prefix_ranges());
+    std::vector<std::string> direct_source_ips =
+        createAddressVector(filter_chain_match.direct_source_prefix_ranges());
+    source_addresses.push_back({std::move(source_ips), std::move(direct_source_ips)});
+
+    std::vector<std::string> server_names;
+    // Reject partial wildcards, we don't match on them.
+    for (const auto& server_name : filter_chain_match.server_names()) {
+      if (absl::StrContains(server_name, '*') && !isWildcardServerName(server_name)) {
+        throw EnvoyException(
+            fmt::format("error adding listener '{}': partial wildcards are not supported in "
+                        "\"server_names\"",
+                        absl::StrJoin(addresses_, ",", Network::AddressStrFormatter())));
+      }
+      // Map the wildcard domain, i.e. ".example.com" for "*.example.com".
+      server_names.push_back(absl::AsciiStrToLower(
+          isWildcardServerName(server_name) ? server_name.substr(1) : server_name));
+    }
+
+    if (destination_ips.empty()) {
+      destination_ips.push_back(EMPTY_STRING);
+    }
+    if (server_names.empty()) {
+      server_names.push_back(EMPTY_STRING);
+    }
+    for (const auto& destination_ip : destination_ips) {
+      auto& server_name_indices = filter_chain_indices[destination_ip];
+      for (const auto& server_name : server_names) {
+        server_name_indices[server_name].push_back(i);
+      }
+    }
   }
-  auto& server_names_map = *server_names_map_ptr;
 
-  if (server_names.empty()) {
-    addFilterChainForApplicationProtocols(server_names_map[EMPTY_STRING][transport_protocol],
-                                          application_protocols, direct_source_ips, source_type,
-                                          source_ips, source_ports, filter_chain);
-  } else {
-    for (const auto& server_name : server_names) {
-      if (isWildcardServerName(server_name)) {
-        // Add mapping for the wildcard domain, i.e. ".example.com" for "*.example.com".
+  std::vector<std::pair<ServerNamesIndexSharedPtr, std::vector<Network::Address::CidrRange>>>
+      destination_ips_list;
+  destination_ips_list.reserve(filter_chain_indices.size());
+  for (const auto& [destination_ip, server_name_indices] : filter_chain_indices) {
+    const ServerNamesIndex* origin_server_names_index = nullptr;
+    if (origin_destination_port_entry != nullptr) {
+      const auto origin_iter =
+          origin_destination_port_entry->destination_ips_map_.find(destination_ip);
+      if (origin_iter != origin_destination_port_entry->destination_ips_map_.end()) {
+        origin_server_names_index = origin_iter->second.get();
+      }
+    }
+
+    std::vector<std::pair<std::string, ServerNameEntrySharedPtr>> server_names;
+    server_names.reserve(server_name_indices.size());
+    for (const auto& [server_name, indices] : server_name_indices) {
+      FilterChainSet filter_chain_set;
+      filter_chain_set.reserve(indices.size());
+      for (const size_t index : indices) {
+        filter_chain_set.insert(filter_chains[index].second.get());
+      }
+
+      // Copy the subtree of the original filter chain manager if it indexes exactly the same
+      // filter chains, so that an update of one server name doesn't rebuild the others.
+      if (origin_server_names_index != nullptr) {
+        const auto* origin_server_name_entry = origin_server_names_index->findExact(server_name);
+        if (origin_server_name_entry != nullptr &&
+            (*origin_server_name_entry)->filter_chains_ == filter_chain_set) {
+          server_names.emplace_back(server_name, *origin_server_name_entry);
+          continue;
+        }
+      }
+
+      auto server_name_entry = std::make_shared<ServerNameEntry>();
+      server_name_entry->filter_chains_ = std::move(filter_chain_set);
+      for (const size_t index : indices) {
+        const auto& filter_chain_match = filter_chains[index].first->filter_chain_match();
         addFilterChainForApplicationProtocols(
-            server_names_map[server_name.substr(1)][transport_protocol], application_protocols,
-            direct_source_ips, source_type, source_ips, source_ports, filter_chain);
-      } else {
-        addFilterChainForApplicationProtocols(server_names_map[server_name][transport_protocol],
-                                              application_protocols, direct_source_ips, source_type,
-                                              source_ips, source_ports, filter_chain);
+            server_name_entry->transport_protocols_map_[filter_chain_match.transport_protocol()],
+            filter_chain_match.application_protocols(), source_addresses[index].direct_source_ips_,
+            filter_chain_match.source_type(), source_addresses[index].source_ips_,
+            filter_chain_match.source_ports(), filter_chains[index].second);
       }
+      convertIPsToTries(*server_name_entry);
+      server_names.emplace_back(server_name, std::move(server_name_entry));
     }
+
+    auto server_names_index = std::make_shared<const ServerNamesIndex>(std::move(server_names));
+    destination_ips_list.push_back(makeCidrListEntry(destination_ip, server_names_index));
+    destination_port_entry.destination_ips_map_.emplace(destination_ip,
+                                                        std::move(server_names_index));
   }
+  destination_port_entry.destination_ips_trie_ =
+      std::make_unique<DestinationIPsTrie>(destination_ips_list, true);
 }
 
 void FilterChainManagerImpl::addFilterChainForApplicationProtocols(
@@ -523,30 +597,6 @@ void FilterChainManagerImpl::addFilterChainForSourcePorts(
   }
 }
 
-namespace {
-
-// Template function for creating a CIDR list entry for either source or destination address.
-template <class T>
-std::pair<T, std::vector<Network::Address::CidrRange>> makeCidrListEntry(const std::string& cidr,
-                                                                         const T& data) {
-  std::vector<Network::Address::CidrRange> subnets;
-  if (cidr == EMPTY_STRING) {
-    if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET)) {
-      subnets.push_back(
-          Network::Address::CidrRange::create(Network::Utility::getIpv4CidrCatchAllAddress()));
-    }
-    if (Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET6)) {
-      subnets.push_back(
-          Network::Address::CidrRange::create(Network::Utility::getIpv6CidrCatchAllAddress()));
-    }
-  } else {
-    subnets.push_back(Network::Address::CidrRange::create(cidr));
-  }
-  return std::make_pair<T, std::vector<Network::Address::CidrRange>>(T(data), std::move(subnets));
-}
-
-}; // namespace
-
 const Network::FilterChain*
 FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
                                         const StreamInfo::StreamInfo& info) const {
@@ -561,7 +611,8 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   if (address->type() == Network::Address::Type::Ip) {
     const auto port_match = destination_ports_map_.find(address->ip()->port());
     if (port_match != destination_ports_map_.end()) {
-      best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+      best_match_filter_chain =
+          findFilterChainForDestinationIP(*port_match->second->destination_ips_trie_, socket);
       if (best_match_filter_chain != nullptr) {
         return best_match_filter_chain;
       } else {
@@ -574,7 +625,8 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   // Match on catch-all port 0 if there is no specific port sub tree.
   const auto port_match = destination_ports_map_.find(0);
   if (port_match != destination_ports_map_.end()) {
-    best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+    best_match_filter_chain =
+        findFilterChainForDestinationIP(*port_match->second->destination_ips_trie_, socket);
   }
   return best_match_filter_chain != nullptr
              ? best_match_filter_chain
@@ -615,31 +667,15 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
-    const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
+    const ServerNamesIndex& server_names_index, const Network::ConnectionSocket& socket) const {
   ASSERT(absl::AsciiStrToLower(socket.requestedServerName()) == socket.requestedServerName());
-  const std::string server_name(socket.requestedServerName());
-
-  // Match on exact server name, i.e. "www.example.com" for "www.example.com".
-  const auto server_name_exact_match = server_names_map.find(server_name);
-  if (server_name_exact_match != server_names_map.end()) {
-    return findFilterChainForTransportProtocol(server_name_exact_match->second, socket);
-  }
-
-  // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
-  size_t pos = server_name.find('.', 1);
-  while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
-    const auto server_name_wildcard_match = server_names_map.find(wildcard);
-    if (server_name_wildcard_match != server_names_map.end()) {
-      return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
-    }
-    pos = server_name.find('.', pos + 1);
-  }
 
-  // Match on a filter chain without server name requirements.
-  const auto server_name_catchall_match = server_names_map.find(EMPTY_STRING);
-  if (server_name_catchall_match != server_names_map.end()) {
-    return findFilterChainForTransportProtocol(server_name_catchall_match->second, socket);
+  // Match on exact server name, then on the longest wildcard domain, then on a filter chain
+  // without server name requirements.
+  const auto* server_name_entry = server_names_index.find(socket.requestedServerName());
+  if (server_name_entry != nullptr) {
+    return findFilterChainForTransportProtocol((*server_name_entry)->transport_protocols_map_,
+                                               socket);
   }
 
   return nullptr;
@@ -770,59 +806,38 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAn
   return nullptr;
 }
 
-void FilterChainManagerImpl::convertIPsToTries() {
-  for (auto& [destination_port, destination_ips_pair] : destination_ports_map_) {
-    UNREFERENCED_PARAMETER(destination_port);
-    // These variables are used as we build up the destination CIDRs used for the trie.
-    auto& [destination_ips_map, destination_ips_trie] = destination_ips_pair;
-    std::vector<std::pair<ServerNamesMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-        destination_ips_list;
-    destination_ips_list.reserve(destination_ips_map.size());
-
-    for (const auto& [destination_ip, server_names_map_ptr] : destination_ips_map) {
-      destination_ips_list.push_back(makeCidrListEntry(destination_ip, server_names_map_ptr));
-
-      // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
-      // We need to get access to all of the source IP strings so that we can convert them into
-      // a trie like we did for the destination IPs above.
-      for (auto& [server_name, transport_protocols_map] : *server_names_map_ptr) {
-        UNREFERENCED_PARAMETER(server_name);
-        for (auto& [transport_protocol, application_protocols_map] : transport_protocols_map) {
-          UNREFERENCED_PARAMETER(transport_protocol);
-          for (auto& [application_protocol, direct_source_ips_pair] : application_protocols_map) {
-            UNREFERENCED_PARAMETER(application_protocol);
-            auto& [direct_source_ips_map, direct_source_ips_trie] = direct_source_ips_pair;
-
-            std::vector<
-                std::pair<SourceTypesArraySharedPtr, std::vector<Network::Address::CidrRange>>>
-                direct_source_ips_list;
-            direct_source_ips_list.reserve(direct_source_ips_map.size());
-
-            for (auto& [direct_source_ip, source_arrays_ptr] : direct_source_ips_map) {
-              direct_source_ips_list.push_back(
-                  makeCidrListEntry(direct_source_ip, source_arrays_ptr));
-
-              for (auto& [source_ips_map, source_ips_trie] : *source_arrays_ptr) {
-                std::vector<
-                    std::pair<SourcePortsMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-                    source_ips_list;
-                source_ips_list.reserve(source_ips_map.size());
-
-                for (auto& [source_ip, source_port_map_ptr] : source_ips_map) {
-                  source_ips_list.push_back(makeCidrListEntry(source_ip, source_port_map_ptr));
-                }
-
-                source_ips_trie = std::make_unique<SourceIPsTrie>(source_ips_list, true);
-              }
-            }
-            direct_source_ips_trie =
-                std::make_unique<DirectSourceIPsTrie>(direct_source_ips_list, true);
+void FilterChainManagerImpl::convertIPsToTries(ServerNameEntry& server_name_entry) {
+  // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
+  // We need to get access to all of the source IP strings so that we can convert them into
+  // a trie like we did for the destination IPs.
+  for (auto& [transport_protocol, application_protocols_map] :
+       server_name_entry.transport_protocols_map_) {
+    UNREFERENCED_PARAMETER(transport_protocol);
+    for (auto& [application_protocol, direct_source_ips_pair] : application_protocols_map) {
+      UNREFERENCED_PARAMETER(application_protocol);
+      auto& [direct_source_ips_map, direct_source_ips_trie] = direct_source_ips_pair;
+
+      std::vector<std::pair<SourceTypesArraySharedPtr, std::vector<Network::Address::CidrRange>>>
+          direct_source_ips_list;
+      direct_source_ips_list.reserve(direct_source_ips_map.size());
+
+      for (auto& [direct_source_ip, source_arrays_ptr] : direct_source_ips_map) {
+        direct_source_ips_list.push_back(makeCidrListEntry(direct_source_ip, source_arrays_ptr));
+
+        for (auto& [source_ips_map, source_ips_trie] : *source_arrays_ptr) {
+          std::vector<std::pair<SourcePortsMapSharedPtr, std::vector<Network::Address::CidrRange>>>
+              source_ips_list;
+          source_ips_list.reserve(source_ips_map.size());
+
+          for (auto& [source_ip, source_port_map_ptr] : source_ips_map) {
+            source_ips_list.push_back(makeCidrListEntry(source_ip, source_port_map_ptr));
           }
+
+          source_ips_trie = std::make_unique<SourceIPsTrie>(source_ips_list, true);
         }
       }
+      direct_source_ips_trie = std::make_unique<DirectSourceIPsTrie>(direct_source_ips_list, true);
     }
-
-    destination_ips_trie = std::make_unique<DestinationIPsTrie>(destination_ips_list, true);
   }
 }
 
@@ -21,9 +21,11 @@
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/lc_trie.h"
 #include "source/extensions/listener_managers/listener_manager/filter_chain_factory_context_callback.h"
+#include "source/extensions/listener_managers/listener_manager/server_name_index.h"
 #include "source/server/factory_context_impl.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 
 namespace Envoy {
 namespace Server {
@@ -193,7 +195,6 @@ public:
   }
 
 private:
-  void convertIPsToTries();
   const Network::FilterChain* findFilterChainUsingMatcher(const Network::ConnectionSocket& socket,
                                                           const StreamInfo::StreamInfo& info) const;
 
@@ -226,45 +227,44 @@ private:
 
   using ApplicationProtocolsMap = absl::flat_hash_map<std::string, DirectSourceIPsPair>;
   using TransportProtocolsMap = absl::flat_hash_map<std::string, ApplicationProtocolsMap>;
-  // Both exact server names and wildcard domains are part of the same map, in which wildcard
+  // The filter chains indexed by a lookup subtree. Filter chains are reused across generations of
+  // filter chain manager iff their messages are equal, so equal sets imply equal subtrees.
+  using FilterChainSet = absl::flat_hash_set<const Network::FilterChain*>;
+  // The lookup subtree of a server name. It is immutable once built, and shared with the next
+  // generation of filter chain manager as long as the filter chains on it are unchanged.
+  struct ServerNameEntry {
+    TransportProtocolsMap transport_protocols_map_;
+    FilterChainSet filter_chains_;
+  };
+  using ServerNameEntrySharedPtr = std::shared_ptr<const ServerNameEntry>;
+  // Both exact server names and wildcard domains are part of the same index, in which wildcard
   // domains are prefixed with "." (i.e. ".example.com" for "*.example.com") to differentiate
   // between exact and wildcard entries.
-  using ServerNamesMap = absl::flat_hash_map<std::string, TransportProtocolsMap>;
-  using ServerNamesMapSharedPtr = std::shared_ptr<ServerNamesMap>;
-  using DestinationIPsMap = absl::flat_hash_map<std::string, ServerNamesMapSharedPtr>;
-  using DestinationIPsTrie = Network::LcTrie::LcTrie<ServerNamesMapSharedPtr>;
+  using ServerNamesIndex = ServerNameIndex<ServerNameEntrySharedPtr>;
+  using ServerNamesIndexSharedPtr = std::shared_ptr<const ServerNamesIndex>;
+  using DestinationIPsMap = absl::flat_hash_map<std::string, ServerNamesIndexSharedPtr>;
+  using DestinationIPsTrie = Network::LcTrie::LcTrie<ServerNamesIndexSharedPtr>;
   using DestinationIPsTriePtr = std::unique_ptr<DestinationIPsTrie>;
-  using DestinationPortsMap =
-      absl::flat_hash_map<uint16_t, std::pair<DestinationIPsMap, DestinationIPsTriePtr>>;
-
-  void addFilterChainForDestinationPorts(
-      DestinationPortsMap& destination_ports_map, uint16_t destination_port,
-      const std::vector<std::string>& destination_ips,
-      const absl::Span<const std::string> server_names, const std::string& transport_protocol,
-      const absl::Span<const std::string* const> application_protocols,
-      const std::vector<std::string>& direct_source_ips,
-      const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
-      const std::vector<std::string>& source_ips,
-      const absl::Span<const Protobuf::uint32> source_ports,
-      const Network::FilterChainSharedPtr& filter_chain);
-  void addFilterChainForDestinationIPs(
-      DestinationIPsMap& destination_ips_map, const std::vector<std::string>& destination_ips,
-      const absl::Span<const std::string> server_names, const std::string& transport_protocol,
-      const absl::Span<const std::string* const> application_protocols,
-      const std::vector<std::string>& direct_source_ips,
-      const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
-      const std::vector<std::string>& source_ips,
-      const absl::Span<const Protobuf::uint32> source_ports,
-      const Network::FilterChainSharedPtr& filter_chain);
-  void addFilterChainForServerNames(
-      ServerNamesMapSharedPtr& server_names_map_ptr,
-      const absl::Span<const std::string> server_names, const std::string& transport_protocol,
-      const absl::Span<const std::string* const> application_protocols,
-      const std::vector<std::string>& direct_source_ips,
-      const envoy::config::listener::v3::FilterChainMatch::ConnectionSourceType source_type,
-      const std::vector<std::string>& source_ips,
-      const absl::Span<const Protobuf::uint32> source_ports,
-      const Network::FilterChainSharedPtr& filter_chain);
+  // The lookup subtree of a destination port, immutable and shared like ServerNameEntry.
+  struct DestinationPortEntry {
+    DestinationIPsMap destination_ips_map_;
+    DestinationIPsTriePtr destination_ips_trie_;
+    FilterChainSet filter_chains_;
+  };
+  using DestinationPortEntrySharedPtr = std::shared_ptr<const DestinationPortEntry>;
+  using DestinationPortsMap = absl::flat_hash_map<uint16_t, DestinationPortEntrySharedPtr>;
+  using FilterChainsByPort = absl::flat_hash_map<
+      uint16_t, std::vector<std::pair<const envoy::config::listener::v3::FilterChain*,
+                                      Network::FilterChainSharedPtr>>>;
+
+  // Build the lookup subtree of each destination port. Skip the build but copy the subtrees of
+  // ports and server names whose filter chains are unchanged from the original filter chain
+  // manager. Called by addFilterChains().
+  void copyOrRebuildDestinationPorts(const FilterChainsByPort& filter_chains_by_port);
+  void copyOrRebuildServerNames(DestinationPortEntry& destination_port_entry,
+                                const DestinationPortEntry* origin_destination_port_entry,
+                                const FilterChainsByPort::mapped_type& filter_chains);
+  void convertIPsToTries(ServerNameEntry& server_name_entry);
   void addFilterChainForApplicationProtocols(
       ApplicationProtocolsMap& application_protocol_map,
       const absl::Span<const std::string* const> application_protocols,
@@ -296,7 +296,7 @@ private:
   findFilterChainForDestinationIP(const DestinationIPsTrie& destination_ips_trie,
                                   const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
-  findFilterChainForServerName(const ServerNamesMap& server_names_map,
+  findFilterChainForServerName(const ServerNamesIndex& server_names_index,
                                const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForTransportProtocol(const TransportProtocolsMap& transport_protocols_map,
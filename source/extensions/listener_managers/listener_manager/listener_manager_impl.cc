@@ -1,6 +1,7 @@
 #include "source/extensions/listener_managers/listener_manager/listener_manager_impl.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "envoy/admin/v3/config_dump.pb.h"
 #include "envoy/config/core/v3/address.pb.h"
@@ -957,6 +958,52 @@ void ListenerManagerImpl::stopWorkers() {
   }
 }
 
+void ListenerManagerImpl::migrateIdleConnections(MigrateIdleConnectionsCallback callback) {
+  if (!workers_started_ || workers_.empty()) {
+    callback({});
+    return;
+  }
+  // The callback is called once all the workers are done, with the sockets of all of them.
+  auto remaining_workers = std::make_shared<size_t>(workers_.size());
+  auto all_sockets = std::make_shared<std::vector<Network::IoHandlePtr>>();
+  for (const auto& worker : workers_) {
+    worker->migrateIdleConnections([this, callback, remaining_workers, all_sockets](
+                                       std::vector<Network::IoHandlePtr>&& sockets) -> void {
+      server_.dispatcher().post([this, callback, remaining_workers, all_sockets,
+                                 sockets = std::move(sockets)]() mutable {
+        stats_.idle_connections_migrated_.add(sockets.size());
+        std::move(sockets.begin(), sockets.end(), std::back_inserter(*all_sockets));
+        if (--*remaining_workers == 0) {
+          callback(std::move(*all_sockets));
+        }
+      });
+    });
+  }
+}
+
+void ListenerManagerImpl::acceptMigratedConnection(os_fd_t fd) {
+  Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>(fd);
+  if (!workers_started_) {
+    return;
+  }
+  Network::ConnectionSocketPtr socket;
+  TRY_ASSERT_MAIN_THREAD {
+    // The peer may have closed the connection since it was migrated.
+    Network::Address::InstanceConstSharedPtr local_address = io_handle->localAddress();
+    Network::Address::InstanceConstSharedPtr remote_address = io_handle->peerAddress();
+    socket = std::make_unique<Network::AcceptedSocketImpl>(std::move(io_handle), local_address,
+                                                           remote_address);
+  }
+  END_TRY
+  catch (const EnvoyException& e) {
+    ENVOY_LOG(debug, "closing migrated connection: {}", e.what());
+    return;
+  }
+  stats_.migrated_connections_accepted_.inc();
+  workers_[next_migrated_connection_worker_++ % workers_.size()]->acceptMigratedConnection(
+      std::move(socket));
+}
+
 void ListenerManagerImpl::endListenerUpdate(FailureStates&& failure_states) {
   overall_error_state_ = std::move(failure_states);
 }
@@ -120,6 +120,7 @@ using ListenerImplPtr = std::unique_ptr<ListenerImpl>;
  * All listener manager stats. @see stats_macros.h
  */
 #define ALL_LISTENER_MANAGER_STATS(COUNTER, GAUGE)                                                 \
+  COUNTER(idle_connections_migrated)                                                               \
   COUNTER(listener_added)                                                                          \
   COUNTER(listener_create_failure)                                                                 \
   COUNTER(listener_create_success)                                                                 \
@@ -127,6 +128,7 @@ using ListenerImplPtr = std::unique_ptr<ListenerImpl>;
   COUNTER(listener_modified)                                                                       \
   COUNTER(listener_removed)                                                                        \
   COUNTER(listener_stopped)                                                                        \
+  COUNTER(migrated_connections_accepted)                                                           \
   GAUGE(total_filter_chains_draining, NeverImport)                                                 \
   GAUGE(total_listeners_active, NeverImport)                                                       \
   GAUGE(total_listeners_draining, NeverImport)                                                     \
@@ -209,6 +211,8 @@ public:
   void beginListenerUpdate() override { error_state_tracker_.clear(); }
   void endListenerUpdate(FailureStates&& failure_state) override;
   bool isWorkerStarted() override { return workers_started_; }
+  void migrateIdleConnections(MigrateIdleConnectionsCallback callback) override;
+  void acceptMigratedConnection(os_fd_t fd) override;
   Http::Context& httpContext() { return server_.httpContext(); }
   ApiListenerOptRef apiListener() override;
 
@@ -323,6 +327,8 @@ private:
 
   std::vector<WorkerPtr> workers_;
   bool workers_started_{};
+  // Index of the worker to accept the next connection migrated from the parent process.
+  uint32_t next_migrated_connection_worker_{};
   absl::optional<StopListenersType> stop_listeners_type_;
   Stats::ScopeSharedPtr scope_;
   ListenerManagerStats stats_;
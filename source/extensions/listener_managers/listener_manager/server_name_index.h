@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/common/assert.h"
+
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * Compact, read-only index of the server names of filter chains. Exact server names, wildcard
+ * domains prefixed with "." (i.e. ".example.com" for "*.example.com") and the catch-all empty
+ * name are stored back to back in a single buffer, and found through an open addressing table of
+ * 32 bit entry indices. For hundreds of thousands of names this takes a fraction of the memory of
+ * a hash map of strings.
+ *
+ * Wildcard matching only looks up the suffixes of a server name with as many labels as one of the
+ * indexed wildcard domains, and never copies them, so that misses stay cheap.
+ */
+template <class T> class ServerNameIndex {
+public:
+  /**
+   * @param names supplies the unique, lower case server names and their data.
+   */
+  explicit ServerNameIndex(std::vector<std::pair<std::string, T>>&& names) {
+    size_t names_size = 0;
+    for (const auto& name : names) {
+      names_size += name.first.size();
+    }
+    RELEASE_ASSERT(names_size <= UINT32_MAX, "server names do not fit in the index");
+    names_.reserve(names_size);
+    entries_.reserve(names.size());
+    data_.reserve(names.size());
+
+    // Keep the table at most half full, so that probe sequences stay short and always end.
+    size_t slots = 1;
+    while (slots < names.size() * 2) {
+      slots <<= 1;
+    }
+    slots_.assign(slots, 0);
+    const size_t mask = slots_.size() - 1;
+
+    for (auto& [name, data] : names) {
+      if (!name.empty() && name[0] == '.') {
+        wildcard_dots_ |= dotsBit(std::count(name.begin(), name.end(), '.'));
+      }
+      size_t slot = absl::Hash<absl::string_view>{}(name) & mask;
+      while (slots_[slot] != 0) {
+        ASSERT(entryName(slots_[slot] - 1) != name);
+        slot = (slot + 1) & mask;
+      }
+      entries_.push_back(
+          {static_cast<uint32_t>(names_.size()), static_cast<uint32_t>(name.size())});
+      slots_[slot] = entries_.size();
+      names_.append(name);
+      data_.push_back(std::move(data));
+    }
+  }
+
+  /**
+   * @param name supplies the server name, wildcard domain or empty name to look up exactly.
+   * @return the data of the name, or nullptr if the name isn't indexed.
+   */
+  const T* findExact(absl::string_view name) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = absl::Hash<absl::string_view>{}(name) & mask; slots_[slot] != 0;
+         slot = (slot + 1) & mask) {
+      const uint32_t index = slots_[slot] - 1;
+      if (entryName(index) == name) {
+        return &data_[index];
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @param server_name supplies the lower case server name of a connection.
+   * @return the data of the exact server name, else of the longest matching wildcard domain, else
+   *         of the catch-all empty name, or nullptr if none is indexed.
+   */
+  const T* find(absl::string_view server_name) const {
+    // Match on exact server name, i.e. "www.example.com" for "www.example.com".
+    const T* data = findExact(server_name);
+    if (data != nullptr) {
+      return data;
+    }
+
+    // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
+    if (wildcard_dots_ != 0) {
+      size_t pos = server_name.find('.', 1);
+      size_t dots = pos == absl::string_view::npos
+                        ? 0
+                        : std::count(server_name.begin() + pos, server_name.end(), '.');
+      while (pos < server_name.size() - 1 && pos != absl::string_view::npos) {
+        if ((wildcard_dots_ & dotsBit(dots)) != 0) {
+          data = findExact(server_name.substr(pos));
+          if (data != nullptr) {
+            return data;
+          }
+        }
+        --dots;
+        pos = server_name.find('.', pos + 1);
+      }
+    }
+
+    // Match on a filter chain without server name requirements.
+    return findExact(absl::string_view());
+  }
+
+  /**
+   * @return the number of indexed names.
+   */
+  size_t size() const { return entries_.size(); }
+
+private:
+  struct Entry {
+    uint32_t offset_;
+    uint32_t length_;
+  };
+
+  // Wildcard domains are tracked by their number of dots, domains with 63 dots or more sharing
+  // the last bit.
+  static uint64_t dotsBit(size_t dots) { return uint64_t(1) << std::min<size_t>(dots, 63); }
+
+  absl::string_view entryName(uint32_t index) const {
+    return absl::string_view(names_).substr(entries_[index].offset_, entries_[index].length_);
+  }
+
+  std::string names_;
+  std::vector<Entry> entries_;
+  std::vector<T> data_;
+  // Entry index + 1 of each slot, 0 for an empty slot. The size is a power of 2.
+  std::vector<uint32_t> slots_;
+  uint64_t wildcard_dots_{0};
+};
+
+} // namespace Server
+} // namespace Envoy
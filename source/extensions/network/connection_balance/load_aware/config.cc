@@ -0,0 +1,37 @@
+#include "source/extensions/network/connection_balance/load_aware/config.h"
+
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/network/connection_balance/load_aware/load_aware_balancer.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+Network::ConnectionBalancerSharedPtr
+LoadAwareConnectionBalanceFactory::createConnectionBalancerFromProto(
+    const Protobuf::Message& config, Server::Configuration::FactoryContext& context) {
+  const auto& typed_config =
+      dynamic_cast<const envoy::config::core::v3::TypedExtensionConfig&>(config);
+  envoy::extensions::network::connection_balance::load_aware::v3::LoadAware proto_config;
+  MessageUtil::anyConvertAndValidate(typed_config.typed_config(), proto_config,
+                                     context.messageValidationVisitor());
+
+  return std::make_shared<LoadAwareConnectionBalancerImpl>(
+      context.threadLocal(), context.listenerScope(),
+      std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(proto_config, sample_interval, 100)),
+      std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(proto_config, lag_tolerance, 1)));
+}
+
+/**
+ * Static registration for the load aware connection balancer. @see RegisterFactory.
+ */
+REGISTER_FACTORY(LoadAwareConnectionBalanceFactory, Network::ConnectionBalanceFactory);
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
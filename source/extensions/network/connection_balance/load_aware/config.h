@@ -0,0 +1,36 @@
+#pragma once
+
+#include "envoy/extensions/network/connection_balance/load_aware/v3/load_aware.pb.h"
+#include "envoy/extensions/network/connection_balance/load_aware/v3/load_aware.pb.validate.h"
+
+#include "source/common/network/connection_balancer_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+/**
+ * Config registration for the load aware connection balancer. @see ConnectionBalanceFactory.
+ */
+class LoadAwareConnectionBalanceFactory : public Network::ConnectionBalanceFactory {
+public:
+  // Network::ConnectionBalanceFactory
+  Network::ConnectionBalancerSharedPtr
+  createConnectionBalancerFromProto(const Protobuf::Message& config,
+                                    Server::Configuration::FactoryContext& context) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<
+        envoy::extensions::network::connection_balance::load_aware::v3::LoadAware>();
+  }
+
+  std::string name() const override { return "envoy.network.connection_balance.load_aware"; }
+};
+
+DECLARE_FACTORY(LoadAwareConnectionBalanceFactory);
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
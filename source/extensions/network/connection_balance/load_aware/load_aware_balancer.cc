@@ -0,0 +1,196 @@
+#include "source/extensions/network/connection_balance/load_aware/load_aware_balancer.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <thread>
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+namespace {
+
+LoadAwareBalancerStats generateStats(Stats::Scope& scope) {
+  const std::string prefix = "connection_balance.load_aware.";
+  return {ALL_LOAD_AWARE_BALANCER_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                        POOL_GAUGE_PREFIX(scope, prefix))};
+}
+
+} // namespace
+
+WorkerLoadMonitor::WorkerLoadMonitor(Event::Dispatcher& dispatcher, WorkerLoadSharedPtr load,
+                                     std::chrono::milliseconds sample_interval)
+    : load_(std::move(load)), sample_interval_(sample_interval),
+      time_source_(dispatcher.timeSource()),
+      timer_(dispatcher.createTimer([this]() { onTimer(); })) {
+  armTimer();
+}
+
+void WorkerLoadMonitor::armTimer() {
+  expected_fire_time_ = time_source_.monotonicTime() + sample_interval_;
+  timer_->enableTimer(sample_interval_);
+}
+
+void WorkerLoadMonitor::onTimer() {
+  const MonotonicTime now = time_source_.monotonicTime();
+  const uint64_t lag_us =
+      now > expected_fire_time_
+          ? std::chrono::duration_cast<std::chrono::microseconds>(now - expected_fire_time_).count()
+          : 0;
+  // Only this worker writes its lag, which is smoothed so that a single slow iteration of the
+  // event loop does not send every new connection elsewhere.
+  const uint64_t smoothed_lag_us =
+      (load_->loop_lag_us_.load(std::memory_order_relaxed) * 3 + lag_us) / 4;
+  load_->loop_lag_us_.store(smoothed_lag_us, std::memory_order_relaxed);
+  armTimer();
+}
+
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(
+    ThreadLocal::SlotAllocator& tls, Stats::Scope& scope,
+    std::chrono::milliseconds sample_interval, std::chrono::microseconds lag_tolerance)
+    : stats_(generateStats(scope)), lag_tolerance_(lag_tolerance),
+      tls_slot_(ThreadLocal::TypedSlot<WorkerLoadMonitor>::makeUnique(tls)) {
+  tls_slot_->set([this, sample_interval](Event::Dispatcher& dispatcher) {
+    auto load = std::make_shared<WorkerLoad>();
+    addWorker(load);
+    return std::make_shared<WorkerLoadMonitor>(dispatcher, std::move(load), sample_interval);
+  });
+}
+
+void LoadAwareConnectionBalancerImpl::addWorker(WorkerLoadSharedPtr load) {
+  absl::MutexLock lock(&lock_);
+  auto loads = loads_snapshots_.empty()
+                   ? std::make_unique<WorkerLoads>()
+                   : std::make_unique<WorkerLoads>(*loads_snapshots_.back());
+  loads->push_back(std::move(load));
+  loads_.store(loads.get(), std::memory_order_release);
+  loads_snapshots_.push_back(std::move(loads));
+}
+
+WorkerLoad* LoadAwareConnectionBalancerImpl::currentWorkerLoad() {
+  if (!tls_slot_->currentThreadRegistered() || !tls_slot_->get().has_value()) {
+    return nullptr;
+  }
+  return &tls_slot_->get()->load();
+}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(Network::BalancedConnectionHandler& handler) {
+  // Handlers are registered by the worker they belong to, after the slot has been set on it.
+  WorkerLoad* load = currentWorkerLoad();
+  if (load == nullptr) {
+    ENVOY_LOG(debug, "load aware balancer: handler registered on a thread without a load");
+    return;
+  }
+  load->handler_.store(&handler);
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(
+    Network::BalancedConnectionHandler& handler) {
+  // The lock waits for the picks of threads without a load.
+  absl::MutexLock lock(&lock_);
+  const WorkerLoads* loads = loads_.load(std::memory_order_acquire);
+  if (loads == nullptr) {
+    return;
+  }
+  for (const WorkerLoadSharedPtr& load : *loads) {
+    Network::BalancedConnectionHandler* expected = &handler;
+    load->handler_.compare_exchange_strong(expected, nullptr);
+  }
+  // Once this returns the handler may be destroyed, so wait for the workers which were picking and
+  // may have read it before it was cleared. Picks starting from now don't see it.
+  for (const WorkerLoadSharedPtr& load : *loads) {
+    const uint64_t epoch = load->pick_epoch_.load();
+    if (epoch % 2 == 0) {
+      continue;
+    }
+    while (load->pick_epoch_.load(std::memory_order_acquire) == epoch) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+Network::BalancedConnectionHandler& LoadAwareConnectionBalancerImpl::pickTargetHandler(
+    Network::BalancedConnectionHandler& current_handler) {
+  const WorkerLoads* loads = loads_.load(std::memory_order_acquire);
+  if (loads == nullptr) {
+    current_handler.incNumConnections();
+    return current_handler;
+  }
+
+  WorkerLoad* picker = currentWorkerLoad();
+  if (picker == nullptr) {
+    absl::ReaderMutexLock lock(&lock_);
+    return pickTargetHandlerFrom(*loads, current_handler);
+  }
+  // Handlers stay alive while the epoch is odd, so it is only bumped back once the target has been
+  // charged for the connection.
+  picker->pick_epoch_.fetch_add(1);
+  Network::BalancedConnectionHandler& target = pickTargetHandlerFrom(*loads, current_handler);
+  picker->pick_epoch_.fetch_add(1, std::memory_order_release);
+  return target;
+}
+
+Network::BalancedConnectionHandler& LoadAwareConnectionBalancerImpl::pickTargetHandlerFrom(
+    const WorkerLoads& loads, Network::BalancedConnectionHandler& current_handler) {
+  struct Candidate {
+    Network::BalancedConnectionHandler* handler_;
+    uint64_t loop_lag_us_;
+    uint64_t connections_;
+  };
+
+  absl::InlinedVector<Candidate, 16> candidates;
+  uint64_t min_lag_us = std::numeric_limits<uint64_t>::max();
+  uint64_t max_lag_us = 0;
+  uint64_t min_connections = std::numeric_limits<uint64_t>::max();
+  uint64_t max_connections = 0;
+  for (const WorkerLoadSharedPtr& load : loads) {
+    Network::BalancedConnectionHandler* handler = load->handler_.load();
+    if (handler == nullptr) {
+      continue;
+    }
+
+    const Candidate& candidate = candidates.emplace_back(Candidate{
+        handler, load->loop_lag_us_.load(std::memory_order_relaxed), handler->numConnections()});
+    min_lag_us = std::min(min_lag_us, candidate.loop_lag_us_);
+    max_lag_us = std::max(max_lag_us, candidate.loop_lag_us_);
+    min_connections = std::min(min_connections, candidate.connections_);
+    max_connections = std::max(max_connections, candidate.connections_);
+  }
+
+  if (candidates.empty()) {
+    current_handler.incNumConnections();
+    return current_handler;
+  }
+
+  stats_.loop_lag_spread_us_.set(max_lag_us - min_lag_us);
+  stats_.connection_spread_.set(max_connections - min_connections);
+
+  // Of the workers lagging about as little as the least lagging one, pick the one with the fewest
+  // connections, staying on the current worker on ties.
+  const Candidate* target = nullptr;
+  for (const Candidate& candidate : candidates) {
+    if (candidate.loop_lag_us_ - min_lag_us > static_cast<uint64_t>(lag_tolerance_.count())) {
+      continue;
+    }
+    if (target == nullptr || candidate.connections_ < target->connections_ ||
+        (candidate.connections_ == target->connections_ &&
+         candidate.handler_ == &current_handler)) {
+      target = &candidate;
+    }
+  }
+
+  target->handler_->incNumConnections();
+  if (target->handler_ != &current_handler) {
+    stats_.rebalanced_.inc();
+  }
+
+  return *target->handler_;
+}
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
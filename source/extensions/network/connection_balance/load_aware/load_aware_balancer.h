@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/network/connection_balancer.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+
+/**
+ * All load aware connection balancer stats. @see stats_macros.h
+ */
+#define ALL_LOAD_AWARE_BALANCER_STATS(COUNTER, GAUGE)                                              \
+  COUNTER(rebalanced)                                                                              \
+  GAUGE(connection_spread, NeverImport)                                                            \
+  GAUGE(loop_lag_spread_us, NeverImport)
+
+/**
+ * Struct definition for all load aware connection balancer stats. @see stats_macros.h
+ */
+struct LoadAwareBalancerStats {
+  ALL_LOAD_AWARE_BALANCER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * The load of one worker. The lag is written by the worker and read by all of them without locking.
+ */
+struct WorkerLoad {
+  // The handler of the worker, or nullptr if the worker has none registered.
+  std::atomic<Network::BalancedConnectionHandler*> handler_{};
+  // The smoothed lag of the event loop of the worker.
+  std::atomic<uint64_t> loop_lag_us_{};
+  // Incremented when the worker starts and when it finishes picking a handler, so that it is odd
+  // while the worker may be reading the handlers of the others.
+  std::atomic<uint64_t> pick_epoch_{};
+};
+
+using WorkerLoadSharedPtr = std::shared_ptr<WorkerLoad>;
+
+/**
+ * Measures the lag of the event loop of a worker by how late a periodic timer fires.
+ */
+class WorkerLoadMonitor : public ThreadLocal::ThreadLocalObject {
+public:
+  WorkerLoadMonitor(Event::Dispatcher& dispatcher, WorkerLoadSharedPtr load,
+                    std::chrono::milliseconds sample_interval);
+
+  WorkerLoad& load() { return *load_; }
+
+private:
+  void armTimer();
+  void onTimer();
+
+  const WorkerLoadSharedPtr load_;
+  const std::chrono::milliseconds sample_interval_;
+  TimeSource& time_source_;
+  const Event::TimerPtr timer_;
+  MonotonicTime expected_fire_time_;
+};
+
+/**
+ * Implementation of a connection balancer which hands a connection to the least loaded worker,
+ * judged by the lag of its event loop and then by its number of connections. Active streams and
+ * pending events are not signals of their own: the balancer only sees the connection counts of
+ * the handlers, and the dispatcher doesn't expose its pending events, but both make the event
+ * loop lag.
+ *
+ * Workers pick handlers without locking, unlike with ExactConnectionBalancerImpl. The list of
+ * worker loads is an immutable snapshot replaced when a worker is added, and handlers are
+ * published through atomics. Since a handler may be destroyed as soon as it is unregistered,
+ * unregistering it waits out the picks in progress, which workers announce through their pick
+ * epoch. Threads without a worker load fall back to a reader lock.
+ */
+class LoadAwareConnectionBalancerImpl : public Network::ConnectionBalancer,
+                                        Logger::Loggable<Logger::Id::connection> {
+public:
+  LoadAwareConnectionBalancerImpl(ThreadLocal::SlotAllocator& tls, Stats::Scope& scope,
+                                  std::chrono::milliseconds sample_interval,
+                                  std::chrono::microseconds lag_tolerance);
+
+  // Network::ConnectionBalancer
+  void registerHandler(Network::BalancedConnectionHandler& handler) override;
+  void unregisterHandler(Network::BalancedConnectionHandler& handler) override;
+  Network::BalancedConnectionHandler&
+  pickTargetHandler(Network::BalancedConnectionHandler& current_handler) override;
+
+  const LoadAwareBalancerStats& stats() const { return stats_; }
+
+private:
+  using WorkerLoads = std::vector<WorkerLoadSharedPtr>;
+
+  void addWorker(WorkerLoadSharedPtr load);
+  // The load of the worker running on the current thread, if any.
+  WorkerLoad* currentWorkerLoad();
+  Network::BalancedConnectionHandler&
+  pickTargetHandlerFrom(const WorkerLoads& loads,
+                        Network::BalancedConnectionHandler& current_handler);
+
+  LoadAwareBalancerStats stats_;
+  const std::chrono::microseconds lag_tolerance_;
+  absl::Mutex lock_;
+  // Every snapshot of the loads of the workers, which only grows. The snapshots are kept until the
+  // balancer is destroyed, as a pick may still be reading an older one.
+  std::vector<std::unique_ptr<const WorkerLoads>> loads_snapshots_ ABSL_GUARDED_BY(lock_);
+  // The latest snapshot.
+  std::atomic<const WorkerLoads*> loads_{};
+  ThreadLocal::TypedSlotPtr<WorkerLoadMonitor> tls_slot_;
+};
+
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -3,6 +3,7 @@
 #include "envoy/admin/v3/memory.pb.h"
 
 #include "source/common/http/headers.h"
+#include "source/common/memory/arena.h"
 #include "source/common/memory/stats.h"
 #include "source/common/version/version.h"
 #include "source/server/utils.h"
@@ -50,6 +51,8 @@ Http::Code ServerInfoHandler::handlerMemory(Http::ResponseHeaderMap& response_he
   memory.set_pageheap_unmapped(Memory::Stats::totalPageHeapUnmapped());
   memory.set_pageheap_free(Memory::Stats::totalPageHeapFree());
   memory.set_total_physical_bytes(Memory::Stats::totalPhysicalBytes());
+  memory.set_arena_reserved(Memory::Arena::totalReserved());
+  memory.set_arena_allocated(Memory::Arena::totalAllocated());
   response.add(MessageUtil::getJsonStringFromMessageOrError(memory, true, true)); // pretty-print
   return Http::Code::OK;
 }
@@ -154,6 +154,7 @@ protected:
       void write(Buffer::Instance&, bool) override { IS_ENVOY_BUG("Unexpected function call"); }
       void setBufferLimits(uint32_t) override { IS_ENVOY_BUG("Unexpected function call"); }
       uint32_t bufferLimit() const override { return 65000; }
+      void bindBufferMemoryAccount(Buffer::BufferMemoryAccountSharedPtr) override {}
       bool aboveHighWatermark() const override { return false; }
       const Network::ConnectionSocket::OptionsSharedPtr& socketOptions() const override {
         return options_;
@@ -170,6 +171,7 @@ protected:
       absl::optional<std::chrono::milliseconds> lastRoundTripTime() const override { return {}; }
       void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
       absl::optional<uint64_t> congestionWindowInBytes() const override { return {}; }
+      Network::IoHandlePtr migrateSocket() override { return nullptr; }
       // ScopeTrackedObject
       void dumpState(std::ostream& os, int) const override { os << "SyntheticConnection"; }
 
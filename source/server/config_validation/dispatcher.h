@@ -25,7 +25,8 @@ public:
       const Network::TransportSocketOptionsConstSharedPtr& transport_options) override;
   Network::ListenerPtr createListener(Network::SocketSharedPtr&&, Network::TcpListenerCallbacks&,
                                       Runtime::Loader& runtime, bool bind_to_port,
-                                      bool ignore_global_conn_limit) override;
+                                      bool ignore_global_conn_limit,
+                                      uint32_t max_connections_to_accept_per_socket_event) override;
 };
 
 } // namespace Event
@@ -14,6 +14,13 @@
 namespace Envoy {
 namespace Server {
 
+namespace {
+
+// Interval between two rounds of taking over the connections which became idle in the parent.
+constexpr std::chrono::milliseconds MigrateConnectionsInterval(1000);
+
+} // namespace
+
 DrainManagerImpl::DrainManagerImpl(Instance& server,
                                    envoy::config::listener::v3::Listener::DrainType drain_type,
                                    Event::Dispatcher& dispatcher)
@@ -178,6 +185,32 @@ void DrainManagerImpl::startParentShutdownSequence() {
 
   parent_shutdown_timer_->enableTimer(std::chrono::duration_cast<std::chrono::milliseconds>(
       server_.options().parentShutdownTime()));
+
+  if (server_.options().hotRestartMigrateIdleConnections()) {
+    migrate_connections_timer_ =
+        server_.dispatcher().createTimer([this]() -> void { migrateParentConnections(); });
+    migrate_connections_timer_->enableTimer(MigrateConnectionsInterval);
+  }
+}
+
+void DrainManagerImpl::migrateParentConnections() {
+  const absl::optional<HotRestart::MigrateConnectionsResponse> response =
+      server_.hotRestart().migrateParentConnections();
+  if (!response.has_value()) {
+    // The parent is gone or doesn't migrate connections, leave it to the parent shutdown timer.
+    return;
+  }
+  for (const int fd : response->fds_) {
+    server_.listenerManager().acceptMigratedConnection(fd);
+  }
+  if (response->parent_connections_ == 0) {
+    ENVOY_LOG(info, "shutting down parent after migrating its connections");
+    parent_shutdown_timer_->enableTimer(std::chrono::milliseconds(0));
+    return;
+  }
+  // Come back for the rest of the batch right away, otherwise for connections which become idle.
+  migrate_connections_timer_->enableTimer(response->more_ ? std::chrono::milliseconds(0)
+                                                          : MigrateConnectionsInterval);
 }
 
 } // namespace Server
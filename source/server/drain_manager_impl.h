@@ -43,6 +43,7 @@ public:
 
 private:
   void addDrainCompleteCallback(std::function<void()> cb);
+  void migrateParentConnections();
 
   Instance& server_;
   Event::Dispatcher& dispatcher_;
@@ -62,6 +63,7 @@ private:
   Common::CallbackHandlePtr parent_callback_handle_;
 
   Event::TimerPtr parent_shutdown_timer_;
+  Event::TimerPtr migrate_connections_timer_;
 };
 
 } // namespace Server
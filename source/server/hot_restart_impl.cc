@@ -128,6 +128,10 @@ absl::optional<HotRestart::AdminShutdownResponse> HotRestartImpl::sendParentAdmi
 
 void HotRestartImpl::sendParentTerminateRequest() { as_child_.sendParentTerminateRequest(); }
 
+absl::optional<HotRestart::MigrateConnectionsResponse> HotRestartImpl::migrateParentConnections() {
+  return as_child_.migrateParentConnections();
+}
+
 HotRestart::ServerStatsFromParent
 HotRestartImpl::mergeParentStatsIfAny(Stats::StoreRoot& stats_store) {
   std::unique_ptr<envoy::HotRestartMessage> wrapper_msg = as_child_.getParentStats();
@@ -23,6 +23,9 @@ public:
     return absl::nullopt;
   }
   void sendParentTerminateRequest() override {}
+  absl::optional<MigrateConnectionsResponse> migrateParentConnections() override {
+    return absl::nullopt;
+  }
   ServerStatsFromParent mergeParentStatsIfAny(Stats::StoreRoot&) override { return {}; }
   void shutdown() override {}
   uint32_t baseId() override { return 0; }
@@ -79,6 +79,9 @@ void HotRestartingBase::sendHotRestartMessage(sockaddr_un& address,
   RELEASE_ASSERT(proto.SerializeWithCachedSizesToArray(send_buf.data() + sizeof(uint64_t)),
                  "failed to serialize a HotRestartMessage");
 
+  const std::vector<int> fds = passedFds(proto);
+  RELEASE_ASSERT(fds.size() <= MaxPassedFds, "too many fds to pass with a HotRestartMessage");
+
   RELEASE_ASSERT(fcntl(my_domain_socket_, F_SETFL, 0) != -1,
                  fmt::format("Set domain socket blocking failed, errno = {}", errno));
 
@@ -98,18 +101,19 @@ void HotRestartingBase::sendHotRestartMessage(sockaddr_un& address,
     message.msg_iov = iov;
     message.msg_iovlen = 1;
 
-    // Control data stuff, only relevant for the fd passing done with PassListenSocketReply.
-    uint8_t control_buffer[CMSG_SPACE(sizeof(int))];
-    if (replyIsExpectedType(&proto, HotRestartMessage::Reply::kPassListenSocket) &&
-        proto.reply().pass_listen_socket().fd() != -1) {
-      memset(control_buffer, 0, CMSG_SPACE(sizeof(int)));
+    // Control data stuff, only relevant for the fd passing done with PassListenSocketReply and
+    // MigrateConnectionReply.
+    uint8_t control_buffer[CMSG_SPACE(sizeof(int) * MaxPassedFds)];
+    if (!fds.empty()) {
+      const size_t fds_size = sizeof(int) * fds.size();
+      memset(control_buffer, 0, CMSG_SPACE(fds_size));
       message.msg_control = control_buffer;
-      message.msg_controllen = CMSG_SPACE(sizeof(int));
+      message.msg_controllen = CMSG_SPACE(fds_size);
       cmsghdr* control_message = CMSG_FIRSTHDR(&message);
       control_message->cmsg_level = SOL_SOCKET;
       control_message->cmsg_type = SCM_RIGHTS;
-      control_message->cmsg_len = CMSG_LEN(sizeof(int));
-      *reinterpret_cast<int*>(CMSG_DATA(control_message)) = proto.reply().pass_listen_socket().fd();
+      control_message->cmsg_len = CMSG_LEN(fds_size);
+      memcpy(CMSG_DATA(control_message), fds.data(), fds_size);
       ASSERT(sent == total_size, "an fd passing message was too long for one sendmsg().");
     }
 
@@ -153,20 +157,47 @@ bool HotRestartingBase::replyIsExpectedType(const HotRestartMessage* proto,
          proto->reply().reply_case() == oneof_type;
 }
 
-// Pull the cloned fd, if present, out of the control data and write it into the
-// PassListenSocketReply proto; the higher level code will see a listening fd that Just Works. We
-// should only get control data in a PassListenSocketReply, it should only be the fd passing type,
-// and there should only be one at a time. Crash on any other control data.
+std::vector<int> HotRestartingBase::passedFds(const HotRestartMessage& proto) const {
+  if (replyIsExpectedType(&proto, HotRestartMessage::Reply::kPassListenSocket) &&
+      proto.reply().pass_listen_socket().fd() != -1) {
+    return {proto.reply().pass_listen_socket().fd()};
+  }
+  if (replyIsExpectedType(&proto, HotRestartMessage::Reply::kMigrateConnection)) {
+    const auto& fds = proto.reply().migrate_connection().fds();
+    return {fds.begin(), fds.end()};
+  }
+  return {};
+}
+
+// Pull the cloned fds, if present, out of the control data and write them into the
+// PassListenSocketReply or MigrateConnectionReply proto; the higher level code will see fds that
+// Just Work. We should only get control data in those replies, it should only be the fd passing
+// type, and there should only be one at a time. Crash on any other control data.
 void HotRestartingBase::getPassedFdIfPresent(HotRestartMessage* out, msghdr* message) {
   cmsghdr* cmsg = CMSG_FIRSTHDR(message);
   if (cmsg != nullptr) {
+    const bool pass_listen_socket =
+        replyIsExpectedType(out, HotRestartMessage::Reply::kPassListenSocket);
     RELEASE_ASSERT(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
-                       replyIsExpectedType(out, HotRestartMessage::Reply::kPassListenSocket),
+                       (pass_listen_socket ||
+                        replyIsExpectedType(out, HotRestartMessage::Reply::kMigrateConnection)),
                    "recvmsg() came with control data when the message's purpose was not to pass a "
                    "file descriptor.");
 
-    out->mutable_reply()->mutable_pass_listen_socket()->set_fd(
-        *reinterpret_cast<int*>(CMSG_DATA(cmsg)));
+    const int* fds = reinterpret_cast<int*>(CMSG_DATA(cmsg));
+    const int num_fds = static_cast<int>((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+    if (pass_listen_socket) {
+      RELEASE_ASSERT(num_fds == 1, "PassListenSocketReply came with more than one fd.");
+      out->mutable_reply()->mutable_pass_listen_socket()->set_fd(fds[0]);
+    } else {
+      HotRestartMessage::Reply::MigrateConnection* reply =
+          out->mutable_reply()->mutable_migrate_connection();
+      RELEASE_ASSERT(num_fds == reply->fds_size(),
+                     "MigrateConnectionReply came with a different number of fds than it lists.");
+      for (int i = 0; i < num_fds; i++) {
+        reply->set_fds(i, fds[i]);
+      }
+    }
 
     RELEASE_ASSERT(CMSG_NXTHDR(message, cmsg) == nullptr,
                    "More than one control data on a single hot restart recvmsg().");
@@ -207,19 +238,19 @@ std::unique_ptr<HotRestartMessage> HotRestartingBase::receiveHotRestartMessage(B
 
   iovec iov[1];
   msghdr message;
-  uint8_t control_buffer[CMSG_SPACE(sizeof(int))];
+  uint8_t control_buffer[CMSG_SPACE(sizeof(int) * MaxPassedFds)];
   std::unique_ptr<HotRestartMessage> ret = nullptr;
   while (!ret) {
     iov[0].iov_base = recv_buf_.data() + cur_msg_recvd_bytes_;
     iov[0].iov_len = MaxSendmsgSize;
 
-    // We always setup to receive an FD even though most messages do not pass one.
-    memset(control_buffer, 0, CMSG_SPACE(sizeof(int)));
+    // We always setup to receive FDs even though most messages do not pass any.
+    memset(control_buffer, 0, sizeof(control_buffer));
     memset(&message, 0, sizeof(message));
     message.msg_iov = iov;
     message.msg_iovlen = 1;
     message.msg_control = control_buffer;
-    message.msg_controllen = CMSG_SPACE(sizeof(int));
+    message.msg_controllen = sizeof(control_buffer);
 
     const int recvmsg_rc = recvmsg(my_domain_socket_, &message, 0);
     if (block == Blocking::No && recvmsg_rc == -1 && errno == SOCKET_ERROR_AGAIN) {
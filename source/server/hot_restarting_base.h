@@ -9,6 +9,7 @@
 #include <atomic>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "envoy/common/platform.h"
 #include "envoy/server/hot_restart.h"
@@ -26,6 +27,10 @@ namespace Server {
  * domain socket communication, and our ad hoc RPC protocol.
  */
 class HotRestartingBase : public Logger::Loggable<Logger::Id::main> {
+public:
+  // The most fds passed with one message, well below the SCM_MAX_FD limit of Linux.
+  static constexpr uint32_t MaxPassedFds = 128;
+
 protected:
   HotRestartingBase(uint64_t base_id) : base_id_(base_id) {}
   ~HotRestartingBase();
@@ -68,6 +73,8 @@ protected:
   static Stats::Gauge& hotRestartGeneration(Stats::Scope& scope);
 
 private:
+  // The fds passed along with a reply, if any.
+  std::vector<int> passedFds(const envoy::HotRestartMessage& proto) const;
   void getPassedFdIfPresent(envoy::HotRestartMessage* out, msghdr* message);
   std::unique_ptr<envoy::HotRestartMessage> parseProtoAndResetState();
   void initRecvBufIfNewMessage();
@@ -102,6 +102,30 @@ void HotRestartingChild::sendParentTerminateRequest() {
   stat_merger_.reset();
 }
 
+absl::optional<HotRestart::MigrateConnectionsResponse>
+HotRestartingChild::migrateParentConnections() {
+  if (restart_epoch_ == 0 || parent_terminated_ || !parent_migrates_connections_) {
+    return absl::nullopt;
+  }
+
+  HotRestartMessage wrapped_request;
+  wrapped_request.mutable_request()->mutable_migrate_connection();
+  sendHotRestartMessage(parent_address_, wrapped_request);
+
+  std::unique_ptr<HotRestartMessage> wrapped_reply = receiveHotRestartMessage(Blocking::Yes);
+  if (!replyIsExpectedType(wrapped_reply.get(), HotRestartMessage::Reply::kMigrateConnection)) {
+    // The parent predates handing off connections, don't ask again.
+    ENVOY_LOG(warn, "hot restart parent did not respond as expected to MigrateConnection.");
+    parent_migrates_connections_ = false;
+    return absl::nullopt;
+  }
+  const HotRestartMessage::Reply::MigrateConnection& reply =
+      wrapped_reply->reply().migrate_connection();
+  return HotRestart::MigrateConnectionsResponse{{reply.fds().begin(), reply.fds().end()},
+                                                reply.more(),
+                                                reply.num_connections()};
+}
+
 void HotRestartingChild::mergeParentStats(Stats::Store& stats_store,
                                           const HotRestartMessage::Reply::Stats& stats_proto) {
   if (!stat_merger_) {
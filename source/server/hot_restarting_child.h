@@ -19,12 +19,15 @@ public:
   void drainParentListeners();
   absl::optional<HotRestart::AdminShutdownResponse> sendParentAdminShutdownRequest();
   void sendParentTerminateRequest();
+  absl::optional<HotRestart::MigrateConnectionsResponse> migrateParentConnections();
   void mergeParentStats(Stats::Store& stats_store,
                         const envoy::HotRestartMessage::Reply::Stats& stats_proto);
 
 private:
   const int restart_epoch_;
   bool parent_terminated_{};
+  // Cleared if the parent doesn't recognize requests to hand off its connections.
+  bool parent_migrates_connections_{true};
   sockaddr_un parent_address_;
   std::unique_ptr<Stats::StatMerger> stat_merger_{};
   Stats::StatName hot_restart_generation_stat_name_;
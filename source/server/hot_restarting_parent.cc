@@ -1,5 +1,8 @@
 #include "source/server/hot_restarting_parent.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "envoy/server/instance.h"
 
 #include "source/common/memory/stats.h"
@@ -65,6 +68,13 @@ void HotRestartingParent::onSocketEvent() {
       break;
     }
 
+    case HotRestartMessage::Request::kMigrateConnection: {
+      internal_->migrateConnectionsForChild([this](const HotRestartMessage& wrapped_reply) {
+        sendHotRestartMessage(child_address_, wrapped_reply);
+      });
+      break;
+    }
+
     case HotRestartMessage::Request::kTerminate: {
       ENVOY_LOG(info, "shutting down due to child request");
       kill(getpid(), SIGTERM);
@@ -186,5 +196,41 @@ void HotRestartingParent::Internal::recordDynamics(HotRestartMessage::Reply::Sta
 
 void HotRestartingParent::Internal::drainListeners() { server_->drainListeners(); }
 
+void HotRestartingParent::Internal::migrateConnectionsForChild(MigrateConnectionsReply reply) {
+  if (!migrated_sockets_.empty()) {
+    // Hand off the rest of the last round first.
+    replyMigratedConnections(reply);
+    return;
+  }
+  // Collect the connections which became idle since the last round and hand them off in the same
+  // round. The child blocks on the reply, so no collected connection waits for the next round.
+  server_->listenerManager().migrateIdleConnections(
+      [this, reply](std::vector<Network::IoHandlePtr>&& sockets) {
+        migrated_sockets_ = std::move(sockets);
+        replyMigratedConnections(reply);
+      });
+}
+
+void HotRestartingParent::Internal::replyMigratedConnections(
+    const MigrateConnectionsReply& reply) {
+  const size_t batch_size = std::min<size_t>(migrated_sockets_.size(), MaxPassedFds);
+  // The sockets of the batch stay open until sendmsg() duplicated them for the child.
+  std::vector<Network::IoHandlePtr> batch(
+      std::make_move_iterator(migrated_sockets_.end() - batch_size),
+      std::make_move_iterator(migrated_sockets_.end()));
+  migrated_sockets_.resize(migrated_sockets_.size() - batch_size);
+
+  HotRestartMessage wrapped_reply;
+  HotRestartMessage::Reply::MigrateConnection* migrate_connection =
+      wrapped_reply.mutable_reply()->mutable_migrate_connection();
+  for (const Network::IoHandlePtr& socket : batch) {
+    migrate_connection->add_fds(socket->fdDoNotUse());
+  }
+  migrate_connection->set_more(!migrated_sockets_.empty());
+  migrate_connection->set_num_connections(server_->listenerManager().numConnections() +
+                                          migrated_sockets_.size());
+  reply(wrapped_reply);
+}
+
 } // namespace Server
 } // namespace Envoy
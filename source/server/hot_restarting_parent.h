@@ -1,5 +1,10 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
+#include "envoy/network/io_handle.h"
+
 #include "source/common/common/hash.h"
 #include "source/server/hot_restarting_base.h"
 
@@ -33,9 +38,19 @@ public:
     void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
                         Stats::StatName stat_name);
     void drainListeners();
+    using MigrateConnectionsReply = std::function<void(const envoy::HotRestartMessage&)>;
+    // 'reply' is called with the response to return to the child, possibly asynchronously once
+    // the idle connections are collected from the workers. The fds in the response are kept open
+    // until 'reply' returns.
+    void migrateConnectionsForChild(MigrateConnectionsReply reply);
 
   private:
+    void replyMigratedConnections(const MigrateConnectionsReply& reply);
+
     Server::Instance* const server_{};
+    // The sockets of the idle connections closed for the child which didn't fit in the last
+    // response, to be handed off to it next.
+    std::vector<Network::IoHandlePtr> migrated_sockets_;
   };
 
 private:
@@ -19,7 +19,9 @@ namespace Server {
   COUNTER(downstream_listener_filter_error)                                                        \
   COUNTER(no_filter_chain_match)                                                                   \
   GAUGE(downstream_cx_active, Accumulate)                                                          \
+  GAUGE(downstream_cx_buffer_bytes, NeverImport)                                                   \
   GAUGE(downstream_pre_cx_active, Accumulate)                                                      \
+  HISTOGRAM(connections_accepted_per_socket_event, Unspecified)                                    \
   HISTOGRAM(downstream_cx_length_ms, Milliseconds)
 
 /**
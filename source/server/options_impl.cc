@@ -136,6 +136,9 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
                                     false, "serve", "string", cmd);
   TCLAP::SwitchArg disable_hot_restart("", "disable-hot-restart",
                                        "Disable hot restart functionality", cmd, false);
+  TCLAP::SwitchArg hot_restart_migrate_idle_connections(
+      "", "hot-restart-migrate-idle-connections",
+      "Take over the idle connections of the parent process on hot restart", cmd, false);
   TCLAP::SwitchArg enable_mutex_tracing(
       "", "enable-mutex-tracing", "Enable mutex contention tracing functionality", cmd, false);
   TCLAP::SwitchArg cpuset_threads(
@@ -182,6 +185,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   }
 
   hot_restart_disabled_ = disable_hot_restart.getValue();
+  hot_restart_migrate_idle_connections_ = hot_restart_migrate_idle_connections.getValue();
   mutex_tracing_enabled_ = enable_mutex_tracing.getValue();
   core_dump_enabled_ = enable_core_dump.getValue();
 
@@ -425,6 +429,8 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
       Protobuf::util::TimeUtil::SecondsToDuration(parentShutdownTime().count()));
 
   command_line_options->set_disable_hot_restart(hotRestartDisabled());
+  command_line_options->set_hot_restart_migrate_idle_connections(
+      hotRestartMigrateIdleConnections());
   command_line_options->set_enable_mutex_tracing(mutexTracingEnabled());
   command_line_options->set_cpuset_threads(cpusetThreadsEnabled());
   command_line_options->set_restart_epoch(restartEpoch());
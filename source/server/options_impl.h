@@ -93,6 +93,9 @@ public:
   void setHotRestartDisabled(bool hot_restart_disabled) {
     hot_restart_disabled_ = hot_restart_disabled;
   }
+  void setHotRestartMigrateIdleConnections(bool hot_restart_migrate_idle_connections) {
+    hot_restart_migrate_idle_connections_ = hot_restart_migrate_idle_connections;
+  }
   void setSignalHandling(bool signal_handling_enabled) {
     signal_handling_enabled_ = signal_handling_enabled;
   }
@@ -152,6 +155,9 @@ public:
   const std::string& serviceNodeName() const override { return service_node_; }
   const std::string& serviceZone() const override { return service_zone_; }
   bool hotRestartDisabled() const override { return hot_restart_disabled_; }
+  bool hotRestartMigrateIdleConnections() const override {
+    return hot_restart_migrate_idle_connections_;
+  }
   bool signalHandlingEnabled() const override { return signal_handling_enabled_; }
   bool mutexTracingEnabled() const override { return mutex_tracing_enabled_; }
   bool coreDumpEnabled() const override { return core_dump_enabled_; }
@@ -213,6 +219,7 @@ private:
   Server::DrainStrategy drain_strategy_{Server::DrainStrategy::Gradual};
   Server::Mode mode_{Server::Mode::Serve};
   bool hot_restart_disabled_{false};
+  bool hot_restart_migrate_idle_connections_{false};
   bool signal_handling_enabled_{true};
   bool mutex_tracing_enabled_{false};
   bool core_dump_enabled_{false};
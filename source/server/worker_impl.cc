@@ -136,6 +136,20 @@ void WorkerImpl::stopListener(Network::ListenerConfig& listener, std::function<v
   });
 }
 
+void WorkerImpl::migrateIdleConnections(MigrateIdleConnectionsCompletion completion) {
+  ASSERT(thread_);
+  dispatcher_->post([this, completion = std::move(completion)]() -> void {
+    completion(handler_->migrateIdleConnections());
+  });
+}
+
+void WorkerImpl::acceptMigratedConnection(Network::ConnectionSocketPtr&& socket) {
+  ASSERT(thread_);
+  dispatcher_->post([this, socket = std::move(socket)]() mutable -> void {
+    handler_->acceptMigratedConnection(std::move(socket));
+  });
+}
+
 void WorkerImpl::threadRoutine(GuardDog& guard_dog, const std::function<void()>& cb) {
   ENVOY_LOG(debug, "worker entering dispatch loop");
   // The watch dog must be created after the dispatcher starts running and has post events flushed,
@@ -64,6 +64,8 @@ public:
   void initializeStats(Stats::Scope& scope) override;
   void stop() override;
   void stopListener(Network::ListenerConfig& listener, std::function<void()> completion) override;
+  void migrateIdleConnections(MigrateIdleConnectionsCompletion completion) override;
+  void acceptMigratedConnection(Network::ConnectionSocketPtr&& socket) override;
 
 private:
   void threadRoutine(GuardDog& guard_dog, const std::function<void()>& cb);
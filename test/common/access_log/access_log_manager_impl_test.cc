@@ -1,4 +1,6 @@
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "source/common/access_log/access_log_manager_impl.h"
 #include "source/common/filesystem/file_shared_impl.h"
@@ -11,6 +13,9 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -171,8 +176,8 @@ TEST_F(AccessLogManagerImplTest, FlushToLogFileOnDemand) {
   EXPECT_EQ(0UL, store_.counter("filesystem.flushed_by_timer").value());
 
   // The first write to a given file will start the flush thread. Because AccessManagerImpl::write
-  // holds the write_lock_ when the thread is started, the thread will flush on its first loop, once
-  // it obtains the write_lock_. Perform a write to get all that out of the way.
+  // buffers the data before the thread is started, the thread will flush on its first loop.
+  // Perform a write to get all that out of the way.
   EXPECT_CALL(*file_, write_(_))
       .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
         return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
@@ -486,6 +491,80 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, ConcurrentWritersKeepTheirLinesInOrder) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&written](absl::string_view data) -> Api::IoCallSizeResult {
+        // Writes are serialized by the file lock.
+        absl::StrAppend(&written, data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  constexpr uint32_t num_threads = 8;
+  constexpr uint32_t num_lines = 1000;
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory_.createThread([&log_file, i]() {
+      for (uint32_t j = 0; j < num_lines; ++j) {
+        log_file->write(absl::StrCat(i, " ", j, "\n"));
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+
+  std::vector<uint32_t> next_line(num_threads, 0);
+  for (absl::string_view line : absl::StrSplit(written, '\n', absl::SkipEmpty())) {
+    const std::vector<absl::string_view> fields = absl::StrSplit(line, ' ');
+    ASSERT_EQ(2U, fields.size());
+    uint32_t thread;
+    uint32_t line_number;
+    ASSERT_TRUE(absl::SimpleAtoi(fields[0], &thread));
+    ASSERT_TRUE(absl::SimpleAtoi(fields[1], &line_number));
+    ASSERT_LT(thread, num_threads);
+    EXPECT_EQ(next_line[thread]++, line_number);
+  }
+  EXPECT_EQ(std::vector<uint32_t>(num_threads, num_lines), next_line);
+  EXPECT_EQ(num_threads * num_lines, store_.counter("filesystem.write_buffered").value());
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, ThreadsWriteToDifferentShards) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  // Shards are handed out to threads in turn, whatever the ids of the threads hash to.
+  std::vector<uint32_t> shards;
+  for (uint32_t i = 0; i < 2; ++i) {
+    Thread::ThreadPtr thread = thread_factory_.createThread([&log_file, &shards]() {
+      log_file->write("line\n");
+      shards.push_back(AccessLogFileImpl::writeShardIndex());
+      // The shard of a thread doesn't change.
+      log_file->write("line\n");
+      EXPECT_EQ(shards.back(), AccessLogFileImpl::writeShardIndex());
+    });
+    thread->join();
+  }
+  ASSERT_EQ(2U, shards.size());
+  EXPECT_NE(shards[0], shards[1]);
+  log_file->flush();
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
@@ -320,6 +320,20 @@ BENCHMARK(bufferReserveCommit)
     ->Arg(64 * 1024)
     ->Arg(128 * 1024);
 
+// Test the add+drain cycle of a connection buffer, where each iteration allocates the storage of a
+// slice and releases it once the data is written out.
+static void bufferAddDrainCycle(benchmark::State& state) {
+  const std::string data(state.range(0), 'a');
+  Buffer::OwnedImpl buffer;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    buffer.add(data);
+    buffer.drain(buffer.length());
+  }
+  benchmark::DoNotOptimize(buffer.length());
+}
+BENCHMARK(bufferAddDrainCycle)->Arg(4096)->Arg(16384)->Arg(65536);
+
 // Test the reserve+commit cycle, for the common case where the reserved space is
 // only partially used (and therefore the commit size is smaller than the reservation size).
 static void bufferReserveCommitPartial(benchmark::State& state) {
@@ -4,6 +4,7 @@
 #include "envoy/api/io_error.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_allocator.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/win32_socket_handle_impl.h"
 
@@ -856,6 +857,8 @@ TEST_F(OwnedImplTest, ReserveSingleOverCommit) {
 
 // Test functionality of the `freelist` (a performance optimization).
 TEST_F(OwnedImplTest, SliceFreeList) {
+  // Start from empty free lists.
+  SliceAllocator::trim();
   Buffer::OwnedImpl b1, b2;
   std::vector<void*> slices;
   {
@@ -874,19 +877,21 @@ TEST_F(OwnedImplTest, SliceFreeList) {
     EXPECT_EQ(slices[1], b2.getRawSlices()[0].mem_);
   }
 
+  // The storage of drained slices goes back to the `freelist` too.
   b1.drain(1);
   EXPECT_EQ(0, b1.getRawSlices().size());
   {
     auto r = b2.reserveForRead();
     // slices()[0] is the partially used slice that is already part of this buffer.
-    EXPECT_EQ(slices[2], r.slices()[1].mem_);
+    EXPECT_EQ(slices[0], r.slices()[1].mem_);
+    EXPECT_EQ(slices[2], r.slices()[2].mem_);
   }
   {
     auto r = b1.reserveForRead();
-    EXPECT_EQ(slices[2], r.slices()[0].mem_);
+    EXPECT_EQ(slices[0], r.slices()[0].mem_);
   }
   {
-    // This causes an underflow in the `freelist` on creation, and overflows it on deletion.
+    // This causes an underflow in the `freelist` on creation.
     auto r1 = b1.reserveForRead();
     auto r2 = b2.reserveForRead();
     for (auto& r1_slice : absl::MakeSpan(r1.slices(), r1.numSlices())) {
@@ -0,0 +1,102 @@
+#include <vector>
+
+#include "source/common/buffer/slice_allocator.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SliceAllocatorTest : public testing::Test {
+protected:
+  // Start every test from empty free lists.
+  SliceAllocatorTest() { SliceAllocator::trim(); }
+  ~SliceAllocatorTest() override { SliceAllocator::trim(); }
+
+  static std::vector<uint8_t*> allocate(size_t size, size_t count) {
+    std::vector<uint8_t*> blocks;
+    for (size_t i = 0; i < count; ++i) {
+      blocks.push_back(SliceAllocator::allocate(size));
+    }
+    return blocks;
+  }
+
+  static void release(size_t size, const std::vector<uint8_t*>& blocks) {
+    for (uint8_t* block : blocks) {
+      SliceAllocator::release(block, size);
+    }
+  }
+};
+
+// The most recently released storage is reused first.
+TEST_F(SliceAllocatorTest, ReusesReleasedStorage) {
+  for (const size_t size : {4096, 16384, 65536}) {
+    const std::vector<uint8_t*> blocks = allocate(size, 2);
+    release(size, blocks);
+    EXPECT_EQ(2, SliceAllocator::threadCachedForTest(size));
+
+    uint8_t* block = SliceAllocator::allocate(size);
+    EXPECT_EQ(blocks[1], block);
+    EXPECT_EQ(1, SliceAllocator::threadCachedForTest(size));
+    SliceAllocator::release(block, size);
+  }
+}
+
+TEST_F(SliceAllocatorTest, UncachedSizes) {
+  for (const size_t size : {8192, 32768, 131072}) {
+    release(size, allocate(size, 2));
+    EXPECT_EQ(0, SliceAllocator::threadCachedForTest(size));
+    EXPECT_EQ(0, SliceAllocator::sharedCachedForTest(size));
+  }
+  SliceAllocator::release(nullptr, 16384);
+  EXPECT_EQ(0, SliceAllocator::threadCachedForTest(16384));
+}
+
+// Overflowing the free list of a thread moves half of it to the shared free list, from which a
+// batch is taken back once the free list of the thread runs empty.
+TEST_F(SliceAllocatorTest, OverflowToSharedFreeList) {
+  const std::vector<uint8_t*> blocks = allocate(16384, 17);
+  release(16384, blocks);
+  EXPECT_EQ(9, SliceAllocator::threadCachedForTest(16384));
+  EXPECT_EQ(8, SliceAllocator::sharedCachedForTest(16384));
+
+  const std::vector<uint8_t*> reused = allocate(16384, 10);
+  EXPECT_EQ(7, SliceAllocator::threadCachedForTest(16384));
+  EXPECT_EQ(0, SliceAllocator::sharedCachedForTest(16384));
+  release(16384, reused);
+}
+
+// Storage released on another thread than the one which allocated it flows back through the shared
+// free list, which is bounded.
+TEST_F(SliceAllocatorTest, CrossThreadRelease) {
+  const std::vector<uint8_t*> blocks = allocate(65536, 40);
+  auto thread = Thread::threadFactoryForTest().createThread([&blocks]() {
+    release(65536, blocks);
+    EXPECT_EQ(4, SliceAllocator::threadCachedForTest(65536));
+  });
+  thread->join();
+  // The free list of the thread is handed over to the shared free list on thread exit.
+  EXPECT_EQ(32, SliceAllocator::sharedCachedForTest(65536));
+
+  uint8_t* block = SliceAllocator::allocate(65536);
+  EXPECT_EQ(1, SliceAllocator::threadCachedForTest(65536));
+  EXPECT_EQ(30, SliceAllocator::sharedCachedForTest(65536));
+  SliceAllocator::release(block, 65536);
+}
+
+TEST_F(SliceAllocatorTest, Trim) {
+  release(4096, allocate(4096, 40));
+  EXPECT_LT(0, SliceAllocator::threadCachedForTest(4096));
+  EXPECT_LT(0, SliceAllocator::sharedCachedForTest(4096));
+
+  SliceAllocator::trim();
+  EXPECT_EQ(0, SliceAllocator::sharedCachedForTest(4096));
+  EXPECT_EQ(0, SliceAllocator::threadCachedForTest(4096));
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
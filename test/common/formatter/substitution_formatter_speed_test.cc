@@ -1,5 +1,6 @@
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/protobuf/utility.h"
 
 #include "test/common/stream_info/test_util.h"
 #include "test/mocks/http/mocks.h"
@@ -186,6 +187,33 @@ static void BM_TypedJsonAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_TypedJsonAccessLogFormatter);
 
+// Serializes the output of the StructFormatter through protobuf, which is how JSON access logs
+// used to be produced, as a baseline for BM_JsonAccessLogFormatter and
+// BM_TypedJsonAccessLogFormatter.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_JsonAccessLogFormatterViaStruct(benchmark::State& state) {
+  MockTimeSystem time_system;
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  std::unique_ptr<Envoy::Formatter::StructFormatter> struct_formatter =
+      makeStructFormatter(state.range(0) != 0);
+
+  size_t output_bytes = 0;
+  Http::TestRequestHeaderMapImpl request_headers;
+  Http::TestResponseHeaderMapImpl response_headers;
+  Http::TestResponseTrailerMapImpl response_trailers;
+  std::string body;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    const ProtobufWkt::Struct output_struct =
+        struct_formatter->format(request_headers, response_headers, response_trailers,
+                                 *stream_info, body, AccessLog::AccessLogType::NotSet);
+    output_bytes +=
+        absl::StrCat(MessageUtil::getJsonStringFromMessageOrError(output_struct, false, true), "\n")
+            .length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_JsonAccessLogFormatterViaStruct)->Arg(0)->Arg(1);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_FormatterCommandParsing(benchmark::State& state) {
   const std::string token = "Listener:namespace:key";
@@ -3811,6 +3811,154 @@ TEST(SubstitutionFormatterTest, JsonFormatterTest) {
   EXPECT_TRUE(TestUtility::jsonStringEqual(out_json, expected));
 }
 
+TEST(SubstitutionFormatterTest, JsonFormatterWritesSortedCompactJson) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"user-agent", "a \"quoted\"\tagent <1>"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body;
+  EXPECT_CALL(stream_info, responseCode()).WillRepeatedly(Return(200));
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    user_agent: '%REQ(USER-AGENT)%'
+    code: '%RESPONSE_CODE%'
+    number: 42
+    list: ['%RESPONSE_CODE%', '%REQ(MISSING)%', 'literal']
+    nested:
+      missing: '%REQ(MISSING)%'
+  )EOF",
+                            key_mapping);
+
+  EXPECT_EQ("{\"code\":\"200\",\"list\":[\"200\",\"-\",\"literal\"],\"nested\":{\"missing\":\"-\"},"
+            "\"number\":\"42\",\"user_agent\":\"a \\\"quoted\\\"\\tagent \\u003c1\\u003e\"}\n",
+            JsonFormatterImpl(key_mapping, false, false)
+                .format(request_header, response_header, response_trailer, stream_info, body,
+                        AccessLog::AccessLogType::NotSet));
+  EXPECT_EQ("{\"code\":200,\"list\":[200,\"literal\"],\"number\":42,"
+            "\"user_agent\":\"a \\\"quoted\\\"\\tagent \\u003c1\\u003e\"}\n",
+            JsonFormatterImpl(key_mapping, true, true)
+                .format(request_header, response_header, response_trailer, stream_info, body,
+                        AccessLog::AccessLogType::NotSet));
+}
+
+// The JSON formatter writes JSON directly, which must match serializing the StructFormatter's
+// output through protobuf.
+// Serializes a Struct the way the protobuf JSON serializer does, but with its keys sorted as the
+// JSON formatter sorts them.
+std::string sortedJsonStringFromStruct(const ProtobufWkt::Struct& output_struct) {
+  std::string binary;
+  {
+    Protobuf::io::StringOutputStream stream(&binary);
+    Protobuf::io::CodedOutputStream coded_stream(&stream);
+    coded_stream.SetSerializationDeterministic(true);
+    output_struct.SerializeToCodedStream(&coded_stream);
+  }
+  const std::unique_ptr<ProtobufUtil::TypeResolver> resolver(
+      ProtobufUtil::NewTypeResolverForDescriptorPool("type.googleapis.com",
+                                                     Protobuf::DescriptorPool::generated_pool()));
+  ProtobufUtil::JsonPrintOptions options;
+  options.always_print_primitive_fields = true;
+  std::string json;
+  EXPECT_TRUE(ProtobufUtil::BinaryToJsonString(resolver.get(),
+                                               "type.googleapis.com/google.protobuf.Struct",
+                                               binary, &json, options)
+                  .ok());
+  return json;
+}
+
+TEST(SubstitutionFormatterTest, JsonFormatterMatchesStructFormatter) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{
+      {"first", "GET"},
+      {"escaped", "\"\\<\x01é>"},
+      {"control", "\b\f\n\r\t\x1f\x7f"},
+      // U+0080, U+00AD, U+200B, U+2028, U+FEFF, U+1D173 and U+E0001, which are escaped, and U+00A0
+      // and U+1F600, which are not.
+      {"formatting", "\xc2\x80\xc2\xad\xe2\x80\x8b\xe2\x80\xa8\xef\xbb\xbf\xf0\x9d\x85\xb3"
+                     "\xf3\xa0\x80\x81\xc2\xa0\xf0\x9f\x98\x80"}};
+  Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}};
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body = "local reply";
+  envoy::config::core::v3::Metadata metadata;
+  populateMetadataTestData(metadata);
+  EXPECT_CALL(stream_info, dynamicMetadata()).WillRepeatedly(ReturnRef(metadata));
+  EXPECT_CALL(Const(stream_info), dynamicMetadata()).WillRepeatedly(ReturnRef(metadata));
+  EXPECT_CALL(stream_info, responseCode()).WillRepeatedly(Return(404));
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(protocol));
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    first: '%REQ(FIRST)%'
+    escaped: '%REQ(ESCAPED)%'
+    control: '%REQ(CONTROL)%'
+    formatting: '%REQ(FORMATTING)%'
+    missing: '%REQ(MISSING)%'
+    multiple: '%REQ(FIRST)% %REQ(MISSING)% %RESP(SECOND)%'
+    code: '%RESPONSE_CODE%'
+    body: '%LOCAL_REPLY_BODY%'
+    metadata: '%DYNAMIC_METADATA(com.test)%'
+    missing_metadata: '%DYNAMIC_METADATA(com.missing)%'
+    number: 3.5
+    empty: {}
+    list: ['%PROTOCOL%', '%REQ(MISSING)%', {missing: '%REQ(MISSING)%'}, []]
+    nested:
+      protocol: '%PROTOCOL%'
+      missing: '%REQ(MISSING)%'
+      all_missing:
+        missing: '%REQ(MISSING)%'
+  )EOF",
+                            key_mapping);
+
+  for (const bool preserve_types : {false, true}) {
+    for (const bool omit_empty_values : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("preserve_types: ", preserve_types,
+                                " omit_empty_values: ", omit_empty_values));
+      const ProtobufWkt::Struct output_struct =
+          StructFormatter(key_mapping, preserve_types, omit_empty_values)
+              .format(request_header, response_header, response_trailer, stream_info, body,
+                      AccessLog::AccessLogType::NotSet);
+      const std::string out_json =
+          JsonFormatterImpl(key_mapping, preserve_types, omit_empty_values)
+              .format(request_header, response_header, response_trailer, stream_info, body,
+                      AccessLog::AccessLogType::NotSet);
+      EXPECT_EQ(absl::StrCat(sortedJsonStringFromStruct(output_struct), "\n"), out_json);
+    }
+  }
+}
+
+// Protobuf drops the bytes of strings which aren't valid UTF-8, so these are escaped as
+// Json::sanitize() escapes them instead.
+TEST(SubstitutionFormatterTest, JsonFormatterInvalidUtf8) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{
+      {"truncated", "a\"\xc3"},
+      {"overlong", "<\xc0\x80\x01é"},
+      {"surrogate", "\\\xed\xa0\x80\x7f"},
+      {"valid", "\x01é"}};
+  Http::TestResponseHeaderMapImpl response_header;
+  Http::TestResponseTrailerMapImpl response_trailer;
+  std::string body;
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    truncated: '%REQ(TRUNCATED)%'
+    overlong: '%REQ(OVERLONG)%'
+    surrogate: '%REQ(SURROGATE)%'
+    valid: '%REQ(VALID)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false, false);
+
+  EXPECT_EQ(R"EOF({"overlong":"<\300\200\001\303\251",)EOF"
+            R"EOF("surrogate":"\134\355\240\200\177",)EOF"
+            R"EOF("truncated":"a\042\303","valid":"\u0001é"})EOF"
+            "\n",
+            formatter.format(request_header, response_header, response_trailer, stream_info, body,
+                             AccessLog::AccessLogType::NotSet));
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
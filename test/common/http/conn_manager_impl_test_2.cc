@@ -3706,5 +3706,33 @@ TEST_F(HttpConnectionManagerImplTest, NoProxyProtocolAdded) {
   // Clean up.
   filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
 }
+
+// Only idle HTTP/1 connections can be migrated to another process.
+TEST_F(HttpConnectionManagerImplTest, CanMigrate) {
+  setup(false, "");
+  setupFilterChain(1, 0);
+  EXPECT_TRUE(conn_manager_->canMigrate());
+
+  EXPECT_CALL(*decoder_filters_[0], decodeHeaders(_, true))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  startRequest(true);
+  EXPECT_FALSE(conn_manager_->canMigrate());
+
+  EXPECT_CALL(response_encoder_, encodeHeaders(_, true));
+  EXPECT_CALL(*decoder_filters_[0], onStreamComplete());
+  EXPECT_CALL(*decoder_filters_[0], onDestroy());
+  ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{{":status", "200"}}};
+  decoder_filters_[0]->callbacks_->streamInfo().setResponseCodeDetails("");
+  decoder_filters_[0]->callbacks_->encodeHeaders(std::move(response_headers), true, "details");
+  EXPECT_TRUE(conn_manager_->canMigrate());
+
+  EXPECT_CALL(*codec_, wantsToWrite()).WillOnce(Return(true));
+  EXPECT_FALSE(conn_manager_->canMigrate());
+
+  codec_->protocol_ = Protocol::Http2;
+  EXPECT_FALSE(conn_manager_->canMigrate());
+
+  filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
+}
 } // namespace Http
 } // namespace Envoy
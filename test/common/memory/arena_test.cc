@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "source/common/memory/arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+TEST(ArenaTest, Allocate) {
+  const uint64_t total_reserved = Arena::totalReserved();
+  const uint64_t total_allocated = Arena::totalAllocated();
+  {
+    Arena arena;
+    EXPECT_EQ(0, arena.reserved());
+
+    void* first = arena.allocate(10, 1);
+    void* second = arena.allocate(8, 8);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % 8);
+    EXPECT_LE(static_cast<uint8_t*>(first) + 10, static_cast<uint8_t*>(second));
+    EXPECT_EQ(Arena::MinChunkSize, arena.reserved());
+    EXPECT_EQ(18, arena.allocated());
+    EXPECT_EQ(total_reserved + Arena::MinChunkSize, Arena::totalReserved());
+    EXPECT_EQ(total_allocated + 18, Arena::totalAllocated());
+
+    void* aligned = arena.allocate(64, 64);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(aligned) % 64);
+  }
+  EXPECT_EQ(total_reserved, Arena::totalReserved());
+  EXPECT_EQ(total_allocated, Arena::totalAllocated());
+}
+
+// Chunks double in size up to the huge page size, from which point they are aligned to it.
+TEST(ArenaTest, ChunksGrowToHugePages) {
+  Arena arena;
+  uint64_t reserved = 0;
+  for (size_t chunk_size = Arena::MinChunkSize; chunk_size <= Arena::HugePageSize;
+       chunk_size *= 2) {
+    void* mem = arena.allocate(chunk_size, 1);
+    reserved += chunk_size;
+    EXPECT_EQ(reserved, arena.reserved());
+    if (chunk_size == Arena::HugePageSize) {
+      EXPECT_EQ(0, reinterpret_cast<uintptr_t>(mem) % Arena::HugePageSize);
+    }
+  }
+
+  arena.allocate(1, 1);
+  EXPECT_EQ(reserved + Arena::HugePageSize, arena.reserved());
+}
+
+TEST(ArenaTest, LargeAllocation) {
+  Arena arena;
+  arena.allocate(3 * Arena::HugePageSize, 1);
+  EXPECT_LE(3 * Arena::HugePageSize, arena.reserved());
+  EXPECT_EQ(3 * Arena::HugePageSize, arena.allocated());
+}
+
+// Objects allocated from an arena keep it alive.
+TEST(ArenaTest, MakeSharedInArena) {
+  const uint64_t total_reserved = Arena::totalReserved();
+  std::shared_ptr<std::string> object;
+  {
+    auto arena = std::make_shared<Arena>();
+    object = makeSharedInArena<std::string>(arena, "hello");
+    EXPECT_LT(0, arena->allocated());
+  }
+  EXPECT_EQ("hello", *object);
+  EXPECT_LT(total_reserved, Arena::totalReserved());
+  object.reset();
+  EXPECT_EQ(total_reserved, Arena::totalReserved());
+
+  object = makeSharedInArena<std::string>(nullptr, "world");
+  EXPECT_EQ("world", *object);
+  EXPECT_EQ(total_reserved, Arena::totalReserved());
+}
+
+TEST(ArenaTest, Container) {
+  auto arena = std::make_shared<Arena>();
+  std::map<int, int, std::less<int>, ArenaAllocator<std::pair<const int, int>>> map(
+      ArenaAllocator<std::pair<const int, int>>{arena});
+  for (int i = 0; i < 1000; ++i) {
+    map.emplace(i, i);
+  }
+  EXPECT_EQ(1000, map.size());
+  EXPECT_LT(1000 * sizeof(std::pair<const int, int>), arena->allocated());
+}
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
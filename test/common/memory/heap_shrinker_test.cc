@@ -1,3 +1,4 @@
+#include "source/common/buffer/slice_allocator.h"
 #include "source/common/event/dispatcher_impl.h"
 #include "source/common/memory/heap_shrinker.h"
 #include "source/common/memory/stats.h"
@@ -83,6 +84,25 @@ TEST_F(HeapShrinkerTest, ShrinkWhenTriggered) {
   EXPECT_EQ(2, shrink_count.value());
 }
 
+TEST_F(HeapShrinkerTest, ShrinkTrimsSliceAllocator) {
+  Server::OverloadActionCb action_cb;
+  EXPECT_CALL(overload_manager_, registerForAction(_, _, _))
+      .WillOnce(Invoke([&](const std::string&, Event::Dispatcher&, Server::OverloadActionCb cb) {
+        action_cb = cb;
+        return true;
+      }));
+
+  HeapShrinker h(dispatcher_, overload_manager_, *stats_.rootScope());
+
+  Buffer::SliceAllocator::release(Buffer::SliceAllocator::allocate(16384), 16384);
+  EXPECT_LT(0, Buffer::SliceAllocator::threadCachedForTest(16384));
+
+  action_cb(Server::OverloadActionState::saturated());
+  step();
+  EXPECT_EQ(0, Buffer::SliceAllocator::threadCachedForTest(16384));
+  EXPECT_EQ(0, Buffer::SliceAllocator::sharedCachedForTest(16384));
+}
+
 } // namespace
 } // namespace Memory
 } // namespace Envoy
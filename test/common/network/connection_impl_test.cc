@@ -158,7 +158,8 @@ protected:
       dispatcher_ = api_->allocateDispatcher("test_thread");
     }
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(address);
-    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false,
+                                            Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
     client_connection_ = std::make_unique<Network::TestClientConnectionImpl>(
         *dispatcher_, socket_->connectionInfoProvider().localAddress(), source_address_,
         createTransportSocket(), socket_options_, transport_socket_options_);
@@ -343,6 +344,32 @@ TEST_P(ConnectionImplTest, GetCongestionWindow) {
   disconnect(true);
 }
 
+TEST_P(ConnectionImplTest, MigrateSocket) {
+  setUpBasicConnection();
+  connect();
+
+  // The read filter doesn't allow the connection to be migrated.
+  EXPECT_EQ(nullptr, server_connection_->migrateSocket());
+  EXPECT_EQ(Connection::State::Open, server_connection_->state());
+
+  EXPECT_CALL(*read_filter_, canMigrate()).WillOnce(Return(true));
+  EXPECT_CALL(server_callbacks_, onEvent(ConnectionEvent::LocalClose));
+  IoHandlePtr io_handle = server_connection_->migrateSocket();
+  ASSERT_NE(nullptr, io_handle);
+  EXPECT_TRUE(io_handle->isOpen());
+  EXPECT_EQ(Connection::State::Closed, server_connection_->state());
+
+  // The client only sees the connection close once the migrated socket is closed.
+  EXPECT_CALL(client_callbacks_, onEvent(ConnectionEvent::RemoteClose)).Times(0);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&client_callbacks_);
+
+  EXPECT_CALL(client_callbacks_, onEvent(ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { dispatcher_->exit(); }));
+  io_handle->close();
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
 TEST_P(ConnectionImplTest, CloseDuringConnectCallback) {
   setUpBasicConnection();
 
@@ -1426,7 +1453,8 @@ TEST_P(ConnectionImplTest, BindFailureTest) {
   dispatcher_ = api_->allocateDispatcher("test_thread");
   socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
       Network::Test::getCanonicalLoopbackAddress(GetParam()));
-  listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+  listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false,
+                                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   client_connection_ = dispatcher_->createClientConnection(
       socket_->connectionInfoProvider().localAddress(), source_address_,
@@ -2913,7 +2941,8 @@ public:
     dispatcher_ = api_->allocateDispatcher("test_thread");
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
         Network::Test::getCanonicalLoopbackAddress(GetParam()));
-    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(socket_, listener_callbacks_, runtime_, true, false,
+                                            Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
     client_connection_ = dispatcher_->createClientConnection(
         socket_->connectionInfoProvider().localAddress(),
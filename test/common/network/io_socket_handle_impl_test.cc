@@ -1,3 +1,4 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
@@ -99,6 +100,65 @@ TEST(IoSocketHandleImpl, LastRoundTripTimeReturnsRttIfSuccessful) {
               Eq(std::chrono::duration_cast<std::chrono::milliseconds>(rtt)));
 }
 
+TEST(IoSocketHandleImpl, SendmmsgSendsEachMessageWithItsOwnSlices) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+
+  std::string hello = "hello";
+  std::string world = "world";
+  std::string bye = "bye";
+  const Buffer::RawSlice first[] = {
+      {hello.data(), hello.size()}, {nullptr, 0}, {world.data(), world.size()}};
+  const Buffer::RawSlice second[] = {{bye.data(), bye.size()}};
+  const absl::Span<const Buffer::RawSlice> messages[] = {first, second};
+
+  const auto iov_string = [](const iovec& iov) {
+    return absl::string_view(static_cast<const char*>(iov.iov_base), iov.iov_len);
+  };
+  EXPECT_CALL(os_sys_calls, sendmmsg(_, _, 2, 0))
+      .WillOnce(Invoke([&](os_fd_t, struct mmsghdr* msgvec, unsigned int,
+                           int) -> Api::SysCallIntResult {
+        // The empty slice is skipped and no address is passed for the connected socket.
+        EXPECT_EQ(nullptr, msgvec[0].msg_hdr.msg_name);
+        EXPECT_EQ(2U, msgvec[0].msg_hdr.msg_iovlen);
+        EXPECT_EQ("hello", iov_string(msgvec[0].msg_hdr.msg_iov[0]));
+        EXPECT_EQ("world", iov_string(msgvec[0].msg_hdr.msg_iov[1]));
+        EXPECT_EQ(1U, msgvec[1].msg_hdr.msg_iovlen);
+        EXPECT_EQ("bye", iov_string(msgvec[1].msg_hdr.msg_iov[0]));
+        return {1, 0};
+      }));
+
+  IoSocketHandleImpl io_handle;
+  Api::IoCallUint64Result result = io_handle.sendmmsg(messages, 0);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(1U, result.return_value_);
+}
+
+// Reads of less than a default slice are done into a slice of their size.
+TEST(IoSocketHandleImpl, SmallReadIntoSmallSlice) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+
+  EXPECT_CALL(os_sys_calls, recv(_, _, 4096, 0))
+      .WillOnce(Invoke([](os_fd_t, void* buffer, size_t, int) -> Api::SysCallSizeResult {
+        memcpy(buffer, "hello", 5);
+        return {5, 0};
+      }));
+
+  IoSocketHandleImpl io_handle;
+  Buffer::OwnedImpl buffer;
+  Api::IoCallUint64Result result = io_handle.read(buffer, 4096);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(5U, result.return_value_);
+  EXPECT_EQ("hello", buffer.toString());
+  ASSERT_EQ(1U, buffer.describeSlicesForTest().size());
+  EXPECT_EQ(4096U, buffer.describeSlicesForTest()[0].capacity);
+}
+
 TEST(IoSocketHandleImpl, InterfaceNameWithPipe) {
   std::string path = TestEnvironment::unixDomainSocketPath("foo.sock");
 
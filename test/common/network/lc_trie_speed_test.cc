@@ -1,6 +1,11 @@
+#include <random>
+
 #include "source/common/network/lc_trie.h"
+#include "source/common/network/stride_trie.h"
 #include "source/common/network/utility.h"
 
+#include "test/benchmark/main.h"
+
 #include "benchmark/benchmark.h"
 
 namespace {
@@ -50,23 +55,66 @@ struct CidrInputs {
       tag_data_minimal_;
 };
 
+struct BgpInputs {
+  // Construct num_prefixes prefixes with lengths distributed as in full BGP tables: 3 in 4 are
+  // IPv4 prefixes, of which 60% are /24s, 35% are /16s to /23s and the rest are /8s to /15s; the
+  // others are IPv6 prefixes, half /48s and half /29s to /47s. Prefixes are tagged with one of 256
+  // tags, as when tagging by country or origin AS.
+  explicit BgpInputs(size_t num_prefixes) : tag_data_(256) {
+    std::mt19937 random(0);
+    for (size_t i = 0; i < tag_data_.size(); i++) {
+      tag_data_[i].first = fmt::format("tag_{}", i);
+    }
+    for (size_t i = 0; i < num_prefixes; i++) {
+      const uint32_t address = random();
+      const uint32_t length_class = random() % 100;
+      std::string prefix;
+      if (i % 4 != 3) {
+        const uint32_t length = length_class < 60   ? 24
+                                : length_class < 95 ? 16 + random() % 8
+                                                    : 8 + random() % 8;
+        prefix = fmt::format("{}.{}.{}.{}/{}", address >> 24, (address >> 16) & 0xff,
+                             (address >> 8) & 0xff, address & 0xff, length);
+      } else {
+        const uint32_t length = length_class < 50 ? 48 : 29 + random() % 19;
+        prefix = fmt::format("{:x}:{:x}:{:x}::/{}", 0x2000 | (address >> 20),
+                             (address >> 4) & 0xffff, random() & 0xffff, length);
+      }
+      tag_data_[random() % tag_data_.size()].second.push_back(
+          Envoy::Network::Address::CidrRange::create(prefix));
+    }
+
+    for (size_t i = 0; i < 4096; i++) {
+      const uint32_t address = random();
+      addresses_.push_back(Envoy::Network::Utility::parseInternetAddress(
+          i % 4 != 3 ? fmt::format("{}.{}.{}.{}", address >> 24, (address >> 16) & 0xff,
+                                   (address >> 8) & 0xff, address & 0xff)
+                     : fmt::format("{:x}:{:x}:{:x}::1", 0x2000 | (address >> 20),
+                                   (address >> 4) & 0xffff, random() & 0xffff)));
+    }
+  }
+
+  std::vector<std::pair<std::string, std::vector<Envoy::Network::Address::CidrRange>>> tag_data_;
+  std::vector<Envoy::Network::Address::InstanceConstSharedPtr> addresses_;
+};
+
 } // namespace
 
 namespace Envoy {
 
-static void lcTrieConstruct(benchmark::State& state) {
+static void lcTrieConstruct(::benchmark::State& state) {
   CidrInputs inputs;
 
   std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> trie;
   for (auto _ : state) {
     trie = std::make_unique<Envoy::Network::LcTrie::LcTrie<std::string>>(inputs.tag_data_);
   }
-  benchmark::DoNotOptimize(trie);
+  ::benchmark::DoNotOptimize(trie);
 }
 
 BENCHMARK(lcTrieConstruct);
 
-static void lcTrieConstructNested(benchmark::State& state) {
+static void lcTrieConstructNested(::benchmark::State& state) {
   CidrInputs inputs;
 
   std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> trie;
@@ -74,24 +122,24 @@ static void lcTrieConstructNested(benchmark::State& state) {
     trie = std::make_unique<Envoy::Network::LcTrie::LcTrie<std::string>>(
         inputs.tag_data_nested_prefixes_);
   }
-  benchmark::DoNotOptimize(trie);
+  ::benchmark::DoNotOptimize(trie);
 }
 
 BENCHMARK(lcTrieConstructNested);
 
-static void lcTrieConstructMinimal(benchmark::State& state) {
+static void lcTrieConstructMinimal(::benchmark::State& state) {
   CidrInputs inputs;
 
   std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> trie;
   for (auto _ : state) {
     trie = std::make_unique<Envoy::Network::LcTrie::LcTrie<std::string>>(inputs.tag_data_minimal_);
   }
-  benchmark::DoNotOptimize(trie);
+  ::benchmark::DoNotOptimize(trie);
 }
 
 BENCHMARK(lcTrieConstructMinimal);
 
-static void lcTrieLookup(benchmark::State& state) {
+static void lcTrieLookup(::benchmark::State& state) {
   CidrInputs cidr_inputs;
   AddressInputs address_inputs;
   std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> lc_trie =
@@ -104,12 +152,12 @@ static void lcTrieLookup(benchmark::State& state) {
     i %= address_inputs.addresses_.size();
     output_tags += lc_trie->getData(address_inputs.addresses_[i]).size();
   }
-  benchmark::DoNotOptimize(output_tags);
+  ::benchmark::DoNotOptimize(output_tags);
 }
 
 BENCHMARK(lcTrieLookup);
 
-static void lcTrieLookupWithNestedPrefixes(benchmark::State& state) {
+static void lcTrieLookupWithNestedPrefixes(::benchmark::State& state) {
   CidrInputs cidr_inputs;
   AddressInputs address_inputs;
   std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> lc_trie_nested_prefixes =
@@ -123,12 +171,12 @@ static void lcTrieLookupWithNestedPrefixes(benchmark::State& state) {
     i %= address_inputs.addresses_.size();
     output_tags += lc_trie_nested_prefixes->getData(address_inputs.addresses_[i]).size();
   }
-  benchmark::DoNotOptimize(output_tags);
+  ::benchmark::DoNotOptimize(output_tags);
 }
 
 BENCHMARK(lcTrieLookupWithNestedPrefixes);
 
-static void lcTrieLookupMinimal(benchmark::State& state) {
+static void lcTrieLookupMinimal(::benchmark::State& state) {
   CidrInputs cidr_inputs;
   AddressInputs address_inputs;
   std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> lc_trie_minimal =
@@ -141,9 +189,62 @@ static void lcTrieLookupMinimal(benchmark::State& state) {
     i %= address_inputs.addresses_.size();
     output_tags += lc_trie_minimal->getData(address_inputs.addresses_[i]).size();
   }
-  benchmark::DoNotOptimize(output_tags);
+  ::benchmark::DoNotOptimize(output_tags);
 }
 
 BENCHMARK(lcTrieLookupMinimal);
 
+// Construct an LC trie or a stride trie from a BGP sized table. The LC trie runs out of nodes
+// past about 200,000 such prefixes.
+template <class Trie> static void bgpTableConstruct(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  BgpInputs inputs(state.range(0));
+  std::unique_ptr<Trie> trie;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    trie = std::make_unique<Trie>(inputs.tag_data_);
+  }
+  ::benchmark::DoNotOptimize(trie);
+}
+
+BENCHMARK_TEMPLATE(bgpTableConstruct, Network::LcTrie::LcTrie<std::string>)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bgpTableConstruct, Network::StrideTrie::StrideTrie<std::string>)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(::benchmark::kMillisecond);
+
+// Look up random addresses in an LC trie or a stride trie built from a BGP sized table.
+template <class Trie> static void bgpTableLookup(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  BgpInputs inputs(state.range(0));
+  const Trie trie(inputs.tag_data_);
+  size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    i++;
+    i %= inputs.addresses_.size();
+    output_tags += trie.getData(inputs.addresses_[i]).size();
+  }
+  ::benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK_TEMPLATE(bgpTableLookup, Network::LcTrie::LcTrie<std::string>)
+    ->Arg(10000)
+    ->Arg(100000);
+BENCHMARK_TEMPLATE(bgpTableLookup, Network::StrideTrie::StrideTrie<std::string>)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
 } // namespace Envoy
@@ -21,6 +21,7 @@
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::Gt;
 using testing::Invoke;
 using testing::Return;
 
@@ -39,7 +40,8 @@ static void errorCallbackTest(Address::IpVersion version) {
       Network::Test::getCanonicalLoopbackAddress(version));
   Network::MockTcpListenerCallbacks listener_callbacks;
   Network::ListenerPtr listener =
-      dispatcher->createListener(socket, listener_callbacks, runtime, true, false);
+      dispatcher->createListener(socket, listener_callbacks, runtime, true, false,
+                                 Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   Network::ClientConnectionPtr client_connection = dispatcher->createClientConnection(
       socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
@@ -71,9 +73,11 @@ class TestTcpListenerImpl : public TcpListenerImpl {
 public:
   TestTcpListenerImpl(Event::DispatcherImpl& dispatcher, Random::RandomGenerator& random_generator,
                       Runtime::Loader& runtime, SocketSharedPtr socket, TcpListenerCallbacks& cb,
-                      bool bind_to_port, bool ignore_global_conn_limit)
+                      bool bind_to_port, bool ignore_global_conn_limit,
+                      uint32_t max_connections_to_accept_per_socket_event =
+                          Network::DefaultMaxConnectionsToAcceptPerSocketEvent)
       : TcpListenerImpl(dispatcher, random_generator, runtime, std::move(socket), cb, bind_to_port,
-                        ignore_global_conn_limit) {}
+                        ignore_global_conn_limit, max_connections_to_accept_per_socket_event) {}
 
   MOCK_METHOD(Address::InstanceConstSharedPtr, getLocalAddress, (os_fd_t fd));
 };
@@ -121,6 +125,42 @@ TEST_P(TcpListenerImplTest, UseActualDst) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+// Connections beyond the per socket event budget are accepted on the following socket events.
+TEST_P(TcpListenerImplTest, MaxConnectionsToAcceptPerSocketEvent) {
+  auto socket = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
+      Network::Test::getCanonicalLoopbackAddress(version_));
+  Network::MockTcpListenerCallbacks listener_callbacks;
+  Random::MockRandomGenerator random_generator;
+  NiceMock<Runtime::MockLoader> runtime;
+  Network::TestTcpListenerImpl listener(dispatcherImpl(), random_generator, runtime, socket,
+                                        listener_callbacks, true, false, 1);
+
+  std::vector<Network::ClientConnectionPtr> client_connections;
+  for (int i = 0; i < 3; ++i) {
+    client_connections.emplace_back(dispatcher_->createClientConnection(
+        socket->connectionInfoProvider().localAddress(), Network::Address::InstanceConstSharedPtr(),
+        Network::Test::createRawBufferSocket(), nullptr, nullptr));
+    client_connections.back()->connect();
+  }
+
+  EXPECT_CALL(listener_callbacks, recordConnectionsAcceptedOnSocketEvent(Gt(1))).Times(0);
+  EXPECT_CALL(listener_callbacks, recordConnectionsAcceptedOnSocketEvent(1)).Times(3);
+  int accepted = 0;
+  EXPECT_CALL(listener_callbacks, onAccept_(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](Network::ConnectionSocketPtr&) -> void {
+        if (++accepted == 3) {
+          dispatcher_->exit();
+        }
+      }));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  for (auto& client_connection : client_connections) {
+    client_connection->close(ConnectionCloseType::NoFlush);
+  }
+}
+
 TEST_P(TcpListenerImplTest, GlobalConnectionLimitEnforcement) {
   // Required to manipulate runtime values when there is no test server.
   TestScopedRuntime scoped_runtime;
@@ -130,7 +170,8 @@ TEST_P(TcpListenerImplTest, GlobalConnectionLimitEnforcement) {
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
   Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, false);
+      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, false,
+                                  Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   std::vector<Network::ClientConnectionPtr> client_connections;
   std::vector<Network::ConnectionPtr> server_connections;
@@ -195,7 +236,8 @@ TEST_P(TcpListenerImplTest, GlobalConnectionLimitListenerOptOut) {
       Network::Test::getCanonicalLoopbackAddress(version_));
   Network::MockTcpListenerCallbacks listener_callbacks;
   Network::ListenerPtr listener =
-      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, true);
+      dispatcher_->createListener(socket, listener_callbacks, scoped_runtime.loader(), true, true,
+                                  Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   std::vector<Network::ClientConnectionPtr> client_connections;
   std::vector<Network::ConnectionPtr> server_connections;
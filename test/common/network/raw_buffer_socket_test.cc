@@ -1,10 +1,24 @@
+#include <algorithm>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "test/mocks/network/io_handle.h"
+#include "test/mocks/network/mocks.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/test_runtime.h"
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::ReturnRef;
+
 namespace Envoy {
 namespace Network {
 
@@ -19,5 +33,64 @@ TEST(RawBufferSocketFactory, RawBufferSocketFactory) {
   EXPECT_GT(keys.size(), 0);
 }
 
+class RawBufferSocketReadSizeTest : public testing::Test {
+public:
+  RawBufferSocketReadSizeTest() {
+    ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
+  }
+
+  // Reads with the socket and returns the read sizes it asked for, with the peer sending the given
+  // amounts of data before the socket would block.
+  std::vector<absl::optional<uint64_t>> doRead(RawBufferSocket& socket,
+                                               const std::vector<uint64_t>& sent) {
+    std::vector<absl::optional<uint64_t>> read_sizes;
+    EXPECT_CALL(io_handle_, read(_, _))
+        .WillRepeatedly(Invoke(
+            [&](Buffer::Instance&, absl::optional<uint64_t> max_length) -> Api::IoCallUint64Result {
+              if (read_sizes.size() == sent.size()) {
+                return {0, Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                                           IoSocketError::deleteIoError)};
+              }
+              read_sizes.push_back(max_length);
+              return {std::min(sent[read_sizes.size() - 1], max_length.value_or(UINT64_MAX)),
+                      Api::IoErrorPtr(nullptr, [](Api::IoError*) {})};
+            }));
+    Buffer::OwnedImpl buffer;
+    socket.doRead(buffer);
+    return read_sizes;
+  }
+
+  NiceMock<MockTransportSocketCallbacks> callbacks_;
+  NiceMock<MockIoHandle> io_handle_;
+};
+
+TEST_F(RawBufferSocketReadSizeTest, AdaptsReadSize) {
+  RawBufferSocket socket;
+  socket.setTransportSocketCallbacks(callbacks_);
+
+  // Reads filling the read size grow it up to the size of a read reservation.
+  EXPECT_EQ((std::vector<absl::optional<uint64_t>>{16384, 32768, 65536, 131072, 131072}),
+            doRead(socket, {16384, 32768, 65536, 131072, 131072}));
+
+  // Reads much smaller than the read size shrink it down to a page, so that little data is read
+  // into small slices.
+  EXPECT_EQ((std::vector<absl::optional<uint64_t>>{131072, 65536, 32768, 16384, 8192, 4096, 4096}),
+            doRead(socket, {100, 100, 100, 100, 100, 100, 100}));
+
+  // Reads of about the read size leave it as is.
+  EXPECT_EQ((std::vector<absl::optional<uint64_t>>{4096, 4096}), doRead(socket, {2048, 2048}));
+}
+
+TEST_F(RawBufferSocketReadSizeTest, AdaptiveReadSizeDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.raw_buffer_socket_adapt_read_size", "false"}});
+  RawBufferSocket socket;
+  socket.setTransportSocketCallbacks(callbacks_);
+
+  EXPECT_EQ((std::vector<absl::optional<uint64_t>>{absl::nullopt, absl::nullopt}),
+            doRead(socket, {100, 131072}));
+}
+
 } // namespace Network
 } // namespace Envoy
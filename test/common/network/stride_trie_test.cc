@@ -0,0 +1,239 @@
+#include <memory>
+#include <random>
+
+#include "source/common/common/utility.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/lc_trie.h"
+#include "source/common/network/stride_trie.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace StrideTrie {
+
+class StrideTrieTest : public testing::Test {
+public:
+  static std::vector<std::pair<std::string, std::vector<Address::CidrRange>>>
+  tagData(const std::vector<std::vector<std::string>>& cidr_range_strings) {
+    std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> output;
+    for (size_t i = 0; i < cidr_range_strings.size(); i++) {
+      std::pair<std::string, std::vector<Address::CidrRange>> ip_tags;
+      ip_tags.first = fmt::format("tag_{0}", i);
+      for (const auto& j : cidr_range_strings[i]) {
+        ip_tags.second.push_back(Address::CidrRange::create(j));
+      }
+      output.push_back(ip_tags);
+    }
+    return output;
+  }
+
+  void setup(const std::vector<std::vector<std::string>>& cidr_range_strings,
+             bool exclusive = false) {
+    trie_ = std::make_unique<StrideTrie<std::string>>(tagData(cidr_range_strings), exclusive);
+  }
+
+  void expectIPAndTags(
+      const std::vector<std::pair<std::string, std::vector<std::string>>>& test_output) {
+    for (const auto& kv : test_output) {
+      std::vector<std::string> expected(kv.second);
+      std::sort(expected.begin(), expected.end());
+      std::vector<std::string> actual(trie_->getData(Utility::parseInternetAddress(kv.first)));
+      std::sort(actual.begin(), actual.end());
+      EXPECT_EQ(expected, actual) << kv.first;
+    }
+  }
+
+  std::unique_ptr<StrideTrie<std::string>> trie_;
+};
+
+TEST_F(StrideTrieTest, IPv4) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/4"},   // tag_0
+      {"16.0.0.0/4"},  // tag_1
+      {"40.0.0.0/5"},  // tag_2
+      {"64.0.0.0/3"},  // tag_3
+      {"160.0.0.0/6"}, // tag_4
+      {"232.0.0.0/8"}, // tag_5
+      {"233.0.0.0/8"}, // tag_6
+      {"10.1.2.0/23"}, // tag_7
+      {"10.1.4.7/32"}, // tag_8
+  };
+  setup(cidr_range_strings);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"0.0.0.0", {"tag_0"}},
+      {"16.0.0.1", {"tag_1"}},
+      {"40.0.0.255", {"tag_2"}},
+      {"64.0.130.0", {"tag_3"}},
+      {"164.0.0.0", {}},
+      {"160.0.0.1", {"tag_4"}},
+      {"232.0.80.0", {"tag_5"}},
+      {"233.255.255.255", {"tag_6"}},
+      {"10.1.3.255", {"tag_0", "tag_7"}},
+      {"10.1.4.7", {"tag_0", "tag_8"}},
+      {"10.1.4.6", {"tag_0"}},
+      {"::1", {}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(StrideTrieTest, IPv4Boundaries) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/32"},         // tag_0
+      {"255.255.255.255/32"}, // tag_1
+      {"255.255.255.254/31"}, // tag_2
+  };
+  setup(cidr_range_strings, true);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"0.0.0.0", {"tag_0"}},
+      {"0.0.0.1", {}},
+      {"255.255.255.255", {"tag_1"}},
+      {"255.255.255.254", {"tag_2"}},
+      {"255.255.255.253", {}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(StrideTrieTest, IPv6) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"2406:da00:2000::/40", "::1/128"}, // tag_0
+      {"2001:abcd:ef00::/56"},            // tag_1
+      {"2001:abcd:ef01::/64"},            // tag_2
+      {"::/128"},                         // tag_3
+  };
+  setup(cidr_range_strings);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"2406:da00:2000::1", {"tag_0"}},
+      {"::1", {"tag_0"}},
+      {"2001:abcd:ef00::1", {"tag_1"}},
+      {"2001:abcd:ef01::1", {"tag_2"}},
+      {"2001:abcd:ef02::1", {}},
+      {"::", {"tag_3"}},
+      {"1.2.3.4", {}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(StrideTrieTest, Empty) {
+  setup({});
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {{"1.2.3.4", {}},
+                                                                             {"::1", {}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(StrideTrieTest, CatchAllPrefixes) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/0"}, // tag_0
+      {"::/0"},      // tag_1
+  };
+  setup(cidr_range_strings);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"0.0.0.0", {"tag_0"}},
+      {"255.255.255.255", {"tag_0"}},
+      {"::", {"tag_1"}},
+      {"ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff", {"tag_1"}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(StrideTrieTest, NestedPrefixesWithCatchAll) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/0"},                          // tag_0
+      {"203.0.113.0/24"},                     // tag_1
+      {"203.0.113.128/25"},                   // tag_2
+      {"198.51.100.0/24"},                    // tag_3
+      {"::0/0"},                              // tag_4
+      {"2001:db8::/96", "2001:db8::8000/97"}, // tag_5
+      {"2001:db8::ffff/128"},                 // tag_6
+      {"2001:db8:1::/48"},                    // tag_7
+      {"203.0.113.0/24"}                      // tag_8 (same subnet as tag_1)
+  };
+  setup(cidr_range_strings);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"203.0.0.0", {"tag_0"}},
+      {"203.0.113.0", {"tag_0", "tag_1", "tag_8"}},
+      {"203.0.113.192", {"tag_0", "tag_1", "tag_2", "tag_8"}},
+      {"203.0.113.255", {"tag_0", "tag_1", "tag_2", "tag_8"}},
+      {"198.51.100.1", {"tag_0", "tag_3"}},
+      {"2001:db8::ffff", {"tag_4", "tag_5", "tag_6"}},
+      {"2001:db8:1::ffff", {"tag_4", "tag_7"}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(StrideTrieTest, ExclusiveNestedPrefixesWithCatchAll) {
+  std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/0"},                          // tag_0
+      {"203.0.113.0/24"},                     // tag_1
+      {"203.0.113.128/25"},                   // tag_2
+      {"198.51.100.0/24"},                    // tag_3
+      {"::0/0"},                              // tag_4
+      {"2001:db8::/96", "2001:db8::8000/97"}, // tag_5
+      {"2001:db8::ffff/128"},                 // tag_6
+      {"2001:db8:1::/48"},                    // tag_7
+      {"203.0.113.0/24"}                      // tag_8 (same subnet as tag_1)
+  };
+  setup(cidr_range_strings, true);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"203.0.0.0", {"tag_0"}},       {"203.0.113.0", {"tag_1", "tag_8"}},
+      {"203.0.113.192", {"tag_2"}},   {"203.0.113.255", {"tag_2"}},
+      {"198.51.100.1", {"tag_3"}},    {"2001:db8::ffff", {"tag_6"}},
+      {"2001:db8:1::ffff", {"tag_7"}}};
+  expectIPAndTags(test_case);
+}
+
+// The stride trie returns the same data as the LC trie for random nested CIDR ranges.
+TEST_F(StrideTrieTest, MatchesLcTrie) {
+  std::mt19937 random(0);
+  for (const bool exclusive : {false, true}) {
+    std::vector<std::vector<std::string>> cidr_range_strings;
+    for (size_t i = 0; i < 200; i++) {
+      // Cluster the CIDR ranges in a few /8s so that many of them nest.
+      const uint32_t length = random() % 33;
+      cidr_range_strings.push_back(
+          {fmt::format("10.{}.{}.{}/{}", random() % 4, random() % 256, random() % 256, length),
+           fmt::format("2001:db8:{:x}:{:x}::/{}", random() % 4, random() % 65536, length * 2)});
+    }
+    const auto tag_data = tagData(cidr_range_strings);
+    const StrideTrie<std::string> stride_trie(tag_data, exclusive);
+    const LcTrie::LcTrie<std::string> lc_trie(tag_data, exclusive);
+
+    for (size_t i = 0; i < 10000; i++) {
+      const auto address = Utility::parseInternetAddress(
+          i % 2 == 0
+              ? fmt::format("10.{}.{}.{}", random() % 4, random() % 256, random() % 256)
+              : fmt::format("2001:db8:{:x}:{:x}:{:x}::", random() % 4, random() % 65536,
+                            random() % 65536));
+      std::vector<std::string> expected = lc_trie.getData(address);
+      std::sort(expected.begin(), expected.end());
+      std::vector<std::string> actual = stride_trie.getData(address);
+      std::sort(actual.begin(), actual.end());
+      EXPECT_EQ(expected, actual) << address->asString();
+    }
+  }
+}
+
+// Unlike the LC trie, the stride trie isn't limited to 2^18 CIDR ranges.
+TEST_F(StrideTrieTest, MoreCidrRangesThanLcTrie) {
+  std::vector<Address::CidrRange> prefixes;
+  for (size_t i = 0; i < (1 << 19); i++) {
+    prefixes.push_back(Address::CidrRange::create(
+        fmt::format("10.{}.{}.{}/32", i >> 16, (i >> 8) & 0xff, i & 0xff)));
+  }
+  std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input{
+      {"tag", prefixes}};
+  trie_ = std::make_unique<StrideTrie<std::string>>(ip_tags_input);
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"10.0.0.0", {"tag"}}, {"10.7.255.255", {"tag"}}, {"10.8.0.0", {}}};
+  expectIPAndTags(test_case);
+}
+
+} // namespace StrideTrie
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,74 @@
+// Measures how many datagrams per second a connected UDP socket sends with one sendmsg call per
+// datagram, and with batches of datagrams sent with a single sendmmsg call.
+
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/socket_impl.h"
+#include "source/common/network/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+
+namespace {
+
+// A receiver which never reads, and a sender connected to it. Datagrams overflowing the receive
+// buffer are dropped by the kernel without the sender noticing, so the send rate is not bound by
+// the receiver.
+struct ConnectedUdpSockets {
+  ConnectedUdpSockets()
+      : receiver_(Socket::Type::Datagram, Utility::getCanonicalIpv4LoopbackAddress(), nullptr, {}),
+        sender_(Socket::Type::Datagram, Utility::getCanonicalIpv4LoopbackAddress(), nullptr, {}) {
+    RELEASE_ASSERT(receiver_.bind(Utility::getCanonicalIpv4LoopbackAddress()).return_value_ == 0,
+                   "");
+    RELEASE_ASSERT(
+        sender_.ioHandle().connect(receiver_.ioHandle().localAddress()).return_value_ == 0, "");
+  }
+
+  SocketImpl receiver_;
+  SocketImpl sender_;
+};
+
+// Size of a small game or DNS datagram.
+constexpr uint64_t DatagramSize = 100;
+
+} // namespace
+
+static void bmUdpSendmsg(benchmark::State& state) {
+  ConnectedUdpSockets sockets;
+  Buffer::OwnedImpl datagram(std::string(DatagramSize, 'a'));
+  const Buffer::RawSliceVector slices = datagram.getRawSlices();
+  const Address::InstanceConstSharedPtr peer = sockets.receiver_.ioHandle().localAddress();
+  for (auto _ : state) {
+    Api::IoCallUint64Result result =
+        sockets.sender_.ioHandle().sendmsg(slices.data(), slices.size(), 0, nullptr, *peer);
+    benchmark::DoNotOptimize(result.return_value_);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(bmUdpSendmsg);
+
+static void bmUdpSendmmsg(benchmark::State& state) {
+  ConnectedUdpSockets sockets;
+  if (!sockets.sender_.ioHandle().supportsMmsg()) {
+    state.SkipWithError("sendmmsg is not supported");
+    return;
+  }
+  const uint64_t batch_size = state.range(0);
+  Buffer::OwnedImpl datagram(std::string(DatagramSize, 'a'));
+  const Buffer::RawSliceVector slices = datagram.getRawSlices();
+  const std::vector<absl::Span<const Buffer::RawSlice>> messages(batch_size, slices);
+  uint64_t sent = 0;
+  for (auto _ : state) {
+    Api::IoCallUint64Result result = sockets.sender_.ioHandle().sendmmsg(messages, 0);
+    sent += result.ok() ? result.return_value_ : 0;
+  }
+  state.SetItemsProcessed(sent);
+}
+BENCHMARK(bmUdpSendmmsg)->Arg(1)->Arg(8)->Arg(16)->Arg(64);
+
+} // namespace Network
+} // namespace Envoy
@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -84,8 +85,16 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
  * matched by the incoming request. Only the last route will be matched.
  * We then time how long it takes for the request to be matched against the
  * last route.
+ *
+ * When `arena` is set, the virtual host and route entries are allocated from the route
+ * configuration's arena rather than the heap.
  */
-static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type,
+                             bool arena = false) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.route_config_hugepage_arena", arena ? "true" : "false"}});
+
   // Setup router for benchmarking.
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
@@ -136,9 +145,29 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Same as bmRouteTableSizeWithPathPrefixMatch, with the route entries allocated from an arena.
+ */
+static void bmRouteTableSizeWithPathPrefixMatchInArena(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPrefix, true);
+}
+
+/**
+ * Same as bmRouteTableSizeWithExactPathMatch, with the route entries allocated from an arena.
+ */
+static void bmRouteTableSizeWithExactPathMatchInArena(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath, true);
+}
+
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatchInArena)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithExactPathMatchInArena)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 2 << 13}});
 
 } // namespace
 } // namespace Router
@@ -18,6 +18,7 @@
 #include "source/common/config/well_known_names.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
+#include "source/common/memory/arena.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/router/config_impl.h"
 #include "source/common/router/string_accessor_impl.h"
@@ -479,6 +480,51 @@ virtual_hosts:
             config.route(genHeaders("bat5.com", " ", "CONNECT"), 0)->routeEntry()->clusterName());
 }
 
+// The virtual hosts and routes of a configuration are allocated from its arena, which outlives the
+// configuration until the last route is released.
+TEST_F(RouteMatcherTest, RoutesInArena) {
+  mergeValues({{"envoy.reloadable_features.route_config_hugepage_arena", "true"}});
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: www
+  domains:
+  - www.lyft.com
+  routes:
+  - match:
+      prefix: "/foo"
+    route:
+      cluster: foo
+  - match:
+      path: "/bar"
+    route:
+      cluster: bar
+  - match:
+      safe_regex:
+        regex: "/baz/.*"
+    route:
+      cluster: baz
+  )EOF";
+  factory_context_.cluster_manager_.initializeClusters({"foo", "bar", "baz"}, {});
+  const uint64_t arena_allocated = Memory::Arena::totalAllocated();
+  RouteConstSharedPtr route;
+  {
+    TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+    EXPECT_LT(arena_allocated, Memory::Arena::totalAllocated());
+
+    EXPECT_EQ("foo", config.route(genHeaders("www.lyft.com", "/foo/1", "GET"), 0)
+                         ->routeEntry()
+                         ->clusterName());
+    EXPECT_EQ("bar", config.route(genHeaders("www.lyft.com", "/bar", "GET"), 0)
+                         ->routeEntry()
+                         ->clusterName());
+    route = config.route(genHeaders("www.lyft.com", "/baz/1", "GET"), 0);
+  }
+  EXPECT_EQ("baz", route->routeEntry()->clusterName());
+  EXPECT_LT(arena_allocated, Memory::Arena::totalAllocated());
+  route.reset();
+  EXPECT_EQ(arena_allocated, Memory::Arena::totalAllocated());
+}
+
 TEST_F(RouteMatcherTest, TestRoutes) {
   const std::string yaml = R"EOF(
 virtual_hosts:
@@ -0,0 +1,114 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/compression/common/compressor/compressor_pool.h"
+
+#include "test/mocks/server/overload_manager.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+namespace {
+
+class TestCompressor : public Envoy::Compression::Compressor::Compressor {
+public:
+  TestCompressor(uint32_t id) : id_(id) {}
+
+  void reset() {}
+
+  // Compression::Compressor::Compressor
+  void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State) override {
+    buffer.add(absl::StrCat(id_));
+  }
+
+  const uint32_t id_;
+};
+
+class CompressorPoolTest : public testing::Test {
+protected:
+  CompressorPoolTest()
+      : pool_(std::make_unique<CompressorPool<TestCompressor>>(
+            tls_, overload_manager_, 2, [this]() {
+              return std::make_unique<TestCompressor>(++built_);
+            })) {}
+
+  // Returns the id of the compressor backing the pooled one.
+  static std::string compressorId(Envoy::Compression::Compressor::Compressor& compressor) {
+    Buffer::OwnedImpl buffer;
+    compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    return buffer.toString();
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Server::MockOverloadManager> overload_manager_;
+  uint32_t built_{0};
+  CompressorPoolPtr<TestCompressor> pool_;
+};
+
+TEST_F(CompressorPoolTest, ReusesReleasedCompressors) {
+  auto compressor = pool_->acquire();
+  EXPECT_EQ("1", compressorId(*compressor));
+  EXPECT_EQ(0U, pool_->idleCount());
+
+  compressor.reset();
+  EXPECT_EQ(1U, pool_->idleCount());
+
+  compressor = pool_->acquire();
+  EXPECT_EQ("1", compressorId(*compressor));
+  EXPECT_EQ(0U, pool_->idleCount());
+  EXPECT_EQ(1U, built_);
+}
+
+TEST_F(CompressorPoolTest, BuildsCompressorsWhenNoneIdle) {
+  auto compressor1 = pool_->acquire();
+  auto compressor2 = pool_->acquire();
+  EXPECT_EQ("1", compressorId(*compressor1));
+  EXPECT_EQ("2", compressorId(*compressor2));
+  EXPECT_EQ(2U, built_);
+}
+
+TEST_F(CompressorPoolTest, KeepsAtMostMaxIdleCompressors) {
+  auto compressor1 = pool_->acquire();
+  auto compressor2 = pool_->acquire();
+  auto compressor3 = pool_->acquire();
+
+  compressor1.reset();
+  compressor2.reset();
+  compressor3.reset();
+  EXPECT_EQ(2U, pool_->idleCount());
+}
+
+TEST_F(CompressorPoolTest, DropsCompressorsUnderMemoryPressure) {
+  auto compressor1 = pool_->acquire();
+  auto compressor2 = pool_->acquire();
+  compressor1.reset();
+  EXPECT_EQ(1U, pool_->idleCount());
+
+  const Server::OverloadActionState saturated = Server::OverloadActionState::saturated();
+  EXPECT_CALL(overload_manager_.overload_state_,
+              getState(Server::OverloadActionNames::get().ShrinkHeap))
+      .WillOnce(ReturnRef(saturated));
+  compressor2.reset();
+  EXPECT_EQ(0U, pool_->idleCount());
+}
+
+TEST_F(CompressorPoolTest, CompressorOutlivesPool) {
+  auto compressor = pool_->acquire();
+  pool_.reset();
+  EXPECT_EQ("1", compressorId(*compressor));
+  compressor.reset();
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
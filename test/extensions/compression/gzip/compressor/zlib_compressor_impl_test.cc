@@ -3,6 +3,8 @@
 #include "source/extensions/compression/gzip/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
+#include "test/mocks/server/overload_manager.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "absl/container/fixed_array.h"
@@ -159,6 +161,31 @@ TEST_P(ZlibCompressorImplFactoryTest, CreateCompressorTest) {
   drainBuffer(buffer);
 }
 
+// Exercises compressors reused from the factory's pool, including one whose previous stream was
+// abandoned before being finished.
+TEST(ZlibCompressorImplPoolTest, PooledCompressorStartsNewStream) {
+  testing::NiceMock<ThreadLocal::MockInstance> tls;
+  testing::NiceMock<Server::MockOverloadManager> overload_manager;
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  GzipCompressorFactory factory(gzip, tls, overload_manager);
+  Buffer::OwnedImpl buffer;
+
+  {
+    Envoy::Compression::Compressor::CompressorPtr compressor = factory.createCompressor();
+    TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+    compressor->compress(buffer, Envoy::Compression::Compressor::State::Flush);
+    drainBuffer(buffer);
+  }
+
+  for (uint32_t i = 0; i < 2; ++i) {
+    Envoy::Compression::Compressor::CompressorPtr compressor = factory.createCompressor();
+    TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+    compressor->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+    expectValidFinishedBuffer(buffer, 4096);
+    drainBuffer(buffer);
+  }
+}
+
 // Exercises death by passing bad initialization params or by calling
 // compress before init.
 TEST_F(ZlibCompressorImplDeathTest, CompressorDeathTest) {
@@ -105,6 +105,20 @@ TEST_F(ZstdCompressorImplTest, CompressWitHugeBuffer) {
   verifyWithDecompressor(std::move(compressor));
 }
 
+TEST_F(ZstdCompressorImplTest, ResetDiscardsUnfinishedFrame) {
+  auto compressor =
+      std::make_unique<ZstdCompressorImpl>(default_compression_level_, default_enable_checksum_,
+                                           default_strategy_, default_cdict_manager_, 4096);
+
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+  compressor->compress(buffer, Envoy::Compression::Compressor::State::Flush);
+  drainBuffer(buffer);
+
+  compressor->reset();
+  verifyWithDecompressor(std::move(compressor));
+}
+
 TEST_F(ZstdCompressorImplTest, IllegalConfig) {
   envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
   Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
@@ -802,6 +802,45 @@ TEST(CreateVaryIdentifier, DisallowedHeaderWithAllowedHeader) {
       absl::nullopt);
 }
 
+TEST(CreateVaryIdentifier, AcceptEncodingNormalized) {
+  VaryAllowList vary_allow_list(toStringMatchers({"accept-encoding"}));
+
+  Http::TestRequestHeaderMapImpl request_headers1{{"accept-encoding", "gzip, br"}};
+  Http::TestRequestHeaderMapImpl request_headers2{{"accept-encoding", "BR,gzip;q=1.0"}};
+  Http::TestRequestHeaderMapImpl request_headers3{{"accept-encoding", "br"},
+                                                  {"accept-encoding", "gzip, br"}};
+
+  EXPECT_EQ(VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"},
+                                                  request_headers1),
+            "vary-id\naccept-encoding\rbr,gzip\n");
+  EXPECT_EQ(VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"},
+                                                  request_headers2),
+            "vary-id\naccept-encoding\rbr,gzip\n");
+  EXPECT_EQ(VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"},
+                                                  request_headers3),
+            "vary-id\naccept-encoding\rbr,gzip\n");
+}
+
+TEST(CreateVaryIdentifier, AcceptEncodingKeepsPreferences) {
+  VaryAllowList vary_allow_list(toStringMatchers({"accept-encoding"}));
+
+  Http::TestRequestHeaderMapImpl request_headers{
+      {"accept-encoding", "gzip;q=0.5, br, zstd;q=0, deflate;level=1"}};
+
+  EXPECT_EQ(VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"},
+                                                  request_headers),
+            "vary-id\naccept-encoding\rbr,deflate;level=1,gzip;q=0.5,zstd;q=0\n");
+}
+
+TEST(CreateVaryIdentifier, AcceptEncodingMissing) {
+  VaryAllowList vary_allow_list(toStringMatchers({"accept-encoding"}));
+  Http::TestRequestHeaderMapImpl request_headers;
+
+  EXPECT_EQ(VaryHeaderUtils::createVaryIdentifier(vary_allow_list, {"accept-encoding"},
+                                                  request_headers),
+            "vary-id\naccept-encoding\r\n");
+}
+
 envoy::extensions::filters::http::cache::v3::CacheConfig getConfig() {
   // Allows {accept, accept-language, width} to be varied in the tests.
   envoy::extensions::filters::http::cache::v3::CacheConfig config;
@@ -5,15 +5,18 @@
 #include "source/extensions/compression/brotli/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
+#include "source/extensions/compression/zstd/compressor/config.h"
 #include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
 #include "source/extensions/filters/http/compressor/compressor_filter.h"
 
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/factory_context.h"
 #include "test/mocks/stats/mocks.h"
 
 #include "benchmark/benchmark.h"
 #include "gmock/gmock.h"
+#include "zdict.h"
 
 using testing::Return;
 
@@ -688,6 +691,250 @@ BENCHMARK(compressChunks1024WithBrotli)
     ->UseManualTime()
     ->Unit(benchmark::kMillisecond);
 
+// Typical API responses are small, so per-stream setup and the lack of shared context dominate
+// both the cost and the ratio of compressing them. The benchmarks below compress a set of ~2 KB
+// JSON documents, one stream each, and report the achieved "ratio" next to the time taken.
+static constexpr uint64_t SmallPayloadCount = 100;
+static constexpr uint64_t DictionaryTrainingSampleCount = 1000;
+static constexpr uint64_t DictionaryCapacity = 16 * 1024;
+
+// Builds a JSON document shaped like an API response. Documents share their structure and field
+// names but differ in values, which is the redundancy a trained dictionary captures.
+static std::string generateJsonPayload(uint64_t seed) {
+  static constexpr absl::string_view statuses[] = {"pending", "shipped", "delivered", "returned"};
+  std::string json =
+      absl::StrCat(R"({"id":)", seed, R"(,"type":"order","status":")", statuses[seed % 4],
+                   R"(","created_at":"2023-05-)", 10 + seed % 18, "T", 10 + seed % 13, ":",
+                   10 + seed % 49, R"(:00Z","customer":{"id":)", (seed * 7919) % 100000,
+                   R"(,"name":"Customer )", seed, R"(","email":"customer)", seed,
+                   R"(@example.com","tier":")", seed % 2 ? "gold" : "standard", R"("},"items":[)");
+  for (uint64_t i = 0; i < 12; ++i) {
+    absl::StrAppend(&json, i == 0 ? "" : ",", R"({"sku":"SKU-)", (seed * 31 + i * 17) % 99991,
+                    R"(","name":"Item )", (seed + i) % 500, R"(","quantity":)", 1 + (seed + i) % 5,
+                    R"(,"unit_price":{"amount":)", (seed * 13 + i * 101) % 10000,
+                    R"(,"currency":"USD"},"in_stock":)", (seed + i) % 3 ? "true" : "false", "}");
+  }
+  absl::StrAppend(&json, R"(],"shipping":{"method":"ground","address":{"city":"City )", seed % 97,
+                  R"(","country":"US","postal_code":")", 10000 + (seed * 37) % 89999, R"("}}})");
+  return json;
+}
+
+static std::vector<std::string> generateJsonPayloads(uint64_t first_seed, uint64_t count) {
+  std::vector<std::string> payloads;
+  payloads.reserve(count);
+  for (uint64_t seed = first_seed; seed < first_seed + count; ++seed) {
+    payloads.push_back(generateJsonPayload(seed));
+  }
+  return payloads;
+}
+
+const std::vector<std::string>& smallJsonPayloads() {
+  CONSTRUCT_ON_FIRST_USE(std::vector<std::string>, generateJsonPayloads(0, SmallPayloadCount));
+}
+
+// Trains a dictionary on documents disjoint from the ones being compressed, the way an operator
+// would train one offline from sampled traffic.
+static std::string trainZstdDictionary() {
+  std::string samples;
+  std::vector<size_t> sample_sizes;
+  for (const std::string& sample :
+       generateJsonPayloads(SmallPayloadCount, DictionaryTrainingSampleCount)) {
+    samples.append(sample);
+    sample_sizes.push_back(sample.size());
+  }
+
+  std::string dictionary(DictionaryCapacity, '\0');
+  const size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(),
+                                            sample_sizes.data(), sample_sizes.size());
+  RELEASE_ASSERT(!ZDICT_isError(size), ZDICT_getErrorName(size));
+  dictionary.resize(size);
+  return dictionary;
+}
+
+const std::string& zstdDictionary() { CONSTRUCT_ON_FIRST_USE(std::string, trainZstdDictionary()); }
+
+// Uses the production factory so that the dictionary is digested once into a CDict which is then
+// shared by every compressor it creates.
+CompressorFilterConfigSharedPtr
+makeZstdDictionaryConfig(Stats::IsolatedStoreImpl& stats,
+                         testing::NiceMock<Runtime::MockLoader>& runtime,
+                         NiceMock<Server::Configuration::MockFactoryContext>& context,
+                         const CompressionParams& params) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  zstd.mutable_compression_level()->set_value(params.level);
+  zstd.mutable_dictionary()->set_inline_bytes(zstdDictionary());
+
+  Compression::Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  envoy::extensions::filters::http::compressor::v3::Compressor compressor;
+  return std::make_shared<CompressorFilterConfig>(
+      compressor, "test.", *stats.rootScope(), runtime,
+      lib_factory.createCompressorFactoryFromProto(zstd, context));
+}
+
+// Compresses every small payload in its own stream. Only the response path of the filter is
+// timed; setting up the mocked stream is not.
+static void compressSmallPayloadsWith(CompressorFilterConfigSharedPtr config,
+                                      absl::string_view encoding, benchmark::State& state) {
+  Result res;
+  std::chrono::duration<double> elapsed{0};
+  for (const std::string& payload : smallJsonPayloads()) {
+    NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+    CompressorFilter filter(config);
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+
+    Http::TestRequestHeaderMapImpl headers = {{":method", "get"},
+                                              {"accept-encoding", std::string(encoding)}};
+    filter.decodeHeaders(headers, true);
+
+    Http::TestResponseHeaderMapImpl response_headers = {
+        {":method", "get"},
+        {"content-length", absl::StrCat(payload.size())},
+        {"content-type", "application/json;charset=utf-8"}};
+    Buffer::OwnedImpl data(payload);
+    res.total_uncompressed_bytes += data.length();
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    filter.encodeHeaders(response_headers, false);
+    filter.encodeData(data, true);
+    elapsed += std::chrono::high_resolution_clock::now() - start;
+
+    res.total_compressed_bytes += data.length();
+  }
+
+  state.SetIterationTime(elapsed.count());
+  state.counters["ratio"] = static_cast<double>(res.total_uncompressed_bytes) /
+                            static_cast<double>(res.total_compressed_bytes);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithGzip(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats;
+  testing::NiceMock<Runtime::MockLoader> runtime;
+  ON_CALL(runtime.snapshot_, featureEnabled("test.filter_enabled", 100))
+      .WillByDefault(Return(true));
+  auto config = makeGzipConfig(stats, runtime, gzip_compression_params[state.range(0)]);
+
+  for (auto _ : state) { // NOLINT
+    compressSmallPayloadsWith(config, "gzip", state);
+  }
+}
+BENCHMARK(compressSmallJsonWithGzip)
+    ->DenseRange(0, 8, 1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithBrotli(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats;
+  testing::NiceMock<Runtime::MockLoader> runtime;
+  ON_CALL(runtime.snapshot_, featureEnabled("test.filter_enabled", 100))
+      .WillByDefault(Return(true));
+  auto config = makeBrotliConfig(stats, runtime, brotli_compression_params[state.range(0)]);
+
+  for (auto _ : state) { // NOLINT
+    compressSmallPayloadsWith(config, "br", state);
+  }
+}
+BENCHMARK(compressSmallJsonWithBrotli)
+    ->DenseRange(0, 10, 1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithZstd(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats;
+  testing::NiceMock<Runtime::MockLoader> runtime;
+  ON_CALL(runtime.snapshot_, featureEnabled("test.filter_enabled", 100))
+      .WillByDefault(Return(true));
+  auto config = makeZstdConfig(stats, runtime, zstd_compression_params[state.range(0)]);
+
+  for (auto _ : state) { // NOLINT
+    compressSmallPayloadsWith(config, "zstd", state);
+  }
+}
+BENCHMARK(compressSmallJsonWithZstd)
+    ->DenseRange(0, 21, 1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithZstdDictionary(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats;
+  testing::NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  ON_CALL(runtime.snapshot_, featureEnabled("test.filter_enabled", 100))
+      .WillByDefault(Return(true));
+  auto config =
+      makeZstdDictionaryConfig(stats, runtime, context, zstd_compression_params[state.range(0)]);
+
+  for (auto _ : state) { // NOLINT
+    compressSmallPayloadsWith(config, "zstd", state);
+  }
+}
+BENCHMARK(compressSmallJsonWithZstdDictionary)
+    ->DenseRange(0, 21, 1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// The production gzip and zstd factories reuse compressors from a per-worker pool rather than
+// allocating a new compression context for every stream. Compare with the benchmarks above.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithPooledGzip(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats;
+  testing::NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  ON_CALL(runtime.snapshot_, featureEnabled("test.filter_enabled", 100))
+      .WillByDefault(Return(true));
+  const auto& params = gzip_compression_params[state.range(0)];
+  using GzipConfig = envoy::extensions::compression::gzip::compressor::v3::Gzip;
+  GzipConfig gzip;
+  // Explicit zlib levels map to the proto enum values of the same number.
+  gzip.set_compression_level(params.level == Z_DEFAULT_COMPRESSION
+                                 ? GzipConfig::DEFAULT_COMPRESSION
+                                 : static_cast<GzipConfig::CompressionLevel>(params.level));
+  gzip.mutable_window_bits()->set_value(params.window_bits);
+  gzip.mutable_memory_level()->set_value(params.memory_level);
+
+  Compression::Gzip::Compressor::GzipCompressorLibraryFactory lib_factory;
+  envoy::extensions::filters::http::compressor::v3::Compressor compressor;
+  auto config = std::make_shared<CompressorFilterConfig>(
+      compressor, "test.", *stats.rootScope(), runtime,
+      lib_factory.createCompressorFactoryFromProto(gzip, context));
+
+  for (auto _ : state) { // NOLINT
+    compressSmallPayloadsWith(config, "gzip", state);
+  }
+}
+BENCHMARK(compressSmallJsonWithPooledGzip)
+    ->DenseRange(0, 8, 1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallJsonWithPooledZstd(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats;
+  testing::NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  ON_CALL(runtime.snapshot_, featureEnabled("test.filter_enabled", 100))
+      .WillByDefault(Return(true));
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  zstd.mutable_compression_level()->set_value(zstd_compression_params[state.range(0)].level);
+
+  Compression::Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  envoy::extensions::filters::http::compressor::v3::Compressor compressor;
+  auto config = std::make_shared<CompressorFilterConfig>(
+      compressor, "test.", *stats.rootScope(), runtime,
+      lib_factory.createCompressorFactoryFromProto(zstd, context));
+
+  for (auto _ : state) { // NOLINT
+    compressSmallPayloadsWith(config, "zstd", state);
+  }
+}
+BENCHMARK(compressSmallJsonWithPooledZstd)
+    ->DenseRange(0, 21, 1)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace Compressor
 } // namespace HttpFilters
 } // namespace Extensions
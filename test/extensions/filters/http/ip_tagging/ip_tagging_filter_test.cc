@@ -10,6 +10,7 @@
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -24,9 +25,12 @@ namespace HttpFilters {
 namespace IpTagging {
 namespace {
 
-class IpTaggingFilterTest : public testing::Test {
+// Runs with the LC trie and with the stride trie.
+class IpTaggingFilterTest : public testing::TestWithParam<bool> {
 public:
   IpTaggingFilterTest() {
+    scoped_runtime_.mergeValues(
+        {{"envoy.reloadable_features.ip_tagging_stride_trie", GetParam() ? "true" : "false"}});
     ON_CALL(runtime_.snapshot_, featureEnabled("ip_tagging.http_filter_enabled", 100))
         .WillByDefault(Return(true));
   }
@@ -51,6 +55,7 @@ ip_tags:
 
   ~IpTaggingFilterTest() override { filter_->onDestroy(); }
 
+  TestScopedRuntime scoped_runtime_;
   NiceMock<Stats::MockStore> stats_;
   IpTaggingFilterConfigSharedPtr config_;
   std::unique_ptr<IpTaggingFilter> filter_;
@@ -59,7 +64,9 @@ ip_tags:
   NiceMock<Runtime::MockLoader> runtime_;
 };
 
-TEST_F(IpTaggingFilterTest, InternalRequest) {
+INSTANTIATE_TEST_SUITE_P(Tries, IpTaggingFilterTest, testing::Bool());
+
+TEST_P(IpTaggingFilterTest, InternalRequest) {
   initializeFilter(internal_request_yaml);
   EXPECT_EQ(FilterRequestType::INTERNAL, config_->requestType());
   Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"}};
@@ -85,7 +92,7 @@ TEST_F(IpTaggingFilterTest, InternalRequest) {
   EXPECT_FALSE(request_headers.has(Http::Headers::get().EnvoyIpTags));
 }
 
-TEST_F(IpTaggingFilterTest, ExternalRequest) {
+TEST_P(IpTaggingFilterTest, ExternalRequest) {
   const std::string external_request_yaml = R"EOF(
 request_type: external
 ip_tags:
@@ -118,7 +125,7 @@ ip_tags:
   EXPECT_FALSE(request_headers.has(Http::Headers::get().EnvoyIpTags));
 }
 
-TEST_F(IpTaggingFilterTest, BothRequest) {
+TEST_P(IpTaggingFilterTest, BothRequest) {
   const std::string both_request_yaml = R"EOF(
 request_type: both
 ip_tags:
@@ -155,7 +162,7 @@ ip_tags:
   EXPECT_EQ("external_request", request_headers.get_(Http::Headers::get().EnvoyIpTags));
 }
 
-TEST_F(IpTaggingFilterTest, NoHits) {
+TEST_P(IpTaggingFilterTest, NoHits) {
   initializeFilter(internal_request_yaml);
   Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"}};
 
@@ -175,7 +182,7 @@ TEST_F(IpTaggingFilterTest, NoHits) {
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
-TEST_F(IpTaggingFilterTest, AppendEntry) {
+TEST_P(IpTaggingFilterTest, AppendEntry) {
   initializeFilter(internal_request_yaml);
   Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"},
                                                  {"x-envoy-ip-tags", "test"}};
@@ -193,7 +200,7 @@ TEST_F(IpTaggingFilterTest, AppendEntry) {
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
-TEST_F(IpTaggingFilterTest, NestedPrefixes) {
+TEST_P(IpTaggingFilterTest, NestedPrefixes) {
   const std::string duplicate_request_yaml = R"EOF(
 request_type: both
 ip_tags:
@@ -220,7 +227,7 @@ ip_tags:
 
   EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
 
-  // There is no guarantee for the order tags are returned by the LC-Trie.
+  // There is no guarantee for the order tags are returned by the trie.
   const std::string header_tag_data = request_headers.get_(Http::Headers::get().EnvoyIpTags.get());
   EXPECT_NE(std::string::npos, header_tag_data.find("test"));
   EXPECT_NE(std::string::npos, header_tag_data.find("internal_request"));
@@ -231,7 +238,7 @@ ip_tags:
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
-TEST_F(IpTaggingFilterTest, Ipv6Address) {
+TEST_P(IpTaggingFilterTest, Ipv6Address) {
   const std::string ipv6_addresses_yaml = R"EOF(
 ip_tags:
   - ip_tag_name: ipv6_request
@@ -254,7 +261,7 @@ ip_tags:
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
-TEST_F(IpTaggingFilterTest, RuntimeDisabled) {
+TEST_P(IpTaggingFilterTest, RuntimeDisabled) {
   initializeFilter(internal_request_yaml);
   Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"}};
 
@@ -267,7 +274,7 @@ TEST_F(IpTaggingFilterTest, RuntimeDisabled) {
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
-TEST_F(IpTaggingFilterTest, ClearRouteCache) {
+TEST_P(IpTaggingFilterTest, ClearRouteCache) {
   initializeFilter(internal_request_yaml);
   Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"}};
 
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include "test/extensions/filters/listener/tls_inspector/tls_utility.h"
+
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+namespace {
+
+class ClientHelloParserTest : public testing::TestWithParam<std::tuple<uint16_t, uint16_t>> {
+public:
+  ClientHelloParser::Result parse(const std::vector<uint8_t>& data, size_t len) {
+    return ClientHelloParser::parse(data.data(), len, client_hello_, server_name_);
+  }
+  ClientHelloParser::Result parse(const std::vector<uint8_t>& data) {
+    return parse(data, data.size());
+  }
+
+  SSL_CLIENT_HELLO client_hello_{};
+  absl::string_view server_name_;
+};
+
+INSTANTIATE_TEST_SUITE_P(TlsProtocolVersions, ClientHelloParserTest,
+                         testing::Values(std::make_tuple(TLS1_VERSION, TLS1_3_VERSION),
+                                         std::make_tuple(TLS1_VERSION, TLS1_VERSION),
+                                         std::make_tuple(TLS1_1_VERSION, TLS1_1_VERSION),
+                                         std::make_tuple(TLS1_2_VERSION, TLS1_2_VERSION),
+                                         std::make_tuple(TLS1_3_VERSION, TLS1_3_VERSION)));
+
+// The fields of a ClientHello point into the parsed data.
+TEST_P(ClientHelloParserTest, Parsed) {
+  std::vector<uint8_t> data = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), "example.com", "\x02h2");
+  ASSERT_EQ(ClientHelloParser::Result::Parsed, parse(data));
+  EXPECT_EQ("example.com", server_name_);
+  EXPECT_EQ(nullptr, client_hello_.ssl);
+  EXPECT_EQ(data.data() + SSL3_RT_HEADER_LENGTH + SSL3_HM_HEADER_LENGTH,
+            client_hello_.client_hello);
+  EXPECT_EQ(data.data() + data.size(), client_hello_.client_hello + client_hello_.client_hello_len);
+  EXPECT_EQ(std::min<uint16_t>(std::get<1>(GetParam()), TLS1_2_VERSION), client_hello_.version);
+  EXPECT_EQ(static_cast<size_t>(SSL3_RANDOM_SIZE), client_hello_.random_len);
+  EXPECT_LT(0U, client_hello_.cipher_suites_len);
+
+  const uint8_t* alpn;
+  size_t alpn_len;
+  ASSERT_TRUE(SSL_early_callback_ctx_extension_get(
+      &client_hello_, TLSEXT_TYPE_application_layer_protocol_negotiation, &alpn, &alpn_len));
+  EXPECT_EQ(absl::string_view("\x00\x03\x02h2", 5),
+            absl::string_view(reinterpret_cast<const char*>(alpn), alpn_len));
+}
+
+TEST_P(ClientHelloParserTest, NoServerName) {
+  std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(std::get<0>(GetParam()), std::get<1>(GetParam()), "", "");
+  ASSERT_EQ(ClientHelloParser::Result::Parsed, parse(data));
+  EXPECT_TRUE(server_name_.empty());
+}
+
+// Every part of a ClientHello is the start of a ClientHello.
+TEST_P(ClientHelloParserTest, NeedMoreData) {
+  std::vector<uint8_t> data = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), "example.com", "");
+  for (size_t len = 0; len < data.size(); ++len) {
+    EXPECT_EQ(ClientHelloParser::Result::NeedMoreData, parse(data, len)) << len;
+  }
+}
+
+TEST_P(ClientHelloParserTest, MultipleRecords) {
+  std::vector<uint8_t> data = Tls::Test::splitClientHelloRecord(
+      Tls::Test::generateClientHello(std::get<0>(GetParam()), std::get<1>(GetParam()),
+                                     "example.com", ""),
+      10);
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported, parse(data));
+}
+
+TEST(ClientHelloParserErrorTest, NotTls) {
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  const std::vector<uint8_t> data(100);
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported,
+            ClientHelloParser::parse(data.data(), 1, client_hello, server_name));
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported,
+            ClientHelloParser::parse(data.data(), data.size(), client_hello, server_name));
+}
+
+TEST(ClientHelloParserErrorTest, UnsupportedVersion) {
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  const std::vector<uint8_t> data = Tls::Test::generateClientHelloFromJA3Fingerprint("768,47,,,");
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported,
+            ClientHelloParser::parse(data.data(), data.size(), client_hello, server_name));
+}
+
+TEST(ClientHelloParserErrorTest, DuplicateExtensions) {
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHelloFromJA3Fingerprint("771,47,23-23,,");
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported,
+            ClientHelloParser::parse(data.data(), data.size(), client_hello, server_name));
+}
+
+TEST(ClientHelloParserErrorTest, MalformedExtension) {
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  // Empty supported_groups extension.
+  const std::vector<uint8_t> data = Tls::Test::generateClientHelloFromJA3Fingerprint("771,47,10,,");
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported,
+            ClientHelloParser::parse(data.data(), data.size(), client_hello, server_name));
+}
+
+TEST(ClientHelloParserErrorTest, TrailingDataInRecord) {
+  SSL_CLIENT_HELLO client_hello;
+  absl::string_view server_name;
+  std::vector<uint8_t> data = Tls::Test::generateClientHelloFromJA3Fingerprint("771,47,0,,");
+  ASSERT_EQ(ClientHelloParser::Result::Parsed,
+            ClientHelloParser::parse(data.data(), data.size(), client_hello, server_name));
+  EXPECT_EQ("www.envoyproxy.io", server_name);
+
+  // Grow the record by one byte past the handshake message.
+  data.push_back(0);
+  ++data[4];
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported,
+            ClientHelloParser::parse(data.data(), data.size(), client_hello, server_name));
+}
+
+} // namespace
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -65,10 +65,16 @@ public:
   const std::vector<uint8_t> client_hello_;
 };
 
+// Inspects a ClientHello in a single record, which is parsed directly, or split over two records,
+// which is left to the TLS library.
 static void BM_TlsInspector(benchmark::State& state) {
-  NiceMock<FastMockOsSysCalls> os_sys_calls(Tls::Test::generateClientHello(
+  std::vector<uint8_t> client_hello = Tls::Test::generateClientHello(
       Config::TLS_MIN_SUPPORTED_VERSION, Config::TLS_MAX_SUPPORTED_VERSION, "example.com",
-      "\x02h2\x08http/1.1"));
+      "\x02h2\x08http/1.1");
+  if (state.range(0) != 0) {
+    client_hello = Tls::Test::splitClientHelloRecord(client_hello, client_hello.size() / 2);
+  }
+  NiceMock<FastMockOsSysCalls> os_sys_calls(client_hello);
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls{&os_sys_calls};
   NiceMock<Stats::MockStore> store;
   envoy::extensions::filters::listener::tls_inspector::v3::TlsInspector proto_config;
@@ -100,7 +106,7 @@ static void BM_TlsInspector(benchmark::State& state) {
   }
 }
 
-BENCHMARK(BM_TlsInspector)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TlsInspector)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
 
 } // namespace TlsInspector
 } // namespace ListenerFilters
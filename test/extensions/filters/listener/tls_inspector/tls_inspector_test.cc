@@ -229,6 +229,45 @@ TEST_P(TlsInspectorTest, NoExtensions) {
   EXPECT_EQ(1, cfg_->stats().alpn_not_found_.value());
 }
 
+// Test that a ClientHello split over multiple records, which is left to the TLS library, is
+// inspected as well.
+TEST_P(TlsInspectorTest, ClientHelloOverMultipleRecords) {
+  init();
+  const auto alpn_protos = std::vector<absl::string_view>{Http::Utility::AlpnNames::get().Http2};
+  const std::string servername("example.com");
+  std::vector<uint8_t> client_hello = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), servername, "\x02h2");
+  client_hello = Tls::Test::splitClientHelloRecord(client_hello, 10);
+  mockSysCallForPeek(client_hello);
+  EXPECT_CALL(socket_, setRequestedServerName(Eq(servername)));
+  EXPECT_CALL(socket_, setRequestedApplicationProtocols(alpn_protos));
+  EXPECT_CALL(socket_, setDetectedTransportProtocol(absl::string_view("tls")));
+  EXPECT_CALL(socket_, detectedTransportProtocol()).Times(::testing::AnyNumber());
+  // trigger the event to copy the client hello message into buffer
+  file_event_callback_(Event::FileReadyType::Read);
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_found_.value());
+  EXPECT_EQ(1, cfg_->stats().sni_found_.value());
+  EXPECT_EQ(1, cfg_->stats().alpn_found_.value());
+}
+
+// Test that a ClientHello the TLS library rejects is not reported as TLS.
+TEST_P(TlsInspectorTest, UnsupportedVersion) {
+  init();
+  // SSL 3.0 ClientHello.
+  std::vector<uint8_t> client_hello =
+      Tls::Test::generateClientHelloFromJA3Fingerprint("768,47-53,,,");
+  mockSysCallForPeek(client_hello);
+  EXPECT_CALL(socket_, setRequestedServerName(_)).Times(0);
+  EXPECT_CALL(socket_, setDetectedTransportProtocol(_)).Times(0);
+  // trigger the event to copy the client hello message into buffer
+  file_event_callback_(Event::FileReadyType::Read);
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_not_found_.value());
+}
+
 // Test that the filter fails if the ClientHello is larger than the
 // maximum allowed size.
 TEST_P(TlsInspectorTest, ClientHelloTooBig) {
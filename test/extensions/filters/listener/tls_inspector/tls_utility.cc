@@ -195,6 +195,26 @@ std::vector<uint8_t> generateClientHelloFromJA3Fingerprint(const std::string& ja
   return clienthello_message;
 }
 
+std::vector<uint8_t> splitClientHelloRecord(const std::vector<uint8_t>& client_hello,
+                                            size_t first_record_size) {
+  const size_t header_size = SSL3_RT_HEADER_LENGTH;
+  ASSERT(client_hello.size() > header_size + first_record_size);
+  const size_t second_record_size = client_hello.size() - header_size - first_record_size;
+
+  std::vector<uint8_t> records;
+  for (const auto& [offset, size] :
+       {std::make_pair(header_size, first_record_size),
+        std::make_pair(header_size + first_record_size, second_record_size)}) {
+    // Same record type and version as the original record.
+    records.insert(records.end(), client_hello.begin(), client_hello.begin() + 3);
+    records.push_back((size & 0xff00) >> 8);
+    records.push_back(size & 0xff);
+    records.insert(records.end(), client_hello.begin() + offset,
+                   client_hello.begin() + offset + size);
+  }
+  return records;
+}
+
 } // namespace Test
 } // namespace Tls
 } // namespace Envoy
@@ -25,6 +25,14 @@ std::vector<uint8_t> generateClientHello(uint16_t tls_min_version, uint16_t tls_
  */
 std::vector<uint8_t> generateClientHelloFromJA3Fingerprint(const std::string& ja3_fingerprint);
 
+/**
+ * Split a TLS ClientHello in wire-format over two handshake records.
+ * @param client_hello The ClientHello to split, in a single record.
+ * @param first_record_size The number of bytes of the handshake message in the first record.
+ */
+std::vector<uint8_t> splitClientHelloRecord(const std::vector<uint8_t>& client_hello,
+                                            size_t first_record_size);
+
 } // namespace Test
 } // namespace Tls
 } // namespace Envoy
@@ -68,6 +68,7 @@ public:
     // Create timers in order they are created in client_impl.cc
     connect_or_op_timer_ = new Event::MockTimer(&dispatcher_);
     flush_timer_ = new Event::MockTimer(&dispatcher_);
+    flush_cb_ = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
 
     EXPECT_CALL(*connect_or_op_timer_, enableTimer(_, _));
     EXPECT_CALL(*host_, createConnection_(_, _)).WillOnce(Return(conn_info));
@@ -114,7 +115,7 @@ public:
 
     Common::Redis::RespValue readonly_request = Utility::ReadOnlyRequest::instance();
     EXPECT_CALL(*encoder_, encode(Eq(readonly_request), _));
-    EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+    EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
     client_->initialize(auth_username_, auth_password_);
 
     EXPECT_EQ(1UL, host_->cluster_.traffic_stats_->upstream_rq_total_.value());
@@ -131,6 +132,7 @@ public:
   std::shared_ptr<Upstream::MockHost> host_{new NiceMock<Upstream::MockHost>()};
   Event::MockDispatcher dispatcher_;
   Event::MockTimer* flush_timer_{};
+  Event::MockSchedulableCallback* flush_cb_{};
   Event::MockTimer* connect_or_op_timer_{};
   MockEncoder* encoder_{new MockEncoder()};
   MockDecoder* decoder_{new MockDecoder()};
@@ -148,7 +150,8 @@ public:
 
 TEST_F(RedisClientImplTest, BatchWithZeroBufferAndTimeout) {
   // Basic test with a single request, default buffer size (0) and timeout (0).
-  // This means we do not batch requests, and thus the flush timer is never enabled.
+  // This means we do not batch requests across event loop iterations, and thus the flush timer is
+  // never enabled.
   InSequence s;
 
   setup();
@@ -157,7 +160,7 @@ TEST_F(RedisClientImplTest, BatchWithZeroBufferAndTimeout) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -287,6 +290,43 @@ TEST_F(RedisClientImplTest, BatchWithTimerCancelledByBufferFlush) {
   client_->close();
 }
 
+TEST_F(RedisClientImplTest, BatchWithZeroBufferFlushesAtEndOfIteration) {
+  // With the default buffer size (0), the requests made during an event loop iteration are sent
+  // upstream together with a single write at its end.
+  InSequence s;
+
+  setup();
+
+  Common::Redis::RespValue request1;
+  request1.type(Common::Redis::RespType::BulkString);
+  request1.asString() = "foo";
+  MockClientCallbacks callbacks1;
+  EXPECT_CALL(*encoder_, encode(Ref(request1), _));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
+  EXPECT_NE(nullptr, client_->makeRequest(request1, callbacks1));
+
+  // The flush is already scheduled for the second request.
+  Common::Redis::RespValue request2;
+  request2.type(Common::Redis::RespType::BulkString);
+  request2.asString() = "bar";
+  MockClientCallbacks callbacks2;
+  EXPECT_CALL(*encoder_, encode(Ref(request2), _));
+  EXPECT_CALL(*upstream_connection_, write(_, _)).Times(0);
+  EXPECT_NE(nullptr, client_->makeRequest(request2, callbacks2));
+
+  EXPECT_CALL(*upstream_connection_, write(_, false))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) -> void {
+        EXPECT_EQ("$3\r\nfoo\r\n$3\r\nbar\r\n", data.toString());
+        data.drain(data.length());
+      }));
+  flush_cb_->invokeCallback();
+
+  EXPECT_CALL(callbacks1, onFailure());
+  EXPECT_CALL(callbacks2, onFailure());
+  EXPECT_CALL(*connect_or_op_timer_, disableTimer());
+  client_->close();
+}
+
 TEST_F(RedisClientImplTest, Basic) {
   InSequence s;
 
@@ -297,7 +337,7 @@ TEST_F(RedisClientImplTest, Basic) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -306,7 +346,6 @@ TEST_F(RedisClientImplTest, Basic) {
   Common::Redis::RespValue request2;
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -382,7 +421,7 @@ TEST_F(RedisClientImplTest, CommandStatsDisabledSingleRequest) {
   initializeRedisSimpleCommand(&request1, get_command, "foo");
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -438,7 +477,7 @@ TEST_F(RedisClientImplTest, CommandStatsEnabledTwoRequests) {
   initializeRedisSimpleCommand(&request1, get_command, "foo");
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -448,7 +487,6 @@ TEST_F(RedisClientImplTest, CommandStatsEnabledTwoRequests) {
   initializeRedisSimpleCommand(&request2, get_command, "bar");
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -514,7 +552,7 @@ TEST_F(RedisClientImplTest, InitializedWithAuthPassword) {
   auth_password_ = "testing password";
   Utility::AuthRequest auth_request(auth_password_);
   EXPECT_CALL(*encoder_, encode(Eq(auth_request), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   client_->initialize(auth_username_, auth_password_);
 
   EXPECT_EQ(1UL, host_->cluster_.traffic_stats_->upstream_rq_total_.value());
@@ -536,7 +574,7 @@ TEST_F(RedisClientImplTest, InitializedWithAuthAcl) {
   auth_password_ = "testing password";
   Utility::AuthRequest auth_request(auth_username_, auth_password_);
   EXPECT_CALL(*encoder_, encode(Eq(auth_request), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   client_->initialize(auth_username_, auth_password_);
 
   EXPECT_EQ(1UL, host_->cluster_.traffic_stats_->upstream_rq_total_.value());
@@ -577,7 +615,7 @@ TEST_F(RedisClientImplTest, Cancel) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -586,7 +624,6 @@ TEST_F(RedisClientImplTest, Cancel) {
   Common::Redis::RespValue request2;
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -630,7 +667,7 @@ TEST_F(RedisClientImplTest, FailAll) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -659,7 +696,7 @@ TEST_F(RedisClientImplTest, FailAllWithCancel) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -684,7 +721,7 @@ TEST_F(RedisClientImplTest, ProtocolError) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -713,7 +750,7 @@ TEST_F(RedisClientImplTest, ConnectFail) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -751,7 +788,7 @@ TEST_F(RedisClientImplTest, OutlierDisabled) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -772,7 +809,7 @@ TEST_F(RedisClientImplTest, ConnectTimeout) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -795,7 +832,7 @@ TEST_F(RedisClientImplTest, OpTimeout) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -814,7 +851,6 @@ TEST_F(RedisClientImplTest, OpTimeout) {
   EXPECT_EQ(0UL, host_->cluster_.traffic_stats_->upstream_rq_active_.value());
 
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   EXPECT_CALL(*connect_or_op_timer_, enableTimer(_, _));
   handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
@@ -840,7 +876,7 @@ TEST_F(RedisClientImplTest, AskRedirection) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -849,7 +885,6 @@ TEST_F(RedisClientImplTest, AskRedirection) {
   Common::Redis::RespValue request2;
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -897,7 +932,7 @@ TEST_F(RedisClientImplTest, MovedRedirection) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -906,7 +941,6 @@ TEST_F(RedisClientImplTest, MovedRedirection) {
   Common::Redis::RespValue request2;
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -954,7 +988,7 @@ TEST_F(RedisClientImplTest, RedirectionFailure) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -963,7 +997,6 @@ TEST_F(RedisClientImplTest, RedirectionFailure) {
   Common::Redis::RespValue request2;
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -1023,7 +1056,7 @@ TEST_F(RedisClientImplTest, AskRedirectionNotEnabled) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -1032,7 +1065,6 @@ TEST_F(RedisClientImplTest, AskRedirectionNotEnabled) {
   Common::Redis::RespValue request2;
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -1090,7 +1122,7 @@ TEST_F(RedisClientImplTest, MovedRedirectionNotEnabled) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -1099,7 +1131,6 @@ TEST_F(RedisClientImplTest, MovedRedirectionNotEnabled) {
   Common::Redis::RespValue request2;
   MockClientCallbacks callbacks2;
   EXPECT_CALL(*encoder_, encode(Ref(request2), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
   PoolRequest* handle2 = client_->makeRequest(request2, callbacks2);
   EXPECT_NE(nullptr, handle2);
 
@@ -1158,7 +1189,7 @@ TEST_F(RedisClientImplTest, RemoveFailedHealthCheck) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
@@ -1192,7 +1223,7 @@ TEST_F(RedisClientImplTest, RemoveFailedHost) {
   Common::Redis::RespValue request1;
   MockClientCallbacks callbacks1;
   EXPECT_CALL(*encoder_, encode(Ref(request1), _));
-  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*flush_cb_, scheduleCallbackCurrentIteration());
   PoolRequest* handle1 = client_->makeRequest(request1, callbacks1);
   EXPECT_NE(nullptr, handle1);
 
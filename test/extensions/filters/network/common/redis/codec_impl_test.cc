@@ -275,6 +275,52 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+TEST_F(RedisEncoderDecoderImplTest, LargeBulkStringAcrossSlices) {
+  const std::string body(EncoderImpl::MinMovedBulkStringLength, 'a');
+  buffer_.add(absl::StrCat("$", body.size(), "\r\n", body.substr(0, 100)));
+  decoder_.decode(buffer_);
+  EXPECT_TRUE(decoded_values_.empty());
+
+  buffer_.appendSliceForTest(body.substr(100));
+  buffer_.appendSliceForTest("\r\n");
+  decoder_.decode(buffer_);
+  ASSERT_EQ(1UL, decoded_values_.size());
+  EXPECT_EQ(RespType::BulkString, decoded_values_[0]->type());
+  EXPECT_EQ(body, decoded_values_[0]->asString());
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, EncodeAndReleaseMovesLargeBulkStrings) {
+  const std::string large(EncoderImpl::MinMovedBulkStringLength, 'l');
+  RespValuePtr value = std::make_unique<RespValue>();
+  value->type(RespType::Array);
+  value->asArray().resize(3);
+  value->asArray()[0].type(RespType::BulkString);
+  value->asArray()[0].asString() = large;
+  value->asArray()[1].type(RespType::BulkString);
+  value->asArray()[1].asString() = "small";
+  value->asArray()[2].type(RespType::Integer);
+  value->asArray()[2].asInteger() = 1;
+  const RespValue expected = *value;
+  const char* large_data = value->asArray()[0].asString().data();
+
+  encoder_.encodeAndRelease(std::move(value), buffer_);
+  EXPECT_EQ(nullptr, value);
+  EXPECT_EQ(absl::StrCat("*3\r\n$", large.size(), "\r\n", large, "\r\n$5\r\nsmall\r\n:1\r\n"),
+            buffer_.toString());
+
+  // The large string's bytes are referenced by the buffer rather than copied into it.
+  bool found = false;
+  for (const Buffer::RawSlice& slice : buffer_.getRawSlices()) {
+    found |= slice.mem_ == large_data;
+  }
+  EXPECT_TRUE(found);
+
+  decoder_.decode(buffer_);
+  EXPECT_EQ(expected, *decoded_values_[0]);
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
@@ -26,6 +26,10 @@ MockEncoder::MockEncoder() {
           Invoke([this](const Common::Redis::RespValue& value, Buffer::Instance& out) -> void {
             real_encoder_.encode(value, out);
           }));
+  // Forward to encode() so that tests can expect the values encoded either way.
+  ON_CALL(*this, encodeAndRelease(_, _))
+      .WillByDefault(Invoke([this](Common::Redis::RespValuePtr&& value,
+                                   Buffer::Instance& out) -> void { encode(*value, out); }));
 }
 
 MockEncoder::~MockEncoder() = default;
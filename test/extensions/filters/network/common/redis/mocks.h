@@ -30,6 +30,8 @@ public:
   ~MockEncoder() override;
 
   MOCK_METHOD(void, encode, (const Common::Redis::RespValue& value, Buffer::Instance& out));
+  MOCK_METHOD(void, encodeAndRelease,
+              (Common::Redis::RespValuePtr && value, Buffer::Instance& out));
 
 private:
   Common::Redis::EncoderImpl real_encoder_;
@@ -203,9 +203,9 @@ TEST(HessianProtocolTest, deserializeRpcInvocationWithParametersOrAttachment) {
 
     auto& result_attach = invo->mutableAttachment();
 
-    // When parsing attachment, parameters will also be parsed.
+    // The encoder may refer to the map parameter encoded before rather than encode the attachment
+    // again, in which case the parameters are parsed first.
     EXPECT_EQ(true, invo->hasAttachment());
-    EXPECT_EQ(true, invo->hasParameters());
 
     EXPECT_EQ("test_value2", result_attach->attachment()
                                  .toUntypedMap()
@@ -226,6 +226,54 @@ TEST(HessianProtocolTest, deserializeRpcInvocationWithParametersOrAttachment) {
                                  .value()
                                  .get());
   }
+  // Test case that the parameters are skipped to parse the attachment.
+  {
+    RpcInvocationImpl::Attachment other_attach(
+        std::make_unique<RpcInvocationImpl::Attachment::Map>(), 0);
+    other_attach.insert("group", "test_group");
+
+    DubboHessian2SerializerImpl serializer;
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string({
+        0x05, '2', '.', '0', '.', '2', // Dubbo version
+        0x04, 't', 'e', 's', 't',      // Service name
+        0x05, '0', '.', '0', '.', '0', // Service version
+        0x04, 't', 'e', 's', 't',      // method name
+    }));
+
+    Hessian2::Encoder encoder(std::make_unique<BufferWriter>(buffer));
+
+    encoder.encode<std::string>(parameters_type);
+
+    for (const auto& param : params) {
+      encoder.encode<Hessian2::Object>(*param);
+    }
+    encoder.encode<Hessian2::Object>(attach.attachment());
+
+    size_t expected_attachment_offset = buffer.length();
+
+    encoder.encode<Hessian2::Object>(other_attach.attachment());
+
+    std::shared_ptr<ContextImpl> context = std::make_shared<ContextImpl>();
+
+    context->setBodySize(buffer.length());
+
+    auto result = serializer.deserializeRpcInvocation(buffer, context);
+    EXPECT_EQ(true, result.second);
+
+    auto invo = dynamic_cast<RpcInvocationImpl*>(result.first.get());
+
+    context->originMessage().move(buffer, buffer.length());
+
+    EXPECT_EQ("test_group", invo->serviceGroup().value());
+    EXPECT_EQ(true, invo->hasAttachment());
+    EXPECT_EQ(false, invo->hasParameters());
+    EXPECT_EQ(expected_attachment_offset, invo->attachment().attachmentOffset());
+
+    // The parameters can still be parsed afterwards.
+    EXPECT_EQ(4, invo->parameters().size());
+    EXPECT_EQ("test_string", invo->parameters().at(0)->toString().value().get());
+  }
   // Test case that request only have parameters.
   {
     DubboHessian2SerializerImpl serializer;
@@ -263,9 +311,9 @@ TEST(HessianProtocolTest, deserializeRpcInvocationWithParametersOrAttachment) {
 
     auto& result_attach = invo->mutableAttachment();
 
-    // When parsing attachment, parameters will also be parsed.
+    // The encoder may refer to the map parameter encoded before rather than encode the attachment
+    // again, in which case the parameters are parsed first.
     EXPECT_EQ(true, invo->hasAttachment());
-    EXPECT_EQ(true, invo->hasParameters());
 
     auto& result_params = invo->parameters();
     EXPECT_EQ("test_value2", result_params.at(3)
@@ -354,6 +402,47 @@ TEST(HessianProtocolTest, deserializeRpcInvocationWithParametersOrAttachment) {
   }
 }
 
+// An attachment referring to a parameter can't be decoded on its own, so the parameters are decoded
+// first.
+TEST(HessianProtocolTest, deserializeRpcInvocationAttachmentWithReference) {
+  DubboHessian2SerializerImpl serializer;
+  Buffer::OwnedImpl buffer;
+  buffer.add(std::string({
+      0x05, '2', '.', '0', '.', '2', // Dubbo version
+      0x04, 't', 'e', 's', 't',      // Service name
+      0x05, '0', '.', '0', '.', '0', // Service version
+      0x04, 't', 'e', 's', 't',      // method name
+  }));
+
+  Hessian2::Encoder encoder(std::make_unique<BufferWriter>(buffer));
+  encoder.encode<std::string>("Ljava/util/Map;");
+  // The parameter.
+  buffer.add(std::string({'H', 0x01, 'a', 0x01, 'b', 'Z'}));
+  // The attachment, with a reference to the parameter.
+  buffer.add(std::string({'H', 0x05, 'g', 'r', 'o', 'u', 'p', 0x03, 'f', 'o', 'o', 0x03, 'r', 'e',
+                          'f', 'Q', static_cast<char>(0x90), 'Z'}));
+
+  std::shared_ptr<ContextImpl> context = std::make_shared<ContextImpl>();
+  context->setBodySize(buffer.length());
+
+  auto result = serializer.deserializeRpcInvocation(buffer, context);
+  EXPECT_EQ(true, result.second);
+
+  auto invo = dynamic_cast<RpcInvocationImpl*>(result.first.get());
+  context->originMessage().move(buffer, buffer.length());
+
+  EXPECT_EQ("foo", invo->serviceGroup().value());
+  EXPECT_EQ(true, invo->hasParameters());
+
+  // The reference resolves to the parameter, not to the attachment itself.
+  const auto& attachment = invo->attachment().attachment().toUntypedMap().value().get();
+  const auto ref = attachment.find("ref");
+  ASSERT_NE(attachment.end(), ref);
+  const auto& referenced = ref->second->toUntypedMap().value().get();
+  ASSERT_NE(referenced.end(), referenced.find("a"));
+  EXPECT_EQ("b", referenced.find("a")->second->toString().value().get());
+}
+
 TEST(HessianProtocolTest, deserializeRpcResult) {
   DubboHessian2SerializerImpl serializer;
   std::shared_ptr<ContextImpl> context = std::make_shared<ContextImpl>();
@@ -0,0 +1,86 @@
+// Measures the cost of deserializing a Dubbo request with the Hessian2 serializer and reading its
+// group for routing, which only needs the attachment, and of also decoding its parameters.
+//
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/dubbo_proxy/dubbo_hessian2_serializer_impl.h"
+#include "source/extensions/filters/network/dubbo_proxy/hessian_utils.h"
+#include "source/extensions/filters/network/dubbo_proxy/message_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace DubboProxy {
+namespace {
+
+Hessian2::ObjectPtr stringObject(const std::string& value) {
+  return std::make_unique<Hessian2::StringObject>(value);
+}
+
+// Builds the body of a request whose parameters are a string and a map of count users by name,
+// each a map with a few fields, followed by the attachment.
+void buildBody(Buffer::Instance& buffer, uint32_t count) {
+  Hessian2::Encoder encoder(std::make_unique<BufferWriter>(buffer));
+  encoder.encode<std::string>("2.0.2");
+  encoder.encode<std::string>("org.apache.dubbo.demo.UserService");
+  encoder.encode<std::string>("1.0.0");
+  encoder.encode<std::string>("saveUsers");
+  encoder.encode<std::string>("Ljava/lang/String;Ljava/util/Map;");
+
+  encoder.encode<std::string>("request-id-0123456789");
+  Hessian2::UntypedMapObject users;
+  for (uint32_t i = 0; i < count; i++) {
+    auto user = std::make_unique<Hessian2::UntypedMapObject>();
+    user->emplace(stringObject("id"), std::make_unique<Hessian2::LongObject>(i));
+    user->emplace(stringObject("name"), stringObject("user-" + std::to_string(i)));
+    user->emplace(stringObject("email"), stringObject("user" + std::to_string(i) + "@example.com"));
+    user->emplace(stringObject("address"), stringObject(std::string(64, 'a')));
+    users.emplace(stringObject("user-" + std::to_string(i)), std::move(user));
+  }
+  encoder.encode<Hessian2::Object>(users);
+
+  Hessian2::UntypedMapObject attachment;
+  attachment.emplace(stringObject("path"), stringObject("org.apache.dubbo.demo.UserService"));
+  attachment.emplace(stringObject("interface"), stringObject("org.apache.dubbo.demo.UserService"));
+  attachment.emplace(stringObject("version"), stringObject("1.0.0"));
+  attachment.emplace(stringObject("group"), stringObject("canary"));
+  attachment.emplace(stringObject("timeout"), stringObject("3000"));
+  encoder.encode<Hessian2::Object>(attachment);
+}
+
+} // namespace
+
+static void bmDeserializeRpcInvocation(benchmark::State& state) {
+  const bool decode_parameters = state.range(0) != 0;
+  Buffer::OwnedImpl body;
+  buildBody(body, state.range(1));
+  const std::string data = body.toString();
+  DubboHessian2SerializerImpl serializer;
+
+  for (auto _ : state) {
+    auto context = std::make_shared<ContextImpl>();
+    context->setBodySize(data.size());
+    Buffer::OwnedImpl buffer(data);
+    auto invocation = std::dynamic_pointer_cast<RpcInvocationImpl>(
+        serializer.deserializeRpcInvocation(buffer, context).first);
+    context->originMessage().move(buffer);
+
+    if (decode_parameters) {
+      benchmark::DoNotOptimize(invocation->parameters().size());
+    }
+    benchmark::DoNotOptimize(invocation->serviceGroup().has_value());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(bmDeserializeRpcInvocation)->ArgsProduct({{0, 1}, {1, 100}});
+
+} // namespace DubboProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
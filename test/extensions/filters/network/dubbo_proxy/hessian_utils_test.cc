@@ -1,5 +1,12 @@
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "envoy/common/exception.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/filters/network/dubbo_proxy/hessian_utils.h"
 
 #include "test/test_common/printers.h"
@@ -78,6 +85,223 @@ TEST(HessianUtilsTest, GetParametersNumberTest) {
   EXPECT_EQ(0, HessianUtils::getParametersNumber(test_error_types));
 }
 
+// Returns the offset following the value at the given offset, if it can be skipped.
+absl::optional<uint64_t> skipValue(const Buffer::Instance& buffer, uint64_t offset = 0) {
+  HessianSkipper skipper(buffer, offset);
+  if (!skipper.skipValue()) {
+    return absl::nullopt;
+  }
+  return skipper.offset();
+}
+
+TEST(HessianSkipperTest, EncodedValues) {
+  std::vector<std::function<void(Hessian2::Encoder&)>> values = {
+      [](Hessian2::Encoder& encoder) { encoder.encode<bool>(true); },
+      [](Hessian2::Encoder& encoder) {
+        encoder.encode<Hessian2::Object>(Hessian2::NullObject());
+      },
+      [](Hessian2::Encoder& encoder) {
+        encoder.encode<Hessian2::Object>(Hessian2::LongObject(int64_t{1} << 40));
+      },
+      [](Hessian2::Encoder& encoder) {
+        encoder.encode<Hessian2::Object>(Hessian2::BinaryObject(std::vector<uint8_t>(70000, 1)));
+      },
+      [](Hessian2::Encoder& encoder) {
+        Hessian2::UntypedMapObject map;
+        map.emplace(std::make_unique<Hessian2::StringObject>("key"),
+                    std::make_unique<Hessian2::StringObject>("value"));
+        auto nested = std::make_unique<Hessian2::UntypedMapObject>();
+        nested->emplace(std::make_unique<Hessian2::StringObject>("nested"),
+                        std::make_unique<Hessian2::LongObject>(1));
+        map.emplace(std::make_unique<Hessian2::StringObject>("map"), std::move(nested));
+        encoder.encode<Hessian2::Object>(map);
+      },
+  };
+  for (int32_t value : {0, -16, 47, 2047, -262144, 262143, std::numeric_limits<int32_t>::max()}) {
+    values.push_back([value](Hessian2::Encoder& encoder) { encoder.encode<int32_t>(value); });
+  }
+  for (int64_t value : std::vector<int64_t>{0, 15, 2047, 262143, int64_t{1} << 31,
+                                            std::numeric_limits<int64_t>::max()}) {
+    values.push_back([value](Hessian2::Encoder& encoder) { encoder.encode<int64_t>(value); });
+  }
+  for (double value : {0.0, 1.0, 127.0, 32767.0, 1.5, 1e300}) {
+    values.push_back([value](Hessian2::Encoder& encoder) { encoder.encode<double>(value); });
+  }
+  for (const std::string& value :
+       {std::string(), std::string("short"), std::string(1000, 'a'), std::string(70000, 'a'),
+        std::string("\xc3\xa9\xe4\xbd\xa0\xe5\xa5\xbd")}) {
+    values.push_back([value](Hessian2::Encoder& encoder) { encoder.encode<std::string>(value); });
+  }
+
+  for (const auto& encode : values) {
+    Buffer::OwnedImpl buffer;
+    buffer.add("prefix");
+    Hessian2::Encoder encoder(std::make_unique<BufferWriter>(buffer));
+    encode(encoder);
+    const uint64_t length = buffer.length();
+    buffer.add("suffix");
+
+    EXPECT_EQ(length, skipValue(buffer, 6));
+  }
+}
+
+TEST(HessianSkipperTest, HandcraftedValues) {
+  const std::vector<std::string> values = {
+      // Fixed length untyped list of two ints.
+      {'X', '\x92', '\x91', '\x92'},
+      // Compact fixed length untyped list of two ints.
+      {'\x7a', '\x91', '\x92'},
+      // Variable length typed list of one int.
+      {'U', '\x04', '[', 'i', 'n', 't', '\x91', 'Z'},
+      // Compact fixed length typed list of one int, with a type reference.
+      {'\x71', '\x90', '\x91'},
+      // Variable length untyped list of one string.
+      {'W', '\x01', 'a', 'Z'},
+      // Typed map, with a type reference.
+      {'M', '\x90', '\x91', '\x92', 'Z'},
+      // Reference.
+      {'Q', '\x90'},
+      // Dates.
+      {'J', '\x00', '\x00', '\x00', '\xd0', '\x4b', '\x92', '\x84', '\xb8'},
+      {'\x4b', '\x00', '\xe3', '\x83', '\x8f'},
+      // String in chunks.
+      {'R', '\x00', '\x01', 'a', 'S', '\x00', '\x01', 'b'},
+      // Binary in chunks.
+      {'A', '\x00', '\x01', 'a', 'B', '\x00', '\x01', 'b'},
+  };
+
+  for (const std::string& value : values) {
+    Buffer::OwnedImpl buffer(value);
+    buffer.add("suffix");
+    EXPECT_EQ(value.size(), skipValue(buffer));
+  }
+}
+
+TEST(HessianSkipperTest, ClassInstances) {
+  Buffer::OwnedImpl buffer(std::string({
+      // Class definition.
+      'C', '\x0b', 'e', 'x', 'a', 'm', 'p', 'l', 'e', '.', 'C', 'a', 'r', '\x92', '\x05', 'c', 'o',
+      'l', 'o', 'r', '\x05', 'm', 'o', 'd', 'e', 'l',
+      // First instance.
+      'O', '\x90', '\x03', 'r', 'e', 'd', '\x05', 'v', 'a', 'l', 'u', 'e',
+      // Second instance.
+      '\x60', '\x05', 'g', 'r', 'e', 'e', 'n', '\x05', 'c', 'i', 'v', 'i', 'c',
+      // Instance of an undefined class.
+      '\x61', '\x90',
+  }));
+
+  HessianSkipper skipper(buffer, 0);
+  EXPECT_TRUE(skipper.skipValue());
+  EXPECT_EQ(38, skipper.offset());
+  EXPECT_TRUE(skipper.skipValue());
+  EXPECT_EQ(51, skipper.offset());
+  EXPECT_FALSE(skipper.skipValue());
+}
+
+// Chunks and class definitions are walked without recursing, however many a message chains.
+TEST(HessianSkipperTest, LongChains) {
+  std::string value;
+  for (int i = 0; i < 1000000; i++) {
+    value.append({'R', '\x00', '\x00'});
+  }
+  value.append({'S', '\x00', '\x01', 'a'});
+  for (int i = 0; i < 1000000; i++) {
+    value.append({'A', '\x00', '\x00'});
+  }
+  value.append({'B', '\x00', '\x01', 'b'});
+  for (int i = 0; i < 1000000; i++) {
+    // Definition of a class named "a" without fields.
+    value.append({'C', '\x01', 'a', '\x90'});
+  }
+  value.push_back('\x91');
+
+  Buffer::OwnedImpl buffer(value);
+  HessianSkipper skipper(buffer, 0);
+  EXPECT_TRUE(skipper.skipValue());
+  EXPECT_EQ(3000004, skipper.offset());
+  EXPECT_TRUE(skipper.skipValue());
+  EXPECT_EQ(6000008, skipper.offset());
+  EXPECT_TRUE(skipper.skipValue());
+  EXPECT_EQ(value.size(), skipper.offset());
+}
+
+TEST(HessianSkipperTest, References) {
+  const std::vector<std::pair<std::string, uint64_t>> values = {
+      // Reference to a value.
+      {{'Q', '\x90'}, 1},
+      // Typed map with a type reference.
+      {{'M', '\x90', '\x91', '\x92', 'Z'}, 1},
+      // Typed list with a type name.
+      {{'U', '\x04', '[', 'i', 'n', 't', '\x91', 'Z'}, 0},
+      // Instances of a class defined in the same value.
+      {{'C', '\x01', 'a', '\x90', 'X', '\x92', 'O', '\x90', '\x60'}, 2},
+      // Untyped map of strings.
+      {{'H', '\x01', 'a', '\x01', 'b', 'Z'}, 0},
+  };
+
+  for (const auto& [value, references] : values) {
+    Buffer::OwnedImpl buffer(value);
+    HessianSkipper skipper(buffer, 0);
+    EXPECT_TRUE(skipper.skipValue());
+    EXPECT_EQ(value.size(), skipper.offset());
+    EXPECT_EQ(references, skipper.references());
+  }
+}
+
+TEST(HessianSkipperTest, MalformedValues) {
+  const std::vector<std::string> values = {
+      // Empty.
+      {},
+      // Reserved code.
+      {'\x40'},
+      // Incomplete string.
+      {'S', '\x00', '\x05', 'a', 'b'},
+      // Incomplete int.
+      {'I', '\x00', '\x00'},
+      // Unterminated list.
+      {'W', '\x91', '\x92'},
+      // List longer than the buffer.
+      {'X', 'I', '\x10', '\x00', '\x00', '\x00', '\x91'},
+      // Unexpected end of list.
+      {'Z'},
+      // Object of an undefined class.
+      {'O', '\x90'},
+      // Invalid UTF-8.
+      {'\x01', '\x80'},
+      // Supplementary character.
+      {'\x02', '\xf0', '\x9f', '\x98', '\x80'},
+      // Nested too deeply.
+      std::string(100, '\x79') + '\x90',
+  };
+
+  for (const std::string& value : values) {
+    Buffer::OwnedImpl buffer(value);
+    EXPECT_EQ(absl::nullopt, skipValue(buffer));
+  }
+
+  Buffer::OwnedImpl buffer("\x91");
+  EXPECT_EQ(absl::nullopt, skipValue(buffer, 2));
+}
+
+TEST(HessianSkipperTest, SlicedBuffer) {
+  Buffer::OwnedImpl encoded;
+  Hessian2::Encoder encoder(std::make_unique<BufferWriter>(encoded));
+  encoder.encode<std::string>("\xe4\xbd\xa0\xe5\xa5\xbd, world");
+  encoder.encode<int32_t>(std::numeric_limits<int32_t>::max());
+  const std::string data = encoded.toString();
+
+  Buffer::OwnedImpl buffer;
+  for (char c : data) {
+    buffer.appendSliceForTest(&c, 1);
+  }
+
+  HessianSkipper skipper(buffer, 0);
+  EXPECT_TRUE(skipper.skipValue());
+  EXPECT_TRUE(skipper.skipValue());
+  EXPECT_EQ(data.size(), skipper.offset());
+  EXPECT_FALSE(skipper.skipValue());
+}
+
 } // namespace
 
 } // namespace DubboProxy
@@ -114,12 +114,12 @@ TEST(RpcInvocationImplTest, RpcInvocationImplTest) {
   EXPECT_EQ(false, invo.hasParameters());
   EXPECT_EQ(false, invo.hasAttachment());
 
-  // When parsing attachment, parameters will also be parsed.
+  // When parsing attachment, parameters will not be parsed.
   EXPECT_NE(nullptr, invo.mutableAttachment());
   invo.attachment();
-  EXPECT_EQ(true, set_parameters);
+  EXPECT_EQ(false, set_parameters);
   EXPECT_EQ(true, set_attachment);
-  EXPECT_EQ(true, invo.hasParameters());
+  EXPECT_EQ(false, invo.hasParameters());
   EXPECT_EQ(true, invo.hasAttachment());
   EXPECT_EQ("fake_group", invo.serviceGroup().value());
 
@@ -127,6 +127,7 @@ TEST(RpcInvocationImplTest, RpcInvocationImplTest) {
   EXPECT_EQ("new_fake_group", invo.serviceGroup().value());
 
   // If parameters and attachment have values, the callback function will not be executed.
+  EXPECT_NE(nullptr, invo.mutableParameters());
   set_parameters = false;
   set_attachment = false;
   EXPECT_NE(nullptr, invo.mutableParameters());
@@ -146,6 +147,30 @@ TEST(RpcInvocationImplTest, RpcInvocationImplTest) {
   EXPECT_EQ(false, invo.hasAttachment());
 }
 
+// The parameters are decoded first if the attachment cannot be decoded without them.
+TEST(RpcInvocationImplTest, AttachmentDecodedAfterParameters) {
+  RpcInvocationImpl invo;
+
+  invo.setParametersLazyCallback([]() -> RpcInvocationImpl::ParametersPtr {
+    return std::make_unique<RpcInvocationImpl::Parameters>();
+  });
+
+  uint32_t attachment_calls{0};
+  invo.setAttachmentLazyCallback([&invo, &attachment_calls]() -> RpcInvocationImpl::AttachmentPtr {
+    attachment_calls++;
+    if (!invo.hasParameters()) {
+      return nullptr;
+    }
+    return std::make_unique<RpcInvocationImpl::Attachment>(
+        std::make_unique<RpcInvocationImpl::Attachment::Map>(), 0);
+  });
+
+  invo.attachment();
+  EXPECT_EQ(2, attachment_calls);
+  EXPECT_EQ(true, invo.hasParameters());
+  EXPECT_EQ(true, invo.hasAttachment());
+}
+
 TEST(RpcResultImplTest, RpcResultImplTest) {
   RpcResultImpl result;
 
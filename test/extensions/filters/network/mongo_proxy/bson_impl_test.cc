@@ -101,6 +101,151 @@ TEST(BsonImplTest, StringSizeObserved) {
   EXPECT_TRUE(BufferHelper::removeString(buffer) == hello);
 }
 
+DocumentSharedPtr testDocument() {
+  return DocumentImpl::create()
+      ->addString("string", "string")
+      ->addSymbol("symbol", "symbol")
+      ->addDouble("double", 2.1)
+      ->addDocument("document", DocumentImpl::create()->addString("hello", "world"))
+      ->addArray("array", DocumentImpl::create()->addString("0", "foo"))
+      ->addBinary("binary", "binary_value")
+      ->addObjectId("object_id", Field::ObjectId())
+      ->addBoolean("true", true)
+      ->addDatetime("datetime", 1)
+      ->addNull("null")
+      ->addRegex("regex", {"hello", "i"})
+      ->addInt32("int32", 1)
+      ->addTimestamp("timestamp", 1000)
+      ->addInt64("int64", 2)
+      ->addInt32("int32", 3);
+}
+
+TEST(DocumentViewTest, Find) {
+  DocumentSharedPtr document = testDocument();
+  Buffer::OwnedImpl buffer;
+  document->encode(buffer);
+  const std::string encoded = buffer.toString();
+  buffer.add("next");
+
+  DocumentSharedPtr view = DocumentView::create(buffer);
+  EXPECT_EQ("next", buffer.toString());
+  EXPECT_EQ(document->byteSize(), view->byteSize());
+
+  EXPECT_EQ("string", view->find("string")->asString());
+  EXPECT_EQ("symbol", view->find("symbol")->asSymbol());
+  EXPECT_EQ(2.1, view->find("double")->asDouble());
+  EXPECT_EQ("world", view->find("document")->asDocument().find("hello")->asString());
+  EXPECT_EQ("foo", view->find("array", Field::Type::Array)->asArray().find("0")->asString());
+  EXPECT_EQ("binary_value", view->find("binary")->asBinary());
+  EXPECT_EQ(Field::ObjectId(), view->find("object_id")->asObjectId());
+  EXPECT_TRUE(view->find("true")->asBoolean());
+  EXPECT_EQ(1, view->find("datetime")->asDatetime());
+  EXPECT_EQ(Field::Type::NullValue, view->find("null")->type());
+  EXPECT_EQ((Field::Regex{"hello", "i"}), view->find("regex")->asRegex());
+  EXPECT_EQ(1, view->find("int32")->asInt32());
+  EXPECT_EQ(1000, view->find("timestamp")->asTimestamp());
+  EXPECT_EQ(2, view->find("int64", Field::Type::Int64)->asInt64());
+  EXPECT_EQ(nullptr, view->find("int64", Field::Type::Int32));
+  EXPECT_EQ(nullptr, view->find("missing"));
+
+  // Fields are decoded once.
+  EXPECT_EQ(view->find("int32"), view->find("int32", Field::Type::Int32));
+
+  Buffer::OwnedImpl output;
+  view->encode(output);
+  EXPECT_EQ(encoded, output.toString());
+
+  EXPECT_TRUE(*view == *document);
+  EXPECT_TRUE(*document == *view);
+  EXPECT_EQ(document->toString(), view->toString());
+  EXPECT_EQ(document->values().size(), view->values().size());
+  EXPECT_EQ(2.1, view->find("double")->asDouble());
+}
+
+TEST(DocumentViewTest, SharedStorage) {
+  auto storage = std::make_shared<Buffer::OwnedImpl>();
+  DocumentImpl::create()->addString("hello", "world")->encode(*storage);
+  DocumentImpl::create()->addInt32("world", 1)->encode(*storage);
+
+  uint64_t offset = 0;
+  DocumentSharedPtr view1 = DocumentView::create(storage, offset);
+  DocumentSharedPtr view2 = DocumentView::create(storage, offset);
+  EXPECT_EQ(storage->length(), offset);
+  EXPECT_EQ("world", view1->find("hello")->asString());
+  EXPECT_EQ(nullptr, view1->find("world"));
+  EXPECT_EQ(1, view2->find("world")->asInt32());
+  EXPECT_THROW(DocumentView::create(storage, offset), EnvoyException);
+}
+
+TEST(DocumentViewTest, ReadOnly) {
+  Buffer::OwnedImpl buffer;
+  DocumentImpl::create()->encode(buffer);
+  DocumentSharedPtr view = DocumentView::create(buffer);
+  EXPECT_THROW(view->addString("hello", "world"), EnvoyException);
+  EXPECT_TRUE(view->values().empty());
+}
+
+TEST(DocumentViewTest, InvalidMessageLength) {
+  {
+    Buffer::OwnedImpl buffer;
+    BufferHelper::writeInt32(buffer, 100);
+    EXPECT_THROW(DocumentView::create(buffer), EnvoyException);
+  }
+
+  {
+    Buffer::OwnedImpl buffer;
+    BufferHelper::writeInt32(buffer, 4);
+    EXPECT_THROW(DocumentView::create(buffer), EnvoyException);
+  }
+}
+
+// Malformed documents are only detected when they are looked into.
+TEST(DocumentViewTest, InvalidDocument) {
+  {
+    Buffer::OwnedImpl buffer;
+    std::string key_name("hello");
+    BufferHelper::writeInt32(buffer, 4 + 1 + key_name.size() + 1 + 1);
+    uint8_t invalid_element_type = 0x20;
+    buffer.add(&invalid_element_type, sizeof(invalid_element_type));
+    BufferHelper::writeCString(buffer, key_name);
+    buffer.add("", 1);
+    DocumentSharedPtr view = DocumentView::create(buffer);
+    EXPECT_THROW(view->find("hello"), EnvoyException);
+    EXPECT_THROW(view->values(), EnvoyException);
+  }
+
+  {
+    Buffer::OwnedImpl buffer;
+    BufferHelper::writeInt32(buffer, 5);
+    uint8_t invalid_document_end = 0x1;
+    buffer.add(&invalid_document_end, sizeof(invalid_document_end));
+    DocumentSharedPtr view = DocumentView::create(buffer);
+    EXPECT_THROW(view->find("hello"), EnvoyException);
+  }
+
+  {
+    // The string runs past the end of the document.
+    Buffer::OwnedImpl buffer;
+    DocumentImpl::create()->addString("hello", "world")->encode(buffer);
+    std::string bytes = buffer.toString();
+    bytes[4 + 1 + 6] = 100;
+    Buffer::OwnedImpl invalid(bytes);
+    DocumentSharedPtr view = DocumentView::create(invalid);
+    EXPECT_THROW(view->find("hello"), EnvoyException);
+  }
+
+  {
+    // The embedded document runs past the end of the document.
+    Buffer::OwnedImpl buffer;
+    DocumentImpl::create()->addDocument("hello", DocumentImpl::create())->encode(buffer);
+    std::string bytes = buffer.toString();
+    bytes[4 + 1 + 6] = 6;
+    Buffer::OwnedImpl invalid(bytes);
+    DocumentSharedPtr view = DocumentView::create(invalid);
+    EXPECT_THROW(view->find("hello"), EnvoyException);
+  }
+}
+
 } // namespace Bson
 } // namespace MongoProxy
 } // namespace NetworkFilters
@@ -0,0 +1,98 @@
+// Measures the cost of decoding a mongo query with a large query document and extracting the
+// information that the proxy uses for stats, with the query document either decoded in full or
+// viewed in place.
+//
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/mongo_proxy/bson_impl.h"
+#include "source/extensions/filters/network/mongo_proxy/codec_impl.h"
+#include "source/extensions/filters/network/mongo_proxy/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace MongoProxy {
+namespace {
+
+// Builds a find query with a comment and count documents of a few fields in its filter.
+Bson::DocumentSharedPtr buildQuery(uint32_t count) {
+  Bson::DocumentSharedPtr filter = Bson::DocumentImpl::create();
+  for (uint32_t i = 0; i < count; i++) {
+    filter->addDocument(absl::StrCat("field", i),
+                        Bson::DocumentImpl::create()
+                            ->addString("name", absl::StrCat("user", i))
+                            ->addInt64("id", i)
+                            ->addArray("tags", Bson::DocumentImpl::create()
+                                                   ->addString("0", "first")
+                                                   ->addString("1", "second")));
+  }
+
+  return Bson::DocumentImpl::create()
+      ->addDocument("$query", filter)
+      ->addInt32("$maxTimeMS", 100)
+      ->addString("$comment", R"EOF({"callingFunction":"getUsers"})EOF");
+}
+
+class StatsDecoderCallbacks : public DecoderCallbacks {
+public:
+  void decodeGetMore(GetMoreMessagePtr&&) override {}
+  void decodeInsert(InsertMessagePtr&&) override {}
+  void decodeKillCursors(KillCursorsMessagePtr&&) override {}
+  void decodeQuery(QueryMessagePtr&& message) override {
+    QueryMessageInfo info(*message);
+    benchmark::DoNotOptimize(info.type());
+  }
+  void decodeReply(ReplyMessagePtr&&) override {}
+  void decodeCommand(CommandMessagePtr&&) override {}
+  void decodeCommandReply(CommandReplyMessagePtr&&) override {}
+};
+
+} // namespace
+
+// Decodes query messages and builds the query info the proxy charges stats with.
+static void bmDecodeQuery(benchmark::State& state) {
+  QueryMessageImpl query(1, 0);
+  query.fullCollectionName("db.users");
+  query.query(buildQuery(state.range(0)));
+  Buffer::OwnedImpl message;
+  EncoderImpl encoder(message);
+  encoder.encodeQuery(query);
+
+  StatsDecoderCallbacks callbacks;
+  DecoderImpl decoder(callbacks);
+  for (auto _ : state) { // NOLINT
+    Buffer::OwnedImpl data(message);
+    decoder.onData(data);
+  }
+}
+BENCHMARK(bmDecodeQuery)->ArgsProduct({{1, 10, 100, 1000}});
+
+// Looks up the fields of a query document the way the query info does, decoding the whole
+// document first (range(1) == 0) or through a view (range(1) == 1).
+static void bmFindQueryFields(benchmark::State& state) {
+  Buffer::OwnedImpl encoded;
+  buildQuery(state.range(0))->encode(encoded);
+
+  for (auto _ : state) { // NOLINT
+    Buffer::OwnedImpl data(encoded);
+    Bson::DocumentSharedPtr document = state.range(1) == 0 ? Bson::DocumentImpl::create(data)
+                                                           : Bson::DocumentView::create(data);
+    benchmark::DoNotOptimize(document->find("$maxTimeMS"));
+    benchmark::DoNotOptimize(document->find("$comment", Bson::Field::Type::String));
+    const Bson::Field* field = document->find("$query", Bson::Field::Type::Document);
+    benchmark::DoNotOptimize(field->asDocument().find("_id"));
+  }
+}
+BENCHMARK(bmFindQueryFields)->ArgsProduct({{1, 10, 100, 1000}, {0, 1}});
+
+} // namespace MongoProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
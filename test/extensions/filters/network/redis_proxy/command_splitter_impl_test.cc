@@ -14,6 +14,7 @@
 #include "test/mocks/common.h"
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/simulated_time_system.h"
 
 using testing::_;
@@ -36,7 +37,11 @@ public:
   RedisCommandSplitterImplTest(bool latency_in_macro)
       : RedisCommandSplitterImplTest(latency_in_macro, nullptr) {}
   RedisCommandSplitterImplTest(bool latency_in_macro, Common::Redis::FaultSharedPtr fault_ptr)
-      : latency_in_micros_(latency_in_macro) {
+      : RedisCommandSplitterImplTest(latency_in_macro, fault_ptr, false) {}
+  RedisCommandSplitterImplTest(bool latency_in_macro, Common::Redis::FaultSharedPtr fault_ptr,
+                               bool hot_key_cache)
+      : latency_in_micros_(latency_in_macro),
+        hot_key_cache_(hot_key_cache ? createHotKeyCache() : nullptr) {
     ON_CALL(*getFaultManager(), getFaultForCommand(_)).WillByDefault(Return(fault_ptr.get()));
   }
   void makeBulkStringArray(Common::Redis::RespValue& value,
@@ -56,6 +61,13 @@ public:
     route_->policies_.push_back(mirror_policy);
   }
 
+  HotKeyCacheSharedPtr createHotKeyCache() {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::HotKeyCache config;
+    config.mutable_ttl()->set_seconds(1);
+    return std::make_shared<HotKeyCache>(config, tls_, time_system_, *store_.rootScope(),
+                                         "redis.foo.");
+  }
+
   MockFaultManager* getFaultManager() {
     auto fault_manager_ptr = splitter_.fault_manager_.get();
     return static_cast<MockFaultManager*>(fault_manager_ptr);
@@ -72,12 +84,15 @@ public:
   NiceMock<MockFaultManager> fault_manager_;
 
   Event::SimulatedTimeSystem time_system_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  HotKeyCacheSharedPtr hot_key_cache_;
   InstanceImpl splitter_{std::make_unique<NiceMock<MockRouter>>(route_),
                          *store_.rootScope(),
                          "redis.foo.",
                          time_system_,
                          latency_in_micros_,
-                         std::make_unique<NiceMock<MockFaultManager>>(fault_manager_)};
+                         std::make_unique<NiceMock<MockFaultManager>>(fault_manager_),
+                         hot_key_cache_};
   MockSplitCallbacks callbacks_;
   SplitRequestPtr handle_;
 };
@@ -187,6 +202,8 @@ public:
   RedisSingleServerRequestTest() : RedisSingleServerRequestTest(false) {}
   RedisSingleServerRequestTest(bool latency_in_micros)
       : RedisCommandSplitterImplTest(latency_in_micros) {}
+  RedisSingleServerRequestTest(bool latency_in_micros, bool hot_key_cache)
+      : RedisCommandSplitterImplTest(latency_in_micros, nullptr, hot_key_cache) {}
   void makeRequest(const std::string& hash_key, Common::Redis::RespValuePtr&& request,
                    bool mirrored = false) {
     EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
@@ -482,6 +499,95 @@ TEST_F(RedisSingleServerRequestTest, EvalNoUpstream) {
   EXPECT_EQ(1UL, store_.counter("redis.foo.command.eval.error").value());
 };
 
+class RedisHotKeyCacheTest : public RedisSingleServerRequestTest {
+public:
+  RedisHotKeyCacheTest() : RedisSingleServerRequestTest(false, true) {}
+
+  Common::Redis::RespValuePtr makeCommand(const std::vector<std::string>& strings) {
+    Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+    makeBulkStringArray(*request, strings);
+    return request;
+  }
+
+  // Sends a command upstream and has it answered with value.
+  void makeUpstreamRequest(const std::vector<std::string>& strings, const std::string& value) {
+    makeRequest("hello", makeCommand(strings));
+    ASSERT_NE(nullptr, handle_);
+    Common::Redis::RespValuePtr response(new Common::Redis::RespValue());
+    response->type(Common::Redis::RespType::BulkString);
+    response->asString() = value;
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(response.get())));
+    pool_callbacks_->onResponse(std::move(response));
+    handle_ = nullptr;
+  }
+
+  void expectCachedGet(const std::string& value) {
+    Common::Redis::RespValue response;
+    response.type(Common::Redis::RespType::BulkString);
+    response.asString() = value;
+    EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+    EXPECT_CALL(*conn_pool_, makeRequest_(_, _, _)).Times(0);
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&response)));
+    EXPECT_EQ(nullptr,
+              splitter_.makeRequest(makeCommand({"get", "hello"}), callbacks_, dispatcher_));
+  }
+};
+
+TEST_F(RedisHotKeyCacheTest, ServesHitsUntilExpiry) {
+  makeUpstreamRequest({"get", "hello"}, "world");
+  expectCachedGet("world");
+  expectCachedGet("world");
+  EXPECT_EQ(2UL, store_.counter("redis.foo.hot_key_cache.hit").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.hot_key_cache.miss").value());
+  EXPECT_EQ(3UL, store_.counter("redis.foo.command.get.total").value());
+  EXPECT_EQ(3UL, store_.counter("redis.foo.command.get.success").value());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  makeUpstreamRequest({"get", "hello"}, "again");
+  expectCachedGet("again");
+  EXPECT_EQ(2UL, store_.counter("redis.foo.hot_key_cache.miss").value());
+}
+
+TEST_F(RedisHotKeyCacheTest, WritesInvalidate) {
+  makeUpstreamRequest({"get", "hello"}, "world");
+  makeUpstreamRequest({"set", "hello", "there"}, "OK");
+  EXPECT_EQ(1UL, store_.counter("redis.foo.hot_key_cache.invalidation").value());
+
+  makeUpstreamRequest({"get", "hello"}, "there");
+  expectCachedGet("there");
+}
+
+TEST_F(RedisHotKeyCacheTest, ReadOvertakenByWriteIsNotCached) {
+  makeRequest("hello", makeCommand({"get", "hello"}));
+  ConnPool::PoolCallbacks* get_callbacks = pool_callbacks_;
+  SplitRequestPtr get_handle = std::move(handle_);
+
+  makeUpstreamRequest({"set", "hello", "there"}, "OK");
+
+  Common::Redis::RespValuePtr response(new Common::Redis::RespValue());
+  response->type(Common::Redis::RespType::BulkString);
+  response->asString() = "world";
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(response.get())));
+  get_callbacks->onResponse(std::move(response));
+
+  // The value read before the write was not cached.
+  makeUpstreamRequest({"get", "hello"}, "there");
+  EXPECT_EQ(0UL, store_.counter("redis.foo.hot_key_cache.hit").value());
+}
+
+TEST_F(RedisHotKeyCacheTest, ErrorsAreNotCached) {
+  makeRequest("hello", makeCommand({"get", "hello"}));
+  Common::Redis::RespValue response;
+  response.type(Common::Redis::RespType::Error);
+  response.asString() = Response::get().UpstreamFailure;
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&response)));
+  pool_callbacks_->onFailure();
+  handle_ = nullptr;
+
+  makeUpstreamRequest({"get", "hello"}, "world");
+  EXPECT_EQ(0UL, store_.counter("redis.foo.hot_key_cache.hit").value());
+}
+
 MATCHER_P(CompositeArrayEq, rhs, "CompositeArray should be equal") {
   const ConnPool::RespVariant& obj = arg;
   const auto& lhs = absl::get<const Common::Redis::RespValue>(obj);
@@ -0,0 +1,173 @@
+#include "source/extensions/filters/network/redis_proxy/hot_key_cache.h"
+
+#include "test/mocks/stats/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace {
+
+class HotKeyCacheTest : public testing::Test {
+public:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::HotKeyCache config;
+    TestUtility::loadFromYamlAndValidate(yaml, config);
+    cache_ = std::make_unique<HotKeyCache>(config, tls_, time_system_, *store_.rootScope(),
+                                           "redis.foo.");
+  }
+
+  static Common::Redis::RespValue makeCommand(const std::vector<std::string>& strings) {
+    std::vector<Common::Redis::RespValue> values(strings.size());
+    for (uint64_t i = 0; i < strings.size(); i++) {
+      values[i].type(Common::Redis::RespType::BulkString);
+      values[i].asString() = strings[i];
+    }
+    Common::Redis::RespValue command;
+    command.type(Common::Redis::RespType::Array);
+    command.asArray().swap(values);
+    return command;
+  }
+
+  static Common::Redis::RespValue makeResponse(const std::string& value) {
+    Common::Redis::RespValue response;
+    response.type(Common::Redis::RespType::BulkString);
+    response.asString() = value;
+    return response;
+  }
+
+  // Looks the key up and, on a miss, fills it with value.
+  bool lookupOrFill(const std::string& key, const std::string& value, uint32_t command = 0) {
+    uint64_t fill_id;
+    if (cache_->lookup(command, key, fill_id) != nullptr) {
+      return true;
+    }
+    cache_->fill(command, key, fill_id, makeResponse(value));
+    return false;
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Stats::MockIsolatedStatsStore> store_;
+  std::unique_ptr<HotKeyCache> cache_;
+};
+
+TEST_F(HotKeyCacheTest, UnsupportedCommand) {
+  EXPECT_THROW_WITH_MESSAGE(initialize(R"EOF(
+commands: [get, lrange]
+ttl: 1s
+)EOF"),
+                            EnvoyException, "unsupported hot key cache command 'lrange'");
+}
+
+TEST_F(HotKeyCacheTest, CommandIndex) {
+  initialize(R"EOF(
+commands: [GET, hlen]
+ttl: 1s
+)EOF");
+  EXPECT_EQ(0U, cache_->commandIndex("get"));
+  EXPECT_EQ(1U, cache_->commandIndex("hlen"));
+  EXPECT_FALSE(cache_->commandIndex("strlen").has_value());
+}
+
+TEST_F(HotKeyCacheTest, DefaultsToGet) {
+  initialize("ttl: 1s");
+  EXPECT_EQ(0U, cache_->commandIndex("get"));
+  EXPECT_FALSE(cache_->commandIndex("hlen").has_value());
+}
+
+TEST_F(HotKeyCacheTest, CachesResponsesPerCommand) {
+  initialize(R"EOF(
+commands: [get, strlen]
+ttl: 1s
+)EOF");
+  EXPECT_FALSE(lookupOrFill("a", "value", 0));
+  EXPECT_FALSE(lookupOrFill("a", "5", 1));
+
+  uint64_t fill_id;
+  Common::Redis::RespValuePtr response = cache_->lookup(0, "a", fill_id);
+  ASSERT_NE(nullptr, response);
+  EXPECT_EQ("value", response->asString());
+  response = cache_->lookup(1, "a", fill_id);
+  ASSERT_NE(nullptr, response);
+  EXPECT_EQ("5", response->asString());
+}
+
+TEST_F(HotKeyCacheTest, EvictsLeastRecentlyUsedKey) {
+  initialize(R"EOF(
+ttl: 1s
+max_keys: 2
+)EOF");
+  EXPECT_FALSE(lookupOrFill("a", "1"));
+  EXPECT_FALSE(lookupOrFill("b", "2"));
+  EXPECT_TRUE(lookupOrFill("a", "1"));
+
+  // b is the least recently used key.
+  EXPECT_FALSE(lookupOrFill("c", "3"));
+  EXPECT_EQ(1UL, store_.counter("redis.foo.hot_key_cache.eviction").value());
+  EXPECT_TRUE(lookupOrFill("a", "1"));
+  EXPECT_TRUE(lookupOrFill("c", "3"));
+  EXPECT_FALSE(lookupOrFill("b", "2"));
+}
+
+TEST_F(HotKeyCacheTest, FillAfterEvictionIsDropped) {
+  initialize(R"EOF(
+ttl: 1s
+max_keys: 1
+)EOF");
+  uint64_t fill_id;
+  EXPECT_EQ(nullptr, cache_->lookup(0, "a", fill_id));
+  EXPECT_FALSE(lookupOrFill("b", "2"));
+  cache_->fill(0, "a", fill_id, makeResponse("1"));
+  EXPECT_FALSE(lookupOrFill("a", "1"));
+}
+
+TEST_F(HotKeyCacheTest, MultiKeyWritesInvalidateEachKey) {
+  initialize("ttl: 1s");
+  for (const char* key : {"a", "b", "c", "d"}) {
+    lookupOrFill(key, key);
+  }
+
+  cache_->invalidate("mset", makeCommand({"mset", "a", "b", "c", "d"}));
+  EXPECT_FALSE(lookupOrFill("a", "a"));
+  EXPECT_TRUE(lookupOrFill("b", "b"));
+  EXPECT_FALSE(lookupOrFill("c", "c"));
+
+  cache_->invalidate("del", makeCommand({"del", "b", "c"}));
+  EXPECT_FALSE(lookupOrFill("b", "b"));
+  EXPECT_FALSE(lookupOrFill("c", "c"));
+
+  // Only the declared keys of a script are invalidated.
+  cache_->invalidate("eval", makeCommand({"eval", "script", "1", "a", "d"}));
+  EXPECT_FALSE(lookupOrFill("a", "a"));
+  EXPECT_TRUE(lookupOrFill("d", "d"));
+
+  // Reads do not invalidate.
+  cache_->invalidate("get", makeCommand({"get", "d"}));
+  EXPECT_TRUE(lookupOrFill("d", "d"));
+  EXPECT_EQ(5UL, store_.counter("redis.foo.hot_key_cache.invalidation").value());
+}
+
+TEST_F(HotKeyCacheTest, GetSetInvalidatesKey) {
+  initialize("ttl: 1s");
+  EXPECT_FALSE(lookupOrFill("a", "old"));
+  EXPECT_TRUE(lookupOrFill("a", "old"));
+
+  cache_->invalidate("getset", makeCommand({"getset", "a", "new"}));
+  EXPECT_FALSE(lookupOrFill("a", "new"));
+  EXPECT_EQ(1UL, store_.counter("redis.foo.hot_key_cache.invalidation").value());
+}
+
+} // namespace
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
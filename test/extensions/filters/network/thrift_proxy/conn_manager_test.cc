@@ -2458,6 +2458,68 @@ route_config:
   filter_callbacks_.connection_.dispatcher_.clearDeferredDeleteList();
 }
 
+// The response to a pipelined request is passed through according to the filter chain of its own
+// RPC, not the one of the most recent RPC on the connection.
+TEST_F(ThriftConnectionManagerTest, PayloadPassthroughPipelinedResponses) {
+  const std::string yaml = fmt::format(R"EOF(
+stat_prefix: test
+payload_passthrough: true
+{}
+)EOF",
+                                       accessLogConfig());
+
+  initializeFilter(yaml);
+  ON_CALL(*decoder_filter_, passthroughSupported()).WillByDefault(Return(true));
+  ON_CALL(*encoder_filter_, passthroughSupported()).WillByDefault(Return(true));
+  ON_CALL(*bidirectional_filter_, decodePassthroughSupported()).WillByDefault(Return(true));
+  ON_CALL(*bidirectional_filter_, encodePassthroughSupported()).WillByDefault(Return(true));
+
+  std::list<ThriftFilters::DecoderFilterCallbacks*> callbacks{};
+  EXPECT_CALL(*decoder_filter_, setDecoderFilterCallbacks(_))
+      .WillRepeatedly(Invoke(
+          [&](ThriftFilters::DecoderFilterCallbacks& cb) -> void { callbacks.push_back(&cb); }));
+
+  // Only the filter chain of the first RPC supports passthrough.
+  auto supported_filter = std::make_shared<NiceMock<ThriftFilters::MockDecoderFilter>>();
+  ON_CALL(*supported_filter, passthroughSupported()).WillByDefault(Return(true));
+  config_->custom_decoder_filter_ = supported_filter;
+  writeFramedBinaryMessage(buffer_, MessageType::Call, 0x01);
+  EXPECT_EQ(filter_->onData(buffer_, false), Network::FilterStatus::StopIteration);
+
+  auto unsupported_filter = std::make_shared<NiceMock<ThriftFilters::MockDecoderFilter>>();
+  ON_CALL(*unsupported_filter, passthroughSupported()).WillByDefault(Return(false));
+  config_->custom_decoder_filter_ = unsupported_filter;
+  writeFramedBinaryMessage(buffer_, MessageType::Call, 0x02);
+  EXPECT_EQ(filter_->onData(buffer_, false), Network::FilterStatus::StopIteration);
+  EXPECT_EQ(2U, stats_.request_active_.value());
+  ASSERT_EQ(2U, callbacks.size());
+
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, deferredDelete_(_)).Times(2);
+
+  FramedTransportImpl transport;
+  BinaryProtocolImpl proto;
+
+  // The first RPC is answered while the second one is the most recent.
+  writeFramedBinaryMessage(write_buffer_, MessageType::Reply, 0x01);
+  callbacks.front()->startUpstreamResponse(transport, proto);
+  EXPECT_EQ(ThriftFilters::ResponseStatus::Complete,
+            callbacks.front()->upstreamData(write_buffer_));
+  callbacks.pop_front();
+  EXPECT_EQ(1U, store_.counter("test.response").value());
+  EXPECT_EQ(1U, store_.counter("test.response_passthrough").value());
+
+  writeFramedBinaryMessage(write_buffer_, MessageType::Reply, 0x02);
+  callbacks.front()->startUpstreamResponse(transport, proto);
+  EXPECT_EQ(ThriftFilters::ResponseStatus::Complete,
+            callbacks.front()->upstreamData(write_buffer_));
+  callbacks.pop_front();
+  EXPECT_EQ(2U, store_.counter("test.response").value());
+  EXPECT_EQ(1U, store_.counter("test.response_passthrough").value());
+
+  filter_callbacks_.connection_.dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(0U, stats_.request_active_.value());
+}
+
 // When a local reply was sent, payload passthrough is disabled because there's no
 // active RPC left.
 TEST_F(ThriftConnectionManagerTest, NoPayloadPassthroughOnLocalReply) {
@@ -7,7 +7,9 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/app_exception_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/binary_protocol_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/config.h"
+#include "source/extensions/filters/network/thrift_proxy/framed_transport_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/router/config.h"
 #include "source/extensions/filters/network/thrift_proxy/router/router_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/router/shadow_writer_impl.h"
@@ -114,8 +116,9 @@ public:
     route_ = new NiceMock<MockRoute>();
     route_ptr_.reset(route_);
 
+    multiplexer_ = std::make_unique<UpstreamMultiplexer>(context_.threadLocal());
     router_ = std::make_unique<Router>(context_.clusterManager(), *stats_, context_.runtime(),
-                                       shadow_writer, close_downstream_on_error);
+                                       shadow_writer, *multiplexer_, close_downstream_on_error);
 
     EXPECT_EQ(nullptr, router_->downstreamConnection());
 
@@ -627,6 +630,7 @@ public:
   NiceMock<Event::MockDispatcher> dispatcher_;
   NiceMock<Server::Configuration::MockFactoryContext> context_;
 
+  std::unique_ptr<UpstreamMultiplexer> multiplexer_;
   std::unique_ptr<Router> router_;
   std::shared_ptr<const RouterStats> stats_;
   MockShadowWriter shadow_writer_;
@@ -716,6 +720,171 @@ class ThriftRouterRainidayTest : public testing::TestWithParam<bool>,
 
 INSTANTIATE_TEST_SUITE_P(CloseDownstreamOnError, ThriftRouterRainidayTest, Bool());
 
+// Routes two concurrent requests over the same multiplexed upstream connection. The transports and
+// protocols encode and decode actual frames, so that the upstream connection can dispatch the
+// responses by sequence id.
+class ThriftRouterMultiplexedTest : public testing::Test, public ThriftRouterTestBase {
+public:
+  ThriftRouterMultiplexedTest() {
+    envoy::extensions::filters::network::thrift_proxy::v3::ThriftProtocolOptions configuration;
+    TestUtility::loadFromYaml(R"EOF(
+transport: framed
+protocol: binary
+max_concurrent_requests_per_connection: 2
+)EOF",
+                              configuration);
+    ON_CALL(*context_.cluster_manager_.thread_local_cluster_.cluster_.info_,
+            extensionProtocolOptions(_))
+        .WillByDefault(Return(std::make_shared<ProtocolOptionsConfigImpl>(configuration)));
+
+    mock_transport_cb_ = [this](MockTransport* transport) -> void {
+      ON_CALL(*transport, type()).WillByDefault(Return(TransportType::Framed));
+      ON_CALL(*transport, encodeFrame(_, _, _))
+          .WillByDefault(Invoke(&framed_transport_, &FramedTransportImpl::encodeFrame));
+      ON_CALL(*transport, decodeFrameStart(_, _))
+          .WillByDefault(Invoke(&framed_transport_, &FramedTransportImpl::decodeFrameStart));
+    };
+    mock_protocol_cb_ = [this](MockProtocol* protocol) -> void {
+      ON_CALL(*protocol, type()).WillByDefault(Return(ProtocolType::Binary));
+      ON_CALL(*protocol, readMessageBegin(_, _))
+          .WillByDefault(Invoke(&binary_protocol_, &BinaryProtocolImpl::readMessageBegin));
+      ON_CALL(*protocol, writeMessageBegin(_, _))
+          .WillByDefault(Invoke(&binary_protocol_, &BinaryProtocolImpl::writeMessageBegin));
+      ON_CALL(*protocol, writeStructBegin(_, _))
+          .WillByDefault(Invoke(&binary_protocol_, &BinaryProtocolImpl::writeStructBegin));
+      ON_CALL(*protocol, writeFieldBegin(_, _, _, _))
+          .WillByDefault(Invoke(&binary_protocol_, &BinaryProtocolImpl::writeFieldBegin));
+      ON_CALL(*protocol, writeStructEnd(_))
+          .WillByDefault(Invoke(&binary_protocol_, &BinaryProtocolImpl::writeStructEnd));
+      ON_CALL(*protocol, writeMessageEnd(_))
+          .WillByDefault(Invoke(&binary_protocol_, &BinaryProtocolImpl::writeMessageEnd));
+    };
+
+    auto& conn_data =
+        *context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_.connection_data_;
+    ON_CALL(conn_data, connectionState())
+        .WillByDefault(Invoke([this]() -> Tcp::ConnectionPool::ConnectionState* {
+          return conn_state_.get();
+        }));
+    ON_CALL(conn_data, setConnectionState_(_))
+        .WillByDefault(Invoke([this](Tcp::ConnectionPool::ConnectionStatePtr& state) -> void {
+          conn_state_ = std::move(state);
+        }));
+    ON_CALL(conn_data, addUpstreamCallbacks(_))
+        .WillByDefault(Invoke([this](Tcp::ConnectionPool::UpstreamCallbacks& callbacks) -> void {
+          upstream_callbacks_ = &callbacks;
+        }));
+    ON_CALL(upstream_connection_, write(_, false))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) -> void {
+          upstream_data_.move(data);
+        }));
+
+    reply_metadata_ = std::make_shared<MessageMetadata>();
+    reply_metadata_->setMessageType(MessageType::Reply);
+  }
+
+  void initializeRouters() {
+    initializeRouter();
+    router2_ = std::make_unique<Router>(context_.clusterManager(), *stats_, context_.runtime(),
+                                        shadow_writer_, *multiplexer_, true);
+    router2_->setDecoderFilterCallbacks(callbacks2_);
+
+    ON_CALL(*route_, routeEntry()).WillByDefault(Return(&route_entry_));
+    ON_CALL(route_entry_, clusterName()).WillByDefault(ReturnRef(cluster_name_));
+    for (auto* callbacks : {&callbacks_, &callbacks2_}) {
+      ON_CALL(*callbacks, route()).WillByDefault(Return(route_ptr_));
+      ON_CALL(*callbacks, downstreamTransportType()).WillByDefault(Return(TransportType::Framed));
+      ON_CALL(*callbacks, downstreamProtocolType()).WillByDefault(Return(ProtocolType::Binary));
+      ON_CALL(*callbacks, dispatcher()).WillByDefault(ReturnRef(dispatcher_));
+      ON_CALL(*callbacks, responseMetadata()).WillByDefault(Return(reply_metadata_));
+      ON_CALL(*callbacks, responseSuccess()).WillByDefault(Return(true));
+    }
+  }
+
+  // Starts the requests of both routers, which both wait for the same upstream connection, and
+  // connects it.
+  void startRequests(int32_t downstream_sequence_id) {
+    EXPECT_CALL(context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+    metadata_ = beginRequest(*router_, downstream_sequence_id);
+    metadata2_ = beginRequest(*router2_, downstream_sequence_id);
+
+    EXPECT_CALL(callbacks_, continueDecoding());
+    EXPECT_CALL(callbacks2_, continueDecoding());
+    context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_.poolReady(upstream_connection_);
+    ASSERT_NE(nullptr, upstream_callbacks_);
+
+    endRequest(*router_);
+    endRequest(*router2_);
+  }
+
+  MessageMetadataSharedPtr beginRequest(Router& router, int32_t sequence_id) {
+    auto metadata = std::make_shared<MessageMetadata>();
+    metadata->setMethodName("method");
+    metadata->setMessageType(MessageType::Call);
+    metadata->setSequenceId(sequence_id);
+    EXPECT_EQ(FilterStatus::Continue, router.transportBegin(metadata));
+    EXPECT_EQ(FilterStatus::StopIteration, router.messageBegin(metadata));
+    return metadata;
+  }
+
+  void endRequest(Router& router) {
+    EXPECT_EQ(FilterStatus::Continue, router.structBegin({}));
+    EXPECT_EQ(FilterStatus::Continue, router.structEnd());
+    EXPECT_EQ(FilterStatus::Continue, router.messageEnd());
+    EXPECT_EQ(FilterStatus::Continue, router.transportEnd());
+  }
+
+  void addResponse(Buffer::Instance& buffer, int32_t sequence_id) {
+    MessageMetadata metadata;
+    metadata.setMethodName("method");
+    metadata.setMessageType(MessageType::Reply);
+    metadata.setSequenceId(sequence_id);
+
+    Buffer::OwnedImpl message;
+    binary_protocol_.writeMessageBegin(message, metadata);
+    binary_protocol_.writeStructBegin(message, "");
+    binary_protocol_.writeFieldBegin(message, "", FieldType::Stop, 0);
+    binary_protocol_.writeStructEnd(message);
+    binary_protocol_.writeMessageEnd(message);
+    framed_transport_.encodeFrame(buffer, metadata, message);
+  }
+
+  // Moves the frame at the start of the buffer out of it.
+  // @return the sequence id of the message of the frame.
+  int32_t drainFrame(Buffer::Instance& buffer) {
+    Buffer::OwnedImpl frame;
+    frame.move(buffer, sizeof(int32_t) + buffer.peekBEInt<int32_t>());
+    MessageMetadata metadata;
+    EXPECT_TRUE(framed_transport_.decodeFrameStart(frame, metadata));
+    EXPECT_TRUE(binary_protocol_.readMessageBegin(frame, metadata));
+    return metadata.sequenceId();
+  }
+
+  void expectResponse(NiceMock<ThriftFilters::MockDecoderFilterCallbacks>& callbacks,
+                      int32_t sequence_id, std::vector<int32_t>& responses) {
+    EXPECT_CALL(callbacks, upstreamData(_))
+        .WillOnce(Invoke([this, sequence_id, &responses](Buffer::Instance& data) {
+          EXPECT_EQ(sequence_id, drainFrame(data));
+          responses.push_back(sequence_id);
+          return ThriftFilters::ResponseStatus::Complete;
+        }));
+  }
+
+  void destroyRouters() {
+    router2_->onDestroy();
+    router2_.reset();
+    destroyRouter();
+  }
+
+  FramedTransportImpl framed_transport_;
+  BinaryProtocolImpl binary_protocol_;
+  NiceMock<ThriftFilters::MockDecoderFilterCallbacks> callbacks2_;
+  std::unique_ptr<Router> router2_;
+  MessageMetadataSharedPtr metadata2_;
+  MessageMetadataSharedPtr reply_metadata_;
+  Buffer::OwnedImpl upstream_data_;
+};
+
 TEST_P(ThriftRouterRainidayTest, PoolRemoteConnectionFailure) {
   initializeRouter(GetParam());
 
@@ -1937,6 +2106,115 @@ TEST_F(ThriftRouterTest, UpstreamZoneCallWithRqTime) {
   returnResponse();
 }
 
+// Concurrent requests sharing an upstream connection are given distinct sequence ids, whatever
+// the sequence ids of their downstream requests.
+TEST_F(ThriftRouterMultiplexedTest, RewritesSequenceIds) {
+  initializeRouters();
+  startRequests(7);
+
+  EXPECT_EQ(0, metadata_->sequenceId());
+  EXPECT_EQ(1, metadata2_->sequenceId());
+  EXPECT_EQ(0, drainFrame(upstream_data_));
+  EXPECT_EQ(1, drainFrame(upstream_data_));
+  EXPECT_EQ(0, upstream_data_.length());
+
+  std::vector<int32_t> responses;
+  expectResponse(callbacks_, 0, responses);
+  expectResponse(callbacks2_, 1, responses);
+  Buffer::OwnedImpl buffer;
+  addResponse(buffer, 0);
+  addResponse(buffer, 1);
+  EXPECT_CALL(upstream_connection_, close(_)).Times(0);
+  EXPECT_CALL(context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_,
+              released(Ref(upstream_connection_)));
+  upstream_callbacks_->onUpstreamData(buffer, false);
+  EXPECT_EQ(std::vector<int32_t>({0, 1}), responses);
+  destroyRouters();
+}
+
+// Responses are handed to their requests in the order they arrive, and may be split across reads.
+TEST_F(ThriftRouterMultiplexedTest, OutOfOrderResponses) {
+  initializeRouters();
+  startRequests(1);
+
+  std::vector<int32_t> responses;
+  expectResponse(callbacks_, metadata_->sequenceId(), responses);
+  expectResponse(callbacks2_, metadata2_->sequenceId(), responses);
+  Buffer::OwnedImpl buffer;
+  addResponse(buffer, metadata2_->sequenceId());
+  addResponse(buffer, metadata_->sequenceId());
+
+  Buffer::OwnedImpl fragment;
+  fragment.move(buffer, buffer.length() - 3);
+  upstream_callbacks_->onUpstreamData(fragment, false);
+  EXPECT_EQ(std::vector<int32_t>({metadata2_->sequenceId()}), responses);
+
+  EXPECT_CALL(upstream_connection_, close(_)).Times(0);
+  EXPECT_CALL(context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_,
+              released(Ref(upstream_connection_)));
+  upstream_callbacks_->onUpstreamData(buffer, false);
+  EXPECT_EQ(std::vector<int32_t>({metadata2_->sequenceId(), metadata_->sequenceId()}), responses);
+  destroyRouters();
+}
+
+// A response frame larger than the upstream transport accepts closes the connection, which fails
+// all the requests on it.
+TEST_F(ThriftRouterMultiplexedTest, OversizedResponseFrame) {
+  initializeRouters();
+  startRequests(1);
+
+  EXPECT_CALL(upstream_connection_, close(Network::ConnectionCloseType::NoFlush))
+      .WillOnce(Invoke([this](Network::ConnectionCloseType) -> void {
+        upstream_callbacks_->onEvent(Network::ConnectionEvent::LocalClose);
+      }));
+  for (auto* callbacks : {&callbacks_, &callbacks2_}) {
+    EXPECT_CALL(*callbacks, upstreamData(_)).Times(0);
+    EXPECT_CALL(*callbacks, sendLocalReply(_, true))
+        .WillOnce(Invoke([&](const DirectResponse& response, bool) -> void {
+          auto& app_ex = dynamic_cast<const AppException&>(response);
+          EXPECT_EQ(AppExceptionType::InternalError, app_ex.type_);
+          EXPECT_THAT(app_ex.what(), ContainsRegex(".*local connection failure.*"));
+        }));
+  }
+
+  Buffer::OwnedImpl buffer;
+  buffer.writeBEInt<int32_t>(FramedTransportImpl::MaxFrameSize + 1);
+  upstream_callbacks_->onUpstreamData(buffer, false);
+  destroyRouters();
+}
+
+// The upstream closing the connection fails the requests still waiting for their response on it.
+TEST_F(ThriftRouterMultiplexedTest, UpstreamCloseWithPendingRequests) {
+  initializeRouters();
+  startRequests(1);
+
+  // The first request gets its response before the connection is closed.
+  std::vector<int32_t> responses;
+  expectResponse(callbacks_, metadata_->sequenceId(), responses);
+  Buffer::OwnedImpl buffer;
+  addResponse(buffer, metadata_->sequenceId());
+  upstream_callbacks_->onUpstreamData(buffer, false);
+
+  EXPECT_CALL(callbacks_, sendLocalReply(_, _)).Times(0);
+  EXPECT_CALL(callbacks2_, sendLocalReply(_, true))
+      .WillOnce(Invoke([&](const DirectResponse& response, bool) -> void {
+        auto& app_ex = dynamic_cast<const AppException&>(response);
+        EXPECT_EQ(AppExceptionType::InternalError, app_ex.type_);
+        EXPECT_THAT(app_ex.what(), ContainsRegex(".*remote connection failure.*"));
+      }));
+  upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
+  EXPECT_EQ(std::vector<int32_t>({metadata_->sequenceId()}), responses);
+
+  // The next request gets a new connection.
+  EXPECT_CALL(context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  router_->onDestroy();
+  router_ = std::make_unique<Router>(context_.clusterManager(), *stats_, context_.runtime(),
+                                     shadow_writer_, *multiplexer_, true);
+  router_->setDecoderFilterCallbacks(callbacks_);
+  beginRequest(*router_, 2);
+  destroyRouters();
+}
+
 } // namespace Router
 } // namespace ThriftProxy
 } // namespace NetworkFilters
@@ -0,0 +1,326 @@
+#include <memory>
+#include <string>
+
+#include "envoy/tcp/conn_pool.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/binary_protocol_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/framed_transport_impl.h"
+#include "source/extensions/filters/network/thrift_proxy/router/upstream_multiplexer.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/tcp/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace ThriftProxy {
+namespace Router {
+namespace {
+
+struct TestStream : public Tcp::ConnectionPool::Callbacks {
+  void onPoolReady(Tcp::ConnectionPool::ConnectionDataPtr&& conn,
+                   Upstream::HostDescriptionConstSharedPtr) override {
+    conn_data_ = std::move(conn);
+    conn_data_->addUpstreamCallbacks(callbacks_);
+    sequence_id_ = conn_data_->connectionStateTyped<ThriftConnectionState>()->nextSequenceId();
+  }
+
+  void onPoolFailure(ConnectionPool::PoolFailureReason reason, absl::string_view,
+                     Upstream::HostDescriptionConstSharedPtr) override {
+    reason_ = reason;
+  }
+
+  NiceMock<Tcp::ConnectionPool::MockUpstreamCallbacks> callbacks_;
+  Tcp::ConnectionPool::ConnectionDataPtr conn_data_;
+  int32_t sequence_id_{-1};
+  absl::optional<ConnectionPool::PoolFailureReason> reason_;
+};
+
+class UpstreamMultiplexerTest : public testing::Test {
+public:
+  UpstreamMultiplexerTest() : pool_data_([]() {}, &conn_pool_), multiplexer_(tls_) {}
+
+  void poolReady() {
+    auto& conn_data = *conn_pool_.connection_data_;
+    ON_CALL(conn_data, connectionState()).WillByDefault(Invoke([this]() {
+      return conn_state_.get();
+    }));
+    ON_CALL(conn_data, setConnectionState_(_))
+        .WillByDefault(Invoke([this](Tcp::ConnectionPool::ConnectionStatePtr& state) {
+          conn_state_ = std::move(state);
+        }));
+    ON_CALL(conn_data, addUpstreamCallbacks(_))
+        .WillByDefault(Invoke([this](Tcp::ConnectionPool::UpstreamCallbacks& callbacks) {
+          upstream_callbacks_ = &callbacks;
+        }));
+    conn_pool_.poolReady(connection_);
+  }
+
+  Tcp::ConnectionPool::Cancellable* newStream(TestStream& stream, uint32_t max_streams = 2,
+                                              bool expects_response = true) {
+    return multiplexer_.connPool().newStream(pool_data_, TransportType::Framed,
+                                             ProtocolType::Binary, max_streams, expects_response,
+                                             stream);
+  }
+
+  void addResponse(Buffer::Instance& buffer, int32_t sequence_id) {
+    MessageMetadata metadata;
+    metadata.setMethodName("method");
+    metadata.setMessageType(MessageType::Reply);
+    metadata.setSequenceId(sequence_id);
+
+    BinaryProtocolImpl protocol;
+    Buffer::OwnedImpl message;
+    protocol.writeMessageBegin(message, metadata);
+    protocol.writeStructBegin(message, "");
+    protocol.writeFieldBegin(message, "", FieldType::Stop, 0);
+    protocol.writeStructEnd(message);
+    protocol.writeMessageEnd(message);
+
+    FramedTransportImpl transport;
+    transport.encodeFrame(buffer, metadata, message);
+  }
+
+  void expectResponse(TestStream& stream) {
+    Buffer::OwnedImpl expected;
+    addResponse(expected, stream.sequence_id_);
+    EXPECT_CALL(stream.callbacks_, onUpstreamData(_, false))
+        .WillOnce(Invoke([&stream, response = expected.toString()](Buffer::Instance& data, bool) {
+          EXPECT_EQ(response, data.toString());
+          stream.conn_data_.reset();
+        }));
+  }
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Tcp::ConnectionPool::MockInstance> conn_pool_;
+  NiceMock<Network::MockClientConnection> connection_;
+  Upstream::TcpPoolData pool_data_;
+  UpstreamMultiplexer multiplexer_;
+  Tcp::ConnectionPool::ConnectionStatePtr conn_state_;
+  Tcp::ConnectionPool::UpstreamCallbacks* upstream_callbacks_{};
+};
+
+// Responses are dispatched by sequence id, in whichever order and fragments they arrive.
+TEST_F(UpstreamMultiplexerTest, DispatchesResponsesBySequenceId) {
+  TestStream stream1;
+  TestStream stream2;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newStream(stream1));
+  EXPECT_NE(nullptr, newStream(stream2));
+  poolReady();
+
+  ASSERT_NE(nullptr, stream1.conn_data_);
+  ASSERT_NE(nullptr, stream2.conn_data_);
+  EXPECT_EQ(&connection_, &stream1.conn_data_->connection());
+  EXPECT_EQ(&connection_, &stream2.conn_data_->connection());
+  EXPECT_NE(stream1.sequence_id_, stream2.sequence_id_);
+
+  Buffer::OwnedImpl responses;
+  addResponse(responses, stream2.sequence_id_);
+  addResponse(responses, stream1.sequence_id_);
+  expectResponse(stream1);
+  expectResponse(stream2);
+
+  Buffer::OwnedImpl fragment;
+  fragment.move(responses, responses.length() / 3);
+  upstream_callbacks_->onUpstreamData(fragment, false);
+  EXPECT_CALL(connection_, close(_)).Times(0);
+  EXPECT_CALL(conn_pool_, released(_));
+  upstream_callbacks_->onUpstreamData(responses, false);
+}
+
+// A request ready to be sent gets a stream on an established connection right away.
+TEST_F(UpstreamMultiplexerTest, SharesReadyConnection) {
+  TestStream stream1;
+  TestStream stream2;
+  newStream(stream1);
+  poolReady();
+  ASSERT_NE(nullptr, stream1.conn_data_);
+
+  EXPECT_CALL(conn_pool_, newConnection(_)).Times(0);
+  EXPECT_EQ(nullptr, newStream(stream2));
+  ASSERT_NE(nullptr, stream2.conn_data_);
+  EXPECT_NE(stream1.sequence_id_, stream2.sequence_id_);
+}
+
+// A full connection is not given more requests.
+TEST_F(UpstreamMultiplexerTest, FullConnection) {
+  TestStream stream1;
+  TestStream stream2;
+  EXPECT_CALL(conn_pool_, newConnection(_)).Times(2);
+  newStream(stream1, 1);
+  newStream(stream2, 1);
+}
+
+// Oneway requests leave the connection once sent.
+TEST_F(UpstreamMultiplexerTest, OnewayRequest) {
+  TestStream stream;
+  newStream(stream, 2, false);
+  poolReady();
+
+  EXPECT_CALL(connection_, close(_)).Times(0);
+  EXPECT_CALL(conn_pool_, released(_));
+  stream.conn_data_.reset();
+}
+
+// The connection is closed rather than released while a response to an abandoned request is
+// expected, and the responses to abandoned requests are dropped.
+TEST_F(UpstreamMultiplexerTest, AbandonedRequest) {
+  TestStream stream1;
+  TestStream stream2;
+  newStream(stream1);
+  newStream(stream2);
+  poolReady();
+
+  const int32_t abandoned_sequence_id = stream1.sequence_id_;
+  stream1.conn_data_.reset();
+
+  Buffer::OwnedImpl responses;
+  addResponse(responses, abandoned_sequence_id);
+  EXPECT_CALL(stream1.callbacks_, onUpstreamData(_, _)).Times(0);
+  upstream_callbacks_->onUpstreamData(responses, false);
+
+  addResponse(responses, stream2.sequence_id_);
+  expectResponse(stream2);
+  EXPECT_CALL(connection_, close(_)).Times(0);
+  upstream_callbacks_->onUpstreamData(responses, false);
+}
+
+TEST_F(UpstreamMultiplexerTest, AbandonedRequestClosesConnection) {
+  TestStream stream1;
+  TestStream stream2;
+  newStream(stream1);
+  newStream(stream2);
+  poolReady();
+
+  stream1.conn_data_.reset();
+  EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush))
+      .WillOnce(Invoke([this](Network::ConnectionCloseType) {
+        upstream_callbacks_->onEvent(Network::ConnectionEvent::LocalClose);
+      }));
+  stream2.conn_data_.reset();
+}
+
+// A closed connection resets its requests, and is not given new ones.
+TEST_F(UpstreamMultiplexerTest, ConnectionClose) {
+  TestStream stream1;
+  TestStream stream2;
+  newStream(stream1);
+  newStream(stream2);
+  poolReady();
+
+  EXPECT_CALL(stream1.callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&stream1](Network::ConnectionEvent) { stream1.conn_data_.reset(); }));
+  EXPECT_CALL(stream2.callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&stream2](Network::ConnectionEvent) { stream2.conn_data_.reset(); }));
+  upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
+
+  TestStream stream3;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_NE(nullptr, newStream(stream3));
+}
+
+// An invalid response closes the connection.
+TEST_F(UpstreamMultiplexerTest, InvalidResponse) {
+  TestStream stream;
+  newStream(stream);
+  poolReady();
+
+  Buffer::OwnedImpl response;
+  response.writeBEInt<int32_t>(-1);
+  EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush))
+      .WillOnce(Invoke([this](Network::ConnectionCloseType) {
+        upstream_callbacks_->onEvent(Network::ConnectionEvent::LocalClose);
+      }));
+  EXPECT_CALL(stream.callbacks_, onEvent(Network::ConnectionEvent::LocalClose));
+  upstream_callbacks_->onUpstreamData(response, false);
+}
+
+// A response frame larger than the framed transport accepts closes the connection, although the
+// header transport would accept it.
+TEST_F(UpstreamMultiplexerTest, OversizedFramedResponse) {
+  TestStream stream;
+  newStream(stream);
+  poolReady();
+
+  Buffer::OwnedImpl response;
+  response.writeBEInt<int32_t>(FramedTransportImpl::MaxFrameSize + 1);
+  EXPECT_CALL(connection_, close(Network::ConnectionCloseType::NoFlush))
+      .WillOnce(Invoke([this](Network::ConnectionCloseType) {
+        upstream_callbacks_->onEvent(Network::ConnectionEvent::LocalClose);
+      }));
+  EXPECT_CALL(stream.callbacks_, onEvent(Network::ConnectionEvent::LocalClose));
+  upstream_callbacks_->onUpstreamData(response, false);
+}
+
+// Connections are not shared between TCP connection pools, even to the same host.
+TEST_F(UpstreamMultiplexerTest, ConnectionsArePerPool) {
+  NiceMock<Tcp::ConnectionPool::MockInstance> other_conn_pool;
+  Upstream::TcpPoolData other_pool_data([]() {}, &other_conn_pool);
+  TestStream stream1;
+  TestStream stream2;
+  EXPECT_CALL(conn_pool_, newConnection(_));
+  EXPECT_CALL(other_conn_pool, newConnection(_));
+  EXPECT_NE(nullptr, newStream(stream1));
+  Tcp::ConnectionPool::Cancellable* handle = multiplexer_.connPool().newStream(
+      other_pool_data, TransportType::Framed, ProtocolType::Binary, 2, true, stream2);
+  ASSERT_NE(nullptr, handle);
+
+  // Let go of the connection of the other pool before the pool is destroyed.
+  EXPECT_CALL(other_conn_pool.handles_.front(), cancel(_));
+  handle->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+}
+
+// A pool is forgotten once idle, as another pool may later be allocated at its address.
+TEST_F(UpstreamMultiplexerTest, IdlePoolIsForgotten) {
+  TestStream stream1;
+  TestStream stream2;
+  EXPECT_CALL(conn_pool_, addIdleCallback(_)).Times(2);
+  EXPECT_CALL(conn_pool_, newConnection(_)).Times(2);
+  newStream(stream1, 2, false);
+  poolReady();
+  stream1.conn_data_.reset();
+  conn_pool_.idle_cb_();
+
+  EXPECT_NE(nullptr, newStream(stream2));
+}
+
+TEST_F(UpstreamMultiplexerTest, PoolFailure) {
+  TestStream stream1;
+  TestStream stream2;
+  newStream(stream1);
+  newStream(stream2);
+  conn_pool_.poolFailure(ConnectionPool::PoolFailureReason::RemoteConnectionFailure);
+
+  EXPECT_EQ(ConnectionPool::PoolFailureReason::RemoteConnectionFailure, stream1.reason_);
+  EXPECT_EQ(ConnectionPool::PoolFailureReason::RemoteConnectionFailure, stream2.reason_);
+}
+
+// Cancelling all the requests waiting for a connection cancels the connection.
+TEST_F(UpstreamMultiplexerTest, CancelPendingStreams) {
+  TestStream stream1;
+  TestStream stream2;
+  Tcp::ConnectionPool::Cancellable* handle1 = newStream(stream1);
+  Tcp::ConnectionPool::Cancellable* handle2 = newStream(stream2);
+
+  EXPECT_CALL(conn_pool_.handles_.front(), cancel(_)).Times(0);
+  handle1->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+  EXPECT_CALL(conn_pool_.handles_.front(), cancel(_));
+  handle2->cancel(Tcp::ConnectionPool::CancelPolicy::Default);
+}
+
+} // namespace
+} // namespace Router
+} // namespace ThriftProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -26,10 +26,12 @@ using testing::AtLeast;
 using testing::ByMove;
 using testing::DoAll;
 using testing::DoDefault;
+using testing::ElementsAre;
 using testing::InSequence;
 using testing::InvokeWithoutArgs;
 using testing::Return;
 using testing::ReturnNew;
+using testing::ReturnPointee;
 using testing::SaveArg;
 
 namespace Envoy {
@@ -56,6 +58,10 @@ Api::IoCallUint64Result makeError(int sys_errno) {
                                                     Network::IoSocketError::deleteIoError));
 }
 
+std::string sliceToString(const Buffer::RawSlice& slice) {
+  return {static_cast<const char*>(slice.mem_), slice.len_};
+}
+
 class UdpProxyFilterBase : public testing::Test {
 public:
   UdpProxyFilterBase() {
@@ -93,7 +99,6 @@ public:
     void expectWriteToUpstream(const std::string& data, int sys_errno = 0,
                                const Network::Address::Ip* local_ip = nullptr,
                                bool expect_connect = false, int connect_sys_errno = 0) {
-      EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
       if (expect_connect) {
         EXPECT_CALL(*socket_->io_handle_, connect(_))
             .WillOnce(Invoke([connect_sys_errno]() -> Api::SysCallIntResult {
@@ -134,8 +139,6 @@ public:
 
     void recvDataFromUpstream(const std::string& data, int recv_sys_errno = 0,
                               int send_sys_errno = 0) {
-      EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
-
       if (parent_.expect_gro_) {
         EXPECT_CALL(*socket_->io_handle_, supportsUdpGro());
       }
@@ -183,7 +186,6 @@ public:
 
     UdpProxyFilterTest& parent_;
     const Network::Address::InstanceConstSharedPtr upstream_address_;
-    Event::MockTimer* idle_timer_{};
     NiceMock<Network::MockSocket>* socket_;
     std::map<int, std::map<int, int>> sock_opts_;
     Event::FileReadyCb file_event_cb_;
@@ -203,6 +205,8 @@ public:
     ON_CALL(os_sys_calls_, supportsIpTransparent()).WillByDefault(Return(true));
     EXPECT_CALL(os_sys_calls_, supportsUdpGro()).Times(AtLeast(0)).WillRepeatedly(Return(true));
     EXPECT_CALL(callbacks_, udpListener()).Times(AtLeast(0));
+    EXPECT_CALL(callbacks_.udp_listener_.dispatcher_, approximateMonotonicTime())
+        .WillRepeatedly(ReturnPointee(&now_));
     EXPECT_CALL(*factory_context_.cluster_manager_.thread_local_cluster_.lb_.host_, address())
         .WillRepeatedly(Return(upstream_address_));
     EXPECT_CALL(*factory_context_.cluster_manager_.thread_local_cluster_.lb_.host_, coarseHealth())
@@ -220,25 +224,35 @@ public:
     if (has_cluster) {
       factory_context_.cluster_manager_.initializeThreadLocalClusters({"fake_cluster"});
     }
+    flush_sessions_cb_ = new Event::MockSchedulableCallback(&callbacks_.udp_listener_.dispatcher_);
+    idle_timer_ = new Event::MockTimer(&callbacks_.udp_listener_.dispatcher_);
     EXPECT_CALL(factory_context_.cluster_manager_, getThreadLocalCluster("fake_cluster"));
     filter_ = std::make_unique<TestUdpProxyFilter>(callbacks_, config_);
     expect_gro_ = expect_gro;
   }
 
+  // Unless end_of_iteration is false, the datagrams written by the sessions are sent upstream as
+  // they would be at the end of the event loop iteration.
   void recvDataFromDownstream(const std::string& peer_address, const std::string& local_address,
-                              const std::string& buffer) {
+                              const std::string& buffer, bool end_of_iteration = true) {
     Network::UdpRecvData data;
     data.addresses_.peer_ = Network::Utility::parseInternetAddressAndPort(peer_address);
     data.addresses_.local_ = Network::Utility::parseInternetAddressAndPort(local_address);
     data.buffer_ = std::make_unique<Buffer::OwnedImpl>(buffer);
     data.receive_time_ = MonotonicTime(std::chrono::seconds(0));
     filter_->onData(data);
+    if (end_of_iteration && flush_sessions_cb_->enabled_) {
+      flush_sessions_cb_->invokeCallback();
+    }
   }
 
   void expectSessionCreate(const Network::Address::InstanceConstSharedPtr& address) {
     test_sessions_.emplace_back(*this, address);
     TestSession& new_session = test_sessions_.back();
-    new_session.idle_timer_ = new Event::MockTimer(&callbacks_.udp_listener_.dispatcher_);
+    // The idle timer is armed when a session is added, unless it already is for another session.
+    if (!idle_timer_->enabled_) {
+      EXPECT_CALL(*idle_timer_, enableTimer(config_->sessionTimeout(), nullptr));
+    }
     EXPECT_CALL(*filter_, createSocket(_))
         .WillOnce(Return(ByMove(Network::SocketPtr{test_sessions_.back().socket_})));
     EXPECT_CALL(
@@ -251,6 +265,12 @@ public:
             InvokeWithoutArgs([]() -> Api::IoCallUint64Result { return makeNoError(0); }));
   }
 
+  // Lets the session timeout elapse and fires the idle timer.
+  void expireIdleSessions() {
+    now_ += config_->sessionTimeout();
+    idle_timer_->invokeCallback();
+  }
+
   std::shared_ptr<NiceMock<Upstream::MockHost>>
   createHost(const Network::Address::InstanceConstSharedPtr& host_address) {
     auto host = std::make_shared<NiceMock<Upstream::MockHost>>();
@@ -358,6 +378,9 @@ use_original_src_ip: true
   Network::MockUdpReadFilterCallbacks callbacks_;
   Upstream::ClusterUpdateCallbacks* cluster_update_callbacks_{};
   std::unique_ptr<TestUdpProxyFilter> filter_;
+  Event::MockSchedulableCallback* flush_sessions_cb_{};
+  Event::MockTimer* idle_timer_{};
+  MonotonicTime now_;
   std::vector<TestSession> test_sessions_;
   StringViewSaver access_log_data_;
   std::vector<std::string> output_;
@@ -500,7 +523,7 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 
-  test_sessions_[0].idle_timer_->invokeCallback();
+  expireIdleSessions();
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
 
@@ -542,7 +565,7 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 
-  test_sessions_[0].idle_timer_->invokeCallback();
+  expireIdleSessions();
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
 
@@ -557,6 +580,52 @@ matcher:
   EXPECT_EQ(output_.front(), "2 1");
 }
 
+// A single idle timer follows the least recently active session, so sessions active since it was
+// armed are not timed out.
+TEST_F(UdpProxyFilterTest, IdleTimerFollowsLeastRecentlyActiveSession) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  test_sessions_[0].expectWriteToUpstream("hello", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+
+  now_ += std::chrono::seconds(10);
+  expectSessionCreate(upstream_address_);
+  test_sessions_[1].expectWriteToUpstream("hello", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.3:1000", "10.0.0.2:80", "hello");
+
+  now_ += std::chrono::seconds(20);
+  test_sessions_[0].recvDataFromUpstream("world");
+
+  // The 2nd session has been idle for 50s and the 1st for 30s.
+  now_ += std::chrono::seconds(30);
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(10000), nullptr));
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(2, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(0, config_->stats().idle_timeout_.value());
+
+  now_ += std::chrono::seconds(10);
+  EXPECT_CALL(*idle_timer_, enableTimer(std::chrono::milliseconds(20000), nullptr));
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(1, config_->stats().idle_timeout_.value());
+
+  now_ += std::chrono::seconds(20);
+  idle_timer_->invokeCallback();
+  EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(2, config_->stats().idle_timeout_.value());
+  EXPECT_FALSE(idle_timer_->enabled_);
+}
+
 // Verify downstream send and receive error handling.
 TEST_F(UdpProxyFilterTest, SendReceiveErrorHandling) {
   InSequence s;
@@ -673,6 +742,188 @@ matcher:
   EXPECT_EQ(output_.back(), "fake_cluster 0 5 0 0 1");
 }
 
+// Datagrams received in one event loop iteration are sent upstream together with sendmmsg.
+TEST_F(UdpProxyFilterTest, BatchesUpstreamWritesPerIteration) {
+  InSequence s;
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello", false);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2", false);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello3", false);
+  checkTransferStats(17 /*rx_bytes*/, 3 /*rx_datagrams*/, 0 /*tx_bytes*/, 0 /*tx_datagrams*/);
+
+  EXPECT_CALL(*session.socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmmsg(_, 0))
+      .WillOnce(Invoke([](absl::Span<const absl::Span<const Buffer::RawSlice>> messages,
+                          int) -> Api::IoCallUint64Result {
+        EXPECT_EQ(3U, messages.size());
+        EXPECT_EQ("hello", sliceToString(messages[0][0]));
+        EXPECT_EQ("hello2", sliceToString(messages[1][0]));
+        EXPECT_EQ("hello3", sliceToString(messages[2][0]));
+        return makeNoError(2);
+      }));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmmsg(_, 0))
+      .WillOnce(Invoke([](absl::Span<const absl::Span<const Buffer::RawSlice>> messages,
+                          int) -> Api::IoCallUint64Result {
+        EXPECT_EQ(1U, messages.size());
+        EXPECT_EQ("hello3", sliceToString(messages[0][0]));
+        return makeError(SOCKET_ERROR_MSG_SIZE);
+      }));
+  flush_sessions_cb_->invokeCallback();
+
+  EXPECT_EQ(11, factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_
+                    ->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+  EXPECT_EQ(
+      2, TestUtility::findCounter(
+             factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_->stats_store_,
+             "udp.sess_tx_datagrams")
+             ->value());
+  EXPECT_EQ(
+      1, TestUtility::findCounter(
+             factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_->stats_store_,
+             "udp.sess_tx_errors")
+             ->value());
+}
+
+// When the socket can't take more datagrams, the rest of the batch is dropped at once.
+TEST_F(UdpProxyFilterTest, DropsBatchWhenSendmmsgWouldBlock) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello", false);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2", false);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello3", false);
+
+  EXPECT_CALL(*session.socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmmsg(_, 0))
+      .WillOnce(Return(ByMove(Api::IoCallUint64Result(
+          0, Api::IoErrorPtr(Network::IoSocketError::getIoSocketEagainInstance(),
+                             Network::IoSocketError::deleteIoError)))));
+  flush_sessions_cb_->invokeCallback();
+
+  EXPECT_EQ(0, factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_
+                   ->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+  EXPECT_EQ(
+      3, TestUtility::findCounter(
+             factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_->stats_store_,
+             "udp.sess_tx_errors")
+             ->value());
+}
+
+// Without sendmmsg, the datagrams of an iteration are sent one at a time and in order.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWritesWithoutMmsg) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello", false);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2", false);
+
+  std::vector<std::string> sent;
+  EXPECT_CALL(*session.socket_->io_handle_, supportsMmsg()).WillOnce(Return(false));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, 1, 0, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&sent](const Buffer::RawSlice* slices, uint64_t, int,
+                                     const Network::Address::Ip*,
+                                     const Network::Address::Instance&) -> Api::IoCallUint64Result {
+        sent.push_back(sliceToString(slices[0]));
+        return makeNoError(slices[0].len_);
+      }));
+  flush_sessions_cb_->invokeCallback();
+  EXPECT_THAT(sent, ElementsAre("hello", "hello2"));
+  EXPECT_EQ(11, factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_
+                    ->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+}
+
+// A session does not buffer more than a full batch of datagrams, and sends the ones it has
+// buffered when it is removed.
+TEST_F(UdpProxyFilterTest, FlushesFullBatchesAndRemovedSessions) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*session.socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmmsg(_, 0))
+      .WillOnce(Invoke([](absl::Span<const absl::Span<const Buffer::RawSlice>> messages,
+                          int) -> Api::IoCallUint64Result {
+        EXPECT_EQ(64U, messages.size());
+        return makeNoError(messages.size());
+      }));
+  for (int i = 0; i < 64; ++i) {
+    recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello", false);
+  }
+  EXPECT_EQ(64, TestUtility::findCounter(factory_context_.cluster_manager_.thread_local_cluster_
+                                             .cluster_.info_->stats_store_,
+                                         "udp.sess_tx_datagrams")
+                    ->value());
+
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2", false);
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, 1, 0, _, _))
+      .WillOnce(Invoke([](const Buffer::RawSlice* slices, uint64_t, int,
+                          const Network::Address::Ip*,
+                          const Network::Address::Instance&) -> Api::IoCallUint64Result {
+        EXPECT_EQ("hello2", sliceToString(slices[0]));
+        return makeNoError(slices[0].len_);
+      }));
+  expireIdleSessions();
+  EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(65, TestUtility::findCounter(factory_context_.cluster_manager_.thread_local_cluster_
+                                             .cluster_.info_->stats_store_,
+                                         "udp.sess_tx_datagrams")
+                    ->value());
+
+  // Nothing is left to send at the end of the iteration.
+  flush_sessions_cb_->invokeCallback();
+}
+
 // No upstream host handling.
 TEST_F(UdpProxyFilterTest, NoUpstreamHost) {
   InSequence s;
@@ -805,7 +1056,7 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 
   // Timing out the 1st session should allow us to create another.
-  test_sessions_[0].idle_timer_->invokeCallback();
+  expireIdleSessions();
   EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
   EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
   expectSessionCreate(upstream_address_);
@@ -178,6 +178,10 @@ const char YamlSingleServer[] = R"EOF(
 const char YamlSingleDstPortTop[] = R"EOF(
     - filter_chain_match:
         destination_port: )EOF";
+const char YamlSingleServerNameTop[] = R"EOF(
+    - filter_chain_match:
+        transport_protocol: "tls"
+        server_names: ")EOF";
 const char YamlSingleDstPortBottom[] = R"EOF(
       transport_socket:
         name: "envoy.transport_sockets.tls"
@@ -208,6 +212,22 @@ public:
     filter_chains_ = listener_config_.filter_chains();
   }
 
+  void initializeServerNames(::benchmark::State& state) {
+    int64_t input_size = state.range(0);
+    std::vector<std::string> server_name_chains;
+    server_name_chains.reserve(input_size);
+    for (int i = 0; i < input_size; i++) {
+      // The transport socket of the port chains is reused as is.
+      server_name_chains.push_back(absl::StrCat(YamlSingleServerNameTop, "tenant", i,
+                                                ".example.com\"", YamlSingleDstPortBottom));
+    }
+    listener_yaml_config_ = TestEnvironment::substitute(
+        absl::StrCat(YamlHeader, absl::StrJoin(server_name_chains, "")),
+        Network::Address::IpVersion::v4);
+    TestUtility::loadFromYaml(listener_yaml_config_, listener_config_);
+    filter_chains_ = listener_config_.filter_chains();
+  }
+
   Envoy::Thread::MutexBasicLockable lock_;
   Logger::Context logging_state_{spdlog::level::warn, Logger::Logger::DEFAULT_LOG_FORMAT, lock_,
                                  false};
@@ -238,6 +258,44 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
   }
 }
 
+// Update one of the filter chains of a listener with a filter chain per server name, either from
+// the previous filter chain manager or from scratch.
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainManagerUpdateTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  const bool incremental = state.range(1) != 0;
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  FilterChainManagerImpl origin_filter_chain_manager{addresses, factory_context, init_manager_};
+  origin_filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr, dummy_builder_,
+                                              origin_filter_chain_manager);
+
+  envoy::config::listener::v3::FilterChain updated_filter_chain = *filter_chains_.back();
+  updated_filter_chain.set_name("updated");
+  std::vector<const envoy::config::listener::v3::FilterChain*> updated_filter_chains(
+      filter_chains_.begin(), filter_chains_.end());
+  updated_filter_chains.back() = &updated_filter_chain;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    if (incremental) {
+      FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_,
+                                                  origin_filter_chain_manager};
+      filter_chain_manager.addFilterChains(nullptr, updated_filter_chains, nullptr,
+                                           dummy_builder_, filter_chain_manager);
+    } else {
+      FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+      filter_chain_manager.addFilterChains(nullptr, updated_filter_chains, nullptr,
+                                           dummy_builder_, filter_chain_manager);
+    }
+  }
+}
+
 BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
 (::benchmark::State& state) {
   if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
@@ -273,6 +331,14 @@ BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
         {1, 4096},
     })
     ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerUpdateTest)
+    ->ArgsProduct({
+        // scale of the chains
+        {1, 64, 1024, 20480},
+        // whether to update from the previous filter chain manager
+        {0, 1},
+    })
+    ->Unit(::benchmark::kMillisecond);
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     ->Ranges({
         // scale of the chains
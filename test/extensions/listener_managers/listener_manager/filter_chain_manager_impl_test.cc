@@ -256,6 +256,67 @@ TEST_P(FilterChainManagerImplTest, DuplicateContextsAreNotBuilt) {
       nullptr, filter_chain_factory_builder_, new_filter_chain_manager);
 }
 
+// The lookup subtrees of unchanged ports and server names are copied from the original filter
+// chain manager, and keep finding the reused filter chains next to the rebuilt ones.
+TEST_P(FilterChainManagerImplTest, UnchangedLookupSubtreesAreCopied) {
+  if (GetParam()) {
+    GTEST_SKIP() << "the matcher doesn't build the lookup subtrees";
+  }
+  std::vector<envoy::config::listener::v3::FilterChain> filter_chain_messages;
+  for (const char* server_name : {"a.example.com", "b.example.com", "*.example.com"}) {
+    envoy::config::listener::v3::FilterChain new_filter_chain = filter_chain_template_;
+    new_filter_chain.set_name(server_name);
+    new_filter_chain.mutable_filter_chain_match()->add_server_names(server_name);
+    filter_chain_messages.push_back(std::move(new_filter_chain));
+  }
+  envoy::config::listener::v3::FilterChain other_port_filter_chain = filter_chain_template_;
+  other_port_filter_chain.mutable_filter_chain_match()->mutable_destination_port()->set_value(
+      10001);
+  filter_chain_messages.push_back(std::move(other_port_filter_chain));
+
+  std::vector<std::shared_ptr<Network::MockFilterChain>> filter_chains;
+  for (int i = 0; i < 4; i++) {
+    filter_chains.push_back(std::make_shared<Network::MockFilterChain>());
+  }
+  EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _))
+      .WillOnce(Return(filter_chains[0]))
+      .WillOnce(Return(filter_chains[1]))
+      .WillOnce(Return(filter_chains[2]))
+      .WillOnce(Return(filter_chains[3]));
+  filter_chain_manager_->addFilterChains(
+      nullptr,
+      std::vector<const envoy::config::listener::v3::FilterChain*>{
+          &filter_chain_messages[3], &filter_chain_messages[2], &filter_chain_messages[1],
+          &filter_chain_messages[0]},
+      nullptr, filter_chain_factory_builder_, *filter_chain_manager_);
+
+  // Update the filter chain of "b.example.com" only.
+  envoy::config::listener::v3::FilterChain updated_filter_chain = filter_chain_messages[1];
+  updated_filter_chain.set_name("updated");
+  auto updated_build_out = std::make_shared<Network::MockFilterChain>();
+  EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _))
+      .WillOnce(Return(updated_build_out));
+  auto new_filter_chain_manager = std::make_unique<FilterChainManagerImpl>(
+      addresses_, parent_context_, init_manager_, *filter_chain_manager_);
+  new_filter_chain_manager->addFilterChains(
+      nullptr,
+      std::vector<const envoy::config::listener::v3::FilterChain*>{
+          &filter_chain_messages[0], &updated_filter_chain, &filter_chain_messages[2],
+          &filter_chain_messages[3]},
+      nullptr, filter_chain_factory_builder_, *new_filter_chain_manager);
+
+  // The original filter chain manager may go away while the copied subtrees are in use.
+  filter_chain_manager_ = std::move(new_filter_chain_manager);
+  EXPECT_EQ(filter_chains[3].get(),
+            findFilterChainHelper(10000, "127.0.0.1", "a.example.com", "tls", {}, "8.8.8.8", 111));
+  EXPECT_EQ(updated_build_out.get(),
+            findFilterChainHelper(10000, "127.0.0.1", "b.example.com", "tls", {}, "8.8.8.8", 111));
+  EXPECT_EQ(filter_chains[1].get(),
+            findFilterChainHelper(10000, "127.0.0.1", "c.example.com", "tls", {}, "8.8.8.8", 111));
+  EXPECT_EQ(filter_chains[0].get(),
+            findFilterChainHelper(10001, "127.0.0.1", "", "tls", {}, "8.8.8.8", 111));
+}
+
 TEST_P(FilterChainManagerImplTest, CreatedFilterChainFactoryContextHasIndependentDrainClose) {
   std::vector<envoy::config::listener::v3::FilterChain> filter_chain_messages;
   for (int i = 0; i < 3; i++) {
@@ -0,0 +1,151 @@
+#include <unistd.h>
+
+#include <string>
+
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/server/hot_restarting_parent.h"
+
+#include "test/extensions/listener_managers/listener_manager/listener_manager_impl_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+using testing::Invoke;
+
+// Drives the migration of an idle connection from the listener manager of the parent, through the
+// hot restart RPC handler of the parent, to the listener manager of the child.
+class HotRestartMigrationTest : public ListenerManagerImplTest {
+protected:
+  void SetUp() override {
+    ListenerManagerImplTest::SetUp();
+    EXPECT_CALL(os_sys_calls_, getpeername)
+        .WillRepeatedly(Invoke([this](os_fd_t sockfd, sockaddr* addr, socklen_t* addrlen) {
+          return os_sys_calls_actual_.getpeername(sockfd, addr, addrlen);
+        }));
+  }
+
+  // @return the accepted and the connecting end of a loopback TCP connection.
+  std::pair<os_fd_t, os_fd_t> connectedSockets() {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    const os_fd_t listen_fd = os_sys_calls_actual_.socket(AF_INET, SOCK_STREAM, 0).return_value_;
+    EXPECT_EQ(0, os_sys_calls_actual_
+                     .bind(listen_fd, reinterpret_cast<const sockaddr*>(&addr), addr_len)
+                     .return_value_);
+    EXPECT_EQ(0, os_sys_calls_actual_.listen(listen_fd, 1).return_value_);
+    EXPECT_EQ(0, os_sys_calls_actual_
+                     .getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len)
+                     .return_value_);
+
+    const os_fd_t client_fd = os_sys_calls_actual_.socket(AF_INET, SOCK_STREAM, 0).return_value_;
+    EXPECT_EQ(0, os_sys_calls_actual_
+                     .connect(client_fd, reinterpret_cast<const sockaddr*>(&addr), addr_len)
+                     .return_value_);
+    const os_fd_t server_fd =
+        os_sys_calls_actual_.accept(listen_fd, nullptr, nullptr).return_value_;
+    os_sys_calls_actual_.close(listen_fd);
+    return {server_fd, client_fd};
+  }
+};
+
+TEST_P(HotRestartMigrationTest, MigrateIdleConnection) {
+  const std::pair<os_fd_t, os_fd_t> fds = connectedSockets();
+  const os_fd_t server_fd = fds.first;
+  const os_fd_t client_fd = fds.second;
+  const Network::Address::InstanceConstSharedPtr local_address =
+      Network::IoSocketHandleImpl(server_fd).localAddress();
+  const Network::Address::InstanceConstSharedPtr remote_address =
+      Network::IoSocketHandleImpl(client_fd).localAddress();
+
+  // Parent.
+  EXPECT_CALL(*worker_, start(_, _));
+  manager_->startWorkers(guard_dog_, callback_.AsStdFunction());
+  EXPECT_CALL(*worker_, numConnections()).WillRepeatedly(Return(0));
+  ON_CALL(server_, listenerManager()).WillByDefault(ReturnRef(*manager_));
+  HotRestartingParent::Internal hot_restarting_parent(&server_);
+
+  // Child.
+  NiceMock<MockInstance> child_server;
+  MockWorker* child_worker = new MockWorker();
+  NiceMock<MockWorkerFactory> child_worker_factory;
+  EXPECT_CALL(child_worker_factory, createWorker_()).WillOnce(Return(child_worker));
+  ListenerManagerImpl child_manager(
+      child_server, std::make_unique<NiceMock<MockListenerComponentFactory>>(),
+      child_worker_factory, false, child_server.quic_stat_names_);
+  EXPECT_CALL(*child_worker, start(_, _));
+  child_manager.startWorkers(guard_dog_, callback_.AsStdFunction());
+
+  // The worker of the parent closes the idle connection for the child.
+  EXPECT_CALL(*worker_, migrateIdleConnections(_))
+      .WillOnce(Invoke([server_fd](Worker::MigrateIdleConnectionsCompletion completion) {
+        std::vector<Network::IoHandlePtr> sockets;
+        sockets.push_back(std::make_unique<Network::IoSocketHandleImpl>(server_fd));
+        completion(std::move(sockets));
+      }));
+  // The parent hands the socket off in the reply, and closes its copy once the reply is sent.
+  os_fd_t migrated_fd = -1;
+  hot_restarting_parent.migrateConnectionsForChild(
+      [&migrated_fd](const envoy::HotRestartMessage& message) {
+        ASSERT_EQ(1, message.reply().migrate_connection().fds_size());
+        EXPECT_FALSE(message.reply().migrate_connection().more());
+        EXPECT_EQ(0, message.reply().migrate_connection().num_connections());
+        // The child receives its own duplicate of the socket, as SCM_RIGHTS would pass it.
+        migrated_fd = ::dup(message.reply().migrate_connection().fds(0));
+      });
+  ASSERT_NE(-1, migrated_fd);
+  EXPECT_EQ(1, server_.stats_store_.counter("listener_manager.idle_connections_migrated").value());
+
+  // The child accepts the socket on its worker.
+  Network::ConnectionSocketPtr accepted_socket;
+  EXPECT_CALL(*child_worker, acceptMigratedConnection(_))
+      .WillOnce(Invoke([&accepted_socket](Network::ConnectionSocketPtr&& socket) {
+        accepted_socket = std::move(socket);
+      }));
+  child_manager.acceptMigratedConnection(migrated_fd);
+  ASSERT_NE(nullptr, accepted_socket);
+  EXPECT_EQ(*local_address, *accepted_socket->connectionInfoProvider().localAddress());
+  EXPECT_EQ(*remote_address, *accepted_socket->connectionInfoProvider().remoteAddress());
+  EXPECT_EQ(1, child_server.stats_store_.counter("listener_manager.migrated_connections_accepted")
+                   .value());
+
+  // The parent has no connection left to hand off.
+  EXPECT_CALL(*worker_, migrateIdleConnections(_))
+      .WillOnce(
+          Invoke([](Worker::MigrateIdleConnectionsCompletion completion) { completion({}); }));
+  bool replied = false;
+  hot_restarting_parent.migrateConnectionsForChild(
+      [&replied](const envoy::HotRestartMessage& message) {
+        replied = true;
+        EXPECT_EQ(0, message.reply().migrate_connection().fds_size());
+        EXPECT_EQ(0, message.reply().migrate_connection().num_connections());
+      });
+  EXPECT_TRUE(replied);
+
+  // The peer now talks to the child over the same connection.
+  const std::string data = "hello";
+  EXPECT_EQ(data.size(),
+            os_sys_calls_actual_.send(client_fd, const_cast<char*>(data.data()), data.size(), 0)
+                .return_value_);
+  char buffer[16];
+  EXPECT_EQ(data.size(), os_sys_calls_actual_
+                             .recv(accepted_socket->ioHandle().fdDoNotUse(), buffer,
+                                   sizeof(buffer), 0)
+                             .return_value_);
+  EXPECT_EQ(data, std::string(buffer, data.size()));
+
+  // Closing is stubbed out by the fixture.
+  os_sys_calls_actual_.close(accepted_socket->ioHandle().fdDoNotUse());
+  os_sys_calls_actual_.close(server_fd);
+  os_sys_calls_actual_.close(client_fd);
+}
+
+INSTANTIATE_TEST_SUITE_P(Matcher, HotRestartMigrationTest, ::testing::Values(false));
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
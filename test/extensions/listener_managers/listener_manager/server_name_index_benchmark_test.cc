@@ -0,0 +1,91 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "source/extensions/listener_managers/listener_manager/server_name_index.h"
+
+#include "test/benchmark/main.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+// One exact server name and one wildcard domain per tenant, as on a multi-tenant edge listener.
+std::vector<std::pair<std::string, int>> tenantServerNames(int64_t tenants) {
+  std::vector<std::pair<std::string, int>> names;
+  names.reserve(tenants * 2 + 1);
+  for (int64_t i = 0; i < tenants; i++) {
+    names.emplace_back(absl::StrCat("tenant", i, ".example.com"), i);
+    names.emplace_back(absl::StrCat(".tenant", i, ".example.net"), i);
+  }
+  names.emplace_back("", -1);
+  return names;
+}
+
+} // namespace
+
+static void bmServerNameIndexBuild(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  const std::vector<std::pair<std::string, int>> names = tenantServerNames(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    std::vector<std::pair<std::string, int>> index_names = names;
+    state.ResumeTiming();
+    ServerNameIndex<int> index(std::move(index_names));
+    ::benchmark::DoNotOptimize(index.size());
+  }
+}
+BENCHMARK(bmServerNameIndexBuild)
+    ->Arg(1000)
+    ->Arg(250000)
+    ->Arg(500000)
+    ->Unit(::benchmark::kMillisecond);
+
+// Look up exact server names, names matching a wildcard domain, and names only matching the
+// catch-all.
+static void bmServerNameIndexFind(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 1000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  const int64_t tenants = state.range(0);
+  const ServerNameIndex<int> index(tenantServerNames(tenants));
+  std::vector<std::string> server_names;
+  for (int64_t i = 0; i < 1000; i++) {
+    const int64_t tenant = (i * 7919) % tenants;
+    switch (state.range(1)) {
+    case 0:
+      server_names.push_back(absl::StrCat("tenant", tenant, ".example.com"));
+      break;
+    case 1:
+      server_names.push_back(absl::StrCat("www.tenant", tenant, ".example.net"));
+      break;
+    default:
+      server_names.push_back(absl::StrCat("www.tenant", tenant, ".example.org"));
+      break;
+    }
+  }
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    for (const std::string& server_name : server_names) {
+      ::benchmark::DoNotOptimize(index.find(server_name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * server_names.size());
+}
+BENCHMARK(bmServerNameIndexFind)
+    ->ArgsProduct({{1000, 500000}, {0, 1, 2}})
+    ->Unit(::benchmark::kMicrosecond);
+
+} // namespace Server
+} // namespace Envoy
@@ -0,0 +1,77 @@
+#include <string>
+#include <vector>
+
+#include "source/extensions/listener_managers/listener_manager/server_name_index.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+int lookup(const ServerNameIndex<int>& index, absl::string_view server_name) {
+  const int* data = index.find(server_name);
+  return data == nullptr ? -1 : *data;
+}
+
+TEST(ServerNameIndexTest, Empty) {
+  ServerNameIndex<int> index({});
+  EXPECT_EQ(0U, index.size());
+  EXPECT_EQ(nullptr, index.findExact(""));
+  EXPECT_EQ(-1, lookup(index, ""));
+  EXPECT_EQ(-1, lookup(index, "www.example.com"));
+}
+
+TEST(ServerNameIndexTest, ExactMatch) {
+  ServerNameIndex<int> index({{"www.example.com", 1}, {"example.com", 2}});
+  EXPECT_EQ(2U, index.size());
+  EXPECT_EQ(1, lookup(index, "www.example.com"));
+  EXPECT_EQ(2, lookup(index, "example.com"));
+  EXPECT_EQ(-1, lookup(index, "api.example.com"));
+  EXPECT_EQ(-1, lookup(index, ""));
+}
+
+// The exact server name wins over the wildcard domains, and longer wildcard domains over shorter
+// ones, before falling back to the catch-all empty name.
+TEST(ServerNameIndexTest, WildcardMatch) {
+  ServerNameIndex<int> index({{"www.example.com", 1},
+                              {".example.com", 2},
+                              {".com", 3},
+                              {".a.b.c.example.org", 4},
+                              {"", 5}});
+  EXPECT_EQ(1, lookup(index, "www.example.com"));
+  EXPECT_EQ(2, lookup(index, "api.example.com"));
+  EXPECT_EQ(2, lookup(index, "a.b.example.com"));
+  EXPECT_EQ(3, lookup(index, "example.com"));
+  EXPECT_EQ(4, lookup(index, "www.a.b.c.example.org"));
+  EXPECT_EQ(5, lookup(index, "a.b.c.example.org"));
+  EXPECT_EQ(5, lookup(index, "example.org"));
+  EXPECT_EQ(5, lookup(index, "com"));
+  EXPECT_EQ(5, lookup(index, "www.example.com."));
+  EXPECT_EQ(5, lookup(index, ""));
+
+  // Wildcard domains are only found by exact lookups as themselves.
+  ASSERT_NE(nullptr, index.findExact(".example.com"));
+  EXPECT_EQ(2, *index.findExact(".example.com"));
+  EXPECT_EQ(nullptr, index.findExact("api.example.com"));
+}
+
+TEST(ServerNameIndexTest, ManyNames) {
+  std::vector<std::pair<std::string, int>> names;
+  for (int i = 0; i < 10000; i++) {
+    names.emplace_back(absl::StrCat("tenant", i, ".example.com"), i);
+    names.emplace_back(absl::StrCat(".tenant", i, ".example.org"), -i);
+  }
+  ServerNameIndex<int> index(std::move(names));
+  EXPECT_EQ(20000U, index.size());
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(i, lookup(index, absl::StrCat("tenant", i, ".example.com")));
+    EXPECT_EQ(-i, lookup(index, absl::StrCat("www.tenant", i, ".example.org")));
+    EXPECT_EQ(-1, lookup(index, absl::StrCat("www.tenant", i, ".example.com")));
+  }
+}
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
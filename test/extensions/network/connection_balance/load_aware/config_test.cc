@@ -0,0 +1,61 @@
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/extensions/network/connection_balance/load_aware/v3/load_aware.pb.h"
+
+#include "source/extensions/network/connection_balance/load_aware/config.h"
+#include "source/extensions/network/connection_balance/load_aware/load_aware_balancer.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+namespace {
+
+TEST(LoadAwareConnectionBalanceFactoryTest, CreateBalancer) {
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  TestUtility::loadFromYaml(R"EOF(
+name: envoy.network.connection_balance.load_aware
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.network.connection_balance.load_aware.v3.LoadAware
+  sample_interval: 0.05s
+  lag_tolerance: 0.002s
+)EOF",
+                            typed_config);
+
+  auto* factory = Registry::FactoryRegistry<Network::ConnectionBalanceFactory>::getFactory(
+      "envoy.network.connection_balance.load_aware");
+  ASSERT_NE(nullptr, factory);
+
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  Network::ConnectionBalancerSharedPtr balancer =
+      factory->createConnectionBalancerFromProto(typed_config, context);
+  EXPECT_NE(nullptr, dynamic_cast<LoadAwareConnectionBalancerImpl*>(balancer.get()));
+}
+
+TEST(LoadAwareConnectionBalanceFactoryTest, InvalidConfig) {
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  TestUtility::loadFromYaml(R"EOF(
+name: envoy.network.connection_balance.load_aware
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.network.connection_balance.load_aware.v3.LoadAware
+  sample_interval: 0s
+)EOF",
+                            typed_config);
+
+  LoadAwareConnectionBalanceFactory factory;
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  EXPECT_THROW(factory.createConnectionBalancerFromProto(typed_config, context),
+               ProtoValidationException);
+}
+
+} // namespace
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,205 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/network/connection_balance/load_aware/load_aware_balancer.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "absl/synchronization/notification.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace LoadAware {
+namespace {
+
+class TestHandler : public Network::BalancedConnectionHandler {
+public:
+  explicit TestHandler(uint64_t connections) : connections_(connections) {}
+
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return connections_; }
+  void incNumConnections() override { connections_++; }
+  void post(Network::ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(Network::ConnectionSocketPtr&&, bool, bool) override {}
+
+  uint64_t connections_;
+};
+
+class LoadAwareConnectionBalancerTest : public testing::Test {
+public:
+  LoadAwareConnectionBalancerTest() {
+    tls_.defer_data_ = true;
+    balancer_ = std::make_unique<LoadAwareConnectionBalancerImpl>(
+        tls_, *store_.rootScope(), std::chrono::milliseconds(100), std::chrono::milliseconds(1));
+    initialize_ = tls_.deferred_data_;
+  }
+
+  // Sets the slot of the balancer up as it would be on a new worker, and registers the handler
+  // of the worker. Returns the timer measuring the event loop lag of the worker.
+  Event::MockTimer* addWorker(TestHandler& handler) {
+    auto* timer = new NiceMock<Event::MockTimer>(&tls_.dispatcher_);
+    tls_.deferred_data_ = initialize_;
+    tls_.call();
+    workers_.push_back(tls_.data_[0]);
+    balancer_->registerHandler(handler);
+    return timer;
+  }
+
+  // Makes the event loop of a worker lag by the given time once.
+  void lag(Event::MockTimer& timer, std::chrono::milliseconds lag) {
+    time_system_.advanceTimeWait(std::chrono::milliseconds(100) + lag);
+    timer.invokeCallback();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  std::unique_ptr<LoadAwareConnectionBalancerImpl> balancer_;
+  std::vector<ThreadLocal::Slot::InitializeCb> initialize_;
+  std::vector<ThreadLocal::ThreadLocalObjectSharedPtr> workers_;
+};
+
+TEST_F(LoadAwareConnectionBalancerTest, PicksFewestConnections) {
+  TestHandler handler1(2);
+  TestHandler handler2(0);
+  TestHandler handler3(1);
+  addWorker(handler1);
+  addWorker(handler2);
+  addWorker(handler3);
+
+  EXPECT_EQ(&handler2, &balancer_->pickTargetHandler(handler1));
+  EXPECT_EQ(1, handler2.connections_);
+  EXPECT_EQ(1, balancer_->stats().rebalanced_.value());
+  EXPECT_EQ(2, balancer_->stats().connection_spread_.value());
+  EXPECT_EQ(0, balancer_->stats().loop_lag_spread_us_.value());
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, StaysOnCurrentHandlerOnTie) {
+  TestHandler handler1(0);
+  TestHandler handler2(0);
+  addWorker(handler1);
+  addWorker(handler2);
+
+  EXPECT_EQ(&handler2, &balancer_->pickTargetHandler(handler2));
+  EXPECT_EQ(&handler1, &balancer_->pickTargetHandler(handler1));
+  EXPECT_EQ(0, balancer_->stats().rebalanced_.value());
+}
+
+// A worker whose event loop lags is avoided even if it has fewer connections.
+TEST_F(LoadAwareConnectionBalancerTest, AvoidsLaggingWorker) {
+  TestHandler handler1(0);
+  TestHandler handler2(5);
+  Event::MockTimer* timer1 = addWorker(handler1);
+  addWorker(handler2);
+
+  // The lag is smoothed, so that 8ms lag once counts as 2ms.
+  lag(*timer1, std::chrono::milliseconds(8));
+  EXPECT_EQ(&handler2, &balancer_->pickTargetHandler(handler1));
+  EXPECT_EQ(6, handler2.connections_);
+  EXPECT_EQ(2000, balancer_->stats().loop_lag_spread_us_.value());
+  EXPECT_EQ(1, balancer_->stats().rebalanced_.value());
+}
+
+// Workers lagging within the tolerance of each other are picked between by their connections.
+TEST_F(LoadAwareConnectionBalancerTest, LagWithinTolerance) {
+  TestHandler handler1(0);
+  TestHandler handler2(5);
+  Event::MockTimer* timer1 = addWorker(handler1);
+  addWorker(handler2);
+
+  lag(*timer1, std::chrono::milliseconds(2));
+  EXPECT_EQ(&handler1, &balancer_->pickTargetHandler(handler2));
+  EXPECT_EQ(500, balancer_->stats().loop_lag_spread_us_.value());
+}
+
+TEST_F(LoadAwareConnectionBalancerTest, UnregisterHandler) {
+  TestHandler handler1(1);
+  TestHandler handler2(0);
+  addWorker(handler1);
+  addWorker(handler2);
+
+  balancer_->unregisterHandler(handler2);
+  EXPECT_EQ(&handler1, &balancer_->pickTargetHandler(handler2));
+  EXPECT_EQ(2, handler1.connections_);
+
+  // With no handler left, the connection stays where it was accepted.
+  balancer_->unregisterHandler(handler1);
+  EXPECT_EQ(&handler2, &balancer_->pickTargetHandler(handler2));
+  EXPECT_EQ(1, handler2.connections_);
+}
+
+// A handler may be destroyed as soon as it is unregistered, so unregistering it waits for the picks
+// reading it.
+TEST_F(LoadAwareConnectionBalancerTest, UnregisterWaitsForPick) {
+  class SlowHandler : public TestHandler {
+  public:
+    explicit SlowHandler(const std::atomic<bool>& unregistered)
+        : TestHandler(0), unregistered_(unregistered) {}
+
+    // TestHandler
+    uint64_t numConnections() const override {
+      picking_.Notify();
+      unregistering_.WaitForNotification();
+      return TestHandler::numConnections();
+    }
+    void incNumConnections() override {
+      unregistered_while_picked_ = unregistered_.load();
+      TestHandler::incNumConnections();
+    }
+
+    const std::atomic<bool>& unregistered_;
+    mutable absl::Notification picking_;
+    absl::Notification unregistering_;
+    bool unregistered_while_picked_{};
+  };
+
+  std::atomic<bool> unregistered{false};
+  TestHandler handler1(1);
+  SlowHandler handler2(unregistered);
+  addWorker(handler1);
+  addWorker(handler2);
+
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread([&]() {
+    handler2.picking_.WaitForNotification();
+    handler2.unregistering_.Notify();
+    balancer_->unregisterHandler(handler2);
+    unregistered = true;
+  });
+  EXPECT_EQ(&handler2, &balancer_->pickTargetHandler(handler1));
+  thread->join();
+  EXPECT_FALSE(handler2.unregistered_while_picked_);
+
+  // Picks starting after the handler was unregistered don't see it.
+  EXPECT_EQ(&handler1, &balancer_->pickTargetHandler(handler1));
+}
+
+// A handler registered on a thread without a worker load is ignored, and picks from such a thread
+// take the lock.
+TEST_F(LoadAwareConnectionBalancerTest, RegisterOnUnregisteredThread) {
+  TestHandler handler1(0);
+  TestHandler handler2(0);
+  addWorker(handler1);
+  tls_.registered_ = false;
+  balancer_->registerHandler(handler2);
+
+  EXPECT_EQ(&handler1, &balancer_->pickTargetHandler(handler2));
+  EXPECT_EQ(1, handler1.connections_);
+}
+
+} // namespace
+} // namespace LoadAware
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
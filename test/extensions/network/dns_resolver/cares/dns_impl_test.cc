@@ -350,6 +350,8 @@ public:
 
   void onReject(RejectCause) override { PANIC("not implemented"); }
 
+  void recordConnectionsAcceptedOnSocketEvent(uint32_t) override {}
+
   void addHosts(const std::string& hostname, const IpList& ip, const RecordType& type) {
     if (type == RecordType::A) {
       hosts_a_[hostname] = ip;
@@ -721,7 +723,8 @@ public:
     server_ = std::make_unique<TestDnsServer>(*dispatcher_);
     socket_ = std::make_shared<Network::Test::TcpListenSocketImmediateListen>(
         Network::Test::getCanonicalLoopbackAddress(GetParam()));
-    listener_ = dispatcher_->createListener(socket_, *server_, runtime_, true, false);
+    listener_ = dispatcher_->createListener(socket_, *server_, runtime_, true, false,
+                                            Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
     updateDnsResolverOptions();
 
     // Create a resolver options on stack here to emulate what actually happens in envoy bootstrap.
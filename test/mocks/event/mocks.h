@@ -70,11 +70,13 @@ public:
     return Filesystem::WatcherPtr{createFilesystemWatcher_()};
   }
 
-  Network::ListenerPtr createListener(Network::SocketSharedPtr&& socket,
-                                      Network::TcpListenerCallbacks& cb, Runtime::Loader& runtime,
-                                      bool bind_to_port, bool ignore_global_conn_limit) override {
-    return Network::ListenerPtr{
-        createListener_(std::move(socket), cb, runtime, bind_to_port, ignore_global_conn_limit)};
+  Network::ListenerPtr
+  createListener(Network::SocketSharedPtr&& socket, Network::TcpListenerCallbacks& cb,
+                 Runtime::Loader& runtime, bool bind_to_port, bool ignore_global_conn_limit,
+                 uint32_t max_connections_to_accept_per_socket_event) override {
+    return Network::ListenerPtr{createListener_(std::move(socket), cb, runtime, bind_to_port,
+                                                ignore_global_conn_limit,
+                                                max_connections_to_accept_per_socket_event)};
   }
 
   Network::UdpListenerPtr
@@ -143,7 +145,8 @@ public:
   MOCK_METHOD(Filesystem::Watcher*, createFilesystemWatcher_, ());
   MOCK_METHOD(Network::Listener*, createListener_,
               (Network::SocketSharedPtr && socket, Network::TcpListenerCallbacks& cb,
-               Runtime::Loader& runtime, bool bind_to_port, bool ignore_global_conn_limit));
+               Runtime::Loader& runtime, bool bind_to_port, bool ignore_global_conn_limit,
+               uint32_t max_connections_to_accept_per_socket_event));
   MOCK_METHOD(Network::UdpListener*, createUdpListener_,
               (Network::SocketSharedPtr socket, Network::UdpListenerCallbacks& cb,
                const envoy::config::core::v3::UdpSocketConfig& config));
@@ -60,11 +60,13 @@ public:
     return impl_.createFilesystemWatcher();
   }
 
-  Network::ListenerPtr createListener(Network::SocketSharedPtr&& socket,
-                                      Network::TcpListenerCallbacks& cb, Runtime::Loader& runtime,
-                                      bool bind_to_port, bool ignore_global_conn_limit) override {
+  Network::ListenerPtr
+  createListener(Network::SocketSharedPtr&& socket, Network::TcpListenerCallbacks& cb,
+                 Runtime::Loader& runtime, bool bind_to_port, bool ignore_global_conn_limit,
+                 uint32_t max_connections_to_accept_per_socket_event) override {
     return impl_.createListener(std::move(socket), cb, runtime, bind_to_port,
-                                ignore_global_conn_limit);
+                                ignore_global_conn_limit,
+                                max_connections_to_accept_per_socket_event);
   }
 
   Network::UdpListenerPtr
@@ -23,6 +23,7 @@ public:
   MOCK_METHOD(std::string, protocol, (), (const));
   MOCK_METHOD(absl::string_view, failureReason, (), (const));
   MOCK_METHOD(bool, canFlushClose, ());
+  MOCK_METHOD(bool, canMigrate, (), (const));
   MOCK_METHOD(Api::SysCallIntResult, connect, (Network::ConnectionSocket & socket));
   MOCK_METHOD(void, closeSocket, (Network::ConnectionEvent event));
   MOCK_METHOD(IoResult, doRead, (Buffer::Instance & buffer));
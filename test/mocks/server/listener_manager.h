@@ -28,6 +28,8 @@ public:
   MOCK_METHOD(void, endListenerUpdate, (ListenerManager::FailureStates &&));
   MOCK_METHOD(ApiListenerOptRef, apiListener, ());
   MOCK_METHOD(bool, isWorkerStarted, ());
+  MOCK_METHOD(void, migrateIdleConnections, (MigrateIdleConnectionsCallback callback));
+  MOCK_METHOD(void, acceptMigratedConnection, (os_fd_t fd));
 };
 } // namespace Server
 } // namespace Envoy
@@ -44,6 +44,7 @@ public:
   MOCK_METHOD(const std::string&, serviceNodeName, (), (const));
   MOCK_METHOD(const std::string&, serviceZone, (), (const));
   MOCK_METHOD(bool, hotRestartDisabled, (), (const));
+  MOCK_METHOD(bool, hotRestartMigrateIdleConnections, (), (const));
   MOCK_METHOD(bool, signalHandlingEnabled, (), (const));
   MOCK_METHOD(bool, mutexTracingEnabled, (), (const));
   MOCK_METHOD(bool, coreDumpEnabled, (), (const));
@@ -70,6 +71,7 @@ public:
   uint32_t concurrency_{1};
   uint64_t hot_restart_epoch_{};
   bool hot_restart_disabled_{};
+  bool hot_restart_migrate_idle_connections_{};
   bool signal_handling_enabled_{true};
   bool mutex_tracing_enabled_{};
   bool core_dump_enabled_{};
@@ -59,7 +59,9 @@ TEST_P(AdminInstanceTest, Memory) {
                                   Property(&envoy::admin::v3::Memory::heap_size, Ge(0)),
                                   Property(&envoy::admin::v3::Memory::pageheap_unmapped, Ge(0)),
                                   Property(&envoy::admin::v3::Memory::pageheap_free, Ge(0)),
-                                  Property(&envoy::admin::v3::Memory::total_thread_cache, Ge(0))));
+                                  Property(&envoy::admin::v3::Memory::total_thread_cache, Ge(0)),
+                                  Property(&envoy::admin::v3::Memory::arena_reserved, Ge(0)),
+                                  Property(&envoy::admin::v3::Memory::arena_allocated, Ge(0))));
 }
 
 TEST_P(AdminInstanceTest, GetReadyRequest) {
@@ -140,7 +140,8 @@ TEST_P(ValidationServerTest, DummyMethodsTest) {
   server.admin()->startHttpListener({}, "", nullptr, nullptr, nullptr);
 
   Network::MockTcpListenerCallbacks listener_callbacks;
-  server.dispatcher().createListener(nullptr, listener_callbacks, server.runtime(), false, false);
+  server.dispatcher().createListener(nullptr, listener_callbacks, server.runtime(), false, false,
+                                     Network::DefaultMaxConnectionsToAcceptPerSocketEvent);
 
   server.dnsResolver()->resolve("", Network::DnsLookupFamily::All, nullptr);
 }
@@ -158,6 +158,9 @@ public:
     uint32_t tcpBacklogSize() const override { return tcp_backlog_size_; }
     Init::Manager& initManager() override { return *init_manager_; }
     bool ignoreGlobalConnLimit() const override { return ignore_global_conn_limit_; }
+    uint32_t maxConnectionsToAcceptPerSocketEvent() const override {
+      return Network::DefaultMaxConnectionsToAcceptPerSocketEvent;
+    }
     void setMaxConnections(const uint32_t num_connections) {
       open_connections_.setMax(num_connections);
     }
@@ -316,7 +319,7 @@ public:
     EXPECT_CALL(listeners_.back()->socketFactory(), getListenSocket(_))
         .WillOnce(Return(listeners_.back()->sockets_[0]));
     if (socket_type == Network::Socket::Type::Stream) {
-      EXPECT_CALL(dispatcher_, createListener_(_, _, _, _, _))
+      EXPECT_CALL(dispatcher_, createListener_(_, _, _, _, _, _))
           .WillOnce(Invoke([listener, listener_callbacks](
                                Network::SocketSharedPtr&&, Network::TcpListenerCallbacks& cb,
                                Runtime::Loader&, bool, bool) -> Network::Listener* {
@@ -384,7 +387,7 @@ public:
       test_listener_raw_ptr->sockets_[i]->connection_info_provider_->setLocalAddress(addresses[i]);
 
       if (socket_type == Network::Socket::Type::Stream) {
-        EXPECT_CALL(dispatcher_, createListener_(_, _, _, _, _))
+        EXPECT_CALL(dispatcher_, createListener_(_, _, _, _, _, _))
             .WillOnce(
                 Invoke([i, &mock_listeners, &listener_callbacks_map](
                            Network::SocketSharedPtr&& socket, Network::TcpListenerCallbacks& cb,
@@ -916,6 +919,57 @@ TEST_F(ConnectionHandlerTest, SetsTransportSocketConnectTimeout) {
   EXPECT_CALL(*listener, onDestroy());
 }
 
+TEST_F(ConnectionHandlerTest, ChargesConnectionBuffersToListener) {
+  InSequence s;
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.listener_buffer_memory_accounting", "true"}});
+
+  Network::TcpListenerCallbacks* listener_callbacks;
+  auto listener = new NiceMock<Network::MockListener>();
+  TestListener* test_listener =
+      addListener(1, false, false, "test_listener", listener, &listener_callbacks);
+
+  handler_->addListener(absl::nullopt, *test_listener, runtime_);
+
+  auto server_connection = new NiceMock<Network::MockServerConnection>();
+  Buffer::BufferMemoryAccountSharedPtr account;
+  EXPECT_CALL(manager_, findFilterChain(_, _)).WillOnce(Return(filter_chain_.get()));
+  EXPECT_CALL(dispatcher_, createServerConnection_()).WillOnce(Return(server_connection));
+  EXPECT_CALL(*server_connection, bindBufferMemoryAccount(_)).WillOnce(SaveArg<0>(&account));
+  EXPECT_CALL(*access_log_, log(_, _, _, _, _));
+
+  listener_callbacks->onAccept(std::make_unique<NiceMock<Network::MockConnectionSocket>>());
+  ASSERT_NE(nullptr, account);
+
+  account->charge(16384);
+  EXPECT_EQ(16384, TestUtility::findGauge(stats_store_, "downstream_cx_buffer_bytes")->value());
+  account->credit(16384);
+  EXPECT_EQ(0, TestUtility::findGauge(stats_store_, "downstream_cx_buffer_bytes")->value());
+
+  EXPECT_CALL(*listener, onDestroy());
+}
+
+TEST_F(ConnectionHandlerTest, NoBufferMemoryAccountByDefault) {
+  InSequence s;
+
+  Network::TcpListenerCallbacks* listener_callbacks;
+  auto listener = new NiceMock<Network::MockListener>();
+  TestListener* test_listener =
+      addListener(1, false, false, "test_listener", listener, &listener_callbacks);
+
+  handler_->addListener(absl::nullopt, *test_listener, runtime_);
+
+  auto server_connection = new NiceMock<Network::MockServerConnection>();
+  EXPECT_CALL(manager_, findFilterChain(_, _)).WillOnce(Return(filter_chain_.get()));
+  EXPECT_CALL(dispatcher_, createServerConnection_()).WillOnce(Return(server_connection));
+  EXPECT_CALL(*server_connection, bindBufferMemoryAccount(_)).Times(0);
+  EXPECT_CALL(*access_log_, log(_, _, _, _, _));
+
+  listener_callbacks->onAccept(std::make_unique<NiceMock<Network::MockConnectionSocket>>());
+
+  EXPECT_CALL(*listener, onDestroy());
+}
+
 TEST_F(ConnectionHandlerTest, DestroyCloseConnections) {
   InSequence s;
 
@@ -2588,6 +2642,21 @@ TEST_F(ConnectionHandlerTest, TcpListenerGlobalCxLimitReject) {
   EXPECT_CALL(*listener, onDestroy());
 }
 
+TEST_F(ConnectionHandlerTest, TcpListenerRecordsConnectionsAcceptedOnSocketEvent) {
+  Network::TcpListenerCallbacks* listener_callbacks;
+  auto listener = new NiceMock<Network::MockListener>();
+  TestListener* test_listener =
+      addListener(1, true, false, "test_listener", listener, &listener_callbacks);
+  handler_->addListener(absl::nullopt, *test_listener, runtime_);
+
+  listener_callbacks->recordConnectionsAcceptedOnSocketEvent(3);
+  listener_callbacks->recordConnectionsAcceptedOnSocketEvent(0);
+
+  EXPECT_EQ(std::vector<uint64_t>({3, 0}),
+            stats_store_.histogramValues("connections_accepted_per_socket_event", false));
+  EXPECT_CALL(*listener, onDestroy());
+}
+
 TEST_F(ConnectionHandlerTest, TcpListenerOverloadActionReject) {
   Network::TcpListenerCallbacks* listener_callbacks;
   auto listener = new NiceMock<Network::MockListener>();
@@ -65,6 +65,43 @@ TEST_F(DrainManagerImplTest, Default) {
   drain_timer->invokeCallback();
 }
 
+TEST_F(DrainManagerImplTest, MigrateParentConnections) {
+  InSequence s;
+  server_.options_.hot_restart_migrate_idle_connections_ = true;
+  DrainManagerImpl drain_manager(server_, envoy::config::listener::v3::Listener::DEFAULT,
+                                 server_.dispatcher());
+
+  Event::MockTimer* shutdown_timer = new Event::MockTimer(&server_.dispatcher_);
+  EXPECT_CALL(*shutdown_timer, enableTimer(std::chrono::milliseconds(900000), _));
+  Event::MockTimer* migrate_timer = new Event::MockTimer(&server_.dispatcher_);
+  EXPECT_CALL(*migrate_timer, enableTimer(std::chrono::milliseconds(1000), _));
+  drain_manager.startParentShutdownSequence();
+
+  // The parent has no idle connection yet, try again later.
+  EXPECT_CALL(server_.hot_restart_, migrateParentConnections())
+      .WillOnce(Return(HotRestart::MigrateConnectionsResponse{{}, false, 3}));
+  EXPECT_CALL(*migrate_timer, enableTimer(std::chrono::milliseconds(1000), _));
+  migrate_timer->invokeCallback();
+
+  // The parent has more connections to hand off than one batch, come back right away.
+  EXPECT_CALL(server_.hot_restart_, migrateParentConnections())
+      .WillOnce(Return(HotRestart::MigrateConnectionsResponse{{10, 11}, true, 1}));
+  EXPECT_CALL(server_.listener_manager_, acceptMigratedConnection(10));
+  EXPECT_CALL(server_.listener_manager_, acceptMigratedConnection(11));
+  EXPECT_CALL(*migrate_timer, enableTimer(std::chrono::milliseconds(0), _));
+  migrate_timer->invokeCallback();
+
+  // Take over the last connection, then shut down the parent right away.
+  EXPECT_CALL(server_.hot_restart_, migrateParentConnections())
+      .WillOnce(Return(HotRestart::MigrateConnectionsResponse{{12}, false, 0}));
+  EXPECT_CALL(server_.listener_manager_, acceptMigratedConnection(12));
+  EXPECT_CALL(*shutdown_timer, enableTimer(std::chrono::milliseconds(0), _));
+  migrate_timer->invokeCallback();
+
+  EXPECT_CALL(server_.hot_restart_, sendParentTerminateRequest());
+  shutdown_timer->invokeCallback();
+}
+
 TEST_F(DrainManagerImplTest, ModifyOnly) {
   InSequence s;
   DrainManagerImpl drain_manager(server_, envoy::config::listener::v3::Listener::MODIFY_ONLY,
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 
 #include "source/common/network/address_impl.h"
@@ -10,9 +11,12 @@
 
 #include "gtest/gtest.h"
 
+using testing::_;
 using testing::InSequence;
+using testing::Invoke;
 using testing::Return;
 using testing::ReturnRef;
+using testing::SaveArg;
 
 namespace Envoy {
 namespace Server {
@@ -302,6 +306,64 @@ TEST_F(HotRestartingParentTest, DrainListeners) {
   hot_restarting_parent_.drainListeners();
 }
 
+TEST_F(HotRestartingParentTest, MigrateConnectionsForChild) {
+  MockListenerManager listener_manager;
+  ON_CALL(server_, listenerManager()).WillByDefault(ReturnRef(listener_manager));
+  ListenerManager::MigrateIdleConnectionsCallback migrate_callback;
+  EXPECT_CALL(listener_manager, migrateIdleConnections(_))
+      .WillOnce(SaveArg<0>(&migrate_callback));
+  EXPECT_CALL(listener_manager, numConnections()).WillRepeatedly(Return(3));
+
+  absl::optional<HotRestartMessage> message;
+  auto reply = [&message](const HotRestartMessage& wrapped_reply) { message = wrapped_reply; };
+
+  // The reply waits for the idle connections to be collected.
+  hot_restarting_parent_.migrateConnectionsForChild(reply);
+  EXPECT_FALSE(message.has_value());
+
+  const int num_sockets = HotRestartingBase::MaxPassedFds + 2;
+  std::vector<Network::IoHandlePtr> sockets;
+  for (int fd = 10; fd < 10 + num_sockets; ++fd) {
+    auto io_handle = std::make_unique<NiceMock<Network::MockIoHandle>>();
+    ON_CALL(*io_handle, fdDoNotUse()).WillByDefault(Return(fd));
+    sockets.push_back(std::move(io_handle));
+  }
+  migrate_callback(std::move(sockets));
+
+  // The collected connections are handed off in batches of at most MaxPassedFds.
+  ASSERT_TRUE(message.has_value());
+  std::vector<int> fds(message->reply().migrate_connection().fds().begin(),
+                       message->reply().migrate_connection().fds().end());
+  EXPECT_EQ(HotRestartingBase::MaxPassedFds, fds.size());
+  EXPECT_TRUE(message->reply().migrate_connection().more());
+  EXPECT_EQ(5, message->reply().migrate_connection().num_connections());
+
+  // The rest is handed off without collecting the idle connections again.
+  message.reset();
+  hot_restarting_parent_.migrateConnectionsForChild(reply);
+  ASSERT_TRUE(message.has_value());
+  fds.insert(fds.end(), message->reply().migrate_connection().fds().begin(),
+             message->reply().migrate_connection().fds().end());
+  EXPECT_FALSE(message->reply().migrate_connection().more());
+  EXPECT_EQ(3, message->reply().migrate_connection().num_connections());
+  std::sort(fds.begin(), fds.end());
+  ASSERT_EQ(num_sockets, fds.size());
+  for (int i = 0; i < num_sockets; ++i) {
+    EXPECT_EQ(10 + i, fds[i]);
+  }
+
+  // Once the collected connections were handed off, the idle connections are collected again.
+  EXPECT_CALL(listener_manager, migrateIdleConnections(_))
+      .WillOnce(Invoke([](ListenerManager::MigrateIdleConnectionsCallback callback) {
+        callback({});
+      }));
+  message.reset();
+  hot_restarting_parent_.migrateConnectionsForChild(reply);
+  ASSERT_TRUE(message.has_value());
+  EXPECT_EQ(0, message->reply().migrate_connection().fds_size());
+  EXPECT_FALSE(message->reply().migrate_connection().more());
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
@@ -99,7 +99,8 @@ TEST_F(OptionsImplTest, All) {
       "--drain-time-s 60 --log-format [%v] --enable-fine-grain-logging --parent-shutdown-time-s 90 "
       "--log-path "
       "/foo/bar "
-      "--disable-hot-restart --cpuset-threads --allow-unknown-static-fields "
+      "--disable-hot-restart --hot-restart-migrate-idle-connections --cpuset-threads "
+      "--allow-unknown-static-fields "
       "--reject-unknown-dynamic-fields --base-id 5 "
       "--use-dynamic-base-id --base-id-path /foo/baz "
       "--stats-tag foo:bar --stats-tag baz:bar "
@@ -122,6 +123,7 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ(std::chrono::seconds(60), options->drainTime());
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
+  EXPECT_TRUE(options->hotRestartMigrateIdleConnections());
   EXPECT_TRUE(options->cpusetThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
@@ -186,6 +188,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setServiceNodeName("node_foo");
   options->setServiceZone("zone_foo");
   options->setHotRestartDisabled(!options->hotRestartDisabled());
+  options->setHotRestartMigrateIdleConnections(true);
   options->setSignalHandling(!options->signalHandlingEnabled());
   options->setCpusetThreads(!options->cpusetThreadsEnabled());
   options->setAllowUnknownFields(true);
@@ -218,6 +221,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ("node_foo", options->serviceNodeName());
   EXPECT_EQ("zone_foo", options->serviceZone());
   EXPECT_EQ(!hot_restart_disabled, options->hotRestartDisabled());
+  EXPECT_TRUE(options->hotRestartMigrateIdleConnections());
   EXPECT_EQ(!signal_handling_enabled, options->signalHandlingEnabled());
   EXPECT_EQ(!cpuset_threads_enabled, options->cpusetThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
@@ -251,6 +255,8 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->serviceNodeName(), command_line_options->service_node());
   EXPECT_EQ(options->serviceZone(), command_line_options->service_zone());
   EXPECT_EQ(options->hotRestartDisabled(), command_line_options->disable_hot_restart());
+  EXPECT_EQ(options->hotRestartMigrateIdleConnections(),
+            command_line_options->hot_restart_migrate_idle_connections());
   EXPECT_EQ(options->mutexTracingEnabled(), command_line_options->enable_mutex_tracing());
   EXPECT_EQ(options->coreDumpEnabled(), command_line_options->enable_core_dump());
   EXPECT_EQ(options->cpusetThreadsEnabled(), command_line_options->cpuset_threads());